@@ -9,6 +9,11 @@
 #include <unistd.h>
 #include <time.h>
 #include <cinttypes>
+#include <stdlib.h>
+
+#if AP_REPLAY_MMAP_ENABLED
+#include <sys/mman.h>
+#endif
 
 #ifndef PRIu64
 #define PRIu64 "llu"
@@ -19,11 +24,36 @@ AP_LoggerFileReader::AP_LoggerFileReader()
 
 AP_LoggerFileReader::~AP_LoggerFileReader()
 {
+#if HAL_LOGGER_COMPRESSION_ENABLED
+    free(frame_buf);
+    free(frame_scratch);
+    free(decoded);
+#endif
     ::printf("Replay counts: %" PRIu64 " bytes  %u entries\n", bytes_read, message_count);
+#if HAL_LOGGER_COMPRESSION_ENABLED
+    if (bad_frames != 0) {
+        ::printf("Replay skipped %u bad compressed frames\n", unsigned(bad_frames));
+    }
+#endif
+#if AP_REPLAY_MMAP_ENABLED
+    if (mapped_log.is_open()) {
+        // the records in the log, to show when a replay stopped early
+        ::printf("Replay log: %" PRIu64 " records\n", mapped_log.total_count());
+    }
+#endif
 }
 
 bool AP_LoggerFileReader::open_log(const char *logfile)
 {
+#if AP_REPLAY_MMAP_ENABLED
+    // replay reads the log in order, so it only needs the mapping and
+    // not the per-record index
+    if (mapped_log.open(logfile)) {
+        madvise(mapped_log.data(), mapped_log.size(), MADV_SEQUENTIAL);
+        file_size = mapped_log.size();
+        return true;
+    }
+#endif
     fd = AP::FS().open(logfile, O_RDONLY);
     if (fd == -1) {
         return false;
@@ -38,11 +68,92 @@ bool AP_LoggerFileReader::open_log(const char *logfile)
 
 ssize_t AP_LoggerFileReader::read_input(void *buffer, const size_t count)
 {
+#if HAL_LOGGER_COMPRESSION_ENABLED
+    if (decoded_ofs < decoded_len) {
+        // frames only hold whole records, so a read never spans frames
+        const size_t n = MIN(count, size_t(decoded_len - decoded_ofs));
+        memcpy(buffer, &decoded[decoded_ofs], n);
+        decoded_ofs += n;
+        return n;
+    }
+#endif
     uint64_t ret = AP::FS().read(fd, buffer, count);
     bytes_read += ret;
     return ret;
 }
 
+#if HAL_LOGGER_COMPRESSION_ENABLED
+bool AP_LoggerFileReader::read_frame(const uint8_t hdr[3])
+{
+    if (frame_buf == nullptr) {
+        frame_buf = (uint8_t *)malloc(LOG_COMPRESSED_HEADER_LEN + UINT16_MAX);
+        frame_scratch = (uint8_t *)malloc(UINT16_MAX);
+        decoded = (uint8_t *)malloc(UINT16_MAX);
+        if (frame_buf == nullptr || frame_scratch == nullptr || decoded == nullptr) {
+            return false;
+        }
+    }
+    // frames are only found in the file itself, so this is where it started
+    const uint64_t frame_start = bytes_read - 3;
+    memcpy(frame_buf, hdr, 3);
+    if (read_input(&frame_buf[3], LOG_COMPRESSED_HEADER_LEN-3) != LOG_COMPRESSED_HEADER_LEN-3) {
+        return false;
+    }
+    const uint32_t frame_len = AP_Logger_Decompressor::frame_length(frame_buf);
+    const uint32_t data_len = frame_len - LOG_COMPRESSED_HEADER_LEN;
+    if (read_input(&frame_buf[LOG_COMPRESSED_HEADER_LEN], data_len) != (ssize_t)data_len ||
+        AP_Logger_Decompressor::decode(frame_buf, frame_len, frame_scratch, decoded, decoded_len) <= 0) {
+        // the length may be damaged too, so look for the next header
+        // from just after this one rather than after the frame
+        bad_frames++;
+        return resync(frame_start + 1);
+    }
+    decoded_ofs = 0;
+    return true;
+}
+
+/*
+  scan the file from ofs for the next frame header, or the header of
+  a record with a known format, and leave the file positioned on it
+ */
+bool AP_LoggerFileReader::resync(uint64_t ofs)
+{
+    if (!seek_input(ofs)) {
+        return false;
+    }
+    uint8_t b[3];
+    if (read_input(b, 2) != 2) {
+        return false;
+    }
+    while (true) {
+        if (read_input(&b[2], 1) != 1) {
+            return false;
+        }
+        if (b[0] == HEAD_BYTE1 &&
+            (b[1] == LOG_COMPRESSED_HEAD_BYTE2 ||
+             (b[1] == HEAD_BYTE2 && (b[2] == LOG_FORMAT_MSG || formats[b[2]].length != 0)))) {
+            break;
+        }
+        b[0] = b[1];
+        b[1] = b[2];
+    }
+    return seek_input(bytes_read - 3);
+}
+
+/*
+  move the read position to a file offset. AP_Filesystem offsets are
+  32 bit, which logs over 2GB don't fit in
+ */
+bool AP_LoggerFileReader::seek_input(uint64_t ofs)
+{
+    if (::lseek(fd, off_t(ofs), SEEK_SET) != off_t(ofs)) {
+        return false;
+    }
+    bytes_read = ofs;
+    return true;
+}
+#endif
+
 void AP_LoggerFileReader::format_type(uint16_t type, char dest[5])
 {
     const struct log_Format &f = formats[type];
@@ -59,10 +170,25 @@ void AP_LoggerFileReader::get_packet_counts(uint64_t dest[])
 
 bool AP_LoggerFileReader::update()
 {
+#if AP_REPLAY_MMAP_ENABLED
+    if (mapped_log.is_open()) {
+        return update_mapped();
+    }
+#endif
+
     uint8_t hdr[3];
     if (read_input(hdr, 3) != 3) {
         return false;
     }
+#if HAL_LOGGER_COMPRESSION_ENABLED
+    if (hdr[0] == HEAD_BYTE1 && hdr[1] == LOG_COMPRESSED_HEAD_BYTE2) {
+        // continue with the records of the frame
+        if (!read_frame(hdr)) {
+            return false;
+        }
+        return update();
+    }
+#endif
     if (hdr[0] != HEAD_BYTE1 || hdr[1] != HEAD_BYTE2) {
         printf("bad log header\n");
         return false;
@@ -107,6 +233,51 @@ bool AP_LoggerFileReader::update()
     return handle_msg(f, msg);
 }
 
+#if AP_REPLAY_MMAP_ENABLED
+/*
+  process the next record straight out of the mapping; message
+  handlers are given a pointer into the mapped file rather than a copy
+ */
+bool AP_LoggerFileReader::update_mapped()
+{
+    if (bytes_read + 3 > mapped_log.size()) {
+        return false;
+    }
+    uint8_t *hdr = &mapped_log.data()[bytes_read];
+    if (hdr[0] != HEAD_BYTE1 || hdr[1] != HEAD_BYTE2) {
+        printf("bad log header\n");
+        return false;
+    }
+    packet_counts[hdr[2]]++;
+
+    if (hdr[2] == LOG_FORMAT_MSG) {
+        if (bytes_read + sizeof(struct log_Format) > mapped_log.size()) {
+            return false;
+        }
+        struct log_Format f;
+        memcpy(&f, hdr, sizeof(f));
+        bytes_read += sizeof(f);
+        memcpy(&formats[f.type], &f, sizeof(formats[f.type]));
+
+        message_count++;
+        return handle_log_format_msg(f);
+    }
+
+    const struct log_Format &f = formats[hdr[2]];
+    if (f.length == 0) {
+        ::printf("No format defined for type (%d)\n", hdr[2]);
+        exit(1);
+    }
+    if (bytes_read + f.length > mapped_log.size()) {
+        return false;
+    }
+    bytes_read += f.length;
+
+    message_count++;
+    return handle_msg(f, hdr);
+}
+#endif // AP_REPLAY_MMAP_ENABLED
+
 float AP_LoggerFileReader::get_percent_read()
 {
     if (file_size == 0) {
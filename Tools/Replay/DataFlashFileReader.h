@@ -1,6 +1,8 @@
 #pragma once
 
 #include <AP_Logger/AP_Logger.h>
+#include <AP_Logger/AP_Logger_Compress.h>
+#include "DataFlashLog.h"
 
 #define LOGREADER_MAX_FORMATS 255 // must be >= highest MESSAGE
 
@@ -29,6 +31,31 @@ protected:
 private:
     ssize_t read_input(void *buf, size_t count);
 
+#if HAL_LOGGER_COMPRESSION_ENABLED
+    // read and decode a compressed frame, given its first 3 bytes
+    bool read_frame(const uint8_t hdr[3]);
+
+    // continue from the next header at or after a file offset
+    bool resync(uint64_t ofs);
+    bool seek_input(uint64_t ofs);
+
+    // frames which failed to decode and were skipped
+    uint32_t bad_frames = 0;
+
+    // records of the current compressed frame not yet read
+    uint8_t *frame_buf = nullptr;
+    uint8_t *frame_scratch = nullptr;
+    uint8_t *decoded = nullptr;
+    uint16_t decoded_len = 0;
+    uint16_t decoded_ofs = 0;
+#endif
+
+#if AP_REPLAY_MMAP_ENABLED
+    bool update_mapped();
+
+    DataFlashLog mapped_log;
+#endif
+
     uint64_t bytes_read = 0;
     uint64_t file_size = 0; // Total size of the log file
     uint32_t message_count = 0;
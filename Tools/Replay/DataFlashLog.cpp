@@ -0,0 +1,470 @@
+#include "DataFlashLog.h"
+#include <AP_Logger/AP_Logger_Compress.h>
+
+#if AP_REPLAY_MMAP_ENABLED
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#define SIDECAR_MAGIC   0x58444941 // "AIDX"
+#define SIDECAR_VERSION 2
+
+/*
+  modification time in nanoseconds, so a log rewritten within the
+  same second as its sidecar was built is still noticed
+ */
+static int64_t mtime_ns(const struct stat &st)
+{
+#if defined(__APPLE__)
+    const struct timespec &ts = st.st_mtimespec;
+#else
+    const struct timespec &ts = st.st_mtim;
+#endif
+    return int64_t(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+/*
+  map a log file. The mapping is private and writable so callers may
+  modify records in place without touching the file
+ */
+bool DataFlashLog::open(const char *filename, bool indexed, bool use_cache)
+{
+    close();
+
+    const int fd = ::open(filename, O_RDONLY|O_CLOEXEC);
+    if (fd == -1) {
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    void *p = mmap(nullptr, st.st_size, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+    // the mapping holds its own reference to the file
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        return false;
+    }
+    base = (uint8_t *)p;
+    length = st.st_size;
+    mtime = mtime_ns(st);
+
+#if HAL_LOGGER_COMPRESSION_ENABLED
+    if (length >= LOG_COMPRESSED_HEADER_LEN &&
+        AP_Logger_Decompressor::frame_length(base) != 0) {
+        // compressed logs can't be indexed in place, they are read
+        // through the file instead
+        close();
+        return false;
+    }
+#endif
+
+    if (!indexed) {
+        use_cache = false;
+    }
+    char idxname[PATH_MAX];
+    if (use_cache && snprintf(idxname, sizeof(idxname), "%s.idx", filename) >= (int)sizeof(idxname)) {
+        use_cache = false;
+    }
+    if (use_cache && load_sidecar(idxname)) {
+        return true;
+    }
+    if (!build_index(indexed)) {
+        close();
+        return false;
+    }
+    if (use_cache) {
+        save_sidecar(idxname);
+    }
+    return true;
+}
+
+void DataFlashLog::close(void)
+{
+    clear_index();
+    if (base != nullptr) {
+        munmap(base, length);
+        base = nullptr;
+        length = 0;
+    }
+}
+
+void DataFlashLog::clear_index(void)
+{
+    if (sidecar_base != nullptr) {
+        munmap(sidecar_base, sidecar_length);
+        sidecar_base = nullptr;
+        sidecar_length = 0;
+    } else {
+        for (auto &ti : index) {
+            free(ti.offsets);
+        }
+        free(checkpoints);
+    }
+    memset(index, 0, sizeof(index));
+    checkpoints = nullptr;
+    num_checkpoints = 0;
+    total_records = 0;
+    memset(fmt_offset, 0, sizeof(fmt_offset));
+    memset(has_time, 0, sizeof(has_time));
+}
+
+/*
+  a format is timestamped if its first field is a uint64_t TimeUS
+ */
+bool DataFlashLog::format_has_time(const struct log_Format &f)
+{
+    return f.format[0] == 'Q' &&
+        strncmp(f.labels, "TimeUS", 6) == 0 &&
+        (f.labels[6] == ',' || f.labels[6] == '\0');
+}
+
+/*
+  walk the log, counting records by message type and noting where
+  each type is defined. With keep_offsets, a second pass records the
+  offset of every record plus a checkpoint every checkpoint_interval
+  bytes; counting first gives each array a single exact-sized
+  allocation. Corrupt data is skipped by resynchronising on the next
+  record header
+ */
+bool DataFlashLog::build_index(bool keep_offsets)
+{
+    for (uint8_t pass=0; pass<2; pass++) {
+        uint8_t lengths[256] {};
+        bool timed[256] {};
+        lengths[LOG_FORMAT_MSG] = sizeof(struct log_Format);
+        uint64_t last_time_us = 0;
+        uint64_t next_checkpoint = 0;
+        uint32_t ncheckpoints = 0;
+        uint64_t ofs = 0;
+        while (ofs + 3 <= length) {
+            const uint8_t *p = &base[ofs];
+            const uint8_t type = p[2];
+            if (p[0] != HEAD_BYTE1 || p[1] != HEAD_BYTE2 ||
+                lengths[type] < 3 || ofs + lengths[type] > length) {
+                ofs++;
+                continue;
+            }
+            if (type == LOG_FORMAT_MSG) {
+                const struct log_Format *f = (const struct log_Format *)p;
+                lengths[f->type] = f->length;
+                timed[f->type] = format_has_time(*f);
+                if (pass == 0) {
+                    // the last definition of a type wins
+                    fmt_offset[f->type] = ofs;
+                    has_time[f->type] = timed[f->type];
+                }
+            }
+            if (timed[type]) {
+                memcpy(&last_time_us, &p[3], sizeof(last_time_us));
+            }
+            if (ofs >= next_checkpoint) {
+                if (pass != 0) {
+                    checkpoints[ncheckpoints] = { last_time_us, ofs };
+                }
+                ncheckpoints++;
+                next_checkpoint = ofs + checkpoint_interval;
+            }
+            type_index &ti = index[type];
+            if (pass != 0) {
+                ti.offsets[ti.count] = ofs;
+            }
+            ti.count++;
+            ofs += lengths[type];
+        }
+        if (pass != 0) {
+            break;
+        }
+
+        total_records = 0;
+        for (const auto &ti : index) {
+            total_records += ti.count;
+        }
+        if (!keep_offsets) {
+            break;
+        }
+        for (auto &ti : index) {
+            if (ti.count != 0) {
+                ti.offsets = (uint64_t *)malloc(ti.count * sizeof(uint64_t));
+                if (ti.offsets == nullptr) {
+                    return false;
+                }
+            }
+            ti.count = 0;
+        }
+        num_checkpoints = ncheckpoints;
+        if (num_checkpoints != 0) {
+            checkpoints = (checkpoint *)malloc(num_checkpoints * sizeof(checkpoint));
+            if (checkpoints == nullptr) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+  note where each type is defined from an index loaded from a
+  sidecar. If a type is redefined part way through the log the last
+  definition wins
+ */
+void DataFlashLog::find_formats(void)
+{
+    const type_index &ti = index[LOG_FORMAT_MSG];
+    for (uint32_t i=0; i<ti.count; i++) {
+        const struct log_Format *f = (const struct log_Format *)&base[ti.offsets[i]];
+        fmt_offset[f->type] = ti.offsets[i];
+        has_time[f->type] = format_has_time(*f);
+    }
+}
+
+const struct log_Format *DataFlashLog::format(uint8_t type) const
+{
+    if (length < sizeof(struct log_Format)) {
+        return nullptr;
+    }
+    // types which are never defined have an offset of zero, which
+    // will only hold a FMT record for one type
+    const struct log_Format *f = (const struct log_Format *)&base[fmt_offset[type]];
+    if (f->msgid != LOG_FORMAT_MSG || f->type != type) {
+        return nullptr;
+    }
+    return f;
+}
+
+int16_t DataFlashLog::find_type(const char *name) const
+{
+    for (uint16_t type=0; type<256; type++) {
+        const struct log_Format *f = format(type);
+        if (f != nullptr && strncmp(f->name, name, sizeof(f->name)) == 0) {
+            return type;
+        }
+    }
+    return -1;
+}
+
+uint8_t DataFlashLog::record_length_at(uint64_t ofs) const
+{
+    if (ofs + 3 > length) {
+        return 0;
+    }
+    const uint8_t *p = &base[ofs];
+    if (p[0] != HEAD_BYTE1 || p[1] != HEAD_BYTE2) {
+        return 0;
+    }
+    uint8_t len = sizeof(struct log_Format);
+    if (p[2] != LOG_FORMAT_MSG) {
+        const struct log_Format *f = format(p[2]);
+        if (f == nullptr) {
+            return 0;
+        }
+        len = f->length;
+    }
+    if (len < 3 || ofs + len > length) {
+        return 0;
+    }
+    return len;
+}
+
+bool DataFlashLog::record_time(const uint8_t *rec, uint64_t &time_us) const
+{
+    if (!has_time[rec[2]]) {
+        return false;
+    }
+    memcpy(&time_us, &rec[3], sizeof(time_us));
+    return true;
+}
+
+uint32_t DataFlashLog::lower_bound(uint8_t type, uint64_t time_us) const
+{
+    if (!has_time[type] || index[type].offsets == nullptr) {
+        return index[type].count;
+    }
+    uint32_t lo = 0;
+    uint32_t hi = index[type].count;
+    while (lo < hi) {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        uint64_t t;
+        record_time(record(type, mid), t);
+        if (t < time_us) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+uint64_t DataFlashLog::seek_time(uint64_t time_us) const
+{
+    // find the last checkpoint which is entirely before time_us
+    uint32_t lo = 0;
+    uint32_t hi = num_checkpoints;
+    while (lo < hi) {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        if (checkpoints[mid].time_us < time_us) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo == 0 ? 0 : checkpoints[lo-1].offset;
+}
+
+/*
+  map a sidecar index, accepting it only if it was built from a log
+  of the same size and modification time and every offset in it is
+  a record of the expected type
+ */
+bool DataFlashLog::load_sidecar(const char *idxname)
+{
+    const int fd = ::open(idxname, O_RDONLY|O_CLOEXEC);
+    if (fd == -1) {
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || (uint64_t)st.st_size < sizeof(sidecar_header)) {
+        ::close(fd);
+        return false;
+    }
+    void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        return false;
+    }
+
+    const sidecar_header &h = *(const sidecar_header *)p;
+    uint64_t expected_size = sizeof(h) + uint64_t(h.num_checkpoints) * sizeof(checkpoint);
+    for (const auto count : h.counts) {
+        expected_size += uint64_t(count) * sizeof(uint64_t);
+    }
+    if (h.magic != SIDECAR_MAGIC ||
+        h.version != SIDECAR_VERSION ||
+        h.header_size != sizeof(h) ||
+        h.log_size != length ||
+        h.log_mtime_ns != mtime ||
+        expected_size != (uint64_t)st.st_size) {
+        munmap(p, st.st_size);
+        return false;
+    }
+
+    sidecar_base = (uint8_t *)p;
+    sidecar_length = st.st_size;
+    total_records = h.total_records;
+
+    uint8_t *q = sidecar_base + sizeof(h);
+    num_checkpoints = h.num_checkpoints;
+    checkpoints = (checkpoint *)(void *)q;
+    q += num_checkpoints * sizeof(checkpoint);
+    for (uint16_t type=0; type<256; type++) {
+        index[type].count = h.counts[type];
+        index[type].offsets = (uint64_t *)(void *)q;
+        q += index[type].count * sizeof(uint64_t);
+    }
+
+    // formats first, as the other record lengths come from them
+    if (!offsets_valid(LOG_FORMAT_MSG)) {
+        clear_index();
+        return false;
+    }
+    find_formats();
+    for (uint16_t type=0; type<256; type++) {
+        if (type != LOG_FORMAT_MSG && !offsets_valid(type)) {
+            clear_index();
+            return false;
+        }
+    }
+    for (uint32_t i=0; i<num_checkpoints; i++) {
+        if (record_length_at(checkpoints[i].offset) == 0 ||
+            (i > 0 && checkpoints[i].offset <= checkpoints[i-1].offset)) {
+            clear_index();
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+  check the offsets of a type are in order and each is a whole record
+  of that type
+ */
+bool DataFlashLog::offsets_valid(uint8_t type) const
+{
+    const type_index &ti = index[type];
+    for (uint32_t i=0; i<ti.count; i++) {
+        const uint64_t ofs = ti.offsets[i];
+        if ((i > 0 && ofs <= ti.offsets[i-1]) ||
+            ofs + 3 > length ||
+            base[ofs+2] != type) {
+            return false;
+        }
+        if (type == LOG_FORMAT_MSG) {
+            // FMT records are checked before the formats are known
+            if (ofs + sizeof(struct log_Format) > length ||
+                base[ofs] != HEAD_BYTE1 || base[ofs+1] != HEAD_BYTE2) {
+                return false;
+            }
+        } else if (record_length_at(ofs) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+  write the index next to the log. It is written to a temporary file
+  and renamed into place so concurrent readers of the same log never
+  see a partial sidecar. Failure is not an error, the index just gets
+  rebuilt next time
+ */
+void DataFlashLog::save_sidecar(const char *idxname) const
+{
+    char tmpname[PATH_MAX];
+    if (snprintf(tmpname, sizeof(tmpname), "%s.%d", idxname, (int)getpid()) >= (int)sizeof(tmpname)) {
+        return;
+    }
+    FILE *f = fopen(tmpname, "wb");
+    if (f == nullptr) {
+        return;
+    }
+
+    static_assert(sizeof(sidecar_header) % sizeof(uint64_t) == 0, "sidecar arrays must stay 8 byte aligned");
+    sidecar_header h {};
+    h.magic = SIDECAR_MAGIC;
+    h.version = SIDECAR_VERSION;
+    h.header_size = sizeof(h);
+    h.log_size = length;
+    h.log_mtime_ns = mtime;
+    h.total_records = total_records;
+    h.num_checkpoints = num_checkpoints;
+    for (uint16_t type=0; type<256; type++) {
+        h.counts[type] = index[type].count;
+    }
+
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+    if (ok && num_checkpoints != 0) {
+        ok = fwrite(checkpoints, sizeof(checkpoint), num_checkpoints, f) == num_checkpoints;
+    }
+    for (uint16_t type=0; ok && type<256; type++) {
+        const type_index &ti = index[type];
+        if (ti.count != 0) {
+            ok = fwrite(ti.offsets, sizeof(uint64_t), ti.count, f) == ti.count;
+        }
+    }
+    if (fclose(f) != 0) {
+        ok = false;
+    }
+    if (!ok || rename(tmpname, idxname) != 0) {
+        unlink(tmpname);
+    }
+}
+
+#endif // AP_REPLAY_MMAP_ENABLED
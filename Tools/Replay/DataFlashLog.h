@@ -0,0 +1,158 @@
+#pragma once
+
+#include <AP_Logger/AP_Logger.h>
+
+#ifndef AP_REPLAY_MMAP_ENABLED
+// map the whole log into memory rather than reading it through AP_Filesystem
+#define AP_REPLAY_MMAP_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX)
+#endif
+
+#if AP_REPLAY_MMAP_ENABLED
+
+/*
+  a DataFlash log mapped into memory, with an index of record offsets
+  per message type and a coarse time index over the whole log.
+
+  Records are handed out as pointers into the mapping; their layout
+  is described by the FMT for their type, so MsgHandler can be used
+  to pull fields out of them without copying.
+
+  The record offsets are only kept when the log is opened indexed, as
+  they take 8 bytes per record. They can be cached in a "<log>.idx"
+  sidecar file which is itself mapped on later opens, so a log only
+  needs to be scanned once.
+ */
+class DataFlashLog
+{
+    friend class DataFlashLog_Test;
+
+public:
+    DataFlashLog() {}
+    ~DataFlashLog() { close(); }
+
+    CLASS_NO_COPY(DataFlashLog);
+
+    /*
+      map a log, counting its records by type. With indexed set the
+      offset of every record is kept as well, which the random access
+      queries below need. With use_cache set an indexed open loads the
+      index from the sidecar, building and saving it if there is no
+      valid sidecar
+     */
+    bool open(const char *filename, bool indexed=false, bool use_cache=false);
+    void close(void);
+
+    bool is_open(void) const { return base != nullptr; }
+    uint8_t *data(void) const { return base; }
+    uint64_t size(void) const { return length; }
+
+    // total number of well-formed records found in the log
+    uint64_t total_count(void) const { return total_records; }
+
+    // FMT record for a message type, or nullptr if the log never defines it
+    const struct log_Format *format(uint8_t type) const;
+
+    // find a message type by its name, returning -1 if not present
+    int16_t find_type(const char *name) const;
+
+    // number of records of a type in the log
+    uint32_t count(uint8_t type) const { return index[type].count; }
+
+    // zero-copy access to the n'th record of a type, indexed logs only
+    uint8_t *record(uint8_t type, uint32_t n) const {
+        return index[type].offsets != nullptr && n < index[type].count ? &base[index[type].offsets[n]] : nullptr;
+    }
+    uint64_t record_offset(uint8_t type, uint32_t n) const {
+        return index[type].offsets[n];
+    }
+
+    // length of the record at a file offset, or 0 if there is no
+    // well-formed record there
+    uint8_t record_length_at(uint64_t ofs) const;
+
+    // TimeUS of a record, false if its message has no leading TimeUS field
+    bool record_time(const uint8_t *rec, uint64_t &time_us) const;
+
+    // index of the first record of a type with TimeUS >= time_us, or
+    // count(type) if there is none or the log is not indexed
+    uint32_t lower_bound(uint8_t type, uint64_t time_us) const;
+
+    // a file offset at or before the first record of any type with
+    // TimeUS >= time_us; scan forward with record_length_at()
+    uint64_t seek_time(uint64_t time_us) const;
+
+    /*
+      call fn(uint8_t *record) for each record of type with
+      start_us <= TimeUS < end_us, returning the number of records
+      visited. fn may return false to stop early
+     */
+    template <typename F>
+    uint32_t for_each_in_range(uint8_t type, uint64_t start_us, uint64_t end_us, F fn) const {
+        uint32_t visited = 0;
+        for (uint32_t i=lower_bound(type, start_us); i<index[type].count; i++) {
+            uint8_t *rec = record(type, i);
+            uint64_t t;
+            if (!record_time(rec, t) || t >= end_us) {
+                break;
+            }
+            visited++;
+            if (!fn(rec)) {
+                break;
+            }
+        }
+        return visited;
+    }
+
+private:
+    // a checkpoint is taken roughly this often through the log
+    static const uint32_t checkpoint_interval = 65536;
+
+    struct PACKED sidecar_header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t header_size;
+        uint64_t log_size;
+        int64_t log_mtime_ns;
+        uint64_t total_records;
+        uint32_t num_checkpoints;
+        uint32_t reserved;
+        uint32_t counts[256];
+    };
+
+    struct checkpoint {
+        uint64_t time_us; // latest TimeUS seen up to and including offset
+        uint64_t offset;
+    };
+
+    struct type_index {
+        uint64_t *offsets;
+        uint32_t count;
+    } index[256] {};
+
+    uint8_t *base = nullptr;
+    uint64_t length = 0;
+    int64_t mtime = 0; // nanoseconds
+    uint64_t total_records = 0;
+
+    checkpoint *checkpoints = nullptr;
+    uint32_t num_checkpoints = 0;
+
+    // offset of the FMT record defining each type, and whether that
+    // format starts with a TimeUS field
+    uint64_t fmt_offset[256] {};
+    bool has_time[256] {};
+
+    // mapped sidecar, when the index was loaded from one
+    uint8_t *sidecar_base = nullptr;
+    uint64_t sidecar_length = 0;
+
+    static bool format_has_time(const struct log_Format &f);
+    bool build_index(bool keep_offsets);
+    void find_formats(void);
+    void clear_index(void);
+    bool load_sidecar(const char *idxname);
+    bool offsets_valid(uint8_t type) const;
+    void save_sidecar(const char *idxname) const;
+};
+
+#endif // AP_REPLAY_MMAP_ENABLED
@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+
+# flake8: noqa
+
+'''
+Run Replay over many logs, and optionally many parameter variants of
+each log, in parallel. Each Replay runs in its own scratch directory so
+the output logs and eeprom of concurrent runs do not collide. Prints a
+summary of runtime and EKF divergence for every log/variant pair
+
+  ./batch_replay.py --jobs 8 logs/*.BIN
+  ./batch_replay.py --variant base: --variant slow_gps:EK3_GPS_DELAY=300 00000012.BIN
+'''
+
+import concurrent.futures
+import csv
+import glob
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+import check_replay
+
+
+def parse_variant(spec):
+    '''parse LABEL:NAME=VALUE,NAME=VALUE into a label and a list of --parm arguments'''
+    if ':' not in spec:
+        raise ValueError("variant must be LABEL:NAME=VALUE,...")
+    label, params = spec.split(':', 1)
+    parms = [p.strip() for p in params.split(',') if p.strip()]
+    for p in parms:
+        if '=' not in p:
+            raise ValueError("bad parameter %s in variant %s" % (p, label))
+    return (label, parms)
+
+
+def run_one(replay, logfile, label, parms, param_file, extra_args, ekf2_only, ekf3_only, keep):
+    '''replay one log with one parameter variant, returning a result dict'''
+    result = {
+        'log': logfile,
+        'variant': label,
+        'ok': False,
+        'runtime': 0.0,
+        'messages': 0,
+        'records': 0,
+        'count': 0,
+        'base_count': 0,
+        'mismatches': 0,
+        'worst': '',
+        'worst_diff': 0.0,
+        'error': '',
+    }
+    workdir = tempfile.mkdtemp(prefix='replay-')
+    try:
+        cmd = [replay]
+        if param_file is not None:
+            cmd.extend(['--param-file', param_file])
+        for p in parms:
+            cmd.extend(['--parm', p])
+        cmd.extend(extra_args)
+        cmd.append(logfile)
+
+        t0 = time.monotonic()
+        p = subprocess.run(cmd, cwd=workdir, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+        result['runtime'] = time.monotonic() - t0
+        if p.returncode != 0:
+            result['error'] = "Replay exited with %d" % p.returncode
+            return result
+
+        m = re.search(r'Replay counts: \d+ bytes\s+(\d+) entries', p.stdout)
+        if m is not None:
+            result['messages'] = int(m.group(1))
+        m = re.search(r'Replay log: (\d+) records', p.stdout)
+        if m is not None:
+            result['records'] = int(m.group(1))
+
+        outlogs = sorted(glob.glob(os.path.join(workdir, 'logs', '*.BIN')))
+        if len(outlogs) == 0:
+            result['error'] = "no output log"
+            return result
+
+        d = check_replay.log_divergence(outlogs[-1], ekf2_only=ekf2_only, ekf3_only=ekf3_only)
+        result['count'] = d['count']
+        result['base_count'] = d['base_count']
+        result['mismatches'] = d['mismatches']
+        if len(d['max_diff']) > 0:
+            worst = max(d['max_diff'], key=d['max_diff'].get)
+            result['worst'] = worst
+            result['worst_diff'] = d['max_diff'][worst]
+        result['ok'] = True
+        return result
+    finally:
+        if keep:
+            result['workdir'] = workdir
+        else:
+            shutil.rmtree(workdir, ignore_errors=True)
+
+
+def print_summary(results):
+    '''print a table of results, one line per log/variant'''
+    print("%-32s %-12s %8s %9s %9s %9s  %s" % ("Log", "Variant", "Time(s)", "Msgs", "Compared", "Mismatch", "Worst field"))
+    for r in results:
+        name = os.path.basename(r['log'])
+        if not r['ok']:
+            print("%-32s %-12s %8.1f  FAILED: %s" % (name, r['variant'], r['runtime'], r['error']))
+            continue
+        worst = ''
+        if r['worst']:
+            worst = "%s (%g)" % (r['worst'], r['worst_diff'])
+        truncated = ''
+        if r['records'] != 0 and r['messages'] < r['records']:
+            truncated = ' [stopped at %u/%u]' % (r['messages'], r['records'])
+        print("%-32s %-12s %8.1f %9u %9u %9u  %s%s" % (
+            name, r['variant'], r['runtime'], r['messages'],
+            r['count'], r['mismatches'], worst, truncated))
+    total = sum([r['runtime'] for r in results])
+    failed = len([r for r in results if not r['ok']])
+    print("%u runs, %u failed, %.1fs total replay time" % (len(results), failed, total))
+
+
+def write_csv(filename, results):
+    fields = ['log', 'variant', 'ok', 'runtime', 'messages', 'records', 'count',
+              'base_count', 'mismatches', 'worst', 'worst_diff', 'error']
+    with open(filename, 'w', newline='') as f:
+        w = csv.DictWriter(f, fieldnames=fields, extrasaction='ignore')
+        w.writeheader()
+        for r in results:
+            w.writerow(r)
+
+
+if __name__ == '__main__':
+    from argparse import ArgumentParser
+    parser = ArgumentParser(description=__doc__)
+    parser.add_argument("--replay", default=None, help="path to Replay binary (default build/sitl/tool/Replay)")
+    parser.add_argument("--jobs", "-j", type=int, default=os.cpu_count(), help="number of Replays to run at once")
+    parser.add_argument("--variant", action='append', default=[], help="parameter variant as LABEL:NAME=VALUE,NAME=VALUE; may be repeated")
+    parser.add_argument("--param-file", default=None, help="parameter file applied to every run")
+    parser.add_argument("--force-ekf2", action='store_true', help="pass --force-ekf2 to Replay")
+    parser.add_argument("--force-ekf3", action='store_true', help="pass --force-ekf3 to Replay")
+    parser.add_argument("--ekf2-only", action='store_true', help="only compare EKF2 output")
+    parser.add_argument("--ekf3-only", action='store_true', help="only compare EKF3 output")
+    parser.add_argument("--csv", default=None, help="also write the summary to a CSV file")
+    parser.add_argument("--keep", action='store_true', help="keep the per-run scratch directories")
+    parser.add_argument("--fail-on-divergence", action='store_true', help="exit non-zero if any run diverges from the logged output")
+    parser.add_argument("logs", metavar="LOG", nargs="+")
+    args = parser.parse_args()
+
+    replay = args.replay
+    if replay is None:
+        topdir = os.path.join(os.path.dirname(os.path.realpath(__file__)), '..', '..')
+        replay = os.path.join(topdir, 'build', 'sitl', 'tool', 'Replay')
+    replay = os.path.realpath(replay)
+    if not os.path.exists(replay):
+        print("Replay binary %s not found; build with ./waf replay" % replay)
+        sys.exit(1)
+
+    variants = [parse_variant(v) for v in args.variant]
+    if len(variants) == 0:
+        variants = [('default', [])]
+
+    extra_args = []
+    if args.force_ekf2:
+        extra_args.append('--force-ekf2')
+    if args.force_ekf3:
+        extra_args.append('--force-ekf3')
+    param_file = None
+    if args.param_file is not None:
+        param_file = os.path.realpath(args.param_file)
+
+    results = []
+    with concurrent.futures.ProcessPoolExecutor(max_workers=max(1, args.jobs)) as executor:
+        futures = []
+        for logfile in args.logs:
+            logfile = os.path.realpath(logfile)
+            for (label, parms) in variants:
+                futures.append(executor.submit(run_one, replay, logfile, label, parms, param_file,
+                                               extra_args, args.ekf2_only, args.ekf3_only, args.keep))
+        for f in concurrent.futures.as_completed(futures):
+            r = f.result()
+            print("Finished %s (%s) in %.1fs" % (os.path.basename(r['log']), r['variant'], r['runtime']))
+            results.append(r)
+
+    results.sort(key=lambda r: (r['log'], r['variant']))
+    print_summary(results)
+    if args.csv is not None:
+        write_csv(args.csv, results)
+
+    failed = any([not r['ok'] for r in results])
+    if args.fail_on_divergence:
+        failed = failed or any([r['mismatches'] != 0 for r in results])
+    sys.exit(1 if failed else 0)
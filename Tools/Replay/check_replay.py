@@ -6,27 +6,24 @@
 check that replay produced identical results
 '''
 
-def check_log(logfile, progress=print, ekf2_only=False, ekf3_only=False, verbose=False, accuracy=0.0, ignores=set()):
-    '''check replay log for matching output'''
-    from contextlib import closing
-    from pymavlink import mavutil
-    progress("Processing log %s" % logfile)
-    failure = 0
-    errors = 0
-    count = 0
-    base_count = 0
-    counts = {}
-    base_counts = {}
+ek2_list = ['NKF1','NKF2','NKF3','NKF4','NKF5','NKF0','NKQ', 'NKY0', 'NKY1']
+ek3_list = ['XKF1','XKF2','XKF3','XKF4','XKF5','XKFA','XKF0','XKFS','XKQ','XKFD','XKV1','XKV2','XKY0','XKY1']
 
-    ek2_list = ['NKF1','NKF2','NKF3','NKF4','NKF5','NKF0','NKQ', 'NKY0', 'NKY1']
-    ek3_list = ['XKF1','XKF2','XKF3','XKF4','XKF5','XKFA','XKF0','XKFS','XKQ','XKFD','XKV1','XKV2','XKY0','XKY1']
-    
+def message_list(ekf2_only=False, ekf3_only=False):
+    '''return the EKF messages to compare'''
     if ekf2_only:
-        mlist = ek2_list
-    elif ekf3_only:
-        mlist = ek3_list
-    else:
-        mlist = ek2_list + ek3_list
+        return ek2_list
+    if ekf3_only:
+        return ek3_list
+    return ek2_list + ek3_list
+
+def compare_log(logfile, mlist, accuracy=0.0, ignores=set()):
+    '''pair each replayed message in a replay log with the logged message
+    it should match. Yields (mtype, m, mb, mismatches) where mismatches
+    is a list of (field, v1, v2) for the fields which differ by more than
+    accuracy percent. Logged messages are yielded with mb set to None'''
+    from contextlib import closing
+    from pymavlink import mavutil
 
     base = {}
     for m in mlist:
@@ -40,19 +37,15 @@ def check_log(logfile, progress=print, ekf2_only=False, ekf3_only=False, verbose
             if not hasattr(m,'C'):
                 continue
             mtype = m.get_type()
-            if mtype not in counts:
-                counts[mtype] = 0
-                base_counts[mtype] = 0
             core = m.C
             if core < 100:
                 base[mtype][core] = m
-                base_count += 1
-                base_counts[mtype] += 1
+                yield (mtype, m, None, [])
+                continue
+            mb = base[mtype].get(core-100, None)
+            if mb is None:
                 continue
-            mb = base[mtype][core-100]
-            count += 1
-            counts[mtype] += 1
-            mismatch = False
+            mismatches = []
             for f in m._fieldnames:
                 if f == 'C':
                     continue
@@ -67,12 +60,37 @@ def check_log(logfile, progress=print, ekf2_only=False, ekf3_only=False, verbose
                     if abs(v1-v2) <= abs(margin):
                         ok = True
                 if not ok:
-                    mismatch = True
-                    errors += 1
-                    progress("Mismatch in field %s.%s: %s %s" % (mtype, f, str(v1), str(v2)))
-            if mismatch:
-                progress(mb)
-                progress(m)
+                    mismatches.append((f, v1, v2))
+            yield (mtype, m, mb, mismatches)
+
+def check_log(logfile, progress=print, ekf2_only=False, ekf3_only=False, verbose=False, accuracy=0.0, ignores=set()):
+    '''check replay log for matching output'''
+    progress("Processing log %s" % logfile)
+    failure = 0
+    errors = 0
+    count = 0
+    base_count = 0
+    counts = {}
+    base_counts = {}
+
+    mlist = message_list(ekf2_only, ekf3_only)
+
+    for (mtype, m, mb, mismatches) in compare_log(logfile, mlist, accuracy, ignores):
+        if mtype not in counts:
+            counts[mtype] = 0
+            base_counts[mtype] = 0
+        if mb is None:
+            base_count += 1
+            base_counts[mtype] += 1
+            continue
+        count += 1
+        counts[mtype] += 1
+        for (f, v1, v2) in mismatches:
+            errors += 1
+            progress("Mismatch in field %s.%s: %s %s" % (mtype, f, str(v1), str(v2)))
+        if len(mismatches) > 0:
+            progress(mb)
+            progress(m)
     progress("Processed %u/%u messages, %u errors" % (count, base_count, errors))
     if verbose:
         for mtype in counts.keys():
@@ -85,6 +103,35 @@ def check_log(logfile, progress=print, ekf2_only=False, ekf3_only=False, verbose
         return False
     return True
 
+def log_divergence(logfile, ekf2_only=False, ekf3_only=False, accuracy=0.0, ignores=set()):
+    '''return a summary of how far replayed EKF output drifted from the
+    logged output, as a dict with message counts, the number of
+    mismatched fields and the largest absolute difference per field.
+    Fields are compared as check_log() compares them'''
+    ret = {
+        'count': 0,
+        'base_count': 0,
+        'mismatches': 0,
+        'max_diff': {},
+    }
+    max_diff = ret['max_diff']
+    mlist = message_list(ekf2_only, ekf3_only)
+    for (mtype, m, mb, mismatches) in compare_log(logfile, mlist, accuracy, ignores):
+        if mb is None:
+            ret['base_count'] += 1
+            continue
+        ret['count'] += 1
+        ret['mismatches'] += len(mismatches)
+        for (f, v1, v2) in mismatches:
+            try:
+                diff = abs(v1-v2)
+            except TypeError:
+                continue
+            name = "%s.%s" % (mtype, f)
+            if diff > max_diff.get(name, 0):
+                max_diff[name] = diff
+    return ret
+
 if __name__ == '__main__':
     import sys
     from argparse import ArgumentParser
@@ -0,0 +1,237 @@
+/*
+  check the DataFlashLog queries against a linear scan of the records
+  written to a log, both with an index built from the log and with one
+  loaded from its sidecar
+ */
+#include <AP_gtest.h>
+
+#include "../DataFlashLog.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+#if AP_REPLAY_MMAP_ENABLED
+
+class DataFlashLog_Test {
+public:
+    static constexpr uint8_t type_att = 10;     // timed
+    static constexpr uint8_t type_gps = 11;     // timed
+    static constexpr uint8_t type_parm = 12;    // not timed
+
+    struct record {
+        uint8_t type;
+        uint64_t offset;
+        uint64_t time_us;
+    };
+
+    char filename[32];
+    char idxname[40];
+    std::vector<record> records;
+
+    DataFlashLog_Test() {
+        strcpy(filename, "/tmp/test_dataflashlog_XXXXXX");
+        const int fd = mkstemp(filename);
+        if (fd != -1) {
+            close(fd);
+        }
+        snprintf(idxname, sizeof(idxname), "%s.idx", filename);
+    }
+    ~DataFlashLog_Test() {
+        unlink(filename);
+        unlink(idxname);
+    }
+    CLASS_NO_COPY(DataFlashLog_Test);
+
+    static void write_format(FILE *f, uint8_t type, uint8_t length, const char *name, const char *format, const char *labels)
+    {
+        struct log_Format fmt {};
+        fmt.head1 = HEAD_BYTE1;
+        fmt.head2 = HEAD_BYTE2;
+        fmt.msgid = LOG_FORMAT_MSG;
+        fmt.type = type;
+        fmt.length = length;
+        strncpy(fmt.name, name, sizeof(fmt.name));
+        strncpy(fmt.format, format, sizeof(fmt.format));
+        strncpy(fmt.labels, labels, sizeof(fmt.labels));
+        fwrite(&fmt, sizeof(fmt), 1, f);
+    }
+
+    /*
+      a log of a few hundred kB, so there are several checkpoints, with
+      records of the timed types at different rates, an untimed type
+      and a little garbage to skip over
+     */
+    bool write_log()
+    {
+        FILE *f = fopen(filename, "wb");
+        if (f == nullptr) {
+            return false;
+        }
+        write_format(f, LOG_FORMAT_MSG, sizeof(struct log_Format), "FMT", "BBnNZ", "Type,Length,Name,Format,Columns");
+        write_format(f, type_att, 3+8+4, "ATT", "Qf", "TimeUS,Roll");
+        write_format(f, type_gps, 3+8+4+4, "GPS", "QiI", "TimeUS,Lat,Status");
+        write_format(f, type_parm, 3+4, "PARM", "f", "Value");
+        records.clear();
+        for (uint32_t i=0; i<20000; i++) {
+            const uint64_t time_us = 1000000 + i * 2500;
+            uint8_t buf[32] {HEAD_BYTE1, HEAD_BYTE2, type_att};
+            memcpy(&buf[3], &time_us, sizeof(time_us));
+            records.push_back({type_att, uint64_t(ftell(f)), time_us});
+            fwrite(buf, 3+8+4, 1, f);
+            if (i % 5 == 0) {
+                buf[2] = type_gps;
+                records.push_back({type_gps, uint64_t(ftell(f)), time_us});
+                fwrite(buf, 3+8+4+4, 1, f);
+            }
+            if (i % 97 == 0) {
+                buf[2] = type_parm;
+                records.push_back({type_parm, uint64_t(ftell(f)), 0});
+                fwrite(buf, 3+4, 1, f);
+            }
+            if (i % 1013 == 0) {
+                const uint8_t garbage[] { 0x12, HEAD_BYTE1, 0x34, HEAD_BYTE2 };
+                fwrite(garbage, sizeof(garbage), 1, f);
+            }
+        }
+        return fclose(f) == 0;
+    }
+
+    static bool from_sidecar(const DataFlashLog &log)
+    {
+        return log.sidecar_base != nullptr;
+    }
+
+    // offsets of the records of a type, in the order they were written
+    std::vector<uint64_t> offsets(uint8_t type) const
+    {
+        std::vector<uint64_t> ret;
+        for (const auto &r : records) {
+            if (r.type == type) {
+                ret.push_back(r.offset);
+            }
+        }
+        return ret;
+    }
+
+    void check_queries(const DataFlashLog &log) const
+    {
+        EXPECT_EQ(log.find_type("ATT"), type_att);
+        EXPECT_EQ(log.find_type("GPS"), type_gps);
+        EXPECT_EQ(log.find_type("PARM"), type_parm);
+        EXPECT_EQ(log.find_type("XKF1"), -1);
+        EXPECT_EQ(log.total_count(), records.size() + 4);
+
+        const uint8_t types[] { type_att, type_gps, type_parm };
+        for (const uint8_t type : types) {
+            const std::vector<uint64_t> expected = offsets(type);
+            ASSERT_EQ(log.count(type), expected.size());
+            for (uint32_t n=0; n<expected.size(); n++) {
+                ASSERT_EQ(log.record(type, n), log.data() + expected[n]);
+            }
+            EXPECT_EQ(log.record(type, expected.size()), nullptr);
+        }
+
+        for (uint64_t t=0; t<1000000 + 20000 * 2500 + 10000; t+=99991) {
+            const uint64_t end_us = t + 50000;
+            for (const uint8_t type : { type_att, type_gps }) {
+                uint32_t first = 0;
+                uint32_t in_range = 0;
+                for (const auto &r : records) {
+                    if (r.type != type) {
+                        continue;
+                    }
+                    first += (r.time_us < t);
+                    in_range += (r.time_us >= t && r.time_us < end_us);
+                }
+                EXPECT_EQ(log.lower_bound(type, t), first);
+                uint32_t seen = 0;
+                EXPECT_EQ(log.for_each_in_range(type, t, end_us, [&](uint8_t *rec) {
+                    uint64_t time_us;
+                    EXPECT_TRUE(log.record_time(rec, time_us));
+                    EXPECT_GE(time_us, t);
+                    EXPECT_LT(time_us, end_us);
+                    seen++;
+                    return true;
+                }), in_range);
+                EXPECT_EQ(seen, in_range);
+            }
+            // untimed types are never found by time
+            EXPECT_EQ(log.lower_bound(type_parm, t), log.count(type_parm));
+
+            // seek_time gives a record at or before the first timed record at t
+            uint64_t first_ofs = log.size();
+            for (const auto &r : records) {
+                if (r.type != type_parm && r.time_us >= t) {
+                    first_ofs = r.offset;
+                    break;
+                }
+            }
+            const uint64_t ofs = log.seek_time(t);
+            EXPECT_LE(ofs, first_ofs);
+            if (ofs != 0) {
+                EXPECT_NE(log.record_length_at(ofs), 0);
+            }
+        }
+    }
+};
+
+// random access queries match a linear scan of the log
+TEST(DataFlashLog, queries)
+{
+    DataFlashLog_Test t;
+    ASSERT_TRUE(t.write_log());
+
+    DataFlashLog log;
+    ASSERT_TRUE(log.open(t.filename, true));
+    EXPECT_FALSE(t.from_sidecar(log));
+    t.check_queries(log);
+
+    // without the index only the counts are available
+    ASSERT_TRUE(log.open(t.filename));
+    EXPECT_EQ(log.count(DataFlashLog_Test::type_gps), t.offsets(DataFlashLog_Test::type_gps).size());
+    EXPECT_EQ(log.record(DataFlashLog_Test::type_gps, 0), nullptr);
+}
+
+// an index saved to the sidecar and loaded again gives the same results
+TEST(DataFlashLog, sidecar)
+{
+    DataFlashLog_Test t;
+    ASSERT_TRUE(t.write_log());
+
+    DataFlashLog log;
+    ASSERT_TRUE(log.open(t.filename, true, true));
+    EXPECT_FALSE(t.from_sidecar(log));
+    ASSERT_EQ(access(t.idxname, F_OK), 0);
+    t.check_queries(log);
+
+    ASSERT_TRUE(log.open(t.filename, true, true));
+    EXPECT_TRUE(t.from_sidecar(log));
+    t.check_queries(log);
+    log.close();
+
+    // a sidecar with an offset that isn't a record of its type is
+    // rebuilt rather than used
+    FILE *f = fopen(t.idxname, "r+b");
+    ASSERT_NE(f, nullptr);
+    const uint64_t bad_offset = 1;
+    ASSERT_EQ(fseek(f, -long(sizeof(bad_offset)), SEEK_END), 0);
+    ASSERT_EQ(fwrite(&bad_offset, sizeof(bad_offset), 1, f), 1U);
+    ASSERT_EQ(fclose(f), 0);
+    ASSERT_TRUE(log.open(t.filename, true, true));
+    EXPECT_FALSE(t.from_sidecar(log));
+    t.check_queries(log);
+
+    // and the rebuilt sidecar is good again
+    ASSERT_TRUE(log.open(t.filename, true, true));
+    EXPECT_TRUE(t.from_sidecar(log));
+    t.check_queries(log);
+}
+
+#endif // AP_REPLAY_MMAP_ENABLED
+
+AP_GTEST_MAIN()
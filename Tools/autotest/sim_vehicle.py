@@ -983,6 +983,8 @@ def start_vehicle(binary, opts, stuff, spawns=None):
         cmd.extend(["--sysid", str(opts.sysid)])
     if opts.slave is not None:
         cmd.extend(["--slave", str(opts.slave)])
+    if opts.lockstep:
+        cmd.extend(["--lockstep", str(opts.count)])
     if opts.enable_fgview:
         cmd.extend(["--enable-fgview"])
     if opts.sitl_instance_args:
@@ -1585,6 +1587,10 @@ group_sim.add_option("", "--slave",
                      type='int',
                      default=0,
                      help="Set the number of JSON slave")
+group_sim.add_option("", "--lockstep",
+                     action='store_true',
+                     default=False,
+                     help="run all vehicles of --count on one simulated clock")
 group_sim.add_option("", "--auto-sysid",
                      default=False,
                      action='store_true',
@@ -1731,6 +1737,10 @@ if cmd_opts.count < 1:
     print("May not specify a count less than 1")
     sys.exit(1)
 
+if cmd_opts.lockstep and cmd_opts.instance != 0:
+    print("--lockstep requires instances to start at 0")
+    sys.exit(1)
+
 if cmd_opts.strace and cmd_opts.valgrind:
     print("valgrind and strace almost certainly not a good idea")
 
@@ -18,10 +18,11 @@ data = open(args.file,'rb').read()
 last_name = ""
 
 magic = 0x671b
+magic_with_default = 0x671c
 
 # header of 6 bytes
 magic2,num_params,total_params = struct.unpack("<HHH", data[0:6])
-if magic != magic2:
+if magic2 not in [magic, magic_with_default]:
     print("Bad magic 0x%x expected 0x%x" % (magic2, magic))
     sys.exit(1)
 
@@ -65,12 +66,21 @@ while True:
     name_len = ((plen>>4) & 0x0F) + 1
     common_len = (plen & 0x0F)
     name = last_name[0:common_len] + data[2:2+name_len].decode('utf-8')
-    vdata = data[2+name_len:2+name_len+type_len]
     last_name = name
-    data = data[2+name_len+type_len:]
-    v, = struct.unpack("<" + type_format, vdata)
+    data = data[2+name_len:]
+    if flags & 2:
+        # zero value, data omitted
+        v = 0
+    else:
+        v, = struct.unpack("<" + type_format, data[0:type_len])
+        data = data[type_len:]
     count += 1
-    print("%-16s %f" % (name, float(v)))
+    if flags & 1:
+        d, = struct.unpack("<" + type_format, data[0:type_len])
+        data = data[type_len:]
+        print("%-16s %f (default %f)" % (name, float(v), float(d)))
+    else:
+        print("%-16s %f" % (name, float(v)))
 
 if count != num_params or count > total_params:
     print("Error: Got %u params expected %u/%u" % (count, num_params, total_params))
@@ -40,6 +40,16 @@ extern const AP_HAL::HAL& hal;
     #define AP_OADATABASE_DISTANCE_FROM_HOME 3
 #endif
 
+#ifndef AP_OADATABASE_GRID_CELL_SIZE
+    #define AP_OADATABASE_GRID_CELL_SIZE 2.0f       // width of grid cells in meters
+#endif
+
+#define OA_DB_GRID_NONE         UINT16_MAX          // marks the end of a bucket's list of items
+#define OA_DB_GRID_BUCKETS_MAX  4096                // upper limit on number of grid buckets
+#define OA_DB_GRID_CELL_LIMIT   1.0e6f              // cell coordinates are limited to +-this many cells
+#define OA_DB_GRID_CELL_COST    2                   // finding the closest item, searching a cell costs about as much as checking this many items
+#define OA_DB_GRID_RADIUS_MAX   (4 * AP_OADATABASE_GRID_CELL_SIZE)  // items with a larger radius are kept out of the buckets
+
 const AP_Param::GroupInfo AP_OADatabase::var_info[] = {
 
     // @Param: SIZE
@@ -126,6 +136,7 @@ void AP_OADatabase::init()
     _database_expiry_seconds.convert_parameter_width(AP_PARAM_INT8);
 
     init_database();
+    init_grid();
     init_queue();
 
     // initialise scalar using beam width of at least 1deg
@@ -135,6 +146,8 @@ void AP_OADatabase::init()
         GCS_SEND_TEXT(MAV_SEVERITY_INFO, "DB init failed . Sizes queue:%u, db:%u", (unsigned int)_queue.size, (unsigned int)_database.size);
         delete _queue.items;
         delete[] _database.items;
+        delete[] _grid.head;
+        delete[] _grid.next;
         return;
     }
 }
@@ -224,6 +237,81 @@ void AP_OADatabase::init_database()
     _database.items = NEW_NOTHROW OA_DbItem[_database.size];
 }
 
+// create an empty grid index with around one bucket per database item
+void AP_OADatabase::init_grid()
+{
+    if (_database.size == 0) {
+        return;
+    }
+
+    _grid.num_buckets = 16;
+    while ((_grid.num_buckets < _database.size) && (_grid.num_buckets < OA_DB_GRID_BUCKETS_MAX)) {
+        _grid.num_buckets *= 2;
+    }
+
+    _grid.head = NEW_NOTHROW uint16_t[_grid.num_buckets];
+    _grid.next = NEW_NOTHROW uint16_t[_database.size];
+    if ((_grid.head == nullptr) || (_grid.next == nullptr)) {
+        delete[] _grid.head;
+        delete[] _grid.next;
+        _grid.head = nullptr;
+        _grid.next = nullptr;
+        return;
+    }
+    for (uint16_t i=0; i<_grid.num_buckets; i++) {
+        _grid.head[i] = OA_DB_GRID_NONE;
+    }
+    _grid.large_head = OA_DB_GRID_NONE;
+}
+
+// convert a position in meters along one axis to the coordinate of the grid cell containing it
+int32_t AP_OADatabase::grid_cell(float pos) const
+{
+    return (int32_t)floorf(constrain_float(pos * (1.0f / AP_OADATABASE_GRID_CELL_SIZE), -OA_DB_GRID_CELL_LIMIT, OA_DB_GRID_CELL_LIMIT));
+}
+
+// get the bucket holding a grid cell's items
+uint16_t AP_OADatabase::grid_bucket(int32_t cell_x, int32_t cell_y) const
+{
+    const uint32_t hash = ((uint32_t)cell_x * 73856093U) ^ ((uint32_t)cell_y * 19349663U);
+    return hash & (_grid.num_buckets - 1);
+}
+
+// get the head of the list an item belongs in.  Large items would need to be found from
+// many cells so they are kept in their own list which every search checks
+uint16_t &AP_OADatabase::grid_list_head(const OA_DbItem &item)
+{
+    if (item.radius > OA_DB_GRID_RADIUS_MAX) {
+        return _grid.large_head;
+    }
+    return _grid.head[grid_bucket(grid_cell(item.pos.x), grid_cell(item.pos.y))];
+}
+
+// add a database item to the grid
+void AP_OADatabase::grid_insert(const uint16_t index)
+{
+    const OA_DbItem &item = _database.items[index];
+    uint16_t &head = grid_list_head(item);
+    _grid.next[index] = head;
+    head = index;
+    if (item.radius <= OA_DB_GRID_RADIUS_MAX) {
+        _grid.radius_max = MAX(_grid.radius_max, item.radius);
+    }
+}
+
+// remove a database item from the grid.  Must be called before the item's position or radius changes
+void AP_OADatabase::grid_remove(const uint16_t index)
+{
+    uint16_t *link = &grid_list_head(_database.items[index]);
+    while (*link != OA_DB_GRID_NONE) {
+        if (*link == index) {
+            *link = _grid.next[index];
+            return;
+        }
+        link = &_grid.next[*link];
+    }
+}
+
 // get bitmask of gcs channels item should be sent to based on its importance
 // returns 0xFF (send to all channels) if should be sent, 0 if it should not be sent
 uint8_t AP_OADatabase::get_send_to_gcs_flags(const OA_DbItemImportance importance) const
@@ -272,6 +360,62 @@ bool AP_OADatabase::item_match(const OA_DbItem& A, const OA_DbItem& B) const
     return false;
 }
 
+// find the lowest indexed item in the database matching item.  returns true on success and updates index
+bool AP_OADatabase::database_item_find(const OA_DbItem &item, uint16_t &index)
+{
+    _query_stats.match_queries++;
+
+    // proximity items may match any item within the larger of their radii so only the cells within
+    // the largest radius need to be searched.  AIS items match on id and are compared with every item
+    bool use_grid = (item.source == OA_DbItem::Source::proximity);
+    int32_t x_min = 0, x_max = 0, y_min = 0, y_max = 0;
+    if (use_grid) {
+        const float radius = MAX(item.radius, _grid.radius_max);
+        x_min = grid_cell(item.pos.x - radius);
+        x_max = grid_cell(item.pos.x + radius);
+        y_min = grid_cell(item.pos.y - radius);
+        y_max = grid_cell(item.pos.y + radius);
+        const uint64_t num_cells = uint64_t(x_max - x_min + 1) * uint64_t(y_max - y_min + 1);
+        use_grid = (num_cells < _database.count);
+    }
+
+    if (!use_grid) {
+        _query_stats.linear_scans++;
+        for (uint16_t i=0; i<_database.count; i++) {
+            _query_stats.items_tested++;
+            if (item_match(_database.items[i], item)) {
+                index = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // several cells may share a bucket and lists are not in index order so check
+    // every candidate, keeping the lowest index to match the linear search
+    bool found = false;
+    for (uint16_t i = _grid.large_head; i != OA_DB_GRID_NONE; i = _grid.next[i]) {
+        _query_stats.items_tested++;
+        if ((!found || (i < index)) && item_match(_database.items[i], item)) {
+            index = i;
+            found = true;
+        }
+    }
+    for (int32_t x = x_min; x <= x_max; x++) {
+        for (int32_t y = y_min; y <= y_max; y++) {
+            _query_stats.cells_visited++;
+            for (uint16_t i = _grid.head[grid_bucket(x, y)]; i != OA_DB_GRID_NONE; i = _grid.next[i]) {
+                _query_stats.items_tested++;
+                if ((!found || (i < index)) && item_match(_database.items[i], item)) {
+                    index = i;
+                    found = true;
+                }
+            }
+        }
+    }
+    return found;
+}
+
 // returns true when there's more work in the queue to do
 bool AP_OADatabase::process_queue()
 {
@@ -303,17 +447,14 @@ bool AP_OADatabase::process_queue()
 
         item.send_to_gcs = get_send_to_gcs_flags(item.importance);
 
-        // compare item to all items in database. If found a similar item, update the existing, else add it as a new one
-        bool found = false;
-        for (uint16_t i=0; i<_database.count; i++) {
-            if (item_match(_database.items[i], item)) {
-                database_item_refresh(_database.items[i], item);
-                found = true;
-                break;
-            }
-        }
-
-        if (!found) {
+        // look for a similar item in the database. If found update the existing, else add it as a new one
+        uint16_t index;
+        if (database_item_find(item, index)) {
+            // refreshing may move the item so take it out of the grid while it is updated
+            grid_remove(index);
+            database_item_refresh(_database.items[index], item);
+            grid_insert(index);
+        } else {
             database_item_add(item);
         }
     }
@@ -327,6 +468,7 @@ void AP_OADatabase::database_item_add(const OA_DbItem &item)
     }
     _database.items[_database.count] = item;
     _database.items[_database.count].send_to_gcs = get_send_to_gcs_flags(_database.items[_database.count].importance);
+    grid_insert(_database.count);
     _database.count++;
 }
 
@@ -337,6 +479,8 @@ void AP_OADatabase::database_item_remove(const uint16_t index)
         return;
     }
 
+    grid_remove(index);
+
     // radius of 0 tells the GCS we don't care about it any more (aka it expired)
     _database.items[index].radius = 0;
     _database.items[index].send_to_gcs = get_send_to_gcs_flags(_database.items[index].importance);
@@ -348,8 +492,10 @@ void AP_OADatabase::database_item_remove(const uint16_t index)
 
     if (index != _database.count) {
         // copy last object in array over expired object
+        grid_remove(_database.count);
         _database.items[index] = _database.items[_database.count];
         _database.items[index].send_to_gcs = get_send_to_gcs_flags(_database.items[index].importance);
+        grid_insert(index);
     }
 }
 
@@ -386,13 +532,123 @@ void AP_OADatabase::database_items_remove_all_expired()
     const uint32_t now_ms = AP_HAL::millis();
     const uint32_t expiry_ms = (uint32_t)_database_expiry_seconds * 1000;
     uint16_t index = 0;
+    float radius_max = 0;
     while (index < _database.count) {
         if (now_ms - _database.items[index].timestamp_ms > expiry_ms) {
             database_item_remove(index);
         } else {
+            if (_database.items[index].radius <= OA_DB_GRID_RADIUS_MAX) {
+                radius_max = MAX(radius_max, _database.items[index].radius);
+            }
             index++;
         }
     }
+
+    // tighten the bound on the radius of items in the grid now the largest may have gone
+    _grid.radius_max = radius_max;
+}
+
+// get the range of rows of cells in one column of cells which may hold positions within dist of a segment
+void AP_OADatabase::grid_segment_rows(const Vector3f &seg_start, const Vector3f &seg_end, float dist, int32_t cell_x, int32_t &y_min, int32_t &y_max) const
+{
+    // a position within dist of the segment is within dist in y of a point on the segment
+    // within dist in x of it, so find the part of the segment within dist of this column
+    float y_start = seg_start.y;
+    float y_end = seg_end.y;
+    const float dx = seg_end.x - seg_start.x;
+    if (!is_zero(dx)) {
+        const float col_min = cell_x * AP_OADATABASE_GRID_CELL_SIZE - dist;
+        const float col_max = (cell_x + 1) * AP_OADATABASE_GRID_CELL_SIZE + dist;
+        const float dy = seg_end.y - seg_start.y;
+        y_start = seg_start.y + dy * constrain_float((col_min - seg_start.x) / dx, 0, 1);
+        y_end = seg_start.y + dy * constrain_float((col_max - seg_start.x) / dx, 0, 1);
+    }
+    y_min = grid_cell(MIN(y_start, y_end) - dist);
+    y_max = grid_cell(MAX(y_start, y_end) + dist);
+}
+
+// calculate the smallest distance between a line segment and the edge of any object in the database
+// segment is an offset in meters from the EKF origin, in the same frame as the object positions
+// on success returns true and updates margin, returns false if the database is empty
+bool AP_OADatabase::calc_margin_from_segment(const Vector3f &seg_start, const Vector3f &seg_end, float &margin)
+{
+    if (!healthy() || (_database.count == 0)) {
+        return false;
+    }
+
+    _query_stats.margin_queries++;
+
+    // search the cells near the segment, widening the search until the closest object found
+    // is closer than any object in the cells not searched could be
+    float smallest_margin = FLT_MAX;
+    for (uint16_t i = _grid.large_head; i != OA_DB_GRID_NONE; i = _grid.next[i]) {
+        _query_stats.items_tested++;
+        const OA_DbItem &item = _database.items[i];
+        smallest_margin = MIN(smallest_margin, Vector3f::closest_distance_between_line_and_point(seg_start, seg_end, item.pos) - item.radius);
+    }
+    float search_dist = _grid.radius_max + AP_OADATABASE_GRID_CELL_SIZE;
+    float searched_dist = -1;
+    while (true) {
+        // count the cells within search_dist of the segment, a column at a time
+        const int32_t x_min = grid_cell(MIN(seg_start.x, seg_end.x) - search_dist);
+        const int32_t x_max = grid_cell(MAX(seg_start.x, seg_end.x) + search_dist);
+        uint64_t num_cells = x_max - x_min + 1;
+        if (num_cells * OA_DB_GRID_CELL_COST < _database.count) {
+            num_cells = 0;
+            for (int32_t x = x_min; x <= x_max; x++) {
+                int32_t y_min, y_max;
+                grid_segment_rows(seg_start, seg_end, search_dist, x, y_min, y_max);
+                num_cells += y_max - y_min + 1;
+            }
+        }
+        if ((num_cells * OA_DB_GRID_CELL_COST >= _database.count) || isinf(search_dist)) {
+            // cheaper to check every object
+            _query_stats.linear_scans++;
+            smallest_margin = FLT_MAX;
+            for (uint16_t i=0; i<_database.count; i++) {
+                _query_stats.items_tested++;
+                const OA_DbItem &item = _database.items[i];
+                smallest_margin = MIN(smallest_margin, Vector3f::closest_distance_between_line_and_point(seg_start, seg_end, item.pos) - item.radius);
+            }
+            break;
+        }
+
+        for (int32_t x = x_min; x <= x_max; x++) {
+            int32_t y_min, y_max;
+            grid_segment_rows(seg_start, seg_end, search_dist, x, y_min, y_max);
+            // skip cells searched by the previous narrower search
+            int32_t skip_y_min = 0, skip_y_max = -1;
+            if (searched_dist >= 0) {
+                grid_segment_rows(seg_start, seg_end, searched_dist, x, skip_y_min, skip_y_max);
+                if ((x < grid_cell(MIN(seg_start.x, seg_end.x) - searched_dist)) ||
+                    (x > grid_cell(MAX(seg_start.x, seg_end.x) + searched_dist))) {
+                    skip_y_max = skip_y_min - 1;
+                }
+            }
+            for (int32_t y = y_min; y <= y_max; y++) {
+                if ((y >= skip_y_min) && (y <= skip_y_max)) {
+                    y = skip_y_max;
+                    continue;
+                }
+                _query_stats.cells_visited++;
+                for (uint16_t i = _grid.head[grid_bucket(x, y)]; i != OA_DB_GRID_NONE; i = _grid.next[i]) {
+                    _query_stats.items_tested++;
+                    const OA_DbItem &item = _database.items[i];
+                    smallest_margin = MIN(smallest_margin, Vector3f::closest_distance_between_line_and_point(seg_start, seg_end, item.pos) - item.radius);
+                }
+            }
+        }
+
+        // objects in unsearched cells are more than search_dist from the segment
+        if (smallest_margin <= search_dist - _grid.radius_max) {
+            break;
+        }
+        searched_dist = search_dist;
+        search_dist *= 2;
+    }
+
+    margin = smallest_margin;
+    return true;
 }
 
 #if HAL_GCS_ENABLED
@@ -16,6 +16,9 @@ public:
 
     CLASS_NO_COPY(AP_OADatabase); /* Do not allow copies */
 
+    friend class AP_OADatabase_benchmark;
+    friend class AP_OADatabase_Test;
+
     // get singleton instance
     static AP_OADatabase *get_singleton() {
         return _singleton;
@@ -53,7 +56,7 @@ public:
     void queue_push(const Vector3f &pos, const uint32_t timestamp_ms, const float distance, const OA_DbItem::Source source, const uint32_t id = 0);
 
     // returns true if database is healthy
-    bool healthy() const { return (_queue.items != nullptr) && (_database.items != nullptr); }
+    bool healthy() const { return (_queue.items != nullptr) && (_database.items != nullptr) && (_grid.head != nullptr); }
 
     // fetch an item in database. Undefined result when i >= _database.count.
     const OA_DbItem& get_item(uint32_t i) const { return _database.items[i]; }
@@ -67,6 +70,23 @@ public:
     // send ADSB_VEHICLE mavlink messages
     void send_adsb_vehicle(mavlink_channel_t chan, uint16_t interval_ms);
 
+    // calculate the smallest distance between a line segment and the edge of any object in the database
+    // segment is an offset in meters from the EKF origin, in the same frame as the object positions
+    // on success returns true and updates margin, returns false if the database is empty
+    bool calc_margin_from_segment(const Vector3f &seg_start, const Vector3f &seg_end, float &margin);
+
+    // counters of the work done by database searches
+    struct QueryStatistics {
+        uint32_t match_queries;     // searches for an object matching a new one
+        uint32_t margin_queries;    // searches for the object closest to a line segment
+        uint32_t cells_visited;     // grid cells looked in
+        uint32_t items_tested;      // objects compared
+        uint32_t linear_scans;      // searches which compared every object instead of using the grid
+    };
+
+    // get counters of the work done by database searches
+    void get_query_statistics(QueryStatistics &stats) const { stats = _query_stats; }
+
     static const struct AP_Param::GroupInfo var_info[];
 
 private:
@@ -88,6 +108,18 @@ private:
     // Return true if item A is likely the same as item B
     bool item_match(const OA_DbItem& A, const OA_DbItem& B) const;
 
+    // find the lowest indexed item in the database matching item.  returns true on success and updates index
+    bool database_item_find(const OA_DbItem &item, uint16_t &index);
+
+    // grid index management
+    void init_grid();
+    int32_t grid_cell(float pos) const;
+    uint16_t grid_bucket(int32_t cell_x, int32_t cell_y) const;
+    uint16_t &grid_list_head(const OA_DbItem &item);
+    void grid_segment_rows(const Vector3f &seg_start, const Vector3f &seg_end, float dist, int32_t cell_x, int32_t &y_min, int32_t &y_max) const;
+    void grid_insert(const uint16_t index);
+    void grid_remove(const uint16_t index);
+
     // enum for use with _OUTPUT parameter
     enum class OutputLevel {
         NONE = 0,
@@ -119,6 +151,19 @@ private:
         uint16_t        size;                               // cached value of _database_size_param that sticks after initialized
     } _database;
 
+    // uniform grid of cells in the horizontal plane, hashed into buckets.  Each bucket holds
+    // a list of the items whose position is in any of the cells which hash to that bucket.
+    // Items too large for the grid to help are held in a separate list
+    struct {
+        uint16_t        *head;                              // index of first item in each bucket, or OA_DB_GRID_NONE
+        uint16_t        *next;                              // index of next item in the same list as each item, or OA_DB_GRID_NONE
+        uint16_t        num_buckets;                        // number of buckets, always a power of two
+        uint16_t        large_head;                         // index of first item too large to be held in a bucket, or OA_DB_GRID_NONE
+        float           radius_max;                         // upper bound on the radius of any item held in a bucket
+    } _grid;
+
+    QueryStatistics _query_stats;
+
     uint16_t _next_index_to_send[MAVLINK_COMM_NUM_BUFFERS]; // index of next object in _database to send to GCS
     uint16_t _highest_index_sent[MAVLINK_COMM_NUM_BUFFERS]; // highest index in _database sent to GCS
     uint32_t _last_send_to_gcs_ms[MAVLINK_COMM_NUM_BUFFERS];// system time that send_adsb_vehicle was last called
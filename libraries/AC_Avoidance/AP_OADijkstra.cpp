@@ -37,7 +37,12 @@ AP_OADijkstra::AP_OADijkstra(AP_Int16 &options) :
         _inclusion_polygon_pts(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
         _exclusion_polygon_pts(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
         _exclusion_circle_pts(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
+        _fence_visgraph_pts(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
+        _fence_visgraph_shapes(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
+        _fence_adj_start(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
+        _fence_adj(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
         _short_path_data(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
+        _heap(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
         _path(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
         _options(options)
 {
@@ -128,7 +133,7 @@ AP_OADijkstra::AP_OADijkstra_State AP_OADijkstra::update(const Location &current
 
     // create visgraph for all fence (with margin) points
     if (!_polyfence_visgraph_ok) {
-        _polyfence_visgraph_ok = create_fence_visgraph(_error_id);
+        _polyfence_visgraph_ok = build_fence_index(_error_id) && create_fence_visgraph(_error_id);
         if (!_polyfence_visgraph_ok) {
             _shortest_path_ok = false;
             dest_to_next_dest_clear = _dest_to_next_dest_clear = false;
@@ -609,76 +614,82 @@ bool AP_OADijkstra::get_point(uint16_t index, Vector2f &point) const
     return false;
 }
 
-// returns true if line segment intersects polygon or circular fence
-bool AP_OADijkstra::intersects_fence(const Vector2f &seg_start, const Vector2f &seg_end) const
+// rebuild bounding box index of inclusion polygons, exclusion polygons and exclusion circles
+// returns true on success.  returns false on failure and err_id is updated
+bool AP_OADijkstra::build_fence_index(AP_OADijkstra_Error &err_id)
 {
-    // return immediately if fence is not enabled
+    _fence_index.clear();
+
+    // exit immediately if fence is not enabled
     const AC_Fence *fence = AC_Fence::get_singleton();
     if (fence == nullptr) {
+        err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_FENCE_DISABLED;
         return false;
     }
 
-    // determine if segment crosses any of the inclusion polygons
+    // add inclusion polygons
     uint16_t num_points = 0;
     for (uint8_t i = 0; i < fence->polyfence().get_inclusion_polygon_count(); i++) {
         const Vector2f* boundary = fence->polyfence().get_inclusion_polygon(i, num_points);
-        if (boundary != nullptr) {
-            Vector2f intersection;
-            if (Polygon_intersects(boundary, num_points, seg_start, seg_end, intersection)) {
-                return true;
-            }
+        if (!_fence_index.add_polygon(boundary, num_points)) {
+            err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
+            return false;
         }
     }
 
-    // determine if segment crosses any of the exclusion polygons
+    // add exclusion polygons
     for (uint8_t i = 0; i < fence->polyfence().get_exclusion_polygon_count(); i++) {
         const Vector2f* boundary = fence->polyfence().get_exclusion_polygon(i, num_points);
-        if (boundary != nullptr) {
-            Vector2f intersection;
-            if (Polygon_intersects(boundary, num_points, seg_start, seg_end, intersection)) {
-                return true;
-            }
+        if (!_fence_index.add_polygon(boundary, num_points)) {
+            err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
+            return false;
         }
     }
 
-    // determine if segment crosses any of the inclusion circles
-    for (uint8_t i = 0; i < fence->polyfence().get_inclusion_circle_count(); i++) {
+    // add exclusion circles
+    for (uint8_t i = 0; i < fence->polyfence().get_exclusion_circle_count(); i++) {
         Vector2f center_pos_cm;
         float radius;
-        if (fence->polyfence().get_inclusion_circle(i, center_pos_cm, radius)) {
-            // intersects circle if either start or end is further from the center than the radius
-            const float radius_cm_sq = sq(radius * 100.0f) ;
-            if ((seg_start - center_pos_cm).length_squared() > radius_cm_sq) {
-                return true;
-            }
-            if ((seg_end - center_pos_cm).length_squared() > radius_cm_sq) {
-                return true;
+        if (fence->polyfence().get_exclusion_circle(i, center_pos_cm, radius)) {
+            if (!_fence_index.add_circle(center_pos_cm, radius * 100.0f)) {
+                err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
+                return false;
             }
         }
     }
 
-    // determine if segment crosses any of the exclusion circles
-    for (uint8_t i = 0; i < fence->polyfence().get_exclusion_circle_count(); i++) {
+    // add inclusion circles
+    for (uint8_t i = 0; i < fence->polyfence().get_inclusion_circle_count(); i++) {
         Vector2f center_pos_cm;
         float radius;
-        if (fence->polyfence().get_exclusion_circle(i, center_pos_cm, radius)) {
-            // calculate distance between circle's center and segment
-            const float dist_cm = Vector2f::closest_distance_between_line_and_point(seg_start, seg_end, center_pos_cm);
-
-            // intersects if distance is less than radius
-            if (dist_cm <= (radius * 100.0f)) {
-                return true;
+        if (fence->polyfence().get_inclusion_circle(i, center_pos_cm, radius)) {
+            if (!_fence_index.add_inclusion_circle(center_pos_cm, radius * 100.0f)) {
+                err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
+                return false;
             }
         }
     }
 
-    // if we got this far then no intersection
-    return false;
+    return true;
+}
+
+// returns true if line segment intersects polygon or circular fence
+bool AP_OADijkstra::intersects_fence(const Vector2f &seg_start, const Vector2f &seg_end) const
+{
+    // return immediately if fence is not enabled
+    const AC_Fence *fence = AC_Fence::get_singleton();
+    if (fence == nullptr) {
+        return false;
+    }
+
+    // determine if segment crosses any of the inclusion or exclusion polygons or circles
+    return _fence_index.intersects(seg_start, seg_end);
 }
 
 // create visibility graph for all fence (with margin) points
+// only edges touching new points or passing near fences which have changed since the last successful call are re-tested
 // returns true on success.  returns false on failure and err_id is updated
-// requires these functions to have been run create_inclusion_polygon_with_margin, create_exclusion_polygon_with_margin, create_exclusion_circle_with_margin
+// requires these functions to have been run create_inclusion_polygon_with_margin, create_exclusion_polygon_with_margin, create_exclusion_circle_with_margin, build_fence_index
 bool AP_OADijkstra::create_fence_visgraph(AP_OADijkstra_Error &err_id)
 {
     // exit immediately if fence is not enabled
@@ -689,21 +700,94 @@ bool AP_OADijkstra::create_fence_visgraph(AP_OADijkstra_Error &err_id)
     }
 
     // fail if more fence points than algorithm can handle
-    if (total_numpoints() >= OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX) {
+    // source and destination nodes must also fit in a node_index
+    if (total_numpoints() + 2 >= OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX) {
         err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_TOO_MANY_FENCE_POINTS;
         return false;
     }
 
-    // clear fence points visibility graph
-    _fence_visgraph.clear();
+    // an edge's visibility can only have changed if one of its points is new or
+    // it passes near a fence which has been added, removed or changed
+    bool incremental = _fence_visgraph_valid;
+    _fence_visgraph_valid = false;
+    AP_OAFenceIndex::BBox changed_region {};
+    uint32_t point_is_new[(OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX + 31) / 32] {};
+    if (incremental) {
+        // add area covered by removed or changed fences
+        for (uint16_t i = 0; i < _fence_visgraph_numshapes; i++) {
+            bool found = false;
+            for (uint16_t j = 0; (j < _fence_index.num_shapes()) && !found; j++) {
+                found = (_fence_visgraph_shapes[i] == _fence_index.get_shape(j));
+            }
+            if (!found) {
+                changed_region.expand(_fence_visgraph_shapes[i].box);
+                // a changed inclusion circle can affect any edge so rebuild the whole graph
+                incremental &= _fence_visgraph_shapes[i].bounded;
+            }
+        }
+        // add area covered by new or changed fences
+        for (uint16_t j = 0; j < _fence_index.num_shapes(); j++) {
+            const AP_OAFenceIndex::Shape shape = _fence_index.get_shape(j);
+            bool found = false;
+            for (uint16_t i = 0; (i < _fence_visgraph_numshapes) && !found; i++) {
+                found = (_fence_visgraph_shapes[i] == shape);
+            }
+            if (!found) {
+                changed_region.expand(shape.box);
+                incremental &= shape.bounded;
+            }
+        }
+    }
+    if (incremental) {
+        // find where each previous point has moved to in the list of points
+        uint8_t point_map[OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX];
+        for (uint8_t j = 0; j < total_numpoints(); j++) {
+            point_is_new[j / 32] |= (1U << (j % 32));
+        }
+        for (uint8_t i = 0; i < _fence_visgraph_numpoints; i++) {
+            point_map[i] = OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX;
+            for (uint8_t j = 0; j < total_numpoints(); j++) {
+                Vector2f point;
+                if ((point_is_new[j / 32] & (1U << (j % 32))) && get_point(j, point) && (point == _fence_visgraph_pts[i])) {
+                    point_map[i] = j;
+                    point_is_new[j / 32] &= ~(1U << (j % 32));
+                    break;
+                }
+            }
+        }
+
+        // keep edges which cannot have changed, renumbering their points
+        uint16_t num_kept = 0;
+        for (uint16_t i = 0; i < _fence_visgraph.num_items(); i++) {
+            AP_OAVisGraph::VisGraphItem item = _fence_visgraph[i];
+            if ((point_map[item.id1.id_num] == OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX) ||
+                (point_map[item.id2.id_num] == OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX) ||
+                changed_region.intersects_segment(_fence_visgraph_pts[item.id1.id_num], _fence_visgraph_pts[item.id2.id_num])) {
+                continue;
+            }
+            item.id1.id_num = point_map[item.id1.id_num];
+            item.id2.id_num = point_map[item.id2.id_num];
+            _fence_visgraph[num_kept++] = item;
+        }
+        _fence_visgraph.truncate(num_kept);
+    } else {
+        // clear fence points visibility graph
+        _fence_visgraph.clear();
+    }
 
     // calculate distance from each point to all other points
     for (uint8_t i = 0; i < total_numpoints() - 1; i++) {
         Vector2f start_seg;
         if (get_point(i, start_seg)) {
+            const bool start_is_new = (point_is_new[i / 32] & (1U << (i % 32))) != 0;
             for (uint8_t j = i + 1; j < total_numpoints(); j++) {
                 Vector2f end_seg;
                 if (get_point(j, end_seg)) {
+                    // skip edges kept from the previous graph
+                    if (incremental && !start_is_new && ((point_is_new[j / 32] & (1U << (j % 32))) == 0) &&
+                        !changed_region.intersects_segment(start_seg, end_seg)) {
+                        continue;
+                    }
                     // if line segment does not intersect with any inclusion or exclusion zones add to visgraph
                     if (!intersects_fence(start_seg, end_seg)) {
                         if (!_fence_visgraph.add_item({AP_OAVisGraph::OATYPE_INTERMEDIATE_POINT, i},
@@ -719,6 +803,72 @@ bool AP_OADijkstra::create_fence_visgraph(AP_OADijkstra_Error &err_id)
         }
     }
 
+    if (!create_fence_visgraph_adjacency() || !save_fence_visgraph_state()) {
+        err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
+        return false;
+    }
+    _fence_visgraph_valid = true;
+
+    return true;
+}
+
+// record fence points and shapes used to create the fence visibility graph
+// returns false if out of memory
+bool AP_OADijkstra::save_fence_visgraph_state()
+{
+    if (!_fence_visgraph_pts.expand_to_hold(total_numpoints()) ||
+        !_fence_visgraph_shapes.expand_to_hold(_fence_index.num_shapes())) {
+        return false;
+    }
+    for (uint8_t i = 0; i < total_numpoints(); i++) {
+        get_point(i, _fence_visgraph_pts[i]);
+    }
+    _fence_visgraph_numpoints = total_numpoints();
+    for (uint16_t i = 0; i < _fence_index.num_shapes(); i++) {
+        _fence_visgraph_shapes[i] = _fence_index.get_shape(i);
+    }
+    _fence_visgraph_numshapes = _fence_index.num_shapes();
+    return true;
+}
+
+// build per point lists of fence visibility graph items
+// returns false if out of memory
+bool AP_OADijkstra::create_fence_visgraph_adjacency()
+{
+    const uint16_t numpoints = total_numpoints();
+    const uint16_t num_items = _fence_visgraph.num_items();
+
+    // each item appears in the lists of both its points
+    if ((uint32_t(num_items) * 2 > UINT16_MAX) ||
+        !_fence_adj_start.expand_to_hold(numpoints + 1) ||
+        !_fence_adj.expand_to_hold(num_items * 2)) {
+        return false;
+    }
+
+    // count items touching each point
+    for (uint16_t i = 0; i <= numpoints; i++) {
+        _fence_adj_start[i] = 0;
+    }
+    for (uint16_t i = 0; i < num_items; i++) {
+        _fence_adj_start[_fence_visgraph[i].id1.id_num + 1]++;
+        _fence_adj_start[_fence_visgraph[i].id2.id_num + 1]++;
+    }
+    for (uint16_t i = 0; i < numpoints; i++) {
+        _fence_adj_start[i + 1] += _fence_adj_start[i];
+    }
+
+    // fill in lists, using each point's start as its write position
+    for (uint16_t i = 0; i < num_items; i++) {
+        _fence_adj[_fence_adj_start[_fence_visgraph[i].id1.id_num]++] = i;
+        _fence_adj[_fence_adj_start[_fence_visgraph[i].id2.id_num]++] = i;
+    }
+
+    // each start now holds the start of the following point's list so shift back
+    for (uint16_t i = numpoints; i > 0; i--) {
+        _fence_adj_start[i] = _fence_adj_start[i - 1];
+    }
+    _fence_adj_start[0] = 0;
+
     return true;
 }
 
@@ -768,36 +918,40 @@ void AP_OADijkstra::update_visible_node_distances(node_index curr_node_idx)
     // get current node for convenience
     const ShortPathNode &curr_node = _short_path_data[curr_node_idx];
 
-    // for each visibility graph
-    const AP_OAVisGraph* visgraphs[] = {&_fence_visgraph, &_destination_visgraph};
-    for (uint8_t v=0; v<ARRAY_SIZE(visgraphs); v++) {
-
-        // skip if empty
-        const AP_OAVisGraph &curr_visgraph = *visgraphs[v];
-        if (curr_visgraph.num_items() == 0) {
-            continue;
-        }
-
-        // search visibility graph for items visible from current_node
-        for (uint16_t i = 0; i < curr_visgraph.num_items(); i++) {
-            const AP_OAVisGraph::VisGraphItem &item = curr_visgraph[i];
-            // match if current node's id matches either of the id's in the graph (i.e. either end of the vector)
-            if ((curr_node.id == item.id1) || (curr_node.id == item.id2)) {
-                AP_OAVisGraph::OAItemID matching_id = (curr_node.id == item.id1) ? item.id2 : item.id1;
-                // find item's id in node array
-                node_index item_node_idx;
-                if (find_node_from_id(matching_id, item_node_idx)) {
-                    // if current node's distance + distance to item is less than item's current distance, update item's distance
-                    const float dist_to_item_via_current_node = _short_path_data[curr_node_idx].distance_cm + item.distance_cm;
-                    if (dist_to_item_via_current_node < _short_path_data[item_node_idx].distance_cm) {
-                        // update item's distance and set "distance_from_idx" to current node's index
-                        _short_path_data[item_node_idx].distance_cm = dist_to_item_via_current_node;
-                        _short_path_data[item_node_idx].distance_from_idx = curr_node_idx;
-                    }
-                }
-            }
+    // only fence points have neighbours other than the destination
+    if (curr_node.id.id_type != AP_OAVisGraph::OATYPE_INTERMEDIATE_POINT) {
+        return;
+    }
+
+    // update fence points visible from current node
+    const uint8_t point = curr_node.id.id_num;
+    for (uint16_t i = _fence_adj_start[point]; i < _fence_adj_start[point + 1]; i++) {
+        const AP_OAVisGraph::VisGraphItem &item = _fence_visgraph[_fence_adj[i]];
+        const AP_OAVisGraph::OAItemID &matching_id = (item.id1.id_num == point) ? item.id2 : item.id1;
+        node_index item_node_idx;
+        if (find_node_from_id(matching_id, item_node_idx)) {
+            update_node_distance(item_node_idx, curr_node_idx, curr_node.distance_cm + item.distance_cm);
         }
     }
+
+    // update destination if visible from current node
+    node_index dest_node_idx;
+    if ((curr_node.dest_distance_cm < FLT_MAX) && find_node_from_id({AP_OAVisGraph::OATYPE_DESTINATION, 0}, dest_node_idx)) {
+        update_node_distance(dest_node_idx, curr_node_idx, curr_node.distance_cm + curr_node.dest_distance_cm);
+    }
+}
+
+// update a node's distance if the path through from_idx is shorter
+void AP_OADijkstra::update_node_distance(node_index node_idx, node_index from_idx, float distance_cm)
+{
+    ShortPathNode &node = _short_path_data[node_idx];
+    if (node.visited || (distance_cm >= node.distance_cm)) {
+        return;
+    }
+    // update item's distance and set "distance_from_idx" to current node's index
+    node.distance_cm = distance_cm;
+    node.distance_from_idx = from_idx;
+    heap_push_or_update(node_idx);
 }
 
 // find a node's index into _short_path_data array from it's id (i.e. id type and id number)
@@ -832,45 +986,79 @@ bool AP_OADijkstra::find_node_from_id(const AP_OAVisGraph::OAItemID &id, node_in
     return false;
 }
 
-// find index of node with lowest tentative distance (ignore visited nodes)
+// add node to heap or move it up after its distance has decreased
+// heap must have been expanded to hold all nodes
+void AP_OADijkstra::heap_push_or_update(node_index node_idx)
+{
+    ShortPathNode &node = _short_path_data[node_idx];
+    if (node.heap_idx == OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX) {
+        node.heap_idx = _heap_numpoints;
+        _heap[_heap_numpoints++] = node_idx;
+    }
+    heap_sift_up(node.heap_idx);
+}
+
+// remove node with lowest tentative distance plus heuristic from heap
 // returns true if successful and node_idx argument is updated
-bool AP_OADijkstra::find_closest_node_idx(node_index &node_idx) const
+bool AP_OADijkstra::heap_pop(node_index &node_idx)
 {
-    node_index lowest_idx = 0;
-    float lowest_dist = FLT_MAX;
+    if (_heap_numpoints == 0) {
+        return false;
+    }
+    node_idx = _heap[0];
+    _short_path_data[node_idx].heap_idx = OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX;
+
+    // move last node to top and let it sink to its place
+    _heap_numpoints--;
+    if (_heap_numpoints > 0) {
+        _heap[0] = _heap[_heap_numpoints];
+        _short_path_data[_heap[0]].heap_idx = 0;
+        heap_sift_down(0);
+    }
+    return true;
+}
 
-    // scan through all nodes looking for closest
-    for (node_index i=0; i<_short_path_data_numpoints; i++) {
-        const ShortPathNode &node = _short_path_data[i];
-        if (node.visited || is_equal(_short_path_data[i].distance_cm, FLT_MAX)) {
-            // if node is already visited OR cannot be reached yet, we can't use it
-            continue;
-        }
-        // figure out the pos of this node
-        Vector2f node_pos;
-        float dist_with_heuristics = FLT_MAX;
-        if (convert_node_to_point(node.id, node_pos)) {
-            // heuristics is is simple Euclidean distance from the node to the destination
-            // This should be admissible, therefore optimal path is guaranteed
-            const float heuristics = (node_pos-_path_destination).length();
-            dist_with_heuristics = node.distance_cm + heuristics;
-        } else {
-            // shouldn't happen
-            return false;
-        }
-        if (dist_with_heuristics < lowest_dist) {
-            // for NOW, this is the closest node
-            lowest_idx = i;
-            lowest_dist = dist_with_heuristics;
+// restore heap order by moving element at heap position pos up towards the top
+void AP_OADijkstra::heap_sift_up(uint16_t pos)
+{
+    const node_index node_idx = _heap[pos];
+    const float key = heap_key(node_idx);
+    while (pos > 0) {
+        const uint16_t parent = (pos - 1) / 2;
+        if (key >= heap_key(_heap[parent])) {
+            break;
         }
+        _heap[pos] = _heap[parent];
+        _short_path_data[_heap[pos]].heap_idx = pos;
+        pos = parent;
     }
+    _heap[pos] = node_idx;
+    _short_path_data[node_idx].heap_idx = pos;
+}
 
-    if (lowest_dist < FLT_MAX) {
-        // found the closest node
-        node_idx = lowest_idx;
-        return true;
+// restore heap order by moving element at heap position pos down towards the bottom
+void AP_OADijkstra::heap_sift_down(uint16_t pos)
+{
+    const node_index node_idx = _heap[pos];
+    const float key = heap_key(node_idx);
+    while (true) {
+        uint16_t child = pos * 2 + 1;
+        if (child >= _heap_numpoints) {
+            break;
+        }
+        // use lower of the two children
+        if ((child + 1 < _heap_numpoints) && (heap_key(_heap[child + 1]) < heap_key(_heap[child]))) {
+            child++;
+        }
+        if (key <= heap_key(_heap[child])) {
+            break;
+        }
+        _heap[pos] = _heap[child];
+        _short_path_data[_heap[pos]].heap_idx = pos;
+        pos = child;
     }
-    return false;
+    _heap[pos] = node_idx;
+    _short_path_data[node_idx].heap_idx = pos;
 }
 
 // calculate shortest path from origin to destination
@@ -880,12 +1068,22 @@ bool AP_OADijkstra::find_closest_node_idx(node_index &node_idx) const
 bool AP_OADijkstra::calc_shortest_path(const Location &origin, const Location &destination, AP_OADijkstra_Error &err_id)
 {
     // convert origin and destination to offsets from EKF origin
-    if (!origin.get_vector_xy_from_origin_NE_cm(_path_source) ||
-        !destination.get_vector_xy_from_origin_NE_cm(_path_destination)) {
+    Vector2f origin_pos, destination_pos;
+    if (!origin.get_vector_xy_from_origin_NE_cm(origin_pos) ||
+        !destination.get_vector_xy_from_origin_NE_cm(destination_pos)) {
         err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_NO_POSITION_ESTIMATE;
         return false;
     }
 
+    return calc_shortest_path(origin_pos, destination_pos, err_id);
+}
+
+// calculate shortest path from origin to destination as offsets (in cm) from the EKF origin
+bool AP_OADijkstra::calc_shortest_path(const Vector2f &origin, const Vector2f &destination, AP_OADijkstra_Error &err_id)
+{
+    _path_source = origin;
+    _path_destination = destination;
+
     // create visgraphs of origin and destination to fence points
     if (!update_visgraph(_source_visgraph, {AP_OAVisGraph::OATYPE_SOURCE, 0}, _path_source, true, _path_destination)) {
         err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
@@ -896,24 +1094,42 @@ bool AP_OADijkstra::calc_shortest_path(const Location &origin, const Location &d
         return false;
     }
 
-    // expand _short_path_data if necessary
-    if (!_short_path_data.expand_to_hold(2 + total_numpoints())) {
+    // expand _short_path_data and heap if necessary
+    if (!_short_path_data.expand_to_hold(2 + total_numpoints()) ||
+        !_heap.expand_to_hold(2 + total_numpoints())) {
         err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
         return false;
     }
 
-    // add origin and destination (node_type, id, visited, distance_from_idx, distance_cm) to short_path_data array
-    _short_path_data[0] = {{AP_OAVisGraph::OATYPE_SOURCE, 0}, false, 0, 0};
-    _short_path_data[1] = {{AP_OAVisGraph::OATYPE_DESTINATION, 0}, false, OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX, FLT_MAX};
+    // add origin and destination (node_type, id, visited, distance_from_idx, heap_idx, distance_cm, heuristic_cm, dest_distance_cm) to short_path_data array
+    _short_path_data[0] = {{AP_OAVisGraph::OATYPE_SOURCE, 0}, false, 0, OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX, 0, (_path_source - _path_destination).length(), FLT_MAX};
+    _short_path_data[1] = {{AP_OAVisGraph::OATYPE_DESTINATION, 0}, false, OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX, OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX, FLT_MAX, 0, FLT_MAX};
     _short_path_data_numpoints = 2;
 
-    // add all inclusion and exclusion fence points to short_path_data array (node_type, id, visited, distance_from_idx, distance_cm)
+    // add all inclusion and exclusion fence points to short_path_data array
+    // heuristic is simple Euclidean distance from the node to the destination
+    // This should be admissible, therefore optimal path is guaranteed
     for (uint8_t i=0; i<total_numpoints(); i++) {
-        _short_path_data[_short_path_data_numpoints++] = {{AP_OAVisGraph::OATYPE_INTERMEDIATE_POINT, i}, false, OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX, FLT_MAX};
+        Vector2f node_pos;
+        if (!get_point(i, node_pos)) {
+            // shouldn't happen
+            err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_COULD_NOT_FIND_PATH;
+            return false;
+        }
+        _short_path_data[_short_path_data_numpoints++] = {{AP_OAVisGraph::OATYPE_INTERMEDIATE_POINT, i}, false, OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX, OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX, FLT_MAX, (node_pos - _path_destination).length(), FLT_MAX};
+    }
+
+    // record which nodes can see the destination
+    for (uint16_t i = 0; i < _destination_visgraph.num_items(); i++) {
+        node_index node_idx;
+        if (find_node_from_id(_destination_visgraph[i].id2, node_idx)) {
+            _short_path_data[node_idx].dest_distance_cm = _destination_visgraph[i].distance_cm;
+        }
     }
 
     // start algorithm from source point
     node_index current_node_idx = 0;
+    _heap_numpoints = 0;
 
     // update nodes visible from source point
     for (uint16_t i = 0; i < _source_visgraph.num_items(); i++) {
@@ -921,6 +1137,7 @@ bool AP_OADijkstra::calc_shortest_path(const Location &origin, const Location &d
         if (find_node_from_id(_source_visgraph[i].id2, node_idx)) {
             _short_path_data[node_idx].distance_cm = _source_visgraph[i].distance_cm;
             _short_path_data[node_idx].distance_from_idx = current_node_idx;
+            heap_push_or_update(node_idx);
         } else {
             err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_COULD_NOT_FIND_PATH;
             return false;
@@ -930,18 +1147,18 @@ bool AP_OADijkstra::calc_shortest_path(const Location &origin, const Location &d
     _short_path_data[current_node_idx].visited = true;
 
     // move current_node_idx to node with lowest distance
-    while (find_closest_node_idx(current_node_idx)) {
+    while (heap_pop(current_node_idx)) {
         node_index dest_node;
         // See if this next "closest" node is actually the destination
         if (find_node_from_id({AP_OAVisGraph::OATYPE_DESTINATION,0}, dest_node) && current_node_idx == dest_node) {
             // We have discovered destination.. Don't bother with the rest of the graph
             break;
         }
-        // update distances to all neighbours of current node
-        update_visible_node_distances(current_node_idx);
-
         // mark current node as visited
         _short_path_data[current_node_idx].visited = true;
+
+        // update distances to all neighbours of current node
+        update_visible_node_distances(current_node_idx);
     }
 
     // extract path starting from destination
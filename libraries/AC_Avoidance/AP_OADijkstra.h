@@ -8,6 +8,7 @@
 #include <AP_Common/Location.h>
 #include <AP_Math/AP_Math.h>
 #include "AP_OAVisGraph.h"
+#include "AP_OAFenceIndex.h"
 #include <AP_Logger/AP_Logger_config.h>
 
 /*
@@ -21,6 +22,9 @@ public:
 
     CLASS_NO_COPY(AP_OADijkstra);  /* Do not allow copies */
 
+    friend class AP_OADijkstra_benchmark;
+    friend class AP_OADijkstra_Test;
+
     // set fence margin (in meters) used when creating "safe positions" within the polygon fence
     void set_fence_margin(float margin) { _polyfence_margin = MAX(margin, 0.0f); }
 
@@ -117,17 +121,32 @@ private:
     bool get_point(uint16_t index, Vector2f& point) const;
 
     // returns true if line segment intersects polygon or circular fence
+    // requires build_fence_index to have been run since the fences last changed
     bool intersects_fence(const Vector2f &seg_start, const Vector2f &seg_end) const;
 
+    // rebuild bounding box index of inclusion polygons, exclusion polygons and exclusion circles
+    // returns true on success.  returns false on failure and err_id is updated
+    bool build_fence_index(AP_OADijkstra_Error &err_id);
+
     // create visibility graph for all fence (with margin) points
+    // only edges touching new points or passing near fences which have changed since the last successful call are re-tested
     // returns true on success.  returns false on failure and err_id is updated
     bool create_fence_visgraph(AP_OADijkstra_Error &err_id);
 
+    // build per point lists of fence visibility graph items
+    // returns false if out of memory
+    bool create_fence_visgraph_adjacency();
+
+    // record fence points and shapes used to create the fence visibility graph
+    // returns false if out of memory
+    bool save_fence_visgraph_state();
+
     // calculate shortest path from origin to destination
     // returns true on success.  returns false on failure and err_id is updated
     // requires create_polygon_fence_with_margin and create_polygon_fence_visgraph to have been run
     // resulting path is stored in _shortest_path array as vector offsets from EKF origin
     bool calc_shortest_path(const Location &origin, const Location &destination, AP_OADijkstra_Error &err_id);
+    bool calc_shortest_path(const Vector2f &origin, const Vector2f &destination, AP_OADijkstra_Error &err_id);
 
     // shortest path state variables
     bool _inclusion_polygon_with_margin_ok;
@@ -157,8 +176,18 @@ private:
     uint8_t _exclusion_circle_numpoints;    // number of points held in above array
     uint32_t _exclusion_circle_update_ms;   // system time exclusion circles were updated (used to detect changes)
 
+    // fence bounding box index
+    AP_OAFenceIndex _fence_index;           // accelerates intersects_fence
+
     // visibility graphs
     AP_OAVisGraph _fence_visgraph;          // holds distances between all inclusion/exclusion fence points (with margin)
+    bool _fence_visgraph_valid;             // true if _fence_visgraph is complete and can be updated incrementally
+    AP_ExpandingArray<Vector2f> _fence_visgraph_pts;                // fence points (with margin) when fence visgraph was created
+    uint8_t _fence_visgraph_numpoints;                              // number of points held in above array
+    AP_ExpandingArray<AP_OAFenceIndex::Shape> _fence_visgraph_shapes;   // fence shapes when fence visgraph was created
+    uint16_t _fence_visgraph_numshapes;                             // number of shapes held in above array
+    AP_ExpandingArray<uint16_t> _fence_adj_start;   // index into _fence_adj of each fence point's first item (one extra element marks the end)
+    AP_ExpandingArray<uint16_t> _fence_adj;         // indexes into _fence_visgraph of the items touching each fence point
     AP_OAVisGraph _source_visgraph;         // holds distances from source point to all other nodes
     AP_OAVisGraph _destination_visgraph;    // holds distances from the destination to all other nodes
 
@@ -173,7 +202,10 @@ private:
         AP_OAVisGraph::OAItemID id;     // unique id for node (combination of type and id number)
         bool visited;                   // true if all this node's neighbour's distances have been updated
         node_index distance_from_idx;   // index into _short_path_data from where distance was updated (or 255 if not set)
+        node_index heap_idx;            // position in _heap (or 255 if not in heap)
         float distance_cm;              // distance from source (number is tentative until this node is the current node and/or visited = true)
+        float heuristic_cm;             // straight line distance to destination
+        float dest_distance_cm;         // distance to destination if visible, FLT_MAX if not
     };
     AP_ExpandingArray<ShortPathNode> _short_path_data;
     node_index _short_path_data_numpoints;  // number of elements in _short_path_data array
@@ -182,13 +214,32 @@ private:
     // curr_node_idx is an index into the _short_path_data array
     void update_visible_node_distances(node_index curr_node_idx);
 
+    // update a node's distance if the path through from_idx is shorter
+    void update_node_distance(node_index node_idx, node_index from_idx, float distance_cm);
+
     // find a node's index into _short_path_data array from it's id (i.e. id type and id number)
     // returns true if successful and node_idx is updated
     bool find_node_from_id(const AP_OAVisGraph::OAItemID &id, node_index &node_idx) const;
 
-    // find index of node with lowest tentative distance (ignore visited nodes)
+    // binary min-heap of reachable but unvisited nodes ordered by tentative distance plus heuristic
+    AP_ExpandingArray<node_index> _heap;
+    uint16_t _heap_numpoints;           // number of nodes in heap
+
+    // add node to heap or move it up after its distance has decreased
+    void heap_push_or_update(node_index node_idx);
+
+    // remove node with lowest tentative distance plus heuristic from heap
     // returns true if successful and node_idx argument is updated
-    bool find_closest_node_idx(node_index &node_idx) const;
+    bool heap_pop(node_index &node_idx);
+
+    // restore heap order by moving element at heap position pos up or down
+    void heap_sift_up(uint16_t pos);
+    void heap_sift_down(uint16_t pos);
+
+    // value used to order nodes within heap
+    float heap_key(node_index node_idx) const {
+        return _short_path_data[node_idx].distance_cm + _short_path_data[node_idx].heuristic_cm;
+    }
 
     // final path variables and functions
     AP_ExpandingArray<AP_OAVisGraph::OAItemID> _path;   // ids of points on return path in reverse order (i.e. destination is first element)
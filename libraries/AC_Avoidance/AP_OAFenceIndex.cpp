@@ -0,0 +1,260 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AC_Avoidance_config.h"
+
+#if AP_OAPATHPLANNER_DIJKSTRA_ENABLED
+
+#include "AP_OAFenceIndex.h"
+
+#define OA_FENCE_INDEX_ELEMENTS_PER_CHUNK   16  // expanding arrays grow in increments of 16 elements
+
+// constructor
+AP_OAFenceIndex::AP_OAFenceIndex() :
+    _polygons(OA_FENCE_INDEX_ELEMENTS_PER_CHUNK),
+    _chunks(OA_FENCE_INDEX_ELEMENTS_PER_CHUNK),
+    _circles(OA_FENCE_INDEX_ELEMENTS_PER_CHUNK)
+{
+}
+
+// grow box to include point
+void AP_OAFenceIndex::BBox::expand(const Vector2f &point)
+{
+    if (!valid) {
+        min = max = point;
+        valid = true;
+        return;
+    }
+    min.x = MIN(min.x, point.x);
+    min.y = MIN(min.y, point.y);
+    max.x = MAX(max.x, point.x);
+    max.y = MAX(max.y, point.y);
+}
+
+// grow box to include another box
+void AP_OAFenceIndex::BBox::expand(const BBox &box)
+{
+    if (box.valid) {
+        expand(box.min);
+        expand(box.max);
+    }
+}
+
+// true if the boxes overlap (touching counts as overlapping)
+bool AP_OAFenceIndex::BBox::overlaps(const BBox &box) const
+{
+    return valid && box.valid &&
+           (min.x <= box.max.x) && (box.min.x <= max.x) &&
+           (min.y <= box.max.y) && (box.min.y <= max.y);
+}
+
+// box around a line segment
+AP_OAFenceIndex::BBox AP_OAFenceIndex::BBox::from_segment(const Vector2f &seg_start, const Vector2f &seg_end)
+{
+    BBox box {};
+    box.expand(seg_start);
+    box.expand(seg_end);
+    return box;
+}
+
+// true if the line segment passes through or touches the box
+bool AP_OAFenceIndex::BBox::intersects_segment(const Vector2f &seg_start, const Vector2f &seg_end) const
+{
+    if (!overlaps(from_segment(seg_start, seg_end))) {
+        return false;
+    }
+    // segment misses the box if all four corners are on the same side of it
+    const Vector2f seg = seg_end - seg_start;
+    const float c1 = seg % (Vector2f(min.x, min.y) - seg_start);
+    const float c2 = seg % (Vector2f(min.x, max.y) - seg_start);
+    const float c3 = seg % (Vector2f(max.x, min.y) - seg_start);
+    const float c4 = seg % (Vector2f(max.x, max.y) - seg_start);
+    return !(((c1 > 0) && (c2 > 0) && (c3 > 0) && (c4 > 0)) ||
+             ((c1 < 0) && (c2 < 0) && (c3 < 0) && (c4 < 0)));
+}
+
+// shapes are the same if they cover the same area and have the same points
+bool AP_OAFenceIndex::Shape::operator ==(const Shape &s) const
+{
+    return (signature == s.signature) && (bounded == s.bounded) && (box.valid == s.box.valid) &&
+           (box.min == s.box.min) && (box.max == s.box.max);
+}
+
+// remove all polygons and circles
+void AP_OAFenceIndex::clear()
+{
+    _num_polygons = 0;
+    _num_chunks = 0;
+    _num_circles = 0;
+}
+
+// add a polygon to the index, returns false if out of memory
+bool AP_OAFenceIndex::add_polygon(const Vector2f *boundary, uint16_t num_points)
+{
+    if ((boundary == nullptr) || (num_points < 2)) {
+        // nothing to intersect with
+        return true;
+    }
+
+    // if the last point is the same as the first treat as if the last point wasn't passed in
+    uint16_t num_edges = num_points;
+    if (Polygon_complete(boundary, num_points)) {
+        num_edges--;
+    }
+
+    const uint16_t num_chunks = (num_edges + edges_per_chunk - 1) / edges_per_chunk;
+    if (!_polygons.expand_to_hold(_num_polygons + 1) ||
+        !_chunks.expand_to_hold(_num_chunks + num_chunks)) {
+        return false;
+    }
+
+    Polygon &poly = _polygons[_num_polygons];
+    poly.shape.box = {};
+    poly.shape.bounded = true;
+    poly.shape.signature = crc_crc32(0, (const uint8_t *)boundary, num_edges * sizeof(Vector2f));
+    poly.boundary = boundary;
+    poly.num_edges = num_edges;
+    poly.first_chunk = _num_chunks;
+
+    // each chunk's box covers both ends of each of its edges
+    for (uint16_t c = 0; c < num_chunks; c++) {
+        Chunk &chunk = _chunks[_num_chunks + c];
+        chunk.box = {};
+        chunk.first_edge = c * edges_per_chunk;
+        const uint16_t last_edge = MIN(chunk.first_edge + edges_per_chunk, num_edges);
+        for (uint16_t e = chunk.first_edge; e < last_edge; e++) {
+            chunk.box.expand(boundary[e]);
+            chunk.box.expand(boundary[(e + 1 < num_edges) ? e + 1 : 0]);
+        }
+        poly.shape.box.expand(chunk.box);
+    }
+
+    _num_chunks += num_chunks;
+    _num_polygons++;
+    return true;
+}
+
+// add a circle which segments must stay out of, returns false if out of memory
+bool AP_OAFenceIndex::add_circle(const Vector2f &center, float radius)
+{
+    return add_circle(center, radius, false);
+}
+
+// add a circle which segments must stay within, returns false if out of memory
+bool AP_OAFenceIndex::add_inclusion_circle(const Vector2f &center, float radius)
+{
+    return add_circle(center, radius, true);
+}
+
+// add an inclusion or exclusion circle
+bool AP_OAFenceIndex::add_circle(const Vector2f &center, float radius, bool inclusion)
+{
+    if (!_circles.expand_to_hold(_num_circles + 1)) {
+        return false;
+    }
+
+    Circle &circle = _circles[_num_circles];
+    circle.center = center;
+    circle.radius = radius;
+    circle.inclusion = inclusion;
+    circle.shape.box = {};
+    // moving an inclusion circle changes which segments outside it are allowed
+    circle.shape.bounded = !inclusion;
+    circle.shape.box.expand(center - Vector2f(radius, radius));
+    circle.shape.box.expand(center + Vector2f(radius, radius));
+    circle.shape.signature = crc_crc32(0, (const uint8_t *)&radius, sizeof(radius));
+
+    _num_circles++;
+    return true;
+}
+
+// returns true if the segment crosses one of num_edges edges of a polygon starting from first_edge
+bool AP_OAFenceIndex::intersects_edges(const Polygon &poly, uint16_t first_edge, uint16_t num_edges, const Vector2f &seg_start, const Vector2f &seg_end)
+{
+    for (uint16_t i = first_edge; i < first_edge + num_edges; i++) {
+        const Vector2f &v1 = poly.boundary[i];
+        const Vector2f &v2 = poly.boundary[(i + 1 < poly.num_edges) ? i + 1 : 0];
+        // same quick rejection as Polygon_intersects
+        if ((v1.x > seg_start.x && v2.x > seg_start.x && v1.x > seg_end.x && v2.x > seg_end.x) ||
+            (v1.y > seg_start.y && v2.y > seg_start.y && v1.y > seg_end.y && v2.y > seg_end.y) ||
+            (v1.x < seg_start.x && v2.x < seg_start.x && v1.x < seg_end.x && v2.x < seg_end.x) ||
+            (v1.y < seg_start.y && v2.y < seg_start.y && v1.y < seg_end.y && v2.y < seg_end.y)) {
+            continue;
+        }
+        Vector2f intersection;
+        if (Vector2f::segment_intersection(v1, v2, seg_start, seg_end, intersection)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// returns true if the line segment crosses an edge of any polygon, passes within
+// any exclusion circle or has an end outside any inclusion circle
+bool AP_OAFenceIndex::intersects(const Vector2f &seg_start, const Vector2f &seg_end) const
+{
+    const BBox seg_box = BBox::from_segment(seg_start, seg_end);
+
+    for (uint16_t p = 0; p < _num_polygons; p++) {
+        const Polygon &poly = _polygons[p];
+        if (!poly.shape.box.overlaps(seg_box)) {
+            continue;
+        }
+        const uint16_t num_chunks = (poly.num_edges + edges_per_chunk - 1) / edges_per_chunk;
+        for (uint16_t c = 0; c < num_chunks; c++) {
+            const Chunk &chunk = _chunks[poly.first_chunk + c];
+            if (!chunk.box.overlaps(seg_box)) {
+                continue;
+            }
+            const uint16_t num_edges = MIN(edges_per_chunk, poly.num_edges - chunk.first_edge);
+            if (intersects_edges(poly, chunk.first_edge, num_edges, seg_start, seg_end)) {
+                return true;
+            }
+        }
+    }
+
+    for (uint16_t i = 0; i < _num_circles; i++) {
+        const Circle &circle = _circles[i];
+        if (circle.inclusion) {
+            // intersects if either start or end is further from the center than the radius
+            const float radius_sq = sq(circle.radius);
+            if (((seg_start - circle.center).length_squared() > radius_sq) ||
+                ((seg_end - circle.center).length_squared() > radius_sq)) {
+                return true;
+            }
+            continue;
+        }
+        if (!circle.shape.box.overlaps(seg_box)) {
+            continue;
+        }
+        // intersects if distance between circle's center and segment is less than radius
+        if (Vector2f::closest_distance_between_line_and_point(seg_start, seg_end, circle.center) <= circle.radius) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// get summary of a polygon or circle.  polygons come first followed by circles
+AP_OAFenceIndex::Shape AP_OAFenceIndex::get_shape(uint16_t i) const
+{
+    if (i < _num_polygons) {
+        return _polygons[i].shape;
+    }
+    return _circles[i - _num_polygons].shape;
+}
+
+#endif  // AP_OAPATHPLANNER_DIJKSTRA_ENABLED
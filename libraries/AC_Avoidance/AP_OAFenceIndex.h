@@ -0,0 +1,114 @@
+#pragma once
+
+#include "AC_Avoidance_config.h"
+
+#if AP_OAPATHPLANNER_DIJKSTRA_ENABLED
+
+#include <AP_Common/AP_Common.h>
+#include <AP_Common/AP_ExpandingArray.h>
+#include <AP_Math/AP_Math.h>
+
+/*
+ * Bounding box index over fence polygons and circles, used to quickly
+ * reject line segments which cannot cross them.  Each polygon
+ * has a bounding box, and its edges are grouped into runs of consecutive
+ * edges which each have their own bounding box, so only the edges near
+ * a segment are tested against it.
+ *
+ * Polygons are referenced, not copied, so the index must be rebuilt
+ * whenever the polygons it was built from change.
+ */
+class AP_OAFenceIndex {
+public:
+    AP_OAFenceIndex();
+
+    CLASS_NO_COPY(AP_OAFenceIndex);  /* Do not allow copies */
+
+    // axis aligned bounding box
+    struct BBox {
+        Vector2f min;
+        Vector2f max;
+        bool valid;
+
+        // grow box to include point
+        void expand(const Vector2f &point);
+        // grow box to include another box
+        void expand(const BBox &box);
+        // true if the boxes overlap (touching counts as overlapping)
+        bool overlaps(const BBox &box) const;
+        // box around a line segment
+        static BBox from_segment(const Vector2f &seg_start, const Vector2f &seg_end);
+        // true if the line segment passes through or touches the box
+        bool intersects_segment(const Vector2f &seg_start, const Vector2f &seg_end) const;
+    };
+
+    // summary of a single polygon or circle, used to detect which fences have changed
+    struct Shape {
+        BBox box;               // bounding box
+        uint32_t signature;     // crc of the shape's points
+        bool bounded;           // false if segments outside the box are affected, as for inclusion circles
+        bool operator ==(const Shape &s) const;
+    };
+
+    // remove all polygons and circles
+    void clear();
+
+    // add a polygon to the index, returns false if out of memory
+    bool add_polygon(const Vector2f *boundary, uint16_t num_points);
+
+    // add a circle which segments must stay out of, returns false if out of memory
+    bool add_circle(const Vector2f &center, float radius);
+
+    // add a circle which segments must stay within, returns false if out of memory
+    bool add_inclusion_circle(const Vector2f &center, float radius);
+
+    // returns true if the line segment crosses an edge of any polygon, passes within
+    // any exclusion circle or has an end outside any inclusion circle
+    bool intersects(const Vector2f &seg_start, const Vector2f &seg_end) const;
+
+    // number of polygons and circles in index
+    uint16_t num_shapes() const { return _num_polygons + _num_circles; }
+
+    // get summary of a polygon or circle.  polygons come first followed by circles
+    // no protection against out-of-bounds accesses so use with num_shapes()
+    Shape get_shape(uint16_t i) const;
+
+private:
+
+    // number of consecutive edges sharing a bounding box
+    static const uint8_t edges_per_chunk = 16;
+
+    struct Polygon {
+        Shape shape;                // bounding box and signature of whole polygon
+        const Vector2f *boundary;   // polygon points (owned by caller)
+        uint16_t num_edges;         // number of edges in polygon
+        uint16_t first_chunk;       // index of first chunk in _chunks
+    };
+
+    struct Chunk {
+        BBox box;                   // bounding box of this chunk's edges
+        uint16_t first_edge;        // index of first edge within the polygon
+    };
+
+    struct Circle {
+        Shape shape;                // bounding box and signature of circle
+        Vector2f center;
+        float radius;
+        bool inclusion;             // true if segments must stay within the circle
+    };
+
+    // add an inclusion or exclusion circle
+    bool add_circle(const Vector2f &center, float radius, bool inclusion);
+
+    // returns true if the segment crosses one of num_edges edges of a polygon starting from first_edge
+    static bool intersects_edges(const Polygon &poly, uint16_t first_edge, uint16_t num_edges, const Vector2f &seg_start, const Vector2f &seg_end);
+
+    AP_ExpandingArray<Polygon> _polygons;
+    uint16_t _num_polygons;
+    AP_ExpandingArray<Chunk> _chunks;
+    uint16_t _num_chunks;
+    AP_ExpandingArray<Circle> _circles;
+    uint16_t _num_circles;
+};
+
+#endif  // AP_OAPATHPLANNER_DIJKSTRA_ENABLED
@@ -52,6 +52,14 @@ public:
     // allow accessing graph as an array, 0 indexed
     // Note: no protection against out-of-bounds accesses so use with num_items()
     const VisGraphItem& operator[](uint16_t i) const { return _items[i]; }
+    VisGraphItem& operator[](uint16_t i) { return _items[i]; }
+
+    // remove all items from index num onwards
+    void truncate(uint16_t num) {
+        if (num < _num_items) {
+            _num_items = num;
+        }
+    }
 
 private:
 
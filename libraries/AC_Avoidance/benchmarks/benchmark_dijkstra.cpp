@@ -0,0 +1,248 @@
+/*
+  benchmarks of Dijkstra's path planner around polygon fences. The
+  argument is the number of points in the inclusion polygon, which
+  holds a ring of exclusion polygons and a couple of exclusion circles,
+  similar to a survey area with no-go zones
+ */
+#include <AP_gbenchmark.h>
+
+#include <AC_Avoidance/AP_OADijkstra.h>
+#include <AC_Fence/AC_Fence.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// fence with no points loaded, the fences used are given directly to the planner
+static AC_Fence fence;
+static AP_Int16 options;
+
+class AP_OADijkstra_benchmark {
+public:
+    static const uint16_t max_inclusion_points = 200;
+    static const uint8_t num_exclusion_polygons = 6;
+    static const uint8_t exclusion_polygon_points = 6;
+    static const uint8_t num_exclusion_circles = 2;
+    static const uint16_t num_segments = 256;
+
+    // fence positions in cm from the EKF origin
+    static constexpr float inclusion_radius_cm = 100000;
+    static constexpr float exclusion_ring_radius_cm = 50000;
+    static constexpr float exclusion_radius_cm = 4000;
+    static constexpr float circle_radius_cm = 2500;
+    static constexpr float margin_cm = 500;
+
+    Vector2f inclusion[max_inclusion_points];
+    uint16_t num_inclusion_points;
+    Vector2f exclusion[num_exclusion_polygons][exclusion_polygon_points];
+    Vector2f exclusion_center[num_exclusion_polygons];
+    Vector2f circle_center[num_exclusion_circles];
+    Vector2f seg_start[num_segments];
+    Vector2f seg_end[num_segments];
+
+    AP_OADijkstra *dijkstra;
+
+    AP_OADijkstra_benchmark(uint16_t num_points)
+    {
+        dijkstra = NEW_NOTHROW AP_OADijkstra(options);
+
+        // inclusion polygon zig-zags in and out so all of its points are used
+        num_inclusion_points = MIN(num_points, max_inclusion_points);
+        for (uint16_t i = 0; i < num_inclusion_points; i++) {
+            const float angle = M_2PI * i / num_inclusion_points;
+            const float radius = (i % 2) ? inclusion_radius_cm * 0.92f : inclusion_radius_cm;
+            inclusion[i] = Vector2f(cosf(angle), sinf(angle)) * radius;
+        }
+        for (uint8_t i = 0; i < num_exclusion_polygons; i++) {
+            const float angle = M_2PI * i / num_exclusion_polygons;
+            set_exclusion_polygon(i, Vector2f(cosf(angle), sinf(angle)) * exclusion_ring_radius_cm);
+        }
+        circle_center[0] = Vector2f(0, 20000);
+        circle_center[1] = Vector2f(-30000, -70000);
+
+        // segments between random points within the inclusion polygon
+        for (uint16_t i = 0; i < num_segments; i++) {
+            seg_start[i] = random_point();
+            seg_end[i] = random_point();
+        }
+
+        fence_updated();
+        dijkstra->_fence_visgraph_valid = false;
+        AP_OADijkstra::AP_OADijkstra_Error err_id;
+        dijkstra->create_fence_visgraph(err_id);
+    }
+
+    ~AP_OADijkstra_benchmark()
+    {
+        delete dijkstra;
+    }
+
+    static Vector2f random_point()
+    {
+        return Vector2f(rand_float(), rand_float()) * 70000.0f;
+    }
+
+    void set_exclusion_polygon(uint8_t n, const Vector2f &center)
+    {
+        exclusion_center[n] = center;
+        for (uint8_t i = 0; i < exclusion_polygon_points; i++) {
+            const float angle = M_2PI * i / exclusion_polygon_points;
+            exclusion[n][i] = center + Vector2f(cosf(angle), sinf(angle)) * exclusion_radius_cm;
+        }
+    }
+
+    // give the fences and points around them to the planner, as
+    // create_*_with_margin and build_fence_index would
+    void fence_updated()
+    {
+        AP_OADijkstra &d = *dijkstra;
+        d._inclusion_polygon_pts.expand_to_hold(num_inclusion_points);
+        for (uint16_t i = 0; i < num_inclusion_points; i++) {
+            d._inclusion_polygon_pts[i] = inclusion[i] * ((inclusion[i].length() - margin_cm) / inclusion[i].length());
+        }
+        d._inclusion_polygon_numpoints = num_inclusion_points;
+
+        d._exclusion_polygon_pts.expand_to_hold(num_exclusion_polygons * exclusion_polygon_points);
+        d._exclusion_polygon_numpoints = 0;
+        for (uint8_t n = 0; n < num_exclusion_polygons; n++) {
+            for (uint8_t i = 0; i < exclusion_polygon_points; i++) {
+                const Vector2f ofs = exclusion[n][i] - exclusion_center[n];
+                d._exclusion_polygon_pts[d._exclusion_polygon_numpoints++] = exclusion_center[n] + ofs * ((ofs.length() + margin_cm) / ofs.length());
+            }
+        }
+
+        d._exclusion_circle_pts.expand_to_hold(num_exclusion_circles * 6);
+        d._exclusion_circle_numpoints = 0;
+        for (uint8_t n = 0; n < num_exclusion_circles; n++) {
+            for (uint8_t i = 0; i < 6; i++) {
+                const float angle = radians(30 + 60 * i);
+                const float scaler = (circle_radius_cm + margin_cm) / cosf(radians(30));
+                d._exclusion_circle_pts[d._exclusion_circle_numpoints++] = circle_center[n] + Vector2f(cosf(angle), sinf(angle)) * scaler;
+            }
+        }
+
+        d._fence_index.clear();
+        d._fence_index.add_polygon(inclusion, num_inclusion_points);
+        for (uint8_t n = 0; n < num_exclusion_polygons; n++) {
+            d._fence_index.add_polygon(exclusion[n], exclusion_polygon_points);
+        }
+        for (uint8_t n = 0; n < num_exclusion_circles; n++) {
+            d._fence_index.add_circle(circle_center[n], circle_radius_cm);
+        }
+    }
+
+    // intersection test as it was done before the fence index
+    bool intersects_fence_unindexed(const Vector2f &start, const Vector2f &end) const
+    {
+        Vector2f intersection;
+        if (Polygon_intersects(inclusion, num_inclusion_points, start, end, intersection)) {
+            return true;
+        }
+        for (uint8_t n = 0; n < num_exclusion_polygons; n++) {
+            if (Polygon_intersects(exclusion[n], exclusion_polygon_points, start, end, intersection)) {
+                return true;
+            }
+        }
+        for (uint8_t n = 0; n < num_exclusion_circles; n++) {
+            if (Vector2f::closest_distance_between_line_and_point(start, end, circle_center[n]) <= circle_radius_cm) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool intersects_fence(const Vector2f &start, const Vector2f &end) const
+    {
+        return dijkstra->intersects_fence(start, end);
+    }
+
+    bool create_fence_visgraph(bool incremental)
+    {
+        AP_OADijkstra::AP_OADijkstra_Error err_id;
+        if (!incremental) {
+            dijkstra->_fence_visgraph_valid = false;
+        }
+        return dijkstra->create_fence_visgraph(err_id);
+    }
+
+    bool calc_shortest_path(const Vector2f &origin, const Vector2f &destination)
+    {
+        AP_OADijkstra::AP_OADijkstra_Error err_id;
+        return dijkstra->calc_shortest_path(origin, destination, err_id);
+    }
+
+    uint16_t total_numpoints() const { return dijkstra->total_numpoints(); }
+};
+
+static void BM_IntersectsFenceUnindexed(benchmark::State& state)
+{
+    AP_OADijkstra_benchmark b(state.range(0));
+    uint16_t i = 0;
+
+    while (state.KeepRunning()) {
+        bool ret = b.intersects_fence_unindexed(b.seg_start[i], b.seg_end[i]);
+        gbenchmark_escape(&ret);
+        i = (i + 1) % AP_OADijkstra_benchmark::num_segments;
+    }
+}
+
+static void BM_IntersectsFence(benchmark::State& state)
+{
+    AP_OADijkstra_benchmark b(state.range(0));
+    uint16_t i = 0;
+
+    while (state.KeepRunning()) {
+        bool ret = b.intersects_fence(b.seg_start[i], b.seg_end[i]);
+        gbenchmark_escape(&ret);
+        i = (i + 1) % AP_OADijkstra_benchmark::num_segments;
+    }
+}
+
+static void BM_CreateFenceVisgraph(benchmark::State& state)
+{
+    AP_OADijkstra_benchmark b(state.range(0));
+
+    while (state.KeepRunning()) {
+        bool ret = b.create_fence_visgraph(false);
+        gbenchmark_escape(&ret);
+    }
+    state.SetItemsProcessed(state.iterations() * b.total_numpoints());
+}
+
+// one exclusion polygon moves back and forth, as when a no-go zone is edited
+static void BM_UpdateFenceVisgraph(benchmark::State& state)
+{
+    AP_OADijkstra_benchmark b(state.range(0));
+    const Vector2f center = b.exclusion_center[0];
+    bool moved = false;
+
+    while (state.KeepRunning()) {
+        moved = !moved;
+        b.set_exclusion_polygon(0, moved ? center + Vector2f(5000, 5000) : center);
+        b.fence_updated();
+        bool ret = b.create_fence_visgraph(true);
+        gbenchmark_escape(&ret);
+    }
+    state.SetItemsProcessed(state.iterations() * b.total_numpoints());
+}
+
+static void BM_CalcShortestPath(benchmark::State& state)
+{
+    AP_OADijkstra_benchmark b(state.range(0));
+
+    // across the survey area, past the exclusion zones
+    const Vector2f origin(-85000, 1000);
+    const Vector2f destination(85000, -1000);
+
+    while (state.KeepRunning()) {
+        bool ret = b.calc_shortest_path(origin, destination);
+        gbenchmark_escape(&ret);
+    }
+    state.SetItemsProcessed(state.iterations() * b.total_numpoints());
+}
+
+BENCHMARK(BM_IntersectsFenceUnindexed)->Arg(32)->Arg(96)->Arg(192);
+BENCHMARK(BM_IntersectsFence)->Arg(32)->Arg(96)->Arg(192);
+BENCHMARK(BM_CreateFenceVisgraph)->Arg(32)->Arg(96)->Arg(192);
+BENCHMARK(BM_UpdateFenceVisgraph)->Arg(32)->Arg(96)->Arg(192);
+BENCHMARK(BM_CalcShortestPath)->Arg(32)->Arg(96)->Arg(192);
+
+BENCHMARK_MAIN();
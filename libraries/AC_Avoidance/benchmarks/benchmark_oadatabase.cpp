@@ -0,0 +1,138 @@
+/*
+  benchmarks of the object avoidance database fed by a 360 degree
+  lidar. The argument is the database size. The vehicle moves through
+  a cluttered area with a lidar reading every 2 degrees
+ */
+#include <AP_gbenchmark.h>
+
+#include <AC_Avoidance/AP_OADatabase.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+class AP_OADatabase_benchmark {
+public:
+    static const uint8_t num_sectors = 180;
+    static const uint8_t num_scans = 16;
+    static const uint8_t num_bearings = 36;
+    static constexpr float lookahead_m = 15;
+
+    // lidar readings of a few scans, each taken from a different position
+    Vector3f point[num_scans][num_sectors];
+    float distance[num_scans][num_sectors];
+    uint8_t scan = 0;
+    uint32_t timestamp_ms = 0;
+
+    AP_OADatabase *db;
+
+    AP_OADatabase_benchmark(uint16_t size)
+    {
+        db = NEW_NOTHROW AP_OADatabase();
+        db->_database_size_param.set(size);
+        db->_queue_size_param.set(num_sectors * 2);
+        db->_database_expiry_seconds.set(0);
+        db->init();
+
+        // obstacle distance in each direction varies between 2 and 30m
+        for (uint8_t s = 0; s < num_scans; s++) {
+            const Vector3f vehicle_pos(s * 2.0f, s * 0.5f, 0);
+            for (uint8_t i = 0; i < num_sectors; i++) {
+                const float angle = radians(i * 360.0f / num_sectors);
+                distance[s][i] = 2 + (get_random16() % 2800) * 0.01f;
+                point[s][i] = vehicle_pos + Vector3f(cosf(angle), sinf(angle), 0) * distance[s][i];
+            }
+        }
+
+        // fill the database
+        for (uint8_t s = 0; s < num_scans * 4; s++) {
+            push_scan();
+        }
+    }
+
+    ~AP_OADatabase_benchmark()
+    {
+        delete db->_queue.items;
+        delete[] db->_database.items;
+        delete[] db->_grid.head;
+        delete[] db->_grid.next;
+        delete db;
+        AP_OADatabase::_singleton = nullptr;
+    }
+
+    // push one scan of lidar readings and move them into the database
+    void push_scan()
+    {
+        timestamp_ms += 100;
+        for (uint8_t i = 0; i < num_sectors; i++) {
+            db->queue_push(point[scan][i], timestamp_ms, distance[scan][i], AP_OADatabase::OA_DbItem::Source::proximity);
+        }
+        while (db->process_queue()) {
+        }
+        scan = (scan + 1) % num_scans;
+    }
+
+    // segment from the vehicle's position in the lookahead direction, as BendyRuler tests
+    static void bearing_segment(uint8_t i, Vector3f &start, Vector3f &end)
+    {
+        const float angle = radians(i * 360.0f / num_bearings);
+        start.zero();
+        end = Vector3f(cosf(angle), sinf(angle), 0) * lookahead_m;
+    }
+
+    // margin as BendyRuler calculated it before the grid index
+    float margin_unindexed(const Vector3f &start, const Vector3f &end) const
+    {
+        float smallest_margin = FLT_MAX;
+        for (uint16_t i = 0; i < db->database_count(); i++) {
+            const AP_OADatabase::OA_DbItem &item = db->get_item(i);
+            const float m = Vector3f::closest_distance_between_line_and_point(start, end, item.pos) - item.radius;
+            smallest_margin = MIN(smallest_margin, m);
+        }
+        return smallest_margin;
+    }
+};
+
+static void BM_ProcessScan(benchmark::State& state)
+{
+    AP_OADatabase_benchmark b(state.range(0));
+
+    while (state.KeepRunning()) {
+        b.push_scan();
+    }
+    state.SetItemsProcessed(state.iterations() * AP_OADatabase_benchmark::num_sectors);
+}
+
+static void BM_MarginUnindexed(benchmark::State& state)
+{
+    AP_OADatabase_benchmark b(state.range(0));
+    uint8_t i = 0;
+
+    while (state.KeepRunning()) {
+        Vector3f start, end;
+        AP_OADatabase_benchmark::bearing_segment(i, start, end);
+        float margin = b.margin_unindexed(start, end);
+        gbenchmark_escape(&margin);
+        i = (i + 1) % AP_OADatabase_benchmark::num_bearings;
+    }
+}
+
+static void BM_Margin(benchmark::State& state)
+{
+    AP_OADatabase_benchmark b(state.range(0));
+    uint8_t i = 0;
+
+    while (state.KeepRunning()) {
+        Vector3f start, end;
+        AP_OADatabase_benchmark::bearing_segment(i, start, end);
+        float margin;
+        bool ret = b.db->calc_margin_from_segment(start, end, margin);
+        gbenchmark_escape(&ret);
+        gbenchmark_escape(&margin);
+        i = (i + 1) % AP_OADatabase_benchmark::num_bearings;
+    }
+}
+
+BENCHMARK(BM_ProcessScan)->Arg(100)->Arg(500)->Arg(2000);
+BENCHMARK(BM_MarginUnindexed)->Arg(100)->Arg(500)->Arg(2000);
+BENCHMARK(BM_Margin)->Arg(100)->Arg(500)->Arg(2000);
+
+BENCHMARK_MAIN();
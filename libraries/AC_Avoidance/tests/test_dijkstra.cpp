@@ -0,0 +1,426 @@
+/*
+  check the fence index, the incremental fence visibility graph and
+  the heap based search against the code they replaced, over randomly
+  generated fences
+ */
+#include <AP_gtest.h>
+
+#include <AC_Avoidance/AP_OADijkstra.h>
+#include <AC_Fence/AC_Fence.h>
+
+#include <algorithm>
+#include <vector>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+#if AP_OAPATHPLANNER_DIJKSTRA_ENABLED && AP_FENCE_ENABLED
+
+// fence with no points loaded, the fences used are given directly to the planner
+static AC_Fence fence;
+static AP_Int16 options;
+
+class AP_OADijkstra_Test {
+public:
+    static const uint8_t max_exclusion_polygons = 6;
+    static const uint8_t max_exclusion_polygon_points = 8;
+    static const uint8_t max_exclusion_circles = 3;
+    static const uint8_t max_inclusion_circles = 2;
+    static constexpr float inclusion_radius_cm = 100000;
+    static constexpr float margin_cm = 500;
+
+    // fences in cm from the EKF origin
+    std::vector<Vector2f> inclusion;
+    std::vector<Vector2f> exclusion[max_exclusion_polygons];
+    uint8_t num_exclusion_polygons;
+    Vector2f circle_center[max_exclusion_circles];
+    float circle_radius_cm[max_exclusion_circles];
+    uint8_t num_exclusion_circles;
+    Vector2f inclusion_circle_center[max_inclusion_circles];
+    float inclusion_circle_radius_cm[max_inclusion_circles];
+    uint8_t num_inclusion_circles;
+
+    // allocated so that it starts zeroed, as the planner expects
+    AP_OADijkstra *dijkstra;
+
+    AP_OADijkstra_Test() :
+        dijkstra(NEW_NOTHROW AP_OADijkstra(options))
+    {}
+    ~AP_OADijkstra_Test() { delete dijkstra; }
+    CLASS_NO_COPY(AP_OADijkstra_Test);
+
+    static float random_float(float min, float max)
+    {
+        return linear_interpolate(min, max, get_random16(), 0, 0xFFFF);
+    }
+
+    Vector2f random_point(float radius)
+    {
+        return Vector2f(random_float(-radius, radius), random_float(-radius, radius));
+    }
+
+    // star shaped polygon, so its edges never cross each other
+    void random_polygon(std::vector<Vector2f> &poly, const Vector2f &center, float radius, uint16_t num_points)
+    {
+        poly.resize(num_points);
+        for (uint16_t i = 0; i < num_points; i++) {
+            const float angle = M_2PI * (i + random_float(0, 0.8f)) / num_points;
+            poly[i] = center + Vector2f(cosf(angle), sinf(angle)) * radius * random_float(0.5f, 1.0f);
+        }
+    }
+
+    void random_exclusion_polygon(uint8_t n)
+    {
+        random_polygon(exclusion[n], random_point(inclusion_radius_cm * 0.6f), random_float(2000, 15000), 3 + get_random16() % (max_exclusion_polygon_points - 2));
+    }
+
+    void random_exclusion_circle(uint8_t n)
+    {
+        circle_center[n] = random_point(inclusion_radius_cm * 0.6f);
+        circle_radius_cm[n] = random_float(1000, 8000);
+    }
+
+    // large enough to leave most of the inclusion polygon inside it
+    void random_inclusion_circle(uint8_t n)
+    {
+        inclusion_circle_center[n] = random_point(inclusion_radius_cm * 0.2f);
+        inclusion_circle_radius_cm[n] = random_float(0.7f, 1.2f) * inclusion_radius_cm;
+    }
+
+    void random_fence(uint16_t num_inclusion_points)
+    {
+        random_polygon(inclusion, Vector2f(), inclusion_radius_cm, num_inclusion_points);
+        num_exclusion_polygons = 1 + get_random16() % max_exclusion_polygons;
+        for (uint8_t n = 0; n < num_exclusion_polygons; n++) {
+            random_exclusion_polygon(n);
+        }
+        num_exclusion_circles = get_random16() % (max_exclusion_circles + 1);
+        for (uint8_t n = 0; n < num_exclusion_circles; n++) {
+            random_exclusion_circle(n);
+        }
+        num_inclusion_circles = get_random16() % (max_inclusion_circles + 1);
+        for (uint8_t n = 0; n < num_inclusion_circles; n++) {
+            random_inclusion_circle(n);
+        }
+    }
+
+    // give the fences and points around them to the planner, as
+    // create_*_with_margin and build_fence_index would
+    void fence_updated()
+    {
+        AP_OADijkstra &d = *dijkstra;
+        d._inclusion_polygon_pts.expand_to_hold(inclusion.size());
+        for (uint16_t i = 0; i < inclusion.size(); i++) {
+            d._inclusion_polygon_pts[i] = inclusion[i] * ((inclusion[i].length() - margin_cm) / inclusion[i].length());
+        }
+        d._inclusion_polygon_numpoints = inclusion.size();
+
+        d._exclusion_polygon_pts.expand_to_hold(max_exclusion_polygons * max_exclusion_polygon_points);
+        d._exclusion_polygon_numpoints = 0;
+        for (uint8_t n = 0; n < num_exclusion_polygons; n++) {
+            Vector2f center;
+            for (const Vector2f &p : exclusion[n]) {
+                center += p / exclusion[n].size();
+            }
+            for (const Vector2f &p : exclusion[n]) {
+                const Vector2f ofs = p - center;
+                d._exclusion_polygon_pts[d._exclusion_polygon_numpoints++] = center + ofs * ((ofs.length() + margin_cm) / ofs.length());
+            }
+        }
+
+        d._exclusion_circle_pts.expand_to_hold(max_exclusion_circles * 6);
+        d._exclusion_circle_numpoints = 0;
+        for (uint8_t n = 0; n < num_exclusion_circles; n++) {
+            for (uint8_t i = 0; i < 6; i++) {
+                const float angle = radians(30 + 60 * i);
+                const float scaler = (circle_radius_cm[n] + margin_cm) / cosf(radians(30));
+                d._exclusion_circle_pts[d._exclusion_circle_numpoints++] = circle_center[n] + Vector2f(cosf(angle), sinf(angle)) * scaler;
+            }
+        }
+
+        d._fence_index.clear();
+        d._fence_index.add_polygon(inclusion.data(), inclusion.size());
+        for (uint8_t n = 0; n < num_exclusion_polygons; n++) {
+            d._fence_index.add_polygon(exclusion[n].data(), exclusion[n].size());
+        }
+        for (uint8_t n = 0; n < num_exclusion_circles; n++) {
+            d._fence_index.add_circle(circle_center[n], circle_radius_cm[n]);
+        }
+        for (uint8_t n = 0; n < num_inclusion_circles; n++) {
+            d._fence_index.add_inclusion_circle(inclusion_circle_center[n], inclusion_circle_radius_cm[n]);
+        }
+    }
+
+    // test of every polygon edge, as done before the fence index
+    static bool polygon_intersects(const std::vector<Vector2f> &poly, const Vector2f &start, const Vector2f &end)
+    {
+        for (uint16_t i = 0; i < poly.size(); i++) {
+            Vector2f intersection;
+            if (Vector2f::segment_intersection(poly[i], poly[(i + 1) % poly.size()], start, end, intersection)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool intersects_fence_unindexed(const Vector2f &start, const Vector2f &end) const
+    {
+        if (polygon_intersects(inclusion, start, end)) {
+            return true;
+        }
+        for (uint8_t n = 0; n < num_exclusion_polygons; n++) {
+            if (polygon_intersects(exclusion[n], start, end)) {
+                return true;
+            }
+        }
+        for (uint8_t n = 0; n < num_exclusion_circles; n++) {
+            if (Vector2f::closest_distance_between_line_and_point(start, end, circle_center[n]) <= circle_radius_cm[n]) {
+                return true;
+            }
+        }
+        for (uint8_t n = 0; n < num_inclusion_circles; n++) {
+            if (((start - inclusion_circle_center[n]).length() > inclusion_circle_radius_cm[n]) ||
+                ((end - inclusion_circle_center[n]).length() > inclusion_circle_radius_cm[n])) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool intersects_fence(const Vector2f &start, const Vector2f &end) const
+    {
+        return dijkstra->intersects_fence(start, end);
+    }
+
+    bool create_fence_visgraph(bool incremental)
+    {
+        AP_OADijkstra::AP_OADijkstra_Error err_id;
+        if (!incremental) {
+            dijkstra->_fence_visgraph_valid = false;
+        }
+        return dijkstra->create_fence_visgraph(err_id);
+    }
+
+    // fence visibility graph edges as (lower point, higher point, distance)
+    struct Edge {
+        uint8_t p1;
+        uint8_t p2;
+        float distance_cm;
+        bool operator <(const Edge &e) const { return (p1 < e.p1) || ((p1 == e.p1) && (p2 < e.p2)); }
+    };
+    std::vector<Edge> fence_visgraph_edges() const
+    {
+        std::vector<Edge> edges;
+        for (uint16_t i = 0; i < dijkstra->_fence_visgraph.num_items(); i++) {
+            const AP_OAVisGraph::VisGraphItem &item = dijkstra->_fence_visgraph[i];
+            edges.push_back({MIN(item.id1.id_num, item.id2.id_num), MAX(item.id1.id_num, item.id2.id_num), item.distance_cm});
+        }
+        std::sort(edges.begin(), edges.end());
+        return edges;
+    }
+
+    // length of the path found by calc_shortest_path
+    bool shortest_path_length(const Vector2f &origin, const Vector2f &destination, float &length_cm)
+    {
+        AP_OADijkstra::AP_OADijkstra_Error err_id;
+        if (!dijkstra->calc_shortest_path(origin, destination, err_id)) {
+            return false;
+        }
+        length_cm = 0;
+        Vector2f prev = origin;
+        for (uint8_t i = 0; i < dijkstra->get_shortest_path_numpoints(); i++) {
+            Vector2f pos;
+            EXPECT_TRUE(dijkstra->get_shortest_path_point(i, pos));
+            length_cm += (pos - prev).length();
+            prev = pos;
+        }
+        EXPECT_EQ(prev, destination);
+        return true;
+    }
+
+    /*
+      length of the shortest path found by the linear scan for the
+      closest node and the whole graph scan for its neighbours which
+      the heap replaced, over the graphs built by the last
+      calc_shortest_path
+     */
+    bool shortest_path_length_linear(float &length_cm) const
+    {
+        const AP_OADijkstra &d = *dijkstra;
+        const uint16_t num_nodes = 2 + d.total_numpoints();
+
+        // node 0 is the source, 1 the destination and the fence points follow
+        auto node = [](const AP_OAVisGraph::OAItemID &id) -> uint16_t {
+            switch (id.id_type) {
+            case AP_OAVisGraph::OATYPE_SOURCE:
+                return 0;
+            case AP_OAVisGraph::OATYPE_DESTINATION:
+                return 1;
+            case AP_OAVisGraph::OATYPE_INTERMEDIATE_POINT:
+                break;
+            }
+            return id.id_num + 2;
+        };
+        auto position = [&](uint16_t n) -> Vector2f {
+            Vector2f pos = (n == 0) ? d._path_source : d._path_destination;
+            if (n >= 2) {
+                d.get_point(n - 2, pos);
+            }
+            return pos;
+        };
+
+        std::vector<float> distance(num_nodes, FLT_MAX);
+        std::vector<bool> visited(num_nodes, false);
+        distance[0] = 0;
+        visited[0] = true;
+        for (uint16_t i = 0; i < d._source_visgraph.num_items(); i++) {
+            distance[node(d._source_visgraph[i].id2)] = d._source_visgraph[i].distance_cm;
+        }
+
+        while (true) {
+            uint16_t current = 0;
+            float lowest = FLT_MAX;
+            for (uint16_t n = 0; n < num_nodes; n++) {
+                if (visited[n] || is_equal(distance[n], FLT_MAX)) {
+                    continue;
+                }
+                const float dist_with_heuristics = distance[n] + (position(n) - d._path_destination).length();
+                if (dist_with_heuristics < lowest) {
+                    current = n;
+                    lowest = dist_with_heuristics;
+                }
+            }
+            if ((lowest == FLT_MAX) || (current == 1)) {
+                break;
+            }
+            const AP_OAVisGraph *visgraphs[] = {&d._fence_visgraph, &d._destination_visgraph};
+            for (const AP_OAVisGraph *visgraph : visgraphs) {
+                for (uint16_t i = 0; i < visgraph->num_items(); i++) {
+                    const AP_OAVisGraph::VisGraphItem &item = (*visgraph)[i];
+                    uint16_t other;
+                    if (node(item.id1) == current) {
+                        other = node(item.id2);
+                    } else if (node(item.id2) == current) {
+                        other = node(item.id1);
+                    } else {
+                        continue;
+                    }
+                    distance[other] = MIN(distance[other], distance[current] + item.distance_cm);
+                }
+            }
+            visited[current] = true;
+        }
+
+        length_cm = distance[1];
+        return distance[1] < FLT_MAX;
+    }
+};
+
+// the index finds the same crossings as testing every edge
+TEST(AP_OADijkstra, intersects_fence)
+{
+    for (uint8_t n = 1; n <= 20; n++) {
+        AP_OADijkstra_Test t;
+        t.random_fence((n % 2) ? 24 + n * 5 : 150 + n * 4);
+        t.fence_updated();
+        for (uint16_t i = 0; i < 2000; i++) {
+            // mostly short segments, as used by the visibility graphs
+            const Vector2f start = t.random_point(AP_OADijkstra_Test::inclusion_radius_cm * 1.1f);
+            const Vector2f end = (i % 4) ? start + t.random_point(20000) : t.random_point(AP_OADijkstra_Test::inclusion_radius_cm * 1.1f);
+            EXPECT_EQ(t.intersects_fence_unindexed(start, end), t.intersects_fence(start, end));
+        }
+    }
+}
+
+// updating the fence visibility graph in place gives the same edges as building it again
+TEST(AP_OADijkstra, incremental_visgraph)
+{
+    for (uint8_t n = 1; n <= 20; n++) {
+        AP_OADijkstra_Test t;
+        t.random_fence(16 + n * 4);
+        t.fence_updated();
+        ASSERT_TRUE(t.create_fence_visgraph(false));
+
+        for (uint8_t change = 0; change < 10; change++) {
+            switch (get_random16() % 6) {
+            case 0:
+                // move or reshape an exclusion polygon
+                t.random_exclusion_polygon(get_random16() % t.num_exclusion_polygons);
+                break;
+            case 1:
+                // add or remove an exclusion polygon
+                if (t.num_exclusion_polygons < AP_OADijkstra_Test::max_exclusion_polygons) {
+                    t.random_exclusion_polygon(t.num_exclusion_polygons++);
+                } else {
+                    t.num_exclusion_polygons--;
+                }
+                break;
+            case 2:
+                // add, remove or move a circle
+                if (t.num_exclusion_circles == 0) {
+                    t.random_exclusion_circle(t.num_exclusion_circles++);
+                } else if (t.num_exclusion_circles == AP_OADijkstra_Test::max_exclusion_circles) {
+                    t.num_exclusion_circles--;
+                } else {
+                    t.random_exclusion_circle(0);
+                }
+                break;
+            case 3:
+                // move one inclusion point
+                t.inclusion[get_random16() % t.inclusion.size()] *= 0.97f;
+                break;
+            case 4:
+                // add, remove or move an inclusion circle
+                if (t.num_inclusion_circles == 0) {
+                    t.random_inclusion_circle(t.num_inclusion_circles++);
+                } else if (t.num_inclusion_circles == AP_OADijkstra_Test::max_inclusion_circles) {
+                    t.num_inclusion_circles--;
+                } else {
+                    t.random_inclusion_circle(0);
+                }
+                break;
+            default:
+                // nothing changed
+                break;
+            }
+            t.fence_updated();
+            ASSERT_TRUE(t.create_fence_visgraph(true));
+            const auto incremental = t.fence_visgraph_edges();
+            ASSERT_TRUE(t.create_fence_visgraph(false));
+            const auto rebuilt = t.fence_visgraph_edges();
+
+            ASSERT_EQ(incremental.size(), rebuilt.size());
+            for (uint16_t i = 0; i < rebuilt.size(); i++) {
+                EXPECT_EQ(incremental[i].p1, rebuilt[i].p1);
+                EXPECT_EQ(incremental[i].p2, rebuilt[i].p2);
+                EXPECT_FLOAT_EQ(incremental[i].distance_cm, rebuilt[i].distance_cm);
+            }
+        }
+    }
+}
+
+// the heap based search finds paths as short as the linear scan it replaced
+TEST(AP_OADijkstra, shortest_path)
+{
+    for (uint8_t n = 1; n <= 20; n++) {
+        AP_OADijkstra_Test t;
+        t.random_fence(16 + n * 4);
+        t.fence_updated();
+        ASSERT_TRUE(t.create_fence_visgraph(false));
+
+        for (uint8_t i = 0; i < 50; i++) {
+            const Vector2f origin = t.random_point(AP_OADijkstra_Test::inclusion_radius_cm * 0.7f);
+            const Vector2f destination = t.random_point(AP_OADijkstra_Test::inclusion_radius_cm * 0.7f);
+            float length_cm = 0;
+            const bool found = t.shortest_path_length(origin, destination, length_cm);
+            float linear_length_cm = 0;
+            EXPECT_EQ(t.shortest_path_length_linear(linear_length_cm), found);
+            if (found) {
+                EXPECT_NEAR(length_cm, linear_length_cm, 1.0f + linear_length_cm * 1e-5f);
+            }
+        }
+    }
+}
+
+#endif // AP_OAPATHPLANNER_DIJKSTRA_ENABLED && AP_FENCE_ENABLED
+
+AP_GTEST_MAIN()
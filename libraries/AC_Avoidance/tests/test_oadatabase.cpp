@@ -0,0 +1,193 @@
+/*
+  check the object database's grid index against the linear searches
+  it replaced, over randomly generated objects
+ */
+#include <AP_gtest.h>
+
+#include <AC_Avoidance/AP_OADatabase.h>
+
+#include <vector>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+#if AP_OADATABASE_ENABLED
+
+class AP_OADatabase_Test {
+public:
+    static const uint16_t queue_size = 100;
+    static const uint16_t expiry_seconds = 10;
+
+    AP_OADatabase *db;
+
+    // database contents as kept by the linear search
+    std::vector<AP_OADatabase::OA_DbItem> items;
+
+    AP_OADatabase_Test(uint16_t size)
+    {
+        db = NEW_NOTHROW AP_OADatabase();
+        db->_database_size_param.set(size);
+        db->_queue_size_param.set(queue_size);
+        db->_database_expiry_seconds.set(expiry_seconds);
+        db->init();
+    }
+
+    ~AP_OADatabase_Test()
+    {
+        delete db->_queue.items;
+        delete[] db->_database.items;
+        delete[] db->_grid.head;
+        delete[] db->_grid.next;
+        delete db;
+        AP_OADatabase::_singleton = nullptr;
+    }
+
+    CLASS_NO_COPY(AP_OADatabase_Test);
+
+    static float random_float(float min, float max)
+    {
+        return linear_interpolate(min, max, get_random16(), 0, 0xFFFF);
+    }
+
+    // new or old objects, so none are close to expiring when the database is checked
+    uint32_t random_timestamp_ms()
+    {
+        const float age_s = (random_float(0, 1) < 0.8f) ? random_float(0, expiry_seconds * 0.5f) : random_float(expiry_seconds * 1.5f, expiry_seconds * 2);
+        return AP_HAL::millis() - uint32_t(age_s * 1000);
+    }
+
+    // push an object into the database, and into the linear search's copy as it did before the grid index
+    void push(const AP_OADatabase::OA_DbItem &item)
+    {
+        db->queue_push(item.pos, item.timestamp_ms, item.pos.length(), item.radius, item.source, item.id);
+        while (db->process_queue()) {
+        }
+
+        AP_OADatabase::OA_DbItem new_item = item;
+        new_item.radius = MAX(db->_radius_min, new_item.radius);
+        bool found = false;
+        for (auto &ref_item : items) {
+            if (db->item_match(ref_item, new_item)) {
+                db->database_item_refresh(ref_item, new_item);
+                found = true;
+                break;
+            }
+        }
+        if (!found && (items.size() < db->_database.size)) {
+            items.push_back(new_item);
+        }
+    }
+
+    // lidar readings from around a position, with some large and some AIS objects
+    void push_random(const Vector3f &center, float spread)
+    {
+        AP_OADatabase::OA_DbItem item {};
+        item.pos = center + Vector3f(random_float(-spread, spread), random_float(-spread, spread), random_float(-2, 2));
+        item.timestamp_ms = random_timestamp_ms();
+        const float r = random_float(0, 1);
+        if (r < 0.05f) {
+            item.source = AP_OADatabase::OA_DbItem::Source::AIS;
+            item.id = get_random16() % 20;
+            item.radius = random_float(1, 50);
+        } else if (r < 0.1f) {
+            item.source = AP_OADatabase::OA_DbItem::Source::proximity;
+            item.radius = random_float(8, 30);
+        } else if (r < 0.3f) {
+            item.source = AP_OADatabase::OA_DbItem::Source::proximity;
+            item.radius = random_float(2, 8);
+        } else {
+            item.source = AP_OADatabase::OA_DbItem::Source::proximity;
+            item.radius = random_float(0, 2);
+        }
+        push(item);
+    }
+
+    // remove expired objects, from the linear search's copy as it did before the grid index
+    void remove_expired()
+    {
+        db->database_items_remove_all_expired();
+
+        const uint32_t now_ms = AP_HAL::millis();
+        for (uint16_t i = 0; i < items.size();) {
+            if (now_ms - items[i].timestamp_ms > expiry_seconds * 1000U) {
+                items[i] = items.back();
+                items.pop_back();
+            } else {
+                i++;
+            }
+        }
+    }
+
+    // margin as BendyRuler calculated it before the grid index
+    float margin_unindexed(const Vector3f &start, const Vector3f &end) const
+    {
+        float smallest_margin = FLT_MAX;
+        for (const auto &item : items) {
+            const float m = Vector3f::closest_distance_between_line_and_point(start, end, item.pos) - item.radius;
+            smallest_margin = MIN(smallest_margin, m);
+        }
+        return smallest_margin;
+    }
+
+    void check_database() const
+    {
+        ASSERT_EQ(db->database_count(), items.size());
+        for (uint16_t i = 0; i < items.size(); i++) {
+            const AP_OADatabase::OA_DbItem &item = db->get_item(i);
+            EXPECT_EQ(item.pos, items[i].pos);
+            EXPECT_EQ(item.radius, items[i].radius);
+            EXPECT_EQ(item.timestamp_ms, items[i].timestamp_ms);
+            EXPECT_EQ(item.source, items[i].source);
+        }
+    }
+};
+
+// objects are matched, added and removed as they were by the linear search
+TEST(AP_OADatabase, database)
+{
+    const uint16_t sizes[] { 20, 100, 500, 1500 };
+    for (const uint16_t size : sizes) {
+        AP_OADatabase_Test t(size);
+        for (uint16_t scan = 0; scan < 30; scan++) {
+            const Vector3f center(t.random_float(-50, 50), t.random_float(-50, 50), 0);
+            for (uint16_t i = 0; i < 180; i++) {
+                t.push_random(center, 30);
+            }
+            t.check_database();
+            t.remove_expired();
+            t.check_database();
+        }
+    }
+}
+
+// margins are the same as found by checking every object
+TEST(AP_OADatabase, margin)
+{
+    const uint16_t sizes[] { 20, 100, 500, 1500 };
+    for (const uint16_t size : sizes) {
+        AP_OADatabase_Test t(size);
+        for (uint16_t scan = 0; scan < 10; scan++) {
+            const Vector3f center(t.random_float(-50, 50), t.random_float(-50, 50), 0);
+            for (uint16_t i = 0; i < 180; i++) {
+                t.push_random(center, 30);
+            }
+            t.remove_expired();
+
+            for (uint16_t i = 0; i < 200; i++) {
+                // segments of all lengths, including ones which are a point
+                const Vector3f start(t.random_float(-100, 100), t.random_float(-100, 100), 0);
+                const float length = (i % 10 == 0) ? 0 : t.random_float(0, (i % 3 == 0) ? 200 : 15);
+                const float angle = t.random_float(0, M_2PI);
+                const Vector3f end = start + Vector3f(cosf(angle), sinf(angle), 0) * length;
+                float margin;
+                ASSERT_EQ(t.db->calc_margin_from_segment(start, end, margin), !t.items.empty());
+                if (!t.items.empty()) {
+                    EXPECT_FLOAT_EQ(margin, t.margin_unindexed(start, end));
+                }
+            }
+        }
+    }
+}
+
+#endif // AP_OADATABASE_ENABLED
+
+AP_GTEST_MAIN()
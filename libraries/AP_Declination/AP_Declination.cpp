@@ -29,6 +29,82 @@
 #include <AP_Common/AP_Common.h>
 #include <AP_Math/AP_Math.h>
 
+AP_Declination::Tile AP_Declination::cache[CACHE_TILES];
+uint8_t AP_Declination::cache_last_used;
+HAL_Semaphore AP_Declination::sem;
+
+// number of tiles in each row of tiles
+uint16_t AP_Declination::num_lon_tiles()
+{
+    return (LON_TABLE_SIZE - 2) / TILE_CELLS + 1;
+}
+
+/*
+  read a zigzag encoded varint residual
+ */
+static int32_t decode_residual(const uint8_t *&p)
+{
+    uint32_t u = 0;
+    uint8_t shift = 0;
+    uint8_t b;
+    do {
+        b = *p++;
+        u |= uint32_t(b & 0x7F) << shift;
+        shift += 7;
+    } while (b & 0x80);
+    return int32_t(u >> 1) ^ -int32_t(u & 1);
+}
+
+/*
+  decode all fields of a tile
+ */
+void AP_Declination::decode_tile(uint16_t index, Tile &tile)
+{
+    const uint16_t tile_lat = index / num_lon_tiles();
+    const uint16_t tile_lon = index % num_lon_tiles();
+    const uint8_t rows = MIN(TILE_CELLS, LAT_TABLE_SIZE - 1 - tile_lat * TILE_CELLS) + 1;
+    const uint8_t cols = MIN(TILE_CELLS, LON_TABLE_SIZE - 1 - tile_lon * TILE_CELLS) + 1;
+
+    const uint8_t *p = &tile_data[tile_offsets[index]];
+    int32_t q[TILE_CELLS+1][TILE_CELLS+1];
+    for (uint8_t f = 0; f < NUM_FIELDS; f++) {
+        for (uint8_t i = 0; i < rows; i++) {
+            for (uint8_t j = 0; j < cols; j++) {
+                int32_t prediction;
+                if (i == 0) {
+                    prediction = j == 0 ? 0 : q[i][j-1];
+                } else if (j == 0) {
+                    prediction = q[i-1][j];
+                } else {
+                    prediction = q[i][j-1] + q[i-1][j] - q[i-1][j-1];
+                }
+                q[i][j] = prediction + decode_residual(p);
+                tile.value[f][i][j] = q[i][j] * field_scale[f];
+            }
+        }
+    }
+    tile.index = index;
+    tile.valid = true;
+}
+
+/*
+  return a decoded tile, replacing the least recently used tile in
+  the cache if needed. Caller must hold sem
+ */
+const AP_Declination::Tile &AP_Declination::get_tile(uint16_t index)
+{
+    for (uint8_t i = 0; i < CACHE_TILES; i++) {
+        if (cache[i].valid && cache[i].index == index) {
+            cache_last_used = i;
+            return cache[i];
+        }
+    }
+    const uint8_t i = (cache_last_used + 1) % CACHE_TILES;
+    decode_tile(index, cache[i]);
+    cache_last_used = i;
+    return cache[i];
+}
+
 /*
   calculate magnetic field intensity and orientation
 */
@@ -70,47 +146,38 @@ bool AP_Declination::get_mag_field_ef(float latitude_deg, float longitude_deg, f
     uint32_t min_lat_index = constrain_int32(static_cast<uint32_t>((-(SAMPLING_MIN_LAT) + min_lat)  / SAMPLING_RES), 0, LAT_TABLE_SIZE - 2);
     uint32_t min_lon_index = constrain_int32(static_cast<uint32_t>((-(SAMPLING_MIN_LON) + min_lon) / SAMPLING_RES), 0, LON_TABLE_SIZE -2);
 
-    /* calculate intensity */
-
-    float data_sw = intensity_table[min_lat_index][min_lon_index];
-    float data_se = intensity_table[min_lat_index][min_lon_index + 1];
-    float data_ne = intensity_table[min_lat_index + 1][min_lon_index + 1];
-    float data_nw = intensity_table[min_lat_index + 1][min_lon_index];
-
-    /* perform bilinear interpolation on the four grid corners */
-
-    float data_min = ((longitude_deg - min_lon) / SAMPLING_RES) * (data_se - data_sw) + data_sw;
-    float data_max = ((longitude_deg - min_lon) / SAMPLING_RES) * (data_ne - data_nw) + data_nw;
-
-    intensity_gauss = ((latitude_deg - min_lat) / SAMPLING_RES) * (data_max - data_min) + data_min;
-
-    /* calculate declination */
-
-    data_sw = declination_table[min_lat_index][min_lon_index];
-    data_se = declination_table[min_lat_index][min_lon_index + 1];
-    data_ne = declination_table[min_lat_index + 1][min_lon_index + 1];
-    data_nw = declination_table[min_lat_index + 1][min_lon_index];
-
-    /* perform bilinear interpolation on the four grid corners */
-
-    data_min = ((longitude_deg - min_lon) / SAMPLING_RES) * (data_se - data_sw) + data_sw;
-    data_max = ((longitude_deg - min_lon) / SAMPLING_RES) * (data_ne - data_nw) + data_nw;
-
-    declination_deg = ((latitude_deg - min_lat) / SAMPLING_RES) * (data_max - data_min) + data_min;
-
-    /* calculate inclination */
-
-    data_sw = inclination_table[min_lat_index][min_lon_index];
-    data_se = inclination_table[min_lat_index][min_lon_index + 1];
-    data_ne = inclination_table[min_lat_index + 1][min_lon_index + 1];
-    data_nw = inclination_table[min_lat_index + 1][min_lon_index];
+    /* find the tile holding the cell and the cell within the tile */
+    const uint16_t tile_lat = min_lat_index / TILE_CELLS;
+    const uint16_t tile_lon = min_lon_index / TILE_CELLS;
+    const uint8_t row = min_lat_index - tile_lat * TILE_CELLS;
+    const uint8_t col = min_lon_index - tile_lon * TILE_CELLS;
+
+    float data_sw[NUM_FIELDS], data_se[NUM_FIELDS], data_ne[NUM_FIELDS], data_nw[NUM_FIELDS];
+    {
+        WITH_SEMAPHORE(sem);
+        const Tile &tile = get_tile(tile_lat * num_lon_tiles() + tile_lon);
+        for (uint8_t f = 0; f < NUM_FIELDS; f++) {
+            data_sw[f] = tile.value[f][row][col];
+            data_se[f] = tile.value[f][row][col + 1];
+            data_ne[f] = tile.value[f][row + 1][col + 1];
+            data_nw[f] = tile.value[f][row + 1][col];
+        }
+    }
 
     /* perform bilinear interpolation on the four grid corners */
 
-    data_min = ((longitude_deg - min_lon) / SAMPLING_RES) * (data_se - data_sw) + data_sw;
-    data_max = ((longitude_deg - min_lon) / SAMPLING_RES) * (data_ne - data_nw) + data_nw;
+    const float lon_frac = (longitude_deg - min_lon) / SAMPLING_RES;
+    const float lat_frac = (latitude_deg - min_lat) / SAMPLING_RES;
+    float field[NUM_FIELDS];
+    for (uint8_t f = 0; f < NUM_FIELDS; f++) {
+        const float data_min = lon_frac * (data_se[f] - data_sw[f]) + data_sw[f];
+        const float data_max = lon_frac * (data_ne[f] - data_nw[f]) + data_nw[f];
+        field[f] = lat_frac * (data_max - data_min) + data_min;
+    }
 
-    inclination_deg = ((latitude_deg - min_lat) / SAMPLING_RES) * (data_max - data_min) + data_min;
+    declination_deg = field[0];
+    inclination_deg = field[1];
+    intensity_gauss = field[2];
 
     return valid_input_data;
 }
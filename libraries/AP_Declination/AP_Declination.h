@@ -1,6 +1,7 @@
 #pragma once
 
 #include <AP_Common/Location.h>
+#include <AP_HAL/Semaphores.h>
 
 /*
   magnetic data derived from WMM
@@ -28,6 +29,12 @@ public:
      */
     static float get_declination(float latitude_deg, float longitude_deg);
     
+    /*
+      the tables are stored in tiles of TILE_CELLS x TILE_CELLS grid
+      cells. generate/generate.py must use the same tile size
+     */
+    static const uint8_t TILE_CELLS = 6;
+
 private:
     static const float SAMPLING_RES;
     static const float SAMPLING_MIN_LAT;
@@ -35,10 +42,36 @@ private:
     static const float SAMPLING_MIN_LON;
     static const float SAMPLING_MAX_LON;
 
-    static const uint32_t LAT_TABLE_SIZE = 19;
-    static const uint32_t LON_TABLE_SIZE = 37;
+    static const uint16_t LAT_TABLE_SIZE;
+    static const uint16_t LON_TABLE_SIZE;
+
+    // declination, inclination and intensity
+    static const uint8_t NUM_FIELDS = 3;
+
+    /*
+      each tile holds the grid points around its cells, so every cell
+      can be interpolated from a single tile. Points are quantised by
+      field_scale[] and stored as the residual from a planar
+      prediction from the points before them, zigzag and varint
+      encoded, one field after another
+     */
+    static const float field_scale[NUM_FIELDS];
+    static const uint16_t tile_offsets[];
+    static const uint8_t tile_data[];
+
+    // decoded tiles around the most recent lookups. Each tile is
+    // 592 bytes, so the cache costs about 1.2kB of static RAM
+    struct Tile {
+        bool valid;
+        uint16_t index;
+        float value[NUM_FIELDS][TILE_CELLS+1][TILE_CELLS+1];
+    };
+    static const uint8_t CACHE_TILES = 2;
+    static Tile cache[CACHE_TILES];
+    static uint8_t cache_last_used;
+    static HAL_Semaphore sem;
 
-    static const float declination_table[LAT_TABLE_SIZE][LON_TABLE_SIZE];
-    static const float inclination_table[LAT_TABLE_SIZE][LON_TABLE_SIZE];
-    static const float intensity_table[LAT_TABLE_SIZE][LON_TABLE_SIZE];
+    static uint16_t num_lon_tiles();
+    static const Tile &get_tile(uint16_t index);
+    static void decode_tile(uint16_t index, Tile &tile);
 };
@@ -0,0 +1,50 @@
+/*
+  benchmarks of field lookups. A vehicle looks up the field close to
+  where it last did, which is served from the decoded tile cache,
+  while lookups scattered over the globe decode a tile each time
+ */
+#include <AP_gbenchmark.h>
+
+#include <AP_Declination/AP_Declination.h>
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+static void BM_DeclinationLocal(benchmark::State& state)
+{
+    float lat = -35.36f;
+    float lon = 149.16f;
+    while (state.KeepRunning()) {
+        float intensity_gauss, declination_deg, inclination_deg;
+        AP_Declination::get_mag_field_ef(lat, lon, intensity_gauss, declination_deg, inclination_deg);
+        gbenchmark_escape(&declination_deg);
+        lat += 1.0e-5f;
+        lon += 1.0e-5f;
+    }
+}
+
+static void BM_DeclinationScattered(benchmark::State& state)
+{
+    while (state.KeepRunning()) {
+        const float lat = -85 + get_random16() % 170;
+        const float lon = -175 + get_random16() % 350;
+        float intensity_gauss, declination_deg, inclination_deg;
+        AP_Declination::get_mag_field_ef(lat, lon, intensity_gauss, declination_deg, inclination_deg);
+        gbenchmark_escape(&declination_deg);
+    }
+}
+
+static void BM_DeclinationEarthField(benchmark::State& state)
+{
+    const Location loc(-353600000, 1491600000, 0, Location::AltFrame::ABSOLUTE);
+    while (state.KeepRunning()) {
+        Vector3f field = AP_Declination::get_earth_field_ga(loc);
+        gbenchmark_escape(&field);
+    }
+}
+
+BENCHMARK(BM_DeclinationLocal);
+BENCHMARK(BM_DeclinationScattered);
+BENCHMARK(BM_DeclinationEarthField);
+
+BENCHMARK_MAIN();
@@ -15,6 +15,7 @@ import math
 import argparse
 parser = argparse.ArgumentParser(description='generate mag tables')
 parser.add_argument('--sampling-res', type=int, default=10, help='sampling resolution, degrees')
+parser.add_argument('--tile-cells', type=int, default=6, help='grid cells per tile side, must match AP_Declination::TILE_CELLS')
 parser.add_argument('--check-error', action='store_true', help='check max error')
 parser.add_argument('--filename', type=str, default='tables.cpp', help='tables file')
 
@@ -24,25 +25,66 @@ if not Path("AP_Declination.h").is_file():
     raise OSError("Please run this tool from the AP_Declination directory")
 
 
-def write_table(f,name, table):
-    '''write one table'''
-    f.write("__EXTFLASHFUNC__ const float AP_Declination::%s[%u][%u] = {\n" %
-                (name, NUM_LAT, NUM_LON))
-    for i in range(NUM_LAT):
-        f.write("    {")
-        for j in range(NUM_LON):
-            f.write("%.5ff" % table[i][j])
-            if j != NUM_LON-1:
-                f.write(",")
-        f.write("}")
-        if i != NUM_LAT-1:
-            f.write(",")
-        f.write("\n")
+# quantisation of declination_deg, inclination_deg and intensity_gauss
+FIELD_SCALE = [0.001, 0.001, 1.0e-6]
+
+def quantise(table, scale):
+    '''quantise a table to integer multiples of scale'''
+    return [[int(round(table[i][j] / scale)) for j in range(NUM_LON)] for i in range(NUM_LAT)]
+
+def write_varint(out, v):
+    '''append v zigzag and varint encoded'''
+    u = (v << 1) if v >= 0 else ((-v << 1) - 1)
+    while u >= 0x80:
+        out.append((u & 0x7F) | 0x80)
+        u >>= 7
+    out.append(u)
+
+def encode_tile(qtables, lat0, lon0):
+    '''encode the grid points of the tile starting at lat0, lon0 as
+    residuals from a planar prediction from the points before them'''
+    out = bytearray()
+    rows = min(TILE_CELLS, NUM_LAT - 1 - lat0) + 1
+    cols = min(TILE_CELLS, NUM_LON - 1 - lon0) + 1
+    for q in qtables:
+        for i in range(lat0, lat0+rows):
+            for j in range(lon0, lon0+cols):
+                if i == lat0:
+                    p = 0 if j == lon0 else q[i][j-1]
+                elif j == lon0:
+                    p = q[i-1][j]
+                else:
+                    p = q[i][j-1] + q[i-1][j] - q[i-1][j-1]
+                write_varint(out, q[i][j] - p)
+    return out
+
+def write_tiles(f, tables):
+    '''write the tables as tiles of TILE_CELLS x TILE_CELLS cells'''
+    qtables = [quantise(t, s) for t, s in zip(tables, FIELD_SCALE)]
+    offsets = []
+    data = bytearray()
+    for lat0 in range(0, NUM_LAT-1, TILE_CELLS):
+        for lon0 in range(0, NUM_LON-1, TILE_CELLS):
+            offsets.append(len(data))
+            data += encode_tile(qtables, lat0, lon0)
+    if offsets[-1] > 0xFFFF:
+        raise ValueError("tile data too large for 16 bit offsets")
+
+    f.write("const float AP_Declination::field_scale[NUM_FIELDS] = {%s};\n\n" %
+            ",".join("%gf" % s for s in FIELD_SCALE))
+    f.write("__EXTFLASHFUNC__ const uint16_t AP_Declination::tile_offsets[%u] = {\n" % len(offsets))
+    for i in range(0, len(offsets), 16):
+        f.write("    %s,\n" % ",".join("%u" % o for o in offsets[i:i+16]))
     f.write("};\n\n")
+    f.write("__EXTFLASHFUNC__ const uint8_t AP_Declination::tile_data[%u] = {\n" % len(data))
+    for i in range(0, len(data), 16):
+        f.write("    %s,\n" % ",".join("0x%02x" % b for b in data[i:i+16]))
+    f.write("};\n")
 
 date = datetime.datetime.now()
 
 SAMPLING_RES = args.sampling_res
+TILE_CELLS = args.tile_cells
 SAMPLING_MIN_LAT = -90
 SAMPLING_MAX_LAT = 90
 SAMPLING_MIN_LON = -180
@@ -158,6 +200,11 @@ for i,lat in enumerate(lats):
         inclination_table[i][j] = mag[1]
         intensity_table[i][j] = mag[2]
 
+# check errors against the quantised values we store
+declination_table = np.round(declination_table / FIELD_SCALE[0]) * FIELD_SCALE[0]
+inclination_table = np.round(inclination_table / FIELD_SCALE[1]) * FIELD_SCALE[1]
+intensity_table = np.round(intensity_table / FIELD_SCALE[2]) * FIELD_SCALE[2]
+
 with open(args.filename, 'w') as f:
     f.write('''// this is an auto-generated file from the IGRF tables. Do not edit
 // To re-generate run generate/generate.py
@@ -172,16 +219,21 @@ const float AP_Declination::SAMPLING_MAX_LAT = %u;
 const float AP_Declination::SAMPLING_MIN_LON = %u;
 const float AP_Declination::SAMPLING_MAX_LON = %u;
 
+const uint16_t AP_Declination::LAT_TABLE_SIZE = %u;
+const uint16_t AP_Declination::LON_TABLE_SIZE = %u;
+
+static_assert(AP_Declination::TILE_CELLS == %u, "tables generated for a different tile size");
+
 ''' % (SAMPLING_RES,
            SAMPLING_MIN_LAT,
            SAMPLING_MAX_LAT,
            SAMPLING_MIN_LON,
-           SAMPLING_MAX_LON))
-
+           SAMPLING_MAX_LON,
+           NUM_LAT,
+           NUM_LON,
+           TILE_CELLS))
 
-    write_table(f,'declination_table', declination_table)
-    write_table(f,'inclination_table', inclination_table)
-    write_table(f,'intensity_table', intensity_table)
+    write_tiles(f, [declination_table, inclination_table, intensity_table])
 
 if args.check_error:
     print("Checking for maximum error")
@@ -9,69 +9,362 @@ const float AP_Declination::SAMPLING_MAX_LAT = 90;
 const float AP_Declination::SAMPLING_MIN_LON = -180;
 const float AP_Declination::SAMPLING_MAX_LON = 180;
 
-__EXTFLASHFUNC__ const float AP_Declination::declination_table[LAT_TABLE_SIZE][LON_TABLE_SIZE] = {
-    {148.83402f,138.83401f,128.83401f,118.83402f,108.83402f,98.83402f,88.83402f,78.83402f,68.83402f,58.83402f,48.83402f,38.83402f,28.83402f,18.83402f,8.83402f,-1.16598f,-11.16598f,-21.16598f,-31.16598f,-41.16598f,-51.16598f,-61.16598f,-71.16598f,-81.16598f,-91.16598f,-101.16598f,-111.16598f,-121.16598f,-131.16598f,-141.16598f,-151.16598f,-161.16598f,-171.16598f,178.83402f,168.83402f,158.83402f,148.83402f},
-    {129.09306f,116.89412f,105.78898f,95.63017f,86.23504f,77.42476f,69.04348f,60.96591f,53.09841f,45.37592f,37.75568f,30.20867f,22.70998f,15.23027f,7.73037f,0.16098f,-7.53238f,-15.40109f,-23.48496f,-31.80703f,-40.37375f,-49.18062f,-58.22152f,-67.49946f,-77.03640f,-86.88079f,-97.11212f,-107.84156f,-119.20626f,-131.35191f,-144.39481f,-158.35719f,-173.08769f,171.78274f,156.78187f,142.43310f,129.09306f},
-    {85.81367f,77.83602f,71.40003f,65.88433f,60.88263f,56.08204f,51.22755f,46.12774f,40.67419f,34.85457f,28.74909f,22.50583f,16.29363f,10.23812f,4.36029f,-1.45095f,-7.40778f,-13.74178f,-20.61213f,-28.04922f,-35.95530f,-44.15322f,-52.45486f,-60.71951f,-68.88732f,-76.99183f,-85.16746f,-93.67473f,-102.97950f,-113.96429f,-128.46293f,-150.36073f,175.55488f,138.00554f,112.28051f,96.48319f,85.81367f},
-    {48.22805f,46.81921f,45.24300f,43.71189f,42.27245f,40.80022f,39.00177f,36.49549f,32.95972f,28.26545f,22.54379f,16.18846f,9.77818f,3.88971f,-1.16066f,-5.50500f,-9.68832f,-14.40052f,-20.13990f,-26.99385f,-34.63319f,-42.50584f,-50.08478f,-57.00760f,-63.07978f,-68.20773f,-72.30336f,-75.14845f,-76.14220f,-73.56875f,-61.46573f,-19.66028f,28.39616f,43.98783f,48.35027f,49.03265f,48.22805f},
-    {31.42931f,31.60530f,31.28145f,30.79047f,30.38024f,30.16777f,29.97487f,29.25597f,27.27948f,23.46202f,17.66378f,10.37176f,2.68673f,-4.06559f,-9.01317f,-12.19989f,-14.47861f,-17.04830f,-21.00672f,-26.83158f,-33.98769f,-41.32654f,-47.85214f,-52.97945f,-56.36644f,-57.72068f,-56.62201f,-52.29959f,-43.64045f,-30.08348f,-13.41611f,2.35315f,14.41455f,22.53506f,27.54777f,30.28028f,31.42931f},
-    {22.67985f,23.21169f,23.25494f,22.99742f,22.63545f,22.42369f,22.46877f,22.43187f,21.42571f,18.33186f,12.46440f,4.21692f,-4.75068f,-12.30560f,-17.22721f,-19.74039f,-20.77499f,-21.16946f,-22.14607f,-25.39336f,-31.01102f,-37.19196f,-42.26227f,-45.34969f,-45.95366f,-43.77299f,-38.67388f,-30.72261f,-20.87969f,-11.16390f,-2.84711f,4.17466f,10.15622f,15.07307f,18.83144f,21.33469f,22.67985f},
-    {17.07334f,17.59062f,17.77934f,17.69577f,17.34929f,16.88674f,16.56217f,16.38656f,15.63204f,12.86517f,6.93562f,-1.75751f,-10.98436f,-18.20308f,-22.41588f,-24.27993f,-24.67590f,-23.50719f,-21.00605f,-19.72369f,-21.87960f,-26.21214f,-30.23195f,-32.25069f,-31.49417f,-28.07385f,-22.58093f,-15.67611f,-8.73630f,-3.38117f,0.43868f,3.90117f,7.49078f,10.92679f,13.85484f,15.93237f,17.07334f},
-    {13.37426f,13.67217f,13.78744f,13.78998f,13.54222f,12.98780f,12.38852f,11.96065f,11.09372f,8.25499f,2.21162f,-6.34723f,-14.82596f,-20.89032f,-23.89434f,-24.45752f,-23.26867f,-20.14461f,-15.21492f,-10.62227f,-9.09952f,-11.18829f,-14.91638f,-17.58833f,-17.75073f,-15.65321f,-12.03643f,-7.38772f,-2.92537f,-0.15156f,1.30857f,3.04660f,5.56513f,8.30463f,10.76538f,12.51642f,13.37426f},
-    {11.10969f,11.11944f,11.01236f,10.99728f,10.84097f,10.32286f,9.70494f,9.19687f,8.09157f,4.94277f,-1.12864f,-9.05484f,-16.32980f,-21.04376f,-22.55109f,-21.19496f,-17.89373f,-13.44411f,-8.58084f,-4.24867f,-1.62827f,-1.86509f,-4.55045f,-7.42469f,-8.64775f,-8.12536f,-6.32716f,-3.48850f,-0.64489f,0.72027f,0.97976f,1.90952f,4.01623f,6.51266f,8.80749f,10.44185f,11.10969f},
-    {9.88349f,9.72040f,9.41289f,9.38439f,9.33291f,8.89921f,8.31537f,7.68011f,6.17272f,2.60695f,-3.33977f,-10.37899f,-16.38823f,-19.72660f,-19.70115f,-16.80477f,-12.41185f,-7.91607f,-4.15177f,-1.10381f,1.22204f,1.82879f,0.23517f,-2.13784f,-3.62813f,-3.94630f,-3.34494f,-1.85961f,-0.22644f,0.26762f,-0.08803f,0.44077f,2.38763f,4.89878f,7.32401f,9.15291f,9.88349f},
-    {9.12464f,9.18177f,8.94457f,9.04553f,9.19618f,8.89744f,8.21223f,7.14260f,4.96349f,0.86055f,-4.97931f,-11.14357f,-15.85640f,-17.78532f,-16.57645f,-13.08478f,-8.67898f,-4.59243f,-1.60427f,0.55144f,2.39028f,3.23916f,2.31654f,0.46434f,-0.91732f,-1.53003f,-1.62589f,-1.18564f,-0.62403f,-0.86624f,-1.66562f,-1.50145f,0.21812f,2.79294f,5.56329f,7.91823f,9.12464f},
-    {8.06290f,8.93172f,9.29767f,9.81684f,10.30693f,10.20311f,9.30721f,7.53634f,4.41412f,-0.45099f,-6.41113f,-11.85029f,-15.25565f,-15.88209f,-13.96742f,-10.49677f,-6.46933f,-2.75504f,-0.08743f,1.66921f,3.12874f,3.96903f,3.45981f,2.05876f,0.88578f,0.20951f,-0.29117f,-0.68669f,-1.18101f,-2.27487f,-3.63054f,-3.95562f,-2.62221f,-0.08793f,3.01927f,6.01454f,8.06290f},
-    {6.31041f,8.41617f,9.93058f,11.21483f,12.13996f,12.23034f,11.14011f,8.66524f,4.49928f,-1.34733f,-7.71989f,-12.71272f,-15.08305f,-14.75641f,-12.45343f,-9.09705f,-5.35725f,-1.83470f,0.82823f,2.57001f,3.86519f,4.69588f,4.60243f,3.76104f,2.87601f,2.13967f,1.24833f,0.02788f,-1.62859f,-3.80231f,-5.90990f,-6.79346f,-5.87079f,-3.45535f,-0.15720f,3.34006f,6.31041f},
-    {4.26294f,7.59975f,10.43666f,12.70491f,14.16020f,14.43398f,13.18770f,10.10768f,4.90586f,-2.08386f,-9.15208f,-14.09196f,-15.93051f,-15.08268f,-12.51517f,-9.09089f,-5.35759f,-1.77919f,1.14514f,3.24292f,4.77489f,5.90082f,6.46683f,6.42854f,5.95440f,5.04613f,3.49019f,1.14215f,-1.96091f,-5.46021f,-8.43365f,-9.79880f,-9.13330f,-6.77311f,-3.34752f,0.50970f,4.26294f},
-    {2.57464f,6.81988f,10.72127f,13.95370f,16.10049f,16.72460f,15.39548f,11.64478f,5.15172f,-3.36781f,-11.49173f,-16.72206f,-18.40831f,-17.31430f,-14.50140f,-10.79977f,-6.74992f,-2.76545f,0.78143f,3.70100f,6.08013f,8.07892f,9.67963f,10.67456f,10.77058f,9.65347f,7.07600f,3.02043f,-2.09809f,-7.27683f,-11.16806f,-12.81861f,-12.13043f,-9.62141f,-5.97603f,-1.77704f,2.57464f},
-    {1.43503f,6.27921f,10.88019f,14.88261f,17.80063f,19.02158f,17.77297f,13.12636f,4.53718f,-6.54055f,-16.27050f,-21.85552f,-23.31365f,-21.85455f,-18.61101f,-14.36797f,-9.64057f,-4.79964f,-0.13239f,4.18385f,8.10605f,11.64519f,14.70734f,16.97990f,17.92977f,16.88820f,13.23164f,6.81146f,-1.34665f,-8.97876f,-14.01257f,-15.81005f,-14.85926f,-12.00033f,-7.99733f,-3.40265f,1.43502f},
-    {0.13094f,5.45479f,10.54962f,15.08235f,18.55436f,20.17754f,18.67574f,12.20150f,-0.36226f,-15.49225f,-26.46004f,-31.19380f,-31.33251f,-28.66356f,-24.33699f,-19.03627f,-13.18344f,-7.06335f,-0.88475f,5.19490f,11.05071f,16.55252f,21.50321f,25.56424f,28.16988f,28.41286f,24.95220f,16.43585f,3.63861f,-8.67079f,-16.18909f,-18.69045f,-17.68753f,-14.54612f,-10.18137f,-5.16795f,0.13094f},
-    {-4.14830f,1.12345f,5.96040f,9.84415f,11.94596f,10.80871f,4.02869f,-10.36405f,-27.94912f,-39.79617f,-44.16477f,-43.57950f,-40.12657f,-34.99189f,-28.83083f,-22.02403f,-14.80922f,-7.34799f,0.23881f,7.85050f,15.39197f,22.75942f,29.82156f,36.38924f,42.15868f,46.59144f,48.63821f,46.09967f,34.72041f,12.13936f,-8.98865f,-18.65098f,-20.47841f,-18.40133f,-14.39834f,-9.45818f,-4.14830f},
-    {-169.79948f,-159.79948f,-149.79948f,-139.79948f,-129.79948f,-119.79948f,-109.79948f,-99.79948f,-89.79948f,-79.79948f,-69.79948f,-59.79948f,-49.79948f,-39.79948f,-29.79948f,-19.79948f,-9.79948f,0.20052f,10.20052f,20.20052f,30.20052f,40.20052f,50.20052f,60.20052f,70.20052f,80.20052f,90.20052f,100.20052f,110.20052f,120.20052f,130.20052f,140.20052f,150.20052f,160.20052f,170.20052f,-179.79948f,-169.79948f}
-};
+const uint16_t AP_Declination::LAT_TABLE_SIZE = 19;
+const uint16_t AP_Declination::LON_TABLE_SIZE = 37;
 
-__EXTFLASHFUNC__ const float AP_Declination::inclination_table[LAT_TABLE_SIZE][LON_TABLE_SIZE] = {
-    {-72.02070f,-72.02071f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02071f,-72.02070f,-72.02071f},
-    {-78.23208f,-77.46612f,-76.54604f,-75.51344f,-74.40408f,-73.25043f,-72.08420f,-70.93779f,-69.84384f,-68.83332f,-67.93241f,-67.15960f,-66.52407f,-66.02648f,-65.66205f,-65.42519f,-65.31392f,-65.33255f,-65.49161f,-65.80511f,-66.28626f,-66.94289f,-67.77395f,-68.76776f,-69.90201f,-71.14489f,-72.45664f,-73.79090f,-75.09549f,-76.31306f,-77.38240f,-78.24183f,-78.83644f,-79.12876f,-79.10879f,-78.79618f,-78.23208f},
-    {-80.80007f,-78.97830f,-77.14756f,-75.29021f,-73.38193f,-71.40769f,-69.37743f,-67.33857f,-65.37896f,-63.61481f,-62.16302f,-61.10460f,-60.45316f,-60.14557f,-60.06470f,-60.08698f,-60.13217f,-60.19219f,-60.32958f,-60.65151f,-61.27183f,-62.27481f,-63.69257f,-65.50302f,-67.64474f,-70.03800f,-72.60073f,-75.25455f,-77.92173f,-80.51496f,-82.91263f,-84.88736f,-85.95658f,-85.63251f,-84.30522f,-82.60297f,-80.80007f},
-    {-77.45516f,-75.43606f,-73.49604f,-71.57699f,-69.59653f,-67.45749f,-65.08505f,-62.48902f,-59.81600f,-57.35291f,-55.46368f,-54.46054f,-54.44855f,-55.23685f,-56.40404f,-57.49090f,-58.18917f,-58.42457f,-58.34278f,-58.24952f,-58.51231f,-59.42525f,-61.10217f,-63.46936f,-66.34503f,-69.53469f,-72.88656f,-76.29320f,-79.66218f,-82.88130f,-85.73520f,-87.38955f,-86.36194f,-84.15583f,-81.83294f,-79.58616f,-77.45517f},
-    {-71.58214f,-69.61565f,-67.71488f,-65.86479f,-64.01505f,-62.04510f,-59.77482f,-57.07400f,-54.02405f,-51.03212f,-48.80491f,-48.09823f,-49.26412f,-51.92460f,-55.16562f,-58.07793f,-60.10267f,-61.01513f,-60.84749f,-59.97822f,-59.15799f,-59.18575f,-60.45940f,-62.86069f,-65.97595f,-69.36736f,-72.71868f,-75.80268f,-78.35851f,-80.06262f,-80.67983f,-80.25871f,-79.08901f,-77.46953f,-75.59576f,-73.59787f,-71.58215f},
-    {-64.39807f,-62.40221f,-60.40960f,-58.42549f,-56.48151f,-54.55795f,-52.49863f,-50.03954f,-47.03044f,-43.80319f,-41.39118f,-41.16169f,-43.78688f,-48.51954f,-53.83971f,-58.60413f,-62.35170f,-64.81766f,-65.60605f,-64.62579f,-62.64650f,-61.08659f,-61.05364f,-62.68316f,-65.34905f,-68.24163f,-70.78236f,-72.62117f,-73.51797f,-73.52965f,-73.02048f,-72.24528f,-71.21594f,-69.88980f,-68.25886f,-66.38361f,-64.39807f},
-    {-55.02826f,-52.87120f,-50.69073f,-48.44731f,-46.19513f,-44.04849f,-42.00465f,-39.74123f,-36.79801f,-33.33110f,-30.77621f,-31.26765f,-35.68330f,-42.58861f,-49.78570f,-56.05256f,-61.22645f,-65.24992f,-67.52021f,-67.43115f,-65.26549f,-62.35447f,-60.45735f,-60.49007f,-61.96843f,-63.81210f,-65.26064f,-65.90429f,-65.53604f,-64.51130f,-63.52424f,-62.77292f,-61.94296f,-60.76846f,-59.16172f,-57.17787f,-55.02826f},
-    {-42.23934f,-39.72248f,-37.30606f,-34.84704f,-32.29950f,-29.84715f,-27.62882f,-25.25073f,-22.02346f,-18.13398f,-15.56621f,-17.09131f,-23.52381f,-32.78684f,-42.11183f,-49.91489f,-55.93881f,-60.34177f,-62.85919f,-63.04596f,-60.93631f,-57.41244f,-54.21948f,-52.82417f,-53.10885f,-54.02972f,-54.81946f,-54.92826f,-53.94911f,-52.38029f,-51.27875f,-50.79557f,-50.20937f,-49.05107f,-47.23568f,-44.84941f,-42.23934f},
-    {-25.31616f,-22.26353f,-19.64432f,-17.13765f,-14.48794f,-11.90452f,-9.56551f,-6.93532f,-3.35246f,0.62534f,2.69744f,0.20162f,-7.49683f,-18.49333f,-29.80260f,-38.99555f,-45.22087f,-48.81124f,-50.28975f,-49.88122f,-47.49942f,-43.57896f,-39.80201f,-37.81589f,-37.58213f,-38.12733f,-38.79073f,-38.91636f,-37.84560f,-36.15384f,-35.28930f,-35.35164f,-35.11620f,-33.90633f,-31.71407f,-28.67497f,-25.31616f},
-    {-5.22365f,-1.68002f,0.98130f,3.28459f,5.73141f,8.13291f,10.33797f,12.92226f,16.28019f,19.52644f,20.64919f,17.75076f,10.26968f,-0.68527f,-12.39654f,-21.81573f,-27.55757f,-29.98547f,-30.24089f,-29.18412f,-26.62224f,-22.51726f,-18.50023f,-16.36665f,-16.02599f,-16.47452f,-17.18522f,-17.56335f,-16.82114f,-15.49276f,-15.21405f,-16.04947f,-16.38744f,-15.33409f,-12.92178f,-9.31548f,-5.22365f},
-    {14.65727f,18.24457f,20.73560f,22.68750f,24.74090f,26.83478f,28.82717f,31.06453f,33.64927f,35.73650f,35.91607f,33.06931f,26.82267f,17.82545f,8.14938f,0.35249f,-4.22224f,-5.65846f,-5.08244f,-3.67265f,-1.30171f,2.36894f,6.00997f,7.96495f,8.31670f,8.01335f,7.45026f,6.96852f,7.19717f,7.76654f,7.31456f,5.77666f,4.68883f,5.07867f,7.05547f,10.50432f,14.65727f},
-    {31.00203f,34.03206f,36.22486f,37.93041f,39.71929f,41.67672f,43.64451f,45.63057f,47.51149f,48.64179f,48.13476f,45.46014f,40.64785f,34.34474f,27.90343f,22.77471f,19.78522f,19.08118f,19.96093f,21.39191f,23.28877f,25.96005f,28.61507f,30.09860f,30.42073f,30.29938f,30.04062f,29.74069f,29.65970f,29.53545f,28.53162f,26.62276f,24.91817f,24.37385f,25.31100f,27.72542f,31.00203f},
-    {43.33608f,45.45851f,47.28808f,48.92364f,50.69187f,52.68920f,54.75852f,56.70372f,58.24993f,58.87748f,58.03709f,55.61656f,52.01961f,47.93440f,44.13769f,41.24459f,39.61639f,39.39065f,40.22833f,41.47069f,42.89022f,44.59331f,46.23881f,47.24171f,47.57154f,47.63935f,47.66249f,47.62919f,47.50096f,47.00810f,45.71114f,43.68014f,41.65440f,40.38784f,40.27252f,41.37670f,43.33608f},
-    {53.10131f,54.36161f,55.82606f,57.45873f,59.32146f,61.39014f,63.50628f,65.43734f,66.85905f,67.31408f,66.44780f,64.38450f,61.68268f,58.96721f,56.68844f,55.08044f,54.25566f,54.24982f,54.89128f,55.82780f,56.83438f,57.87845f,58.85920f,59.59271f,60.06042f,60.40887f,60.71534f,60.90716f,60.81057f,60.15911f,58.74748f,56.73559f,54.64618f,53.02448f,52.20550f,52.28132f,53.10131f},
-    {61.90363f,62.59082f,63.73000f,65.25974f,67.10373f,69.13404f,71.16923f,72.97878f,74.24745f,74.58969f,73.79370f,72.08739f,69.99806f,68.01780f,66.44167f,65.38391f,64.86230f,64.84287f,65.21557f,65.80372f,66.46017f,67.12970f,67.80720f,68.49179f,69.18909f,69.89166f,70.52514f,70.92481f,70.86509f,70.14456f,68.73300f,66.86155f,64.92449f,63.29260f,62.20331f,61.74779f,61.90363f},
-    {70.57319f,70.97549f,71.81891f,73.05700f,74.60513f,76.33503f,78.07584f,79.60158f,80.60606f,80.76720f,79.99878f,78.58008f,76.92858f,75.37566f,74.11340f,73.22087f,72.70518f,72.52979f,72.62677f,72.91213f,73.31657f,73.81370f,74.42101f,75.17239f,76.07666f,77.07532f,78.01176f,78.63384f,78.66938f,77.98598f,76.70086f,75.10445f,73.50638f,72.14451f,71.16426f,70.63412f,70.57319f},
-    {78.82351f,79.06440f,79.60559f,80.41612f,81.44382f,82.60991f,83.79747f,84.82323f,85.41014f,85.29919f,84.52961f,83.39228f,82.15604f,80.99185f,79.99787f,79.22370f,78.68527f,78.37555f,78.27394f,78.35635f,78.60546f,79.01788f,79.60326f,80.37283f,81.31875f,82.38760f,83.44917f,84.26774f,84.54142f,84.12292f,83.18704f,82.03917f,80.91872f,79.97342f,79.28584f,78.89722f,78.82351f},
-    {85.92404f,85.99807f,86.21370f,86.55320f,86.98729f,87.46743f,87.90712f,88.15645f,88.05609f,87.61718f,86.98684f,86.28678f,85.58976f,84.94098f,84.37090f,83.90045f,83.54357f,83.30879f,83.20077f,83.22179f,83.37274f,83.65354f,84.06234f,84.59369f,85.23581f,85.96691f,86.74942f,87.51716f,88.14109f,88.39226f,88.15089f,87.63861f,87.08412f,86.59723f,86.22810f,86.00055f,85.92404f},
-    {88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f}
-};
+static_assert(AP_Declination::TILE_CELLS == 6, "tables generated for a different tile size");
 
-__EXTFLASHFUNC__ const float AP_Declination::intensity_table[LAT_TABLE_SIZE][LON_TABLE_SIZE] = {
-    {0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f},
-    {0.60562f,0.59923f,0.59133f,0.58213f,0.57184f,0.56070f,0.54892f,0.53679f,0.52458f,0.51262f,0.50121f,0.49067f,0.48128f,0.47330f,0.46697f,0.46249f,0.46006f,0.45986f,0.46203f,0.46665f,0.47372f,0.48312f,0.49460f,0.50778f,0.52217f,0.53717f,0.55217f,0.56652f,0.57964f,0.59102f,0.60027f,0.60715f,0.61152f,0.61342f,0.61294f,0.61026f,0.60562f},
-    {0.62993f,0.61663f,0.60163f,0.58513f,0.56721f,0.54792f,0.52741f,0.50597f,0.48417f,0.46274f,0.44252f,0.42424f,0.40840f,0.39524f,0.38483f,0.37722f,0.37262f,0.37149f,0.37444f,0.38211f,0.39496f,0.41303f,0.43591f,0.46271f,0.49220f,0.52288f,0.55321f,0.58160f,0.60660f,0.62705f,0.64217f,0.65166f,0.65569f,0.65477f,0.64966f,0.64113f,0.62993f},
-    {0.61859f,0.59954f,0.57951f,0.55859f,0.53652f,0.51281f,0.48703f,0.45921f,0.43010f,0.40125f,0.37460f,0.35184f,0.33383f,0.32034f,0.31043f,0.30313f,0.29816f,0.29624f,0.29887f,0.30789f,0.32478f,0.35003f,0.38290f,0.42162f,0.46385f,0.50716f,0.54918f,0.58755f,0.62009f,0.64502f,0.66138f,0.66918f,0.66921f,0.66276f,0.65127f,0.63614f,0.61859f},
-    {0.58434f,0.56134f,0.53820f,0.51511f,0.49174f,0.46715f,0.44010f,0.40984f,0.37699f,0.34382f,0.31364f,0.28967f,0.27359f,0.26453f,0.25966f,0.25610f,0.25262f,0.24997f,0.25053f,0.25779f,0.27518f,0.30435f,0.34417f,0.39141f,0.44206f,0.49253f,0.54000f,0.58194f,0.61593f,0.64015f,0.65395f,0.65794f,0.65353f,0.64245f,0.62626f,0.60641f,0.58434f},
-    {0.53921f,0.51448f,0.48995f,0.46595f,0.44250f,0.41888f,0.39359f,0.36521f,0.33366f,0.30097f,0.27115f,0.24895f,0.23726f,0.23477f,0.23677f,0.23885f,0.23920f,0.23803f,0.23691f,0.23986f,0.25296f,0.28060f,0.32245f,0.37391f,0.42855f,0.48085f,0.52753f,0.56643f,0.59562f,0.61429f,0.62316f,0.62341f,0.61626f,0.60311f,0.58508f,0.56327f,0.53921f},
-    {0.48785f,0.46379f,0.43988f,0.41636f,0.39367f,0.37182f,0.34998f,0.32674f,0.30099f,0.27346f,0.24780f,0.22959f,0.22251f,0.22507f,0.23198f,0.23916f,0.24558f,0.25057f,0.25278f,0.25389f,0.26060f,0.28058f,0.31692f,0.36595f,0.41928f,0.46891f,0.51065f,0.54231f,0.56238f,0.57214f,0.57493f,0.57236f,0.56426f,0.55095f,0.53309f,0.51149f,0.48785f},
-    {0.43209f,0.41089f,0.38995f,0.36941f,0.34979f,0.33155f,0.31470f,0.29826f,0.28044f,0.26067f,0.24164f,0.22828f,0.22418f,0.22862f,0.23770f,0.24867f,0.26122f,0.27397f,0.28296f,0.28650f,0.28895f,0.29863f,0.32271f,0.36133f,0.40653f,0.44908f,0.48374f,0.50731f,0.51774f,0.51826f,0.51530f,0.51075f,0.50252f,0.48985f,0.47321f,0.45336f,0.43209f},
-    {0.37890f,0.36283f,0.34739f,0.33271f,0.31922f,0.30724f,0.29696f,0.28780f,0.27809f,0.26658f,0.25432f,0.24439f,0.23994f,0.24247f,0.25117f,0.26398f,0.27930f,0.29517f,0.30771f,0.31403f,0.31546f,0.31823f,0.33068f,0.35590f,0.38846f,0.42051f,0.44683f,0.46322f,0.46680f,0.46142f,0.45465f,0.44832f,0.43950f,0.42721f,0.41228f,0.39568f,0.37890f},
-    {0.34114f,0.33192f,0.32348f,0.31616f,0.31061f,0.30672f,0.30410f,0.30225f,0.29980f,0.29492f,0.28700f,0.27755f,0.26956f,0.26653f,0.27083f,0.28123f,0.29446f,0.30791f,0.31935f,0.32678f,0.32987f,0.33216f,0.33985f,0.35562f,0.37648f,0.39779f,0.41572f,0.42632f,0.42691f,0.42012f,0.41134f,0.40209f,0.39087f,0.37775f,0.36429f,0.35181f,0.34114f},
-    {0.32818f,0.32516f,0.32319f,0.32283f,0.32517f,0.32980f,0.33535f,0.34062f,0.34397f,0.34296f,0.33615f,0.32475f,0.31211f,0.30265f,0.30010f,0.30443f,0.31265f,0.32241f,0.33228f,0.34067f,0.34700f,0.35327f,0.36224f,0.37416f,0.38773f,0.40158f,0.41356f,0.42060f,0.42076f,0.41455f,0.40362f,0.38928f,0.37303f,0.35700f,0.34334f,0.33369f,0.32818f},
-    {0.33981f,0.34000f,0.34266f,0.34809f,0.35721f,0.36937f,0.38240f,0.39400f,0.40180f,0.40293f,0.39568f,0.38157f,0.36502f,0.35110f,0.34343f,0.34233f,0.34605f,0.35337f,0.36304f,0.37282f,0.38187f,0.39163f,0.40273f,0.41394f,0.42487f,0.43601f,0.44625f,0.45294f,0.45399f,0.44803f,0.43420f,0.41393f,0.39124f,0.37028f,0.35389f,0.34377f,0.33981f},
-    {0.37236f,0.37289f,0.37826f,0.38816f,0.40237f,0.41956f,0.43724f,0.45274f,0.46333f,0.46592f,0.45864f,0.44316f,0.42447f,0.40808f,0.39741f,0.39283f,0.39339f,0.39860f,0.40735f,0.41725f,0.42701f,0.43745f,0.44902f,0.46095f,0.47308f,0.48570f,0.49764f,0.50631f,0.50895f,0.50305f,0.48719f,0.46316f,0.43591f,0.41060f,0.39068f,0.37789f,0.37236f},
-    {0.42245f,0.42215f,0.42846f,0.44064f,0.45724f,0.47601f,0.49435f,0.50993f,0.52038f,0.52304f,0.51631f,0.50148f,0.48288f,0.46550f,0.45264f,0.44515f,0.44269f,0.44488f,0.45083f,0.45875f,0.46742f,0.47714f,0.48867f,0.50225f,0.51759f,0.53373f,0.54863f,0.55948f,0.56339f,0.55795f,0.54232f,0.51859f,0.49131f,0.46537f,0.44426f,0.42977f,0.42245f},
-    {0.48319f,0.48226f,0.48758f,0.49842f,0.51308f,0.52913f,0.54416f,0.55622f,0.56358f,0.56459f,0.55836f,0.54575f,0.52954f,0.51323f,0.49956f,0.48985f,0.48445f,0.48324f,0.48569f,0.49085f,0.49796f,0.50710f,0.51894f,0.53390f,0.55144f,0.56981f,0.58634f,0.59810f,0.60259f,0.59827f,0.58527f,0.56571f,0.54318f,0.52144f,0.50331f,0.49032f,0.48319f},
-    {0.53929f,0.53799f,0.54070f,0.54691f,0.55552f,0.56497f,0.57363f,0.58010f,0.58328f,0.58236f,0.57702f,0.56775f,0.55586f,0.54317f,0.53137f,0.52173f,0.51505f,0.51167f,0.51159f,0.51458f,0.52039f,0.52900f,0.54059f,0.55506f,0.57159f,0.58845f,0.60334f,0.61392f,0.61846f,0.61626f,0.60790f,0.59512f,0.58032f,0.56589f,0.55363f,0.54459f,0.53929f},
-    {0.57278f,0.57090f,0.57068f,0.57187f,0.57403f,0.57656f,0.57878f,0.58007f,0.57991f,0.57795f,0.57409f,0.56849f,0.56162f,0.55414f,0.54681f,0.54040f,0.53554f,0.53271f,0.53223f,0.53423f,0.53873f,0.54564f,0.55475f,0.56559f,0.57735f,0.58891f,0.59900f,0.60643f,0.61040f,0.61066f,0.60758f,0.60203f,0.59514f,0.58801f,0.58156f,0.57637f,0.57278f},
-    {0.57900f,0.57728f,0.57584f,0.57463f,0.57360f,0.57263f,0.57160f,0.57039f,0.56890f,0.56707f,0.56489f,0.56241f,0.55976f,0.55710f,0.55465f,0.55263f,0.55127f,0.55074f,0.55121f,0.55273f,0.55530f,0.55883f,0.56314f,0.56798f,0.57300f,0.57785f,0.58216f,0.58562f,0.58802f,0.58928f,0.58943f,0.58865f,0.58716f,0.58523f,0.58309f,0.58097f,0.57900f},
-    {0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f}
+const float AP_Declination::field_scale[NUM_FIELDS] = {0.001f,0.001f,1e-06f};
+
+__EXTFLASHFUNC__ const uint16_t AP_Declination::tile_offsets[18] = {
+    0,298,604,897,1205,1526,1835,2140,2450,2751,3062,3378,3683,3990,4297,4599,
+    4903,5209,
 };
 
+__EXTFLASHFUNC__ const uint8_t AP_Declination::tile_data[5510] = {
+    0xc4,0x95,0x12,0x9f,0x9c,0x01,0x9f,0x9c,0x01,0x9f,0x9c,0x01,0x9f,0x9c,0x01,0x9f,
+    0x9c,0x01,0x9f,0x9c,0x01,0xb9,0xb4,0x02,0xad,0x22,0xa1,0x11,0xbd,0x02,0xba,0x09,
+    0xcc,0x12,0xa4,0x19,0x9d,0xa4,0x05,0xfa,0x41,0xfa,0x48,0xc6,0x48,0xd4,0x44,0xd2,
+    0x3e,0x90,0x37,0xa3,0xcb,0x04,0xd2,0x66,0xf8,0x4b,0xa2,0x3e,0xd2,0x37,0x82,0x34,
+    0xe0,0x2f,0xbd,0x86,0x02,0xe2,0x18,0xc8,0x13,0xa0,0x10,0x8c,0x10,0xd8,0x13,0x8a,
+    0x19,0xd9,0x88,0x01,0xc8,0x05,0xde,0x05,0xd2,0x03,0x60,0x02,0xdc,0x03,0xcd,0x57,
+    0x1b,0xa2,0x02,0xde,0x02,0x1e,0xf5,0x03,0xe3,0x05,0xa9,0xe5,0x08,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x85,0x61,0xfc,0x0b,0xb0,0x0e,0x92,0x10,0xaa,0x11,0x84,0x12,0x9c,
+    0x12,0x8f,0x28,0xc0,0x10,0x9c,0x0e,0xf2,0x0c,0xbe,0x0c,0xe8,0x0c,0xc2,0x0d,0xa2,
+    0x34,0x8a,0x03,0xdc,0x01,0x7a,0x90,0x01,0xcc,0x02,0xaa,0x05,0xe2,0x5b,0x69,0x4d,
+    0x89,0x01,0x83,0x02,0xd3,0x02,0xcb,0x01,0xa0,0x70,0x3c,0xb6,0x01,0x8e,0x02,0xba,
+    0x01,0x5b,0xa5,0x03,0xb4,0x92,0x01,0xc2,0x02,0xf8,0x02,0x86,0x04,0xea,0x04,0xbe,
+    0x03,0x1f,0xdc,0xc4,0x42,0x00,0x00,0x00,0x00,0x00,0x00,0x8c,0xb2,0x07,0xeb,0x63,
+    0xb7,0x7b,0xdf,0x8f,0x01,0xe3,0xa0,0x01,0x87,0xae,0x01,0x87,0xb8,0x01,0xec,0xfb,
+    0x02,0xfb,0x6b,0xf7,0x6e,0x87,0x72,0x9b,0x77,0xab,0x7f,0xb3,0x88,0x01,0x97,0xb1,
+    0x01,0xeb,0x59,0xcb,0x4e,0x87,0x45,0xeb,0x40,0x87,0x45,0xab,0x52,0x93,0x97,0x04,
+    0xdb,0x3d,0xcb,0x30,0xf3,0x21,0xa7,0x14,0xdf,0x0d,0xeb,0x13,0x93,0xc1,0x05,0x83,
+    0x1b,0xdb,0x15,0x9b,0x0e,0x9f,0x01,0x94,0x0f,0xc0,0x1b,0xbf,0xa2,0x06,0xbc,0x0a,
+    0xd8,0x09,0xc0,0x07,0xf0,0x0b,0xd4,0x1b,0xf4,0x35,0x84,0xec,0x0a,0x9f,0x9c,0x01,
+    0x9f,0x9c,0x01,0x9f,0x9c,0x01,0x9f,0x9c,0x01,0x9f,0x9c,0x01,0x9f,0x9c,0x01,0x9d,
+    0xb5,0x02,0x86,0x1e,0xa8,0x21,0xcc,0x23,0x98,0x25,0xaa,0x26,0x8a,0x27,0xad,0x96,
+    0x02,0xc2,0x2e,0xdc,0x25,0xde,0x1d,0xd4,0x17,0xb0,0x14,0x8e,0x14,0x83,0xbf,0x01,
+    0xc2,0x28,0xfe,0x1d,0xc8,0x11,0x82,0x06,0xe1,0x01,0x8b,0x03,0x85,0x8d,0x01,0xf8,
+    0x1b,0xac,0x18,0xdc,0x0d,0x99,0x01,0xcf,0x0e,0xf5,0x13,0xa3,0x75,0xd4,0x0a,0x96,
+    0x0f,0xa6,0x0b,0x8b,0x01,0xf5,0x0e,0x85,0x14,0xa5,0x5c,0x93,0x02,0xf6,0x03,0x8e,
+    0x05,0x79,0xfd,0x06,0x83,0x04,0xa9,0xe5,0x08,0x00,0x00,0x00,0x00,0x00,0x00,0x7d,
+    0xf4,0x11,0x8c,0x11,0xe6,0x0f,0x8a,0x0e,0x88,0x0c,0xf8,0x09,0xa6,0x2a,0xf8,0x0d,
+    0xc4,0x0d,0xe2,0x0b,0xce,0x08,0xbc,0x04,0x20,0x88,0x43,0xdc,0x08,0x92,0x0b,0xf6,
+    0x0a,0xea,0x06,0x6d,0xff,0x09,0xfc,0x52,0xd2,0x01,0xf2,0x05,0xa2,0x08,0xa4,0x05,
+    0xcf,0x04,0xb3,0x12,0xd8,0x71,0xe3,0x03,0x4f,0xd6,0x03,0xf2,0x02,0xbb,0x07,0xe5,
+    0x16,0xfc,0xa3,0x01,0x85,0x03,0x85,0x01,0xe0,0x03,0x9e,0x02,0xa1,0x0b,0xfb,0x1b,
+    0xdc,0xc4,0x42,0x00,0x00,0x00,0x00,0x00,0x00,0x94,0x3c,0xc3,0xbd,0x01,0xe3,0xbe,
+    0x01,0xef,0xba,0x01,0xa3,0xb2,0x01,0xd7,0xa4,0x01,0xdb,0x92,0x01,0x8b,0xd0,0x02,
+    0xbb,0x91,0x01,0xeb,0x95,0x01,0xfb,0x93,0x01,0xd3,0x89,0x01,0xf7,0x78,0xe3,0x64,
+    0xf7,0xf6,0x04,0xd7,0x63,0x9b,0x72,0xf7,0x73,0xbb,0x64,0xff,0x45,0xf3,0x21,0xa3,
+    0xdd,0x05,0x8f,0x26,0xb7,0x3a,0xbf,0x43,0x93,0x37,0xf3,0x12,0x94,0x1e,0xdb,0xd6,
+    0x05,0xb0,0x1d,0xa8,0x14,0xc0,0x07,0xd0,0x05,0xd4,0x1b,0xcc,0x44,0xb3,0xa9,0x05,
+    0xa8,0x50,0xd0,0x5a,0xd0,0x50,0x80,0x41,0xac,0x3e,0x84,0x48,0xc4,0xc2,0x03,0x9f,
+    0x9c,0x01,0x9f,0x9c,0x01,0x9f,0x9c,0x01,0x9f,0x9c,0x01,0x9f,0x9c,0x01,0x9f,0x9c,
+    0x01,0xd7,0x5f,0xb0,0x27,0x88,0x27,0xfe,0x25,0x86,0x24,0xa6,0x21,0xf8,0x1d,0x9f,
+    0x64,0xa0,0x16,0xac,0x19,0xbc,0x1b,0x90,0x1b,0xfe,0x17,0xfc,0x12,0xe7,0x65,0xd0,
+    0x02,0xf6,0x0c,0xf6,0x16,0xdc,0x1b,0xaa,0x19,0xd6,0x11,0xe5,0x6e,0xc1,0x0d,0xd0,
+    0x01,0x8a,0x12,0xe0,0x1d,0xc0,0x21,0xe8,0x1b,0x9b,0x74,0xc3,0x0c,0x34,0xc4,0x0a,
+    0xb8,0x13,0xfe,0x21,0xcc,0x2e,0xb1,0x61,0xa0,0x05,0x88,0x0b,0x92,0x0a,0xfe,0x09,
+    0xb6,0x18,0xac,0x36,0xa9,0xe5,0x08,0x00,0x00,0x00,0x00,0x00,0x00,0xf2,0x55,0xe4,
+    0x07,0xd8,0x05,0xda,0x03,0xde,0x01,0x25,0xbd,0x02,0xee,0x5e,0xfd,0x02,0xb5,0x04,
+    0x85,0x04,0xb7,0x02,0x51,0x2a,0xe8,0x5d,0x8d,0x11,0xbf,0x13,0xd1,0x10,0x99,0x0a,
+    0xdf,0x02,0xb8,0x03,0x82,0x51,0xa1,0x1d,0xb3,0x20,0xc1,0x1c,0xdd,0x14,0xc7,0x0a,
+    0xac,0x01,0xca,0x55,0xaf,0x20,0xbd,0x20,0xf7,0x1c,0xf5,0x1a,0xa3,0x18,0xf7,0x0e,
+    0xd0,0x7e,0xf9,0x21,0xa9,0x1d,0xbd,0x17,0xa1,0x16,0xab,0x18,0x93,0x17,0xdc,0xc4,
+    0x42,0x00,0x00,0x00,0x00,0x00,0x00,0xdb,0xe4,0x07,0xd7,0x7c,0xf3,0x62,0xff,0x45,
+    0xfb,0x25,0x8f,0x03,0xf4,0x21,0xdf,0xf2,0x08,0xf7,0x50,0xdf,0x3f,0xf3,0x30,0xf3,
+    0x21,0xc3,0x0e,0x98,0x0c,0x93,0x8d,0x09,0x93,0x05,0xe8,0x07,0xec,0x04,0xe3,0x05,
+    0xab,0x0c,0xff,0x04,0x9f,0xad,0x07,0x9c,0x45,0xe0,0x4e,0xb8,0x3a,0xa4,0x17,0xb3,
+    0x0b,0xab,0x20,0xd3,0xb7,0x04,0xd4,0x66,0xac,0x6b,0x90,0x58,0xec,0x3b,0x90,0x17,
+    0x9f,0x1a,0xbb,0xe6,0x01,0xf4,0x4e,0xdc,0x4c,0xd8,0x4f,0xec,0x5e,0xa0,0x60,0x84,
+    0x34,0xfb,0xe6,0x03,0x9f,0x9c,0x01,0x9f,0x9c,0x01,0x9f,0x9c,0x01,0x9f,0x9c,0x01,
+    0x9f,0x9c,0x01,0x9f,0x9c,0x01,0x82,0x78,0x9c,0x1a,0xb2,0x16,0xd2,0x12,0xfe,0x0e,
+    0xa6,0x0b,0x9e,0x07,0xf2,0x2c,0xea,0x0d,0xaa,0x0a,0xc2,0x09,0xc6,0x0b,0xe8,0x0f,
+    0xb4,0x15,0xb0,0x07,0x8e,0x09,0x96,0x04,0x8a,0x05,0xa6,0x0b,0xfc,0x14,0xde,0x20,
+    0xc5,0x0d,0x8a,0x10,0xc6,0x07,0xac,0x08,0xbc,0x10,0x88,0x1c,0xfa,0x29,0xe5,0x11,
+    0xa4,0x28,0x84,0x18,0x8c,0x12,0xde,0x16,0xee,0x1f,0xbe,0x2b,0xe8,0x11,0xe2,0x46,
+    0x8c,0x36,0xf2,0x1c,0xb4,0x10,0xda,0x10,0xa2,0x15,0xa9,0xe5,0x08,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x82,0x66,0xf1,0x04,0xc1,0x07,0xa1,0x0a,0xfd,0x0c,0xc3,0x0f,0xdb,
+    0x11,0xd4,0x50,0x11,0x95,0x02,0xb3,0x05,0x95,0x09,0xdf,0x0c,0xdf,0x0f,0x86,0x1f,
+    0xbe,0x06,0xcc,0x05,0xb4,0x01,0x85,0x04,0xd9,0x08,0xbb,0x0b,0x8f,0x27,0x90,0x0c,
+    0xf4,0x10,0xea,0x0d,0xa8,0x06,0x45,0xdd,0x03,0xad,0x4a,0xde,0x01,0x90,0x12,0xe6,
+    0x18,0xb4,0x14,0x8a,0x0c,0x82,0x07,0xf3,0x1d,0xf5,0x0d,0xf4,0x02,0x90,0x15,0x90,
+    0x1d,0xf8,0x18,0xc8,0x12,0xdc,0xc4,0x42,0x00,0x00,0x00,0x00,0x00,0x00,0xbf,0x91,
+    0x0a,0x98,0x48,0xbc,0x6e,0xf0,0x92,0x01,0xb0,0xb3,0x01,0xf8,0xcd,0x01,0xec,0xe0,
+    0x01,0xcb,0xd8,0x0a,0xd4,0x2f,0xa8,0x5a,0xbc,0x87,0x01,0x90,0xb2,0x01,0xe8,0xd4,
+    0x01,0xf8,0xeb,0x01,0xe3,0x9c,0x09,0x8c,0x15,0x90,0x3f,0x98,0x70,0x8c,0x9c,0x01,
+    0xa0,0xba,0x01,0x88,0xc7,0x01,0xa7,0xf3,0x05,0xbf,0x1b,0xe8,0x07,0xa0,0x3d,0xcc,
+    0x6c,0x90,0x85,0x01,0xc8,0x83,0x01,0xe7,0xd4,0x01,0xab,0x43,0x83,0x43,0xf3,0x17,
+    0xdc,0x1f,0xf8,0x41,0xac,0x3e,0xfc,0xf7,0x01,0xdf,0x1c,0xeb,0x63,0xd7,0x77,0x8b,
+    0x56,0xfb,0x25,0xbb,0x14,0xbb,0x90,0x0b,0x9f,0x9c,0x01,0x9f,0x9c,0x01,0x9f,0x9c,
+    0x01,0x9f,0x9c,0x01,0x9f,0x9c,0x01,0x9f,0x9c,0x01,0xe4,0xdc,0x01,0xb6,0x02,0xcd,
+    0x03,0xb3,0x0b,0xa7,0x15,0xc3,0x21,0xc5,0x2f,0xaa,0x7f,0x98,0x1b,0x90,0x20,0xdc,
+    0x22,0x96,0x20,0x94,0x12,0xdf,0x16,0xde,0x5a,0xc2,0x2e,0xe0,0x3f,0xbe,0x58,0xee,
+    0x81,0x01,0xea,0xd3,0x01,0xd4,0x9f,0x03,0xf4,0x68,0xfa,0x3a,0x94,0x51,0xfe,0x6f,
+    0xec,0x96,0x01,0xd0,0xab,0x01,0xa8,0x47,0xd8,0xa2,0x01,0xa0,0x37,0xc0,0x3e,0xda,
+    0x38,0xbe,0x12,0x81,0x3c,0xbb,0x82,0x01,0xf8,0xe1,0x01,0xae,0x13,0x94,0x06,0xab,
+    0x10,0xad,0x2d,0x91,0x44,0xa1,0x46,0xa9,0xe5,0x08,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x8e,0x21,0xb5,0x13,0xbf,0x14,0xeb,0x14,0xaf,0x14,0x83,0x13,0xd9,0x10,0xa2,0x23,
+    0xfb,0x11,0xc5,0x13,0xcf,0x14,0xa5,0x15,0xbd,0x15,0xe1,0x14,0xa8,0x14,0xb9,0x0c,
+    0xa9,0x0c,0xdf,0x0b,0xfb,0x0a,0xe3,0x09,0x8f,0x07,0xe2,0x05,0x91,0x03,0x00,0x84,
+    0x05,0xda,0x0c,0xd6,0x17,0xfa,0x22,0xe6,0x09,0xe4,0x07,0xd8,0x0c,0xba,0x13,0xf6,
+    0x19,0xb8,0x1a,0xce,0x11,0xea,0x34,0xb2,0x10,0x86,0x11,0xd8,0x12,0xe2,0x13,0x9a,
+    0x10,0xba,0x07,0xdc,0xc4,0x42,0x00,0x00,0x00,0x00,0x00,0x00,0xe7,0xe5,0x02,0xb0,
+    0xea,0x01,0xb0,0xea,0x01,0x9c,0xe0,0x01,0x80,0xcd,0x01,0xe8,0xb1,0x01,0xc4,0x90,
+    0x01,0xa3,0xd4,0x03,0x80,0xf5,0x01,0xc4,0xef,0x01,0xb0,0xdb,0x01,0xd0,0xb9,0x01,
+    0xdc,0x8d,0x01,0xdc,0x5b,0xfb,0xba,0x03,0xac,0xc5,0x01,0xd4,0xb6,0x01,0xf8,0x9b,
+    0x01,0xe8,0x75,0x80,0x46,0xb0,0x13,0xbb,0xd4,0x02,0xf0,0x6f,0x94,0x55,0xe4,0x37,
+    0xd4,0x16,0x8b,0x0b,0xff,0x27,0x8b,0xd3,0x01,0xcc,0x1c,0xab,0x0c,0xbf,0x2f,0xff,
+    0x4a,0xdb,0x56,0x83,0x4d,0xeb,0x90,0x01,0xdb,0x29,0x97,0x4d,0x8f,0x71,0xbf,0x8e,
+    0x01,0x9b,0x8b,0x01,0xff,0x5e,0xfb,0xb9,0x12,0x9f,0x9c,0x01,0x9f,0x9c,0x01,0xe0,
+    0xdc,0x2a,0x9f,0x9c,0x01,0x9f,0x9c,0x01,0x9f,0x9c,0x01,0xe6,0x69,0xf3,0x3d,0xf5,
+    0x49,0x91,0x50,0x91,0x4e,0xf9,0x43,0x97,0x34,0xf8,0xf8,0x01,0xff,0x7b,0xce,0xca,
+    0x29,0xa7,0xd7,0x2e,0xc7,0xa7,0x01,0xd1,0x16,0xde,0x29,0xea,0x96,0x08,0xb0,0xe3,
+    0x07,0xc7,0xf5,0x21,0xaa,0xbe,0x06,0x8e,0xd6,0x03,0xc2,0x81,0x02,0x90,0x9a,0x01,
+    0xe4,0xee,0x05,0xe9,0x96,0x03,0xb3,0xb2,0x04,0xdf,0x74,0x96,0x0a,0x82,0x20,0xc4,
+    0x1e,0x92,0xa5,0x01,0xd5,0x88,0x01,0x81,0x5f,0x85,0x32,0xcd,0x13,0xc7,0x03,0x88,
+    0x03,0xac,0x33,0xcf,0x37,0xad,0x25,0x91,0x17,0xfb,0x0c,0xd5,0x06,0x97,0x03,0xa9,
+    0xe5,0x08,0x00,0x00,0x00,0x00,0x00,0x00,0xe1,0x53,0xb7,0x0d,0xa3,0x09,0xc9,0x04,
+    0x28,0xf2,0x04,0xe8,0x08,0xb5,0x56,0xb3,0x11,0xb7,0x07,0xd2,0x09,0xb8,0x14,0xda,
+    0x15,0xae,0x13,0x8b,0x2c,0xfe,0x04,0xe4,0x20,0xb4,0x1d,0xc6,0x0f,0xc2,0x08,0x90,
+    0x05,0xfe,0x4e,0xb8,0x20,0x9c,0x02,0x95,0x09,0x81,0x07,0xf1,0x03,0xe5,0x01,0xd8,
+    0x77,0xc4,0x05,0x99,0x02,0xc9,0x04,0xe5,0x03,0xf5,0x01,0x3b,0xb0,0x94,0x01,0x2f,
+    0x8d,0x03,0xad,0x02,0x31,0xda,0x01,0xc8,0x02,0xdc,0xc4,0x42,0x00,0x00,0x00,0x00,
+    0x00,0x00,0xc0,0xde,0x06,0xc0,0x6b,0xa4,0x44,0xd8,0x1d,0xbf,0x07,0xef,0x29,0xbf,
+    0x48,0xd8,0x8e,0x05,0xe4,0x28,0xa7,0x05,0x87,0x2c,0xab,0x48,0xb3,0x5b,0xbf,0x66,
+    0x94,0xac,0x02,0xb3,0x1a,0xbf,0x3e,0xb3,0x56,0xd7,0x63,0x8f,0x67,0x9b,0x63,0x8b,
+    0x74,0xc3,0x3b,0xaf,0x45,0xab,0x48,0xb7,0x49,0xdf,0x49,0xcf,0x46,0x8b,0xe1,0x03,
+    0xb7,0x3a,0xe7,0x2a,0xab,0x20,0xdf,0x1c,0xcf,0x1e,0x8b,0x1f,0xcb,0xf1,0x05,0x87,
+    0x2c,0xeb,0x0e,0xbf,0x02,0xd4,0x02,0xa4,0x03,0xc8,0x06,0xe2,0x8a,0x02,0x8c,0x08,
+    0xf8,0x02,0xa5,0x01,0xb5,0x05,0x9b,0x07,0x89,0x05,0xe5,0x39,0xb7,0x03,0x91,0x01,
+    0xac,0x01,0xc6,0x01,0xb7,0x01,0xa3,0x04,0xaf,0x23,0xc1,0x04,0xbb,0x03,0x23,0xb8,
+    0x01,0x48,0x25,0x95,0x13,0xd7,0x02,0x8f,0x03,0x1b,0xd2,0x01,0xa8,0x01,0x44,0xeb,
+    0x0b,0xb8,0x03,0x8c,0x01,0x84,0x02,0x92,0x03,0x8e,0x02,0xc9,0x01,0xcb,0x10,0xd8,
+    0x0c,0xb6,0x09,0xc4,0x06,0xa8,0x05,0x86,0x03,0xa5,0x03,0xb1,0x1b,0xaa,0x13,0xfa,
+    0x11,0xfa,0x0b,0xe6,0x06,0x84,0x03,0x83,0x03,0xe7,0xdb,0x06,0xda,0x21,0x88,0x22,
+    0x88,0x23,0x98,0x23,0xc6,0x21,0xf6,0x1f,0xea,0xc7,0x01,0xd0,0x05,0xd8,0x03,0xae,
+    0x03,0xce,0x04,0xe4,0x04,0xde,0x02,0xb6,0x88,0x02,0xae,0x08,0x98,0x03,0x5e,0xce,
+    0x01,0x84,0x02,0xf2,0x01,0xf8,0xb9,0x02,0xd8,0x07,0x52,0x93,0x03,0x97,0x03,0xe9,
+    0x02,0x8b,0x02,0xd2,0xb6,0x02,0x58,0xd3,0x02,0xbf,0x05,0x91,0x06,0xe7,0x04,0xa9,
+    0x03,0xb2,0xff,0x01,0xdb,0x08,0xd3,0x04,0xed,0x03,0x8f,0x04,0x8f,0x02,0x2f,0xdc,
+    0xc0,0x01,0x95,0x0e,0xd7,0x05,0x89,0x01,0x29,0x4e,0xcc,0x01,0xd4,0xc6,0x3b,0xf7,
+    0xf7,0x02,0xcb,0xf5,0x02,0xbf,0xef,0x02,0xc3,0xe2,0x02,0xb3,0xd5,0x02,0x9f,0xd5,
+    0x02,0x9f,0xe7,0x06,0xd8,0x2c,0xb4,0x2e,0xc8,0x2e,0xfc,0x2f,0xb4,0x38,0xfc,0x4d,
+    0x8b,0xbf,0x06,0x94,0x50,0xf8,0x55,0xc8,0x5b,0xe4,0x5f,0xe8,0x61,0xd4,0x66,0xff,
+    0xcd,0x04,0x84,0x6b,0xb0,0x6d,0x80,0x73,0x88,0x7c,0xb4,0x7e,0xd8,0x77,0xbf,0xca,
+    0x01,0xf0,0x60,0x8c,0x65,0xe0,0x6c,0xa4,0x7b,0x90,0x85,0x01,0xd4,0x7f,0xdc,0xb5,
+    0x01,0x94,0x32,0xac,0x48,0xbc,0x5a,0xf8,0x69,0xd4,0x75,0xf0,0x74,0xcc,0xfc,0x03,
+    0xa8,0x05,0xac,0x2a,0xec,0x45,0xc4,0x4f,0xcc,0x4e,0xd4,0x48,0xe4,0x82,0x02,0xdd,
+    0x02,0xe5,0x0b,0x9d,0x2b,0xd1,0x5c,0xeb,0x87,0x01,0x93,0x90,0x01,0x99,0x41,0xf9,
+    0x03,0xdf,0x01,0x8f,0x01,0xe3,0x01,0x8e,0x02,0xd6,0x0b,0xf7,0x29,0x9f,0x01,0xdb,
+    0x03,0xeb,0x04,0x39,0xf2,0x09,0xe8,0x12,0xdb,0x15,0xfd,0x01,0xa3,0x06,0xc1,0x06,
+    0xfa,0x01,0xee,0x0d,0xe4,0x13,0xcd,0x01,0xe3,0x06,0xc1,0x0a,0xaf,0x08,0xd6,0x01,
+    0xd4,0x0d,0xa2,0x14,0x8e,0x11,0xfb,0x0a,0xdb,0x0e,0xf5,0x0b,0xef,0x01,0xac,0x0b,
+    0xb4,0x14,0xd2,0x1c,0xff,0x0a,0xa7,0x10,0xa9,0x0f,0xb9,0x06,0xfc,0x06,0x98,0x10,
+    0xa9,0x90,0x05,0xb0,0x23,0xfe,0x2d,0x96,0x36,0xf6,0x27,0xd7,0x07,0xfd,0x44,0xd0,
+    0xe0,0x01,0xe4,0x01,0xba,0x04,0xcc,0x06,0x1a,0x91,0x10,0xc3,0x1f,0x9e,0x9a,0x02,
+    0xfa,0x03,0xc6,0x05,0xb0,0x01,0xdf,0x07,0x93,0x0f,0xe3,0x13,0x80,0xb7,0x02,0x5d,
+    0xc1,0x03,0xb5,0x0b,0xe9,0x0e,0xa5,0x06,0xb4,0x03,0xf2,0xa0,0x02,0xb3,0x05,0x8b,
+    0x0c,0x8d,0x12,0xdd,0x0e,0x66,0xa6,0x13,0xc4,0xe7,0x01,0xf7,0x03,0xff,0x0a,0xf7,
+    0x0e,0xdd,0x0a,0xd8,0x02,0xb4,0x16,0xd4,0xad,0x01,0x51,0x9b,0x05,0xef,0x07,0x99,
+    0x05,0xfe,0x03,0xfe,0x12,0xb8,0xdc,0x2a,0x8f,0xeb,0x02,0xab,0x92,0x03,0x93,0xae,
+    0x03,0xf7,0x90,0x03,0xc3,0x9c,0x02,0xcf,0x6e,0x9f,0xa7,0x04,0xa0,0x6a,0xf4,0x7b,
+    0xa0,0x79,0xcc,0x67,0xe4,0x4b,0xc8,0x2e,0x97,0x95,0x02,0xe0,0x71,0xdc,0x7e,0x88,
+    0x81,0x01,0xe4,0x69,0xcc,0x35,0xbb,0x05,0xc8,0x6f,0x9c,0x72,0xb8,0x71,0xcc,0x67,
+    0xe8,0x43,0xc0,0x07,0xa7,0x37,0xa4,0xe8,0x03,0xa0,0x6f,0xd0,0x5a,0xbc,0x3c,0xac,
+    0x11,0xbb,0x1e,0xd3,0x48,0x94,0xdf,0x05,0xf4,0x62,0xc4,0x45,0xb8,0x21,0xef,0x06,
+    0xab,0x2a,0x8b,0x3d,0xf0,0xd8,0x06,0xf8,0x3c,0xcc,0x2b,0xe8,0x16,0x3b,0xb3,0x15,
+    0xb7,0x21,0xcf,0xab,0x01,0xe5,0x70,0xe9,0x41,0x8f,0x1d,0x97,0x06,0xa2,0x12,0x8a,
+    0x27,0x83,0x3c,0x86,0x12,0xf2,0x12,0xa8,0x14,0xe2,0x18,0xc6,0x1e,0xfa,0x25,0xbf,
+    0x17,0x8c,0x15,0xb2,0x17,0x80,0x1e,0x80,0x21,0xdc,0x14,0x85,0x01,0x73,0xbe,0x15,
+    0xfa,0x17,0x88,0x18,0x88,0x11,0x5c,0x95,0x11,0xa8,0x08,0x84,0x16,0xbe,0x12,0xa6,
+    0x09,0x1a,0xb1,0x06,0x8f,0x0c,0xb0,0x09,0xae,0x14,0x84,0x0b,0x29,0xf3,0x05,0xe9,
+    0x05,0xff,0x04,0xda,0x02,0xf2,0x0e,0x88,0x06,0xe3,0x01,0xbf,0x04,0xff,0x02,0x09,
+    0xc5,0xad,0x04,0xf3,0x6b,0xb9,0x70,0xf5,0x61,0xe9,0x50,0xef,0x3e,0xbb,0x23,0xfe,
+    0xbd,0x01,0xe9,0x24,0x9f,0x21,0xff,0x17,0xa5,0x0d,0xf5,0x05,0xed,0x03,0xb6,0xfa,
+    0x01,0x89,0x1b,0x81,0x1f,0xdb,0x15,0x91,0x03,0xda,0x0c,0x9c,0x10,0xce,0x95,0x02,
+    0x52,0xa3,0x06,0xc3,0x03,0xc6,0x07,0x96,0x12,0x8e,0x13,0xd2,0x82,0x02,0xca,0x1e,
+    0xe8,0x1f,0xac,0x19,0xa0,0x12,0xbe,0x0f,0x80,0x0d,0x82,0xd8,0x01,0x8e,0x2a,0xc4,
+    0x32,0xda,0x29,0xe0,0x18,0xb8,0x0b,0xe0,0x04,0xd8,0xb1,0x01,0xd2,0x22,0xac,0x29,
+    0xf6,0x22,0xa2,0x15,0xbe,0x07,0x55,0xdc,0x94,0x1b,0x80,0x28,0xfc,0x6b,0x98,0x70,
+    0xa8,0x64,0xfc,0x4d,0xc4,0x22,0x8c,0x1a,0xb0,0x1d,0xf4,0x21,0x9c,0x3b,0xe4,0x5f,
+    0xa0,0x79,0xf8,0x69,0xa0,0xf6,0x01,0xeb,0x1d,0xf7,0x05,0xe0,0x1c,0xa4,0x2b,0xe0,
+    0x30,0xbc,0x37,0xe8,0xce,0x03,0xef,0x56,0xdf,0x44,0xd3,0x25,0xd3,0x20,0xe7,0x25,
+    0x97,0x11,0xec,0x98,0x05,0xbb,0x64,0x83,0x6b,0xeb,0x5e,0xa3,0x4e,0xd3,0x39,0xc3,
+    0x18,0xdc,0xba,0x06,0xd7,0x45,0xff,0x4f,0xeb,0x54,0xa7,0x46,0x8f,0x26,0x8f,0x03,
+    0xf4,0xa0,0x07,0xcb,0x26,0xef,0x2e,0xaf,0x36,0xaf,0x31,0xfb,0x20,0xaf,0x0e,0x9b,
+    0xc8,0x02,0x84,0x14,0xd7,0x21,0xd7,0x43,0xe7,0x3e,0xc5,0x1f,0xea,0x0b,0xbe,0x5a,
+    0xde,0x33,0xbc,0x39,0x88,0x23,0xc8,0x04,0x99,0x0a,0xaf,0x0e,0xd4,0x67,0x89,0x04,
+    0x96,0x11,0xf6,0x1c,0xa6,0x10,0x95,0x03,0xc7,0x10,0x9a,0x45,0x87,0x14,0xcd,0x04,
+    0x98,0x0d,0x86,0x11,0xec,0x07,0x95,0x04,0xe8,0x27,0xf9,0x0d,0xcd,0x07,0xe4,0x03,
+    0xc0,0x0a,0x90,0x08,0xda,0x01,0xda,0x17,0x9d,0x06,0xf5,0x05,0x11,0xba,0x06,0x88,
+    0x07,0xa0,0x03,0xa6,0x0e,0x1b,0xc9,0x02,0x11,0xbe,0x06,0xe0,0x08,0xc0,0x04,0xff,
+    0x9e,0x08,0xb2,0x01,0xec,0x21,0xbe,0x2d,0xd2,0x1d,0x41,0x8b,0x17,0xea,0x48,0xa7,
+    0x04,0x6f,0xca,0x09,0xa0,0x14,0xa8,0x16,0xd2,0x12,0xb2,0xc4,0x01,0xa8,0x09,0xa0,
+    0x04,0x98,0x06,0x90,0x09,0x9e,0x09,0x8e,0x08,0xa2,0xb9,0x02,0x90,0x0a,0xe8,0x02,
+    0xf2,0x02,0xe0,0x03,0xa6,0x02,0xd6,0x01,0x8e,0x89,0x03,0xc0,0x05,0xfd,0x02,0xe3,
+    0x06,0xef,0x05,0xe3,0x02,0x16,0xa6,0x87,0x03,0x2c,0xb3,0x07,0xcf,0x0f,0xb3,0x0f,
+    0xad,0x07,0x3b,0xd6,0xbc,0x02,0xf7,0x02,0xbb,0x07,0x8f,0x0f,0xe1,0x0f,0xc1,0x07,
+    0x10,0xd8,0xed,0x1e,0xac,0x11,0xec,0x68,0x98,0xb8,0x02,0xe8,0xb7,0x04,0x8c,0xfe,
+    0x05,0xa4,0xc1,0x06,0xc8,0xd7,0x03,0xfc,0x25,0xc7,0x42,0xf7,0xa0,0x01,0xc7,0xbf,
+    0x01,0xd3,0xa2,0x01,0x83,0x7f,0xdc,0x82,0x03,0xb8,0x2b,0xf7,0x0f,0xfb,0x6b,0xdb,
+    0xb5,0x01,0xaf,0xd1,0x01,0xbf,0xc5,0x01,0xf0,0xb5,0x01,0xac,0x11,0xf8,0x19,0xbf,
+    0x07,0xaf,0x4a,0xd3,0x93,0x01,0xe7,0xb6,0x01,0x84,0xca,0x01,0x80,0x0f,0xd0,0x32,
+    0x98,0x3e,0x80,0x14,0x93,0x3c,0xf3,0x71,0xd0,0xe0,0x03,0xdc,0x15,0xc0,0x2a,0xc4,
+    0x36,0xa4,0x21,0x8b,0x0b,0x9f,0x29,0xac,0xb4,0x05,0xf0,0x01,0x8c,0x0b,0xd0,0x0a,
+    0xac,0x07,0xa0,0x0b,0xe0,0x12,0x8b,0xec,0x03,0xb8,0x35,0xea,0x55,0xf2,0x6b,0xb8,
+    0x6c,0xd6,0x53,0xd8,0x3b,0xde,0xd6,0x01,0xd3,0x14,0xa7,0x1d,0xa1,0x23,0xd9,0x26,
+    0xab,0x28,0xed,0x24,0x9e,0x8e,0x01,0xcd,0x18,0xb5,0x1c,0xa1,0x1c,0xa7,0x19,0xff,
+    0x15,0xe1,0x12,0xb8,0x4e,0x91,0x0d,0xd9,0x12,0x93,0x15,0xf1,0x12,0xcd,0x0d,0xcf,
+    0x09,0xae,0x2a,0xcd,0x04,0xf1,0x0a,0xa9,0x10,0xdf,0x10,0xbf,0x0b,0xf7,0x06,0x96,
+    0x1c,0x7d,0xa9,0x06,0x87,0x0d,0xbf,0x10,0xa7,0x0d,0xd7,0x08,0x8c,0x1f,0x77,0x8d,
+    0x06,0xef,0x0c,0x95,0x12,0xed,0x10,0xdf,0x0b,0x9f,0xc8,0x07,0xe7,0x1c,0xd1,0x16,
+    0x85,0x0a,0xe0,0x05,0x82,0x10,0xb6,0x0f,0xb6,0x8a,0x01,0xb6,0x0e,0xa8,0x0a,0xac,
+    0x08,0xc6,0x09,0xc0,0x08,0xe4,0x01,0xce,0xf2,0x01,0xf0,0x05,0xfa,0x01,0x1f,0xb6,
+    0x01,0xf6,0x01,0xd7,0x03,0xe8,0xd0,0x02,0xc0,0x01,0x5b,0xf9,0x03,0x8f,0x05,0xd7,
+    0x05,0x93,0x09,0xae,0xfc,0x02,0xa2,0x02,0xa6,0x02,0xcd,0x01,0x83,0x08,0xeb,0x0b,
+    0xb5,0x0b,0xb0,0xd9,0x02,0xec,0x02,0xe2,0x04,0xea,0x02,0xe9,0x04,0xed,0x0a,0xcd,
+    0x08,0xfe,0x8b,0x02,0xfa,0x02,0xb2,0x04,0x96,0x04,0x5d,0xdf,0x05,0xcb,0x04,0xa0,
+    0x97,0x33,0xbc,0x87,0x06,0x98,0x8c,0x05,0xd8,0xee,0x03,0xcc,0xb9,0x02,0xc0,0x98,
+    0x01,0xcc,0x2b,0x9b,0xc7,0x01,0xcf,0x6e,0xcf,0x6e,0xb3,0x7e,0xcf,0x96,0x01,0xaf,
+    0x90,0x01,0xeb,0x59,0xab,0x9a,0x02,0x87,0xa4,0x01,0xa7,0x82,0x01,0x97,0x70,0x83,
+    0x6b,0x97,0x5c,0xc3,0x3b,0x97,0xbb,0x01,0xe7,0xa7,0x01,0x8b,0x83,0x01,0xbb,0x5a,
+    0xdb,0x2e,0x83,0x16,0xb3,0x1f,0xe4,0xaf,0x01,0xc7,0x74,0xfb,0x5c,0xcf,0x37,0xdb,
+    0x06,0x88,0x09,0xcb,0x21,0xa8,0xc4,0x04,0xab,0x2a,0x97,0x1b,0xbb,0x05,0xf4,0x0d,
+    0xf4,0x03,0xa7,0x2d,0xa4,0xf1,0x05,0x90,0x17,0xc8,0x1a,0xf8,0x1e,0xec,0x18,0x78,
+    0xdb,0x1f,0xee,0x06,0x8c,0x36,0x8c,0x38,0xd8,0x35,0xe0,0x2d,0xba,0x20,0xea,0x11,
+    0xcc,0x0d,0xf7,0x1a,0xdf,0x10,0xef,0x0a,0xa7,0x07,0x8b,0x05,0xb5,0x04,0x91,0x05,
+    0xcf,0x0c,0xb7,0x06,0xe5,0x03,0xcb,0x02,0xe7,0x01,0xfb,0x02,0xd7,0x10,0xa1,0x06,
+    0xbd,0x02,0x1c,0x86,0x02,0x84,0x03,0x7c,0xd3,0x18,0xd7,0x05,0xc7,0x03,0x80,0x01,
+    0xb2,0x05,0x9c,0x08,0xba,0x07,0xd9,0x1e,0xd3,0x07,0x81,0x06,0x51,0xa2,0x05,0x82,
+    0x0a,0x92,0x0d,0xcd,0x23,0xdb,0x08,0xb7,0x06,0xeb,0x01,0xfe,0x02,0xea,0x07,0xb4,
+    0x0e,0xc7,0xe0,0x07,0xde,0x0b,0xfc,0x0c,0xae,0x12,0x8c,0x19,0x80,0x1f,0xcc,0x21,
+    0xaa,0xbf,0x01,0x97,0x04,0xe5,0x03,0x21,0xa2,0x03,0xa6,0x06,0x98,0x07,0xec,0xf9,
+    0x01,0xc3,0x08,0xbd,0x05,0x68,0xf2,0x05,0x98,0x0a,0xda,0x0b,0xd6,0xb9,0x02,0x87,
+    0x0c,0xfb,0x08,0xb9,0x02,0xb8,0x03,0xf0,0x08,0xb8,0x0b,0x82,0xe0,0x02,0xfd,0x0a,
+    0xdb,0x0b,0xad,0x0a,0xe7,0x06,0xbb,0x02,0x7c,0xc2,0xcb,0x02,0xe5,0x05,0xd1,0x09,
+    0xcb,0x0e,0x9d,0x10,0x95,0x10,0xd7,0x0d,0xb6,0x8c,0x02,0xf3,0x01,0x81,0x05,0xa3,
+    0x0b,0xb7,0x10,0xbb,0x14,0xcb,0x14,0xa4,0x97,0x46,0x93,0x28,0xc7,0x7e,0xfb,0xcf,
+    0x01,0x87,0x97,0x02,0xbf,0xd1,0x02,0xaf,0xf1,0x02,0xdb,0xa3,0x07,0xf7,0x1e,0x83,
+    0x02,0x80,0x0a,0x88,0x13,0xac,0x1b,0x84,0x25,0xd3,0xb3,0x07,0xe7,0x1b,0x9b,0x09,
+    0xf8,0x05,0xdc,0x1a,0xe4,0x32,0x94,0x46,0xdb,0xa4,0x05,0xcf,0x2d,0xbf,0x25,0xfb,
+    0x0c,0xfc,0x16,0xb0,0x40,0xbc,0x5f,0xcf,0x78,0xc3,0x4f,0xcb,0x4e,0xbb,0x2d,0x8f,
+    0x03,0x9c,0x2c,0xd0,0x50,0xe8,0xdd,0x03,0xd3,0x5c,0xcf,0x64,0x83,0x4d,0xd3,0x2a,
+    0xab,0x07,0x9c,0x18,0xfc,0xbb,0x06,0xdf,0x3a,0x9f,0x47,0xfb,0x43,0x93,0x37,0xdb,
+    0x29,0xc3,0x18,0xcc,0x62,0xf4,0x20,0xd6,0x17,0x88,0x14,0xba,0x0e,0xb4,0x01,0x83,
+    0x11,0xfd,0x1f,0x9e,0x13,0xd4,0x14,0xb0,0x0f,0xa4,0x08,0xf0,0x02,0xb7,0x02,0xaf,
+    0x1a,0x98,0x0e,0xd0,0x10,0x8a,0x0f,0xe6,0x0a,0xbe,0x05,0xa7,0x01,0xe7,0x11,0xae,
+    0x09,0xf8,0x0a,0x84,0x0c,0x88,0x0c,0xa8,0x09,0xa2,0x01,0xaf,0x14,0xc0,0x07,0xdc,
+    0x07,0xa2,0x08,0xd4,0x08,0xa6,0x06,0xf9,0x03,0xed,0x42,0x69,0x83,0x04,0x8f,0x0a,
+    0xb3,0x15,0x91,0x2b,0xbb,0x52,0xa5,0x9c,0x14,0xf2,0x49,0xd6,0x50,0xc8,0x5f,0xb4,
+    0x7b,0x82,0xae,0x01,0x98,0x86,0x02,0x90,0xa5,0x05,0x96,0x21,0xca,0x1c,0xc8,0x19,
+    0xd0,0x1b,0x9a,0x1f,0xac,0x20,0xca,0x98,0x01,0xbb,0x0d,0xd9,0x05,0x05,0xbc,0x01,
+    0x90,0x01,0x5c,0xc6,0x89,0x01,0xfb,0x08,0x89,0x05,0xcd,0x01,0x23,0x4d,0xa1,0x01,
+    0xba,0x87,0x01,0xb9,0x04,0xcd,0x04,0xc7,0x04,0xcf,0x04,0xd7,0x04,0xcb,0x04,0xf6,
+    0x80,0x01,0xc3,0x02,0xdb,0x04,0xd7,0x06,0x8f,0x08,0xe7,0x08,0xd3,0x08,0xf8,0x6e,
+    0xcb,0x02,0x8b,0x05,0xad,0x07,0xa3,0x09,0xdb,0x0a,0xd5,0x0b,0xe4,0x23,0x93,0x01,
+    0xaf,0x03,0xa5,0x05,0xe3,0x06,0xbf,0x07,0xef,0x06,0x90,0xba,0x2d,0xa4,0x08,0xf4,
+    0x53,0xd8,0x9a,0x01,0x84,0xde,0x01,0xcc,0x8c,0x02,0xa0,0x94,0x02,0xd4,0x8e,0x06,
+    0xfb,0x0c,0xd8,0x0e,0xd0,0x23,0xac,0x25,0xd8,0x18,0xa8,0x0a,0x88,0xb5,0x07,0xeb,
+    0x09,0xbb,0x0f,0xf7,0x14,0xa7,0x1e,0xbf,0x2a,0xdb,0x33,0xc8,0xec,0x06,0xe3,0x05,
+    0xe3,0x28,0xab,0x48,0xc3,0x5e,0x8f,0x67,0xc3,0x63,0xa4,0x8b,0x04,0x87,0x09,0xe3,
+    0x2d,0xb7,0x4e,0xe3,0x64,0x8f,0x6c,0xcf,0x64,0x98,0x61,0xc0,0x02,0x87,0x13,0xbf,
+    0x25,0xeb,0x31,0xd7,0x36,0xe3,0x32,0x97,0xa7,0x01,0xf0,0x1a,0xc0,0x16,0xf4,0x12,
+    0x8c,0x10,0x94,0x0f,0x8c,0x10,0x88,0xae,0x01,0xd5,0x26,0x8b,0x41,0xab,0x5b,0xc9,
+    0x63,0x81,0x4e,0x83,0x25,0x80,0x20,0xb9,0x09,0x97,0x10,0xef,0x11,0xed,0x0a,0x6a,
+    0xa6,0x08,0xbe,0x22,0xbb,0x0a,0x95,0x14,0xf3,0x17,0xbf,0x10,0xc3,0x04,0xb2,0x02,
+    0x94,0x25,0x81,0x0e,0xdf,0x20,0xfb,0x27,0x89,0x19,0xc7,0x05,0xc8,0x03,0x8e,0x0e,
+    0xc5,0x1c,0x8d,0x3e,0xa7,0x3f,0xad,0x13,0xa8,0x0d,0xce,0x14,0xed,0xe4,0x01,0xdd,
+    0x7b,0xb9,0x4e,0xa6,0x33,0x8e,0x67,0x8e,0x53,0x90,0x38,0xc7,0xf2,0x0d,0x92,0xfd,
+    0x02,0x82,0xaf,0x03,0xae,0xd5,0x02,0xc2,0xe0,0x01,0x8e,0x93,0x01,0xa6,0x66,0xce,
+    0xd7,0x06,0xb2,0x1e,0x94,0x18,0xe6,0x09,0x8f,0x0d,0xe7,0x25,0x99,0x38,0xd6,0x88,
+    0x01,0x1b,0xf7,0x01,0xd7,0x02,0x33,0xc8,0x05,0x80,0x0e,0xde,0x77,0xf1,0x01,0xb3,
+    0x02,0xdf,0x01,0x8c,0x01,0xca,0x05,0xc8,0x09,0xf6,0x6b,0xb7,0x04,0x8f,0x04,0xeb,
+    0x02,0x38,0xc0,0x04,0xec,0x06,0xb2,0x59,0xe7,0x07,0xc1,0x06,0x9f,0x04,0x01,0xb2,
+    0x04,0xbe,0x06,0x9c,0x40,0x91,0x0c,0xdd,0x0a,0x8f,0x05,0x96,0x02,0xec,0x06,0xb6,
+    0x08,0xe6,0x04,0xf1,0x03,0xc8,0x01,0xee,0x06,0xec,0x09,0xf8,0x0a,0xf2,0x0a,0xf0,
+    0xaf,0x35,0x98,0xf2,0x01,0xbc,0xa5,0x01,0xbc,0x28,0xdf,0x71,0xef,0xf1,0x01,0x83,
+    0xa4,0x02,0xac,0xfc,0x06,0xa0,0x01,0x97,0x02,0x8c,0x01,0xcc,0x08,0x94,0x0a,0xb4,
+    0x01,0xa4,0x8a,0x06,0xff,0x36,0xa3,0x30,0xe3,0x19,0xe8,0x07,0xd8,0x22,0xac,0x25,
+    0xbc,0xcc,0x03,0xab,0x57,0xa7,0x41,0x93,0x1e,0xf4,0x0d,0x98,0x34,0xc0,0x43,0xbc,
+    0x50,0xf7,0x50,0x97,0x34,0x9f,0x10,0x90,0x17,0xac,0x39,0xb8,0x4e,0x97,0x70,0x87,
+    0x27,0xe3,0x14,0x84,0x02,0xa0,0x1a,0xe0,0x30,0xf8,0x41,0xc7,0x33,0xf4,0x12,0xa4,
+    0x17,0xcc,0x1c,0x88,0x22,0xe0,0x26,0xb4,0x29,0xd5,0xeb,0x01,0x8e,0x05,0xfe,0x23,
+    0xb8,0x34,0xb8,0x3a,0x84,0x37,0xce,0x29,0x9f,0x0d,0x92,0x08,0x92,0x04,0x88,0x01,
+    0x0d,0x72,0x8a,0x04,0xd9,0x26,0xec,0x03,0xea,0x03,0xaa,0x04,0xfa,0x04,0xac,0x06,
+    0xdc,0x09,0xd3,0x4c,0xda,0x05,0xde,0x06,0xbc,0x08,0xca,0x0a,0xb0,0x0d,0xc4,0x11,
+    0xa5,0x7d,0xf4,0x12,0xf6,0x10,0xc4,0x10,0xcc,0x11,0xfe,0x13,0xcc,0x17,0xb3,0x89,
+    0x01,0xc4,0x26,0xd4,0x1c,0xc4,0x17,0xa4,0x15,0xfa,0x14,0x82,0x16,0x8f,0x97,0x01,
+    0x82,0x4c,0xfe,0x3b,0xf2,0x31,0xc2,0x2b,0xd6,0x27,0xda,0x25,0xe8,0xac,0x06,0xeb,
+    0x3f,0xa7,0x3b,0x99,0x2d,0xb9,0x19,0xc1,0x03,0x8a,0x0d,0xfe,0x96,0x01,0xb4,0x15,
+    0xda,0x17,0x8a,0x14,0xca,0x0c,0xb6,0x03,0x87,0x03,0xf6,0x81,0x01,0xc0,0x0b,0xfe,
+    0x0a,0xcc,0x08,0xdc,0x04,0x19,0x97,0x04,0xa6,0x6c,0xd6,0x06,0xf2,0x04,0xcc,0x02,
+    0x0c,0xb7,0x02,0xa7,0x04,0xd6,0x51,0x8a,0x06,0x9a,0x04,0xec,0x01,0x2d,0x8b,0x02,
+    0x8d,0x03,0xd4,0x35,0x86,0x08,0xd0,0x06,0xde,0x04,0xee,0x02,0x94,0x01,0x0b,0x80,
+    0x29,0x92,0x0a,0xf4,0x08,0xae,0x07,0xc8,0x05,0xd6,0x03,0xd8,0x01,0xac,0xe8,0x33,
+    0x8b,0x80,0x02,0xdb,0xa6,0x01,0xc7,0x47,0xe0,0x08,0xb4,0x51,0xdc,0x88,0x01,0xd4,
+    0x90,0x07,0xbb,0x0f,0x9b,0x22,0xbb,0x2d,0x97,0x2f,0x97,0x2f,0xdf,0x2b,0x88,0xd9,
+    0x05,0xdc,0x10,0xd3,0x0c,0xd7,0x22,0xf7,0x2d,0x8f,0x35,0xd7,0x36,0xa0,0x9b,0x03,
+    0xc8,0x38,0x9c,0x1d,0x8c,0x01,0xff,0x13,0xf3,0x21,0xc3,0x27,0x80,0x5a,0xb4,0x51,
+    0xec,0x45,0xbc,0x32,0xb8,0x1c,0xcc,0x08,0x9f,0x06,0x87,0x1d,0xa8,0x4b,0xa0,0x4c,
+    0xcc,0x44,0xd8,0x36,0xf8,0x23,0xec,0x0e,0xb8,0x85,0x01,0xc8,0x29,0xa4,0x26,0xc8,
+    0x1f,0xa0,0x15,0xa4,0x08,0xab,0x07,0xf8,0x0c,0x9c,0x1b,0x9e,0x14,0xfe,0x0c,0xbb,
+    0x01,0x91,0x0d,0xe9,0x0d,0xfa,0x04,0xc8,0x05,0xda,0x03,0xce,0x04,0xa8,0x0a,0xc6,
+    0x0c,0xb4,0x06,0xd7,0x05,0xec,0x0c,0x9e,0x0d,0xd2,0x0d,0x96,0x10,0x92,0x10,0xf6,
+    0x08,0xa1,0x0e,0xe8,0x15,0x8e,0x18,0x88,0x18,0xea,0x16,0xfc,0x13,0xac,0x0d,0xe1,
+    0x0b,0xc8,0x1b,0x9c,0x1e,0xd6,0x1e,0xc0,0x1d,0xf8,0x1b,0xf0,0x19,0xc8,0x11,0xf6,
+    0x17,0xac,0x1a,0x92,0x1d,0x82,0x21,0x94,0x27,0xb8,0x31,0xd4,0x9b,0x01,0xaa,0x25,
+    0xb4,0x26,0x92,0x29,0xf2,0x2d,0xd2,0x35,0x8c,0x42,0xc8,0xf4,0x04,0xb6,0x13,0x96,
+    0x16,0xce,0x1a,0xdc,0x19,0xd6,0x0f,0x94,0x05,0x8e,0xe5,0x01,0xe3,0x04,0xb9,0x06,
+    0xa5,0x0a,0xb1,0x0a,0x99,0x04,0x92,0x02,0xaa,0xa1,0x01,0xb9,0x05,0xbb,0x05,0xeb,
+    0x05,0xdf,0x04,0x61,0xcc,0x03,0xe6,0x73,0xdd,0x04,0xf5,0x03,0xd9,0x02,0x8b,0x01,
+    0x84,0x01,0xa0,0x03,0x9e,0x58,0x95,0x03,0xb7,0x02,0xa7,0x01,0x2b,0x26,0x52,0xfe,
+    0x4c,0x79,0xc3,0x01,0x87,0x02,0xe1,0x02,0xdb,0x03,0xdf,0x04,0xaa,0x4e,0x29,0xad,
+    0x02,0xb1,0x04,0xaf,0x06,0xa7,0x08,0x83,0x0a,0xec,0xdc,0x31,0xd8,0x9a,0x01,0xc0,
+    0x98,0x01,0x90,0xa3,0x01,0xe4,0xb4,0x01,0xb4,0xba,0x01,0xc4,0xbd,0x01,0xb0,0xa7,
+    0x05,0xf7,0x1e,0x83,0x11,0x9f,0x0b,0x4f,0xe4,0x19,0x94,0x32,0xd8,0xa0,0x04,0x8f,
+    0x2b,0xaf,0x18,0x87,0x09,0xec,0x04,0xc8,0x15,0xb0,0x22,0xd8,0x94,0x03,0xf3,0x21,
+    0xa7,0x14,0xa3,0x08,0xf3,0x03,0xd3,0x07,0xe3,0x0f,0xc0,0xc2,0x02,0xbb,0x0f,0xbb,
+    0x14,0xc7,0x1a,0xdf,0x26,0xdb,0x38,0xc3,0x4a,0xc8,0xa8,0x02,0xbf,0x07,0x93,0x1e,
+    0xe7,0x34,0xff,0x4a,0xdf,0x5d,0xa7,0x69,0x84,0x8b,0x02,0xdf,0x17,0x93,0x28,0x93,
+    0x37,0xab,0x43,0xcf,0x4b,0xb7,0x4e,0xf8,0x2c,0xbf,0x0b,0xf7,0x0d,0x87,0x13,0xf1,
+    0x19,0xf9,0x21,0xf7,0x20,0x8c,0x30,0xd7,0x02,0xaf,0x0a,0xcf,0x11,0xcb,0x16,0xdb,
+    0x14,0xc3,0x0d,0xa2,0x4b,0xa3,0x03,0xf9,0x0f,0xd7,0x1a,0xbd,0x1f,0x9f,0x1a,0xa9,
+    0x0e,0xee,0x6f,0x98,0x01,0xed,0x10,0xf9,0x24,0xbf,0x2f,0xa9,0x26,0xed,0x11,0x80,
+    0xa0,0x01,0x8a,0x14,0x86,0x03,0xdd,0x20,0xbd,0x48,0x8b,0x49,0xe7,0x26,0xca,0xda,
+    0x01,0xba,0x41,0x88,0x56,0xb4,0x5d,0x92,0x16,0xbd,0xa0,0x01,0xd3,0xd4,0x01,0x94,
+    0xb6,0x03,0x80,0x57,0xa2,0x7c,0xf4,0xc3,0x01,0x88,0xce,0x02,0x8a,0xfd,0x03,0xb0,
+    0xe6,0x03,0xa8,0xe7,0x05,0x86,0x01,0x2e,0x41,0xff,0x01,0xd9,0x07,0xa1,0x14,0x90,
+    0xc3,0x01,0xb4,0x04,0xb6,0x04,0xc2,0x03,0x40,0xbd,0x02,0xe5,0x01,0xd2,0x8e,0x01,
+    0xc4,0x05,0x8e,0x05,0xa0,0x03,0x48,0x87,0x01,0x00,0xd0,0x6b,0xce,0x04,0xe0,0x04,
+    0xbc,0x03,0xbe,0x01,0x4a,0xfe,0x01,0xf4,0x51,0x8e,0x01,0xf8,0x01,0x8a,0x03,0xdc,
+    0x03,0x92,0x04,0xba,0x05,0x9a,0x3d,0xa3,0x05,0xad,0x04,0x65,0xbe,0x05,0xba,0x0a,
+    0xee,0x0a,0xc4,0x2e,0xb5,0x0b,0x9b,0x0c,0xff,0x0b,0xdf,0x09,0xf5,0x03,0xe2,0x03,
+    0xf0,0xdf,0x39,0x98,0xc5,0x01,0xc8,0xba,0x01,0xbc,0x87,0x01,0xa0,0x29,0x97,0x5c,
+    0xe7,0xf7,0x01,0xbc,0xb7,0x05,0x80,0x37,0xa0,0x2e,0x88,0x22,0xec,0x13,0x98,0x07,
+    0xcc,0x03,0xf4,0x90,0x04,0xec,0x22,0xbc,0x19,0x9c,0x0e,0x88,0x09,0xc0,0x11,0x8c,
+    0x29,0xec,0xba,0x02,0xcb,0x17,0xcf,0x19,0xb7,0x12,0x64,0x90,0x21,0xc0,0x48,0x80,
+    0x5a,0xe7,0x52,0xff,0x4a,0x9b,0x31,0xf3,0x08,0xb8,0x26,0xc0,0x52,0xfb,0x43,0xeb,
+    0x68,0xa7,0x5a,0x83,0x3e,0xc3,0x18,0xd0,0x0f,0xbc,0x32,0xb7,0x49,0xe3,0x4b,0xab,
+    0x43,0x87,0x36,0xbf,0x25,0xd7,0x13,0xab,0x02,0xab,0x5c,0xe5,0x0d,0xb4,0x0e,0xe0,
+    0x25,0xc4,0x33,0xd2,0x36,0xb4,0x2e,0xb7,0x27,0xc3,0x07,0xff,0x03,0x6f,0xfe,0x01,
+    0xd2,0x05,0x9e,0x0c,0xdb,0x2a,0xbb,0x04,0x2e,0xaa,0x02,0xb8,0x03,0xaa,0x05,0xae,
+    0x09,0xb9,0x2c,0xa3,0x02,0x8c,0x04,0xbc,0x05,0xcc,0x05,0x96,0x06,0xcc,0x07,0xff,
+    0x21,0xff,0x0a,0x66,0xb6,0x04,0xd4,0x05,0xc6,0x06,0x9a,0x07,0xc0,0x70,0xf1,0x6f,
+    0x99,0x2c,0xd1,0x10,0xd3,0x05,0x91,0x01,0x16,0xec,0xfe,0x10,0x9c,0xb3,0x02,0xe6,
+    0xb8,0x01,0xe6,0x7b,0xda,0x5d,0xf7,0xa9,0x2b,0xa4,0x49,0x9e,0xca,0x05,0xdd,0x1f,
+    0xd3,0x1f,0xe3,0x13,0xe5,0x01,0xa0,0x11,0xce,0x1e,0xd8,0xcb,0x01,0x28,0x7f,0xc7,
+    0x05,0xfd,0x0a,0x89,0x10,0xe5,0x11,0x84,0x9c,0x01,0x98,0x02,0xb0,0x02,0x11,0x9f,
+    0x04,0xa3,0x08,0xaf,0x0a,0xc0,0x7c,0xa4,0x04,0xa8,0x05,0x9c,0x04,0xda,0x01,0x95,
+    0x01,0xb1,0x03,0xac,0x65,0x82,0x07,0xbc,0x07,0xbe,0x06,0xcc,0x04,0x9a,0x02,0x17,
+    0xc8,0x4d,0xf8,0x09,0xea,0x08,0x96,0x07,0xfc,0x04,0xc4,0x02,0x07,0x7e,0x80,0x08,
+    0xd6,0x08,0xce,0x07,0xe2,0x05,0xc6,0x03,0x9a,0x01,0xac,0xbc,0x3b,0xbb,0xf7,0x02,
+    0xe3,0xa9,0x03,0xbb,0x8b,0x03,0x9f,0xb7,0x02,0xeb,0xc7,0x01,0xb3,0x56,0xb4,0xdd,
+    0x06,0xd8,0x04,0x3b,0xeb,0x09,0xcb,0x12,0xc7,0x1a,0xfb,0x1b,0x8c,0x9f,0x05,0x94,
+    0x41,0x9c,0x4a,0xd0,0x41,0xc8,0x2e,0xb8,0x17,0xfc,0x02,0xcc,0xe1,0x02,0xf8,0x69,
+    0xe4,0x78,0x9c,0x72,0xdc,0x5b,0xdc,0x3d,0xcc,0x1c,0xff,0x04,0xfc,0x70,0xcc,0x7b,
+    0x88,0x72,0xe4,0x5a,0x94,0x3c,0xdc,0x1a,0xcb,0x9b,0x02,0xc4,0x4a,0xb0,0x54,0xa0,
+    0x51,0xac,0x43,0xfc,0x2f,0xa8,0x19,0x93,0xca,0x02,0x98,0x0c,0xa4,0x17,0x94,0x1e,
+    0xb8,0x21,0x90,0x21,0xe4,0x1e,
+};
@@ -0,0 +1,81 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Declination/AP_Declination.h>
+
+/*
+  field at grid points of the tables, as produced by
+  AP_Declination/generate/generate.py before quantisation
+ */
+static const struct {
+    float lat, lon;
+    float declination_deg, inclination_deg, intensity_gauss;
+} grid_data[] = {
+    {20, -80, -6.41113, 48.13476, 0.39568},
+    {40, -140, 14.16020, 59.32146, 0.45724},
+    {-60, 170, 49.03265, -79.58616, 0.63614},
+    {-50, 60, -56.36644, -65.97595, 0.44206},
+    {-70, 150, 138.00554, -85.63251, 0.65477},
+    {-20, -150, 13.78998, -34.84704, 0.36941},
+    {-60, 100, -76.14220, -79.66218, 0.62009},
+    {50, -130, 16.72460, 69.13404, 0.52913},
+    {-10, -120, 9.70494, -9.56551, 0.29696},
+    {50, -140, 16.10049, 67.10373, 0.51308},
+    {-50, -30, -12.19989, -58.07793, 0.25610},
+    {-70, 80, -85.16746, -72.60073, 0.55321},
+    {-70, -30, -1.45095, -60.08698, 0.37722},
+    {-70, -90, 34.85457, -63.61481, 0.46274},
+    {10, 90, -1.18564, 6.96852, 0.42060},
+    {-40, 170, 21.33469, -66.38361, 0.56327},
+};
+
+// grid points must come back within the quantisation of the tables
+TEST(Declination, grid_points)
+{
+    for (const auto &d : grid_data) {
+        float intensity_gauss, declination_deg, inclination_deg;
+        EXPECT_TRUE(AP_Declination::get_mag_field_ef(d.lat, d.lon, intensity_gauss, declination_deg, inclination_deg));
+        EXPECT_NEAR(declination_deg, d.declination_deg, 0.001);
+        EXPECT_NEAR(inclination_deg, d.inclination_deg, 0.001);
+        EXPECT_NEAR(intensity_gauss, d.intensity_gauss, 0.00001);
+    }
+}
+
+/*
+  the field must be continuous across grid lines, which includes the
+  edges of the tiles the tables are stored in
+ */
+TEST(Declination, tile_edges)
+{
+    const float delta = 0.001;
+    for (float lat = -80; lat <= 80; lat += 10) {
+        for (float lon = -170; lon <= 170; lon += 1) {
+            float i1, d1, n1, i2, d2, n2;
+            AP_Declination::get_mag_field_ef(lat - delta, lon, i1, d1, n1);
+            AP_Declination::get_mag_field_ef(lat + delta, lon, i2, d2, n2);
+            EXPECT_NEAR(d1, d2, 0.05);
+            EXPECT_NEAR(n1, n2, 0.05);
+            EXPECT_NEAR(i1, i2, 0.0001);
+
+            // and the same along lines of longitude
+            AP_Declination::get_mag_field_ef(lon * 0.5, lat * 2 - delta, i1, d1, n1);
+            AP_Declination::get_mag_field_ef(lon * 0.5, lat * 2 + delta, i2, d2, n2);
+            EXPECT_NEAR(d1, d2, 0.05);
+            EXPECT_NEAR(n1, n2, 0.05);
+            EXPECT_NEAR(i1, i2, 0.0001);
+        }
+    }
+}
+
+TEST(Declination, out_of_range)
+{
+    float intensity_gauss, declination_deg, inclination_deg;
+    EXPECT_FALSE(AP_Declination::get_mag_field_ef(90, 0, intensity_gauss, declination_deg, inclination_deg));
+    EXPECT_FALSE(AP_Declination::get_mag_field_ef(-90, 0, intensity_gauss, declination_deg, inclination_deg));
+    EXPECT_FALSE(AP_Declination::get_mag_field_ef(0, 180, intensity_gauss, declination_deg, inclination_deg));
+    EXPECT_FALSE(AP_Declination::get_mag_field_ef(0, -180, intensity_gauss, declination_deg, inclination_deg));
+    EXPECT_TRUE(AP_Declination::get_mag_field_ef(89.9, 179.9, intensity_gauss, declination_deg, inclination_deg));
+}
+
+AP_GTEST_MAIN()
+int hal = 0;
@@ -24,9 +24,11 @@
 #include "AP_Filesystem_Param.h"
 #include <AP_Param/AP_Param.h>
 #include <AP_Math/AP_Math.h>
+#include <AP_Math/crc.h>
 #include <ctype.h>
 
 #define PACKED_NAME "param.pck"
+#define CRC_NAME "param.crc"
 
 extern const AP_HAL::HAL& hal;
 
@@ -42,6 +44,11 @@ int AP_Filesystem_Param::open(const char *fname, int flags, bool allow_absolute_
         return -1;
     }
     bool read_only = ((flags & O_ACCMODE) == O_RDONLY);
+    const bool crc_file = is_crc_file(fname);
+    if (crc_file && !read_only) {
+        errno = EINVAL;
+        return -1;
+    }
     uint8_t idx;
     for (idx=0; idx<max_open_file; idx++) {
         if (!file[idx].open) {
@@ -53,7 +60,7 @@ int AP_Filesystem_Param::open(const char *fname, int flags, bool allow_absolute_
         return -1;
     }
     struct rfile &r = file[idx];
-    if (read_only) {
+    if (read_only && !crc_file) {
         r.cursors = NEW_NOTHROW cursor[num_cursors];
         if (r.cursors == nullptr) {
             errno = ENOMEM;
@@ -63,11 +70,25 @@ int AP_Filesystem_Param::open(const char *fname, int flags, bool allow_absolute_
     r.file_ofs = 0;
     r.open = true;
     r.with_defaults = false;
+    r.compact = false;
+    r.delta = false;
     r.start = 0;
     r.count = 0;
     r.read_size = 0;
     r.file_size = 0;
     r.writebuf = nullptr;
+    r.crc_data = nullptr;
+#if AP_FILESYSTEM_PARAM_CACHE_ENABLED
+    r.image = nullptr;
+#endif
+    if (crc_file) {
+        if (!build_crc_data(r)) {
+            close(idx);
+            errno = ENOMEM;
+            return -1;
+        }
+        return idx;
+    }
     if (!read_only) {
         // setup for upload
         r.writebuf = NEW_NOTHROW ExpandingString();
@@ -116,12 +137,36 @@ int AP_Filesystem_Param::open(const char *fname, int flags, bool allow_absolute_
             continue;
         }
 #endif
+        if (strncmp(c, "compact=", 8) == 0) {
+            uint32_t v = strtoul(c+8, nullptr, 10);
+            if (v > 1) {
+                goto failed;
+            }
+            r.compact = v == 1;
+            c += 8;
+            c = strchr(c, '&');
+            continue;
+        }
+        if (strncmp(c, "chunks=", 7) == 0) {
+            if (!parse_chunk_mask(r, c+7)) {
+                goto failed;
+            }
+            c += 7;
+            c = strchr(c, '&');
+            continue;
+        }
+    }
+
+    if (r.delta && (r.start != 0 || r.count != 0)) {
+        // chunk selection works on the full parameter list
+        goto failed;
     }
 
     return idx;
 
 failed:
     delete [] r.cursors;
+    r.cursors = nullptr;
     r.open = false;
     errno = EINVAL;
     return -1;
@@ -144,6 +189,14 @@ int AP_Filesystem_Param::close(int fd)
     r.cursors = nullptr;
     delete r.writebuf;
     r.writebuf = nullptr;
+    delete [] r.crc_data;
+    r.crc_data = nullptr;
+#if AP_FILESYSTEM_PARAM_CACHE_ENABLED
+    if (r.image != nullptr) {
+        WITH_SEMAPHORE(cache_sem);
+        release_image(r.image);
+    }
+#endif
     return ret;
 }
 
@@ -158,6 +211,7 @@ int AP_Filesystem_Param::close(int fd)
 
     uint8_t type:4;         // AP_Param type NONE=0, INT8=1, INT16=2, INT32=3, FLOAT=4
     uint8_t flags:4;        // bit 0: includes default value for this param
+                            // bit 1: value is zero and data is omitted (compact=1)
     uint8_t common_len:4;   // number of name bytes in common with previous entry, 0..15
     uint8_t name_len:4;     // non-common length of param name -1 (0..15)
     uint8_t name[name_len]; // name
@@ -191,6 +245,11 @@ uint8_t AP_Filesystem_Param::pack_param(const struct rfile &r, struct cursor &c,
         c.idx++;
         ap = AP_Param::next_scalar(&c.token, &ptype, &default_val);
     }
+    // skip parameters not in a requested chunk
+    while (ap != nullptr && !param_selected(r, c.idx)) {
+        c.idx++;
+        ap = AP_Param::next_scalar(&c.token, &ptype, &default_val);
+    }
     if (ap == nullptr || (r.count && c.idx >= r.count)) {
         if (r.count == 0 && c.idx != AP_Param::count_parameters()) {
             // the parameter count is incorrect, invalidate so a
@@ -221,15 +280,26 @@ uint8_t AP_Filesystem_Param::pack_param(const struct rfile &r, struct cursor &c,
     const bool add_default = false;
 #endif
     const uint8_t type_len = AP_Param::type_size(ptype);
-    uint8_t packed_len = type_len + name_len + 2 + (add_default ? type_len : 0);
-    const uint8_t flags = add_default;
+    bool zero_value = false;
+    if (r.compact && !add_default) {
+        zero_value = true;
+        for (uint8_t i=0; i<type_len; i++) {
+            if (((const uint8_t *)ap)[i] != 0) {
+                zero_value = false;
+                break;
+            }
+        }
+    }
+    const uint8_t value_len = zero_value ? 0 : type_len;
+    uint8_t packed_len = value_len + name_len + 2 + (add_default ? type_len : 0);
+    const uint8_t flags = (add_default ? 1 : 0) | (zero_value ? 2 : 0);
 
     /*
       see if we need to add padding to ensure that a data field never
       crosses a block boundary. This ensures that re-reading a block
       won't get a corrupt value for a parameter
      */
-    if (type_len > 1) {
+    if (value_len > 1) {
         const uint32_t ofs = c.token_ofs + sizeof(struct header) + packed_len;
         const uint32_t ofs_mod = ofs % r.read_size;
         if (ofs_mod > 0 && ofs_mod < type_len) {
@@ -243,7 +313,7 @@ uint8_t AP_Filesystem_Param::pack_param(const struct rfile &r, struct cursor &c,
     buf[0] = uint8_t(ptype) | (flags<<4);
     buf[1] = common_len | ((name_len-1)<<4);
     memcpy(&buf[2], pname, name_len);
-    memcpy(&buf[2+name_len], ap, type_len);
+    memcpy(&buf[2+name_len], ap, value_len);
 #if AP_PARAM_DEFAULTS_ENABLED
     if (add_default) {
         switch (ptype) {
@@ -276,6 +346,8 @@ uint8_t AP_Filesystem_Param::pack_param(const struct rfile &r, struct cursor &c,
 #endif
 
     strcpy(c.last_name, name);
+    c.last_ap = ap;
+    c.last_type = ptype;
 
     return packed_len;
 }
@@ -333,6 +405,15 @@ int32_t AP_Filesystem_Param::read(int fd, void *buf, uint32_t count)
         errno = EINVAL;
         return -1;
     }
+    if (r.crc_data != nullptr) {
+        if (r.file_ofs >= r.file_size) {
+            return 0;
+        }
+        count = MIN(count, r.file_size - r.file_ofs);
+        memcpy(buf, &r.crc_data[r.file_ofs], count);
+        r.file_ofs += count;
+        return count;
+    }
     size_t header_total = 0;
 
     /*
@@ -342,12 +423,25 @@ int32_t AP_Filesystem_Param::read(int fd, void *buf, uint32_t count)
      */
     if (r.read_size == 0 && count > 0) {
         r.read_size = count;
+#if AP_FILESYSTEM_PARAM_CACHE_ENABLED
+        // full downloads without per-parameter options can be served
+        // from the cached image
+        if (r.start == 0 && r.count == 0 && !r.with_defaults && !r.compact && !r.delta) {
+            r.image = get_packed_image(r);
+        }
+#endif
     }
     if (r.read_size != 0 && r.read_size != count) {
         errno = EINVAL;
         return -1;
     }
 
+#if AP_FILESYSTEM_PARAM_CACHE_ENABLED
+    if (r.image != nullptr) {
+        return read_image(r, (uint8_t *)buf, count);
+    }
+#endif
+
     if (r.file_size != 0) {
         // ensure we don't try to read past EOF
         if (r.file_ofs > r.file_size) {
@@ -368,6 +462,9 @@ int32_t AP_Filesystem_Param::read(int fd, void *buf, uint32_t count)
         if (r.count > 0 && hdr.num_params > r.count) {
             hdr.num_params = r.count;
         }
+        if (r.delta) {
+            hdr.num_params = selected_param_count(r, hdr.total_params);
+        }
         uint8_t n = MIN(sizeof(hdr) - r.file_ofs, count);
         if (r.with_defaults) {
             hdr.magic = pmagic_with_default;
@@ -478,6 +575,11 @@ int AP_Filesystem_Param::stat(const char *name, struct stat *stbuf)
         return -1;
     }
     memset(stbuf, 0, sizeof(*stbuf));
+    if (is_crc_file(name)) {
+        const uint16_t num_chunks = (AP_Param::count_parameters() + delta_chunk_params - 1) / delta_chunk_params;
+        stbuf->st_size = sizeof(struct crc_header) + num_chunks * sizeof(uint32_t);
+        return 0;
+    }
     // give size estimation to avoid needing to scan entire file
     stbuf->st_size = AP_Param::count_parameters() * 12;
     return 0;
@@ -493,8 +595,253 @@ bool AP_Filesystem_Param::check_file_name(const char *name)
         (name[packed_len] == 0 || name[packed_len] == '?')) {
         return true;
     }
-    return false;
+    return is_crc_file(name);
+}
+
+/*
+  check for the chunk checksum file
+ */
+bool AP_Filesystem_Param::is_crc_file(const char *name)
+{
+    return strcmp(name, CRC_NAME) == 0;
+}
+
+/*
+  return true if the parameter with the given index is in a chunk
+  selected with chunks=
+ */
+bool AP_Filesystem_Param::param_selected(const rfile &r, uint16_t idx) const
+{
+    if (!r.delta) {
+        return true;
+    }
+    const uint16_t chunk = idx / delta_chunk_params;
+    if (chunk >= max_delta_chunks) {
+        // beyond the range of the mask, always send
+        return true;
+    }
+    return (r.chunk_mask[chunk/8] & (1U<<(chunk%8))) != 0;
+}
+
+/*
+  count the parameters which will be sent for a chunks= request
+ */
+uint16_t AP_Filesystem_Param::selected_param_count(const rfile &r, uint16_t total) const
+{
+    uint16_t ret = 0;
+    for (uint16_t ofs=0; ofs<total; ofs += delta_chunk_params) {
+        if (param_selected(r, ofs)) {
+            ret += MIN(uint16_t(delta_chunk_params), uint16_t(total - ofs));
+        }
+    }
+    return ret;
+}
+
+/*
+  parse a chunks= query string value. This is a hex number where bit
+  N selects chunk N of the parameter list, as listed in param.crc
+ */
+bool AP_Filesystem_Param::parse_chunk_mask(rfile &r, const char *s)
+{
+    uint8_t ndigits = 0;
+    while (isxdigit(s[ndigits])) {
+        ndigits++;
+        if (ndigits > max_delta_chunks/4) {
+            return false;
+        }
+    }
+    if (ndigits == 0 || (s[ndigits] != 0 && s[ndigits] != '&')) {
+        return false;
+    }
+    memset(r.chunk_mask, 0, sizeof(r.chunk_mask));
+    for (uint8_t i=0; i<ndigits; i++) {
+        // the last digit holds chunks 0 to 3
+        const char d = tolower(s[ndigits-1-i]);
+        const uint8_t v = isdigit(d) ? d - '0' : d - 'a' + 10;
+        r.chunk_mask[i/2] |= v << (4*(i%2));
+    }
+    r.delta = true;
+    return true;
+}
+
+/*
+  build the contents of param.crc. This gives a crc32 for each chunk
+  of delta_chunk_params parameters, allowing a GCS holding a copy of
+  the parameters to request only the chunks which have changed
+ */
+bool AP_Filesystem_Param::build_crc_data(rfile &r)
+{
+    const uint16_t total = AP_Param::count_parameters();
+    struct crc_header hdr;
+    hdr.total_params = total;
+    hdr.chunk_size = delta_chunk_params;
+    hdr.num_chunks = (total + delta_chunk_params - 1) / delta_chunk_params;
+
+    const uint32_t len = sizeof(hdr) + hdr.num_chunks * sizeof(uint32_t);
+    r.crc_data = NEW_NOTHROW uint8_t[len];
+    if (r.crc_data == nullptr) {
+        return false;
+    }
+    memcpy(r.crc_data, &hdr, sizeof(hdr));
+    r.file_size = len;
+
+    AP_Param::ParamToken token;
+    enum ap_var_type ptype;
+    uint16_t idx = 0;
+    uint32_t crc = 0;
+    for (AP_Param *ap = AP_Param::first(&token, &ptype);
+         ap != nullptr && idx < total;
+         ap = AP_Param::next_scalar(&token, &ptype)) {
+        char name[AP_MAX_NAME_SIZE+1];
+        ap->copy_name_token(token, name, AP_MAX_NAME_SIZE, true);
+        name[AP_MAX_NAME_SIZE] = 0;
+        const uint8_t type = ptype;
+        crc = crc_crc32(crc, (const uint8_t *)name, strlen(name)+1);
+        crc = crc_crc32(crc, &type, 1);
+        crc = crc_crc32(crc, (const uint8_t *)ap, AP_Param::type_size(ptype));
+        idx++;
+        if (idx % delta_chunk_params == 0 || idx == total) {
+            const uint16_t chunk = (idx - 1) / delta_chunk_params;
+            memcpy(&r.crc_data[sizeof(hdr) + chunk * sizeof(uint32_t)], &crc, sizeof(crc));
+            crc = 0;
+        }
+    }
+    if (idx != total) {
+        // the parameter tree changed while we were walking it; the
+        // remaining chunks are left as zero and the count is
+        // invalidated so the GCS gets a consistent list on retry
+        AP_Param::invalidate_count();
+    }
+    return true;
+}
+
+#if AP_FILESYSTEM_PARAM_CACHE_ENABLED
+/*
+  get the packed image for a full download, building it if the
+  parameter tree or read size has changed since it was last built
+ */
+AP_Filesystem_Param::packed_image *AP_Filesystem_Param::get_packed_image(const rfile &r)
+{
+    WITH_SEMAPHORE(cache_sem);
+    const uint16_t marker = AP_Param::get_count_marker();
+    if (cached_image != nullptr &&
+        cached_image->read_size == r.read_size &&
+        cached_image->count_marker == marker) {
+        cached_image->refcount++;
+        return cached_image;
+    }
+    packed_image *img = build_packed_image(r, marker);
+    if (img == nullptr) {
+        return nullptr;
+    }
+    if (cached_image != nullptr) {
+        release_image(cached_image);
+    }
+    // one reference for the cache and one for the caller
+    img->refcount = 2;
+    cached_image = img;
+    return img;
+}
+
+/*
+  build a packed image using the same packing as the cursor based
+  reads. Returns nullptr if the image would be too large or the
+  parameter tree changed while building it
+ */
+AP_Filesystem_Param::packed_image *AP_Filesystem_Param::build_packed_image(const rfile &r, uint16_t marker)
+{
+    const uint16_t total = AP_Param::count_parameters();
+    packed_image *img = NEW_NOTHROW packed_image;
+    if (img == nullptr) {
+        return nullptr;
+    }
+    img->values = NEW_NOTHROW packed_image::value_ref[total];
+    img->read_size = r.read_size;
+    img->count_marker = marker;
+
+    struct header hdr;
+    hdr.num_params = total;
+    hdr.total_params = total;
+    if (img->values == nullptr ||
+        !img->data.append((const char *)&hdr, sizeof(hdr))) {
+        delete img;
+        return nullptr;
+    }
+
+    struct cursor c {};
+    while (true) {
+        uint8_t tbuf[max_pack_len];
+        const uint8_t len = pack_param(r, c, tbuf);
+        if (len == 0) {
+            break;
+        }
+        if (img->num_values >= total ||
+            img->data.get_length() + len > cache_max_bytes ||
+            !img->data.append((const char *)tbuf, len)) {
+            delete img;
+            return nullptr;
+        }
+        // the value is always the last field of the packed parameter
+        auto &v = img->values[img->num_values++];
+        v.ap = c.last_ap;
+        v.len = AP_Param::type_size(c.last_type);
+        v.ofs = img->data.get_length() - v.len;
+        c.token_ofs += len;
+    }
+    if (img->num_values != total) {
+        delete img;
+        return nullptr;
+    }
+    return img;
+}
+
+/*
+  drop a reference to a packed image. Must be called with cache_sem held
+ */
+void AP_Filesystem_Param::release_image(packed_image *&img)
+{
+    if (--img->refcount == 0) {
+        delete img;
+    }
+    img = nullptr;
+}
+
+/*
+  read from a packed image, filling in the current parameter values
+ */
+int32_t AP_Filesystem_Param::read_image(rfile &r, uint8_t *buf, uint32_t count)
+{
+    const packed_image &img = *r.image;
+    const uint32_t length = img.data.get_length();
+    if (r.file_ofs >= length) {
+        return 0;
+    }
+    count = MIN(count, length - r.file_ofs);
+    const uint32_t start = r.file_ofs;
+    const uint32_t end = start + count;
+    memcpy(buf, &img.data.get_string()[start], count);
+
+    // find the first value which ends after the start of this read
+    uint16_t lo = 0, hi = img.num_values;
+    while (lo < hi) {
+        const uint16_t mid = (lo + hi) / 2;
+        if (uint32_t(img.values[mid].ofs + img.values[mid].len) <= start) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    for (uint16_t i=lo; i<img.num_values && img.values[i].ofs < end; i++) {
+        const auto &v = img.values[i];
+        const uint32_t from = MAX(uint32_t(v.ofs), start);
+        const uint32_t to = MIN(uint32_t(v.ofs + v.len), end);
+        memcpy(&buf[from - start], ((const uint8_t *)v.ap) + (from - v.ofs), to - from);
+    }
+
+    r.file_ofs += count;
+    return count;
 }
+#endif // AP_FILESYSTEM_PARAM_CACHE_ENABLED
 
 /*
   support param upload
@@ -50,6 +50,15 @@ private:
     static constexpr uint16_t pmagic = 0x671b;
     static constexpr uint16_t pmagic_with_default = 0x671c;
 
+    // magic for the param.crc chunk checksum file
+    static constexpr uint16_t cmagic = 0x671d;
+
+    // number of parameters covered by each param.crc checksum
+    static constexpr uint8_t delta_chunk_params = 32;
+
+    // maximum number of chunks which can be selected with chunks=
+    static constexpr uint8_t max_delta_chunks = 128;
+
     // header at front of the file
     struct header {
         uint16_t magic = pmagic;
@@ -57,6 +66,14 @@ private:
         uint16_t total_params; // for upload this is total file length
     };
 
+    // header at front of param.crc
+    struct crc_header {
+        uint16_t magic = cmagic;
+        uint16_t total_params;
+        uint16_t chunk_size;
+        uint16_t num_chunks;
+    };
+
     struct cursor {
         AP_Param::ParamToken token;
         uint32_t token_ofs;
@@ -64,11 +81,41 @@ private:
         uint8_t trailer_len;
         uint8_t trailer[max_pack_len];
         uint16_t idx;
+        AP_Param *last_ap;
+        enum ap_var_type last_type;
+    };
+
+#if AP_FILESYSTEM_PARAM_CACHE_ENABLED
+    // maximum size of a cached param.pck image
+    static constexpr uint32_t cache_max_bytes = 32768;
+
+    /*
+      packed image of a full param.pck download. The values are
+      copied from the live parameters on each read, so the image only
+      needs to be rebuilt when the parameter tree changes
+     */
+    struct packed_image {
+        ~packed_image() { delete[] values; }
+        ExpandingString data;
+        struct value_ref {
+            AP_Param *ap;
+            uint16_t ofs;
+            uint8_t len;
+        } *values = nullptr;
+        uint16_t num_values = 0;
+        uint16_t read_size;
+        uint16_t count_marker;
+        uint8_t refcount;
     };
+    packed_image *cached_image;
+    HAL_Semaphore cache_sem;
+#endif
 
     struct rfile {
         bool open;
         bool with_defaults;
+        bool compact;
+        bool delta;
         uint16_t read_size;
         uint16_t start;
         uint16_t count;
@@ -76,11 +123,30 @@ private:
         uint32_t file_size;
         struct cursor *cursors;
         ExpandingString *writebuf; // for upload
+        uint8_t *crc_data; // for param.crc
+        uint8_t chunk_mask[max_delta_chunks/8];
+#if AP_FILESYSTEM_PARAM_CACHE_ENABLED
+        packed_image *image;
+#endif
     } file[max_open_file];
 
     bool token_seek(const struct rfile &r, const uint32_t data_ofs, struct cursor &c);
     uint8_t pack_param(const struct rfile &r, struct cursor &c, uint8_t *buf);
     bool check_file_name(const char *fname);
+    bool is_crc_file(const char *fname);
+
+    // delta download support
+    bool param_selected(const rfile &r, uint16_t idx) const;
+    uint16_t selected_param_count(const rfile &r, uint16_t total) const;
+    bool parse_chunk_mask(rfile &r, const char *s);
+    bool build_crc_data(rfile &r);
+
+#if AP_FILESYSTEM_PARAM_CACHE_ENABLED
+    packed_image *get_packed_image(const rfile &r);
+    packed_image *build_packed_image(const rfile &r, uint16_t marker);
+    void release_image(packed_image *&img);
+    int32_t read_image(rfile &r, uint8_t *buf, uint32_t count);
+#endif
 
     // finish uploading parameters
     bool finish_upload(const rfile &r);
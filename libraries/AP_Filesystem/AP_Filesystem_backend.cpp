@@ -18,6 +18,27 @@
 
 extern const AP_HAL::HAL& hal;
 
+/*
+  write several buffers in turn, for backends without a native
+  writev(). Returns the number of bytes written, which is short if a
+  write was short, or -1 if nothing could be written
+*/
+int32_t AP_Filesystem_Backend::writev(int fd, const FileIOVec *iov, uint8_t iovcnt)
+{
+    int32_t total = 0;
+    for (uint8_t i=0; i<iovcnt; i++) {
+        const int32_t n = write(fd, iov[i].data, iov[i].len);
+        if (n < 0) {
+            return total > 0 ? total : n;
+        }
+        total += n;
+        if (uint32_t(n) != iov[i].len) {
+            break;
+        }
+    }
+    return total;
+}
+
 /*
   Load a file's contents into memory. Returned object must be `delete`d to free
   the data. The data is guaranteed to be null-terminated such that it can be
@@ -39,6 +39,12 @@ private:
     const void *backend;
 };
 
+// one buffer of a writev() call
+struct FileIOVec {
+    const void *data;
+    uint32_t len;
+};
+
 class AP_Filesystem_Backend {
 
 public:
@@ -49,6 +55,7 @@ public:
     virtual int close(int fd) { return -1; }
     virtual int32_t read(int fd, void *buf, uint32_t count) { return -1; }
     virtual int32_t write(int fd, const void *buf, uint32_t count) { return -1; }
+    virtual int32_t writev(int fd, const FileIOVec *iov, uint8_t iovcnt);
     virtual int fsync(int fd) { return 0; }
     virtual int32_t lseek(int fd, int32_t offset, int whence) { return -1; }
     virtual int stat(const char *pathname, struct stat *stbuf) { return -1; }
@@ -20,6 +20,12 @@
 #define AP_FILESYSTEM_PARAM_ENABLED 1
 #endif
 
+// keep a packed image of the full parameter list for fast repeated
+// downloads of @PARAM/param.pck
+#ifndef AP_FILESYSTEM_PARAM_CACHE_ENABLED
+#define AP_FILESYSTEM_PARAM_CACHE_ENABLED (AP_FILESYSTEM_PARAM_ENABLED && HAL_MEM_CLASS >= HAL_MEM_CLASS_1000)
+#endif
+
 #ifndef AP_FILESYSTEM_POSIX_ENABLED
 #define AP_FILESYSTEM_POSIX_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX || CONFIG_HAL_BOARD == HAL_BOARD_QURT)
 #endif
@@ -22,6 +22,7 @@
 
 #include "AP_Filesystem.h"
 #include <AP_HAL/AP_HAL.h>
+#include <AP_Common/AP_Common.h>
 #include <AP_Vehicle/AP_Vehicle_Type.h>
 
 #if defined(__APPLE__) || defined(__OpenBSD__)
@@ -37,6 +38,10 @@
 #include <utime.h>
 #endif
 
+#if AP_FILESYSTEM_POSIX_HAVE_WRITEV
+#include <sys/uio.h>
+#endif
+
 extern const AP_HAL::HAL& hal;
 
 /*
@@ -116,6 +121,22 @@ int32_t AP_Filesystem_Posix::write(int fd, const void *buf, uint32_t count)
     return ::write(fd, buf, count);
 }
 
+#if AP_FILESYSTEM_POSIX_HAVE_WRITEV
+int32_t AP_Filesystem_Posix::writev(int fd, const FileIOVec *iov, uint8_t iovcnt)
+{
+    FS_CHECK_ALLOWED(-1);
+    struct iovec vec[4];
+    if (iovcnt > ARRAY_SIZE(vec)) {
+        return AP_Filesystem_Backend::writev(fd, iov, iovcnt);
+    }
+    for (uint8_t i=0; i<iovcnt; i++) {
+        vec[i].iov_base = const_cast<void*>(iov[i].data);
+        vec[i].iov_len = iov[i].len;
+    }
+    return ::writev(fd, vec, iovcnt);
+}
+#endif
+
 int AP_Filesystem_Posix::fsync(int fd)
 {
 #if AP_FILESYSTEM_POSIX_HAVE_FSYNC
@@ -37,6 +37,10 @@
 #define AP_FILESYSTEM_POSIX_HAVE_FSYNC 1
 #endif
 
+#ifndef AP_FILESYSTEM_POSIX_HAVE_WRITEV
+#define AP_FILESYSTEM_POSIX_HAVE_WRITEV 1
+#endif
+
 #ifndef AP_FILESYSTEM_POSIX_HAVE_STATFS
 #define AP_FILESYSTEM_POSIX_HAVE_STATFS 1
 #endif
@@ -53,6 +57,9 @@ public:
     int close(int fd) override;
     int32_t read(int fd, void *buf, uint32_t count) override;
     int32_t write(int fd, const void *buf, uint32_t count) override;
+#if AP_FILESYSTEM_POSIX_HAVE_WRITEV
+    int32_t writev(int fd, const FileIOVec *iov, uint8_t iovcnt) override;
+#endif
     int fsync(int fd) override;
     int32_t lseek(int fd, int32_t offset, int whence) override;
     int stat(const char *pathname, struct stat *stbuf) override;
@@ -901,6 +901,12 @@ void AP_GPS::update_instance(uint8_t instance)
 
     // we have an active driver for this instance
     bool result = drivers[instance]->read();
+
+    if (rtcm_pool.pending(instance)) {
+        // write RTCM data the GPS could not take when it arrived
+        WITH_SEMAPHORE(rtcm_pool.get_semaphore());
+        drivers[instance]->inject_rtcm(rtcm_pool);
+    }
     uint32_t tnow = AP_HAL::millis();
 
     // if we did not get a message, and the idle timer of 2 seconds
@@ -925,6 +931,8 @@ void AP_GPS::update_instance(uint8_t instance)
             } else {
                 // free the driver before we run the next detection, so we
                 // don't end up with two allocated at any time
+                WITH_SEMAPHORE(rtcm_pool.get_semaphore());
+                rtcm_pool.discard(instance);
                 delete drivers[instance];
                 drivers[instance] = nullptr;
                 state[instance].status = AP_GPS_FixType::NO_GPS;
@@ -980,7 +988,7 @@ void AP_GPS::update_instance(uint8_t instance)
             for (uint8_t i=0; i< GPS_MAX_RECEIVERS; i++) {
                 if (i != instance && params[i].type == GPS_TYPE_UBLOX_RTK_ROVER) {
                     // pass the data to the rover
-                    inject_data(i, rtcm_data, rtcm_len);
+                    inject_rtcm(rtcm_data, rtcm_len, 1U<<i);
                     drivers[instance]->clear_RTCMV3();
                     break;
                 }
@@ -1053,7 +1061,7 @@ void AP_GPS::inject_MBL_data(uint8_t* data, uint16_t length)
     for (uint8_t i=0; i< GPS_MAX_RECEIVERS; i++) {
         if (params[i].type == GPS_TYPE_UBLOX_RTK_ROVER) {
             // pass the data to the rover
-            inject_data(i, data, length);
+            inject_rtcm(data, length, 1U<<i);
             break;
         }
     }
@@ -1344,6 +1352,7 @@ void AP_GPS::lock_port(uint8_t instance, bool lock)
 // Inject a packet of raw binary to a GPS
 void AP_GPS::inject_data(const uint8_t *data, uint16_t len)
 {
+    uint8_t mask = 0;
     //Support broadcasting to all GPSes.
     if (_inject_to == GPS_RTK_INJECT_TO_ALL) {
         for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
@@ -1351,17 +1360,35 @@ void AP_GPS::inject_data(const uint8_t *data, uint16_t len)
                 // we don't externally inject to moving baseline rover
                 continue;
             }
-            inject_data(i, data, len);
+            mask |= 1U<<i;
         }
-    } else {
-        inject_data(_inject_to, data, len);
+    } else if (uint8_t(_inject_to.get()) < GPS_MAX_RECEIVERS) {
+        mask = 1U<<_inject_to.get();
     }
+    inject_rtcm(data, len, mask);
 }
 
-void AP_GPS::inject_data(uint8_t instance, const uint8_t *data, uint16_t len)
+/*
+  store the data once for all the GPS instances in mask, then write as
+  much of it as each can take now. Whatever is left is written from
+  update_instance()
+ */
+void AP_GPS::inject_rtcm(const uint8_t *data, uint16_t len, uint8_t mask)
 {
-    if (instance < GPS_MAX_RECEIVERS && drivers[instance] != nullptr) {
-        drivers[instance]->inject_data(data, len);
+    WITH_SEMAPHORE(rtcm_pool.get_semaphore());
+
+    for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+        if (drivers[i] == nullptr) {
+            mask &= ~(1U<<i);
+        }
+    }
+    if (!rtcm_pool.add(data, len, mask)) {
+        return;
+    }
+    for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+        if (mask & (1U<<i)) {
+            drivers[i]->inject_rtcm(rtcm_pool);
+        }
     }
 }
 
@@ -1968,6 +1995,28 @@ void AP_GPS::Write_GPS(uint8_t i)
         rtcm_fragments_discarded: rtcm_stats.fragments_discarded
     };
     AP::logger().WriteBlock(&pkt2, sizeof(pkt2));
+
+    if (rtcm_pool.in_use()) {
+        const RTCM_Pool::Stats &rtcm = rtcm_pool.get_stats(i);
+// @LoggerMessage: GRTC
+// @Description: RTCM data written to a GPS
+// @Field: TimeUS: Time since system startup
+// @Field: I: GPS instance number
+// @Field: Fr: RTCM frames written to this GPS
+// @Field: Drop: RTCM frames dropped before they could be written to this GPS
+// @Field: Trunc: RTCM frames dropped part way through being written to this GPS
+// @Field: Lat: time from receipt of the last frame written to it being written
+// @Field: MLat: largest time from receipt to write since the last GRTC message
+        AP::logger().WriteStreaming("GRTC", "TimeUS,I,Fr,Drop,Trunc,Lat,MLat", "s#---ss", "F----FF", "QBIIIII",
+                                    time_us,
+                                    i,
+                                    rtcm.frames,
+                                    rtcm.dropped,
+                                    rtcm.truncated,
+                                    rtcm.latency_us,
+                                    rtcm.max_latency_us);
+        rtcm_pool.reset_max_latency(i);
+    }
 }
 #endif
 
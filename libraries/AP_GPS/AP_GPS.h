@@ -41,6 +41,7 @@
 #if GPS_MOVING_BASELINE
 #include "MovingBase.h"
 #endif // GPS_MOVING_BASELINE
+#include "RTCM_Pool.h"
 
 class AP_GPS_Backend;
 class RTCM3_Parser;
@@ -775,8 +776,16 @@ private:
     void handle_gps_rtcm_data(mavlink_channel_t chan, const mavlink_message_t &msg);
     void handle_gps_inject(const mavlink_message_t &msg);
 
-    //Inject a packet of raw binary to a GPS
-    void inject_data(uint8_t instance, const uint8_t *data, uint16_t len);
+    /*
+      RTCM data waiting to be written to the GPS receivers. Data is
+      stored once however many receivers it goes to, and a receiver
+      which can't take it all at once is given the rest on later
+      updates
+     */
+    RTCM_Pool rtcm_pool;
+
+    // inject a packet of raw binary to the GPS instances in mask
+    void inject_rtcm(const uint8_t *data, uint16_t len, uint8_t mask);
 
 #if AP_GPS_BLENDED_ENABLED
     bool _output_is_blended; // true when a blended GPS solution being output
@@ -713,8 +713,6 @@ bool AP_GPS_DroneCAN::read(void)
 
     WITH_SEMAPHORE(sem);
 
-    send_rtcm();
-
     if (_new_data) {
         _new_data = false;
 
@@ -775,13 +773,10 @@ bool AP_GPS_DroneCAN::is_configured(void) const
 }
 
 /*
-  send pending RTCM data
+  send pending RTCM data, straight from the pool
  */
-void AP_GPS_DroneCAN::send_rtcm(void)
+void AP_GPS_DroneCAN::send_rtcm(RTCM_Pool &pool)
 {
-    if (_rtcm_stream.buf == nullptr) {
-        return;
-    }
     WITH_SEMAPHORE(sem);
 
     const uint32_t now = AP_HAL::millis();
@@ -789,26 +784,23 @@ void AP_GPS_DroneCAN::send_rtcm(void)
         // don't send more than 50 per second
         return;
     }
-    uint32_t outlen = 0;
-    const uint8_t *ptr = _rtcm_stream.buf->readptr(outlen);
-    if (ptr == nullptr || outlen == 0) {
+    uavcan_equipment_gnss_RTCMStream msg {};
+    const uint16_t outlen = pool.copy(state.instance, msg.data.data, sizeof(msg.data.data));
+    if (outlen == 0) {
         return;
     }
-    uavcan_equipment_gnss_RTCMStream msg {};
-    outlen = MIN(outlen, sizeof(msg.data.data));
     msg.protocol_id = UAVCAN_EQUIPMENT_GNSS_RTCMSTREAM_PROTOCOL_ID_RTCM3;
-    memcpy(msg.data.data, ptr, outlen);
     msg.data.len = outlen;
     if (_detected_modules[_detected_module].ap_dronecan->rtcm_stream.broadcast(msg)) {
-        _rtcm_stream.buf->advance(outlen);
+        pool.advance(state.instance, outlen);
         _rtcm_stream.last_send_ms = now;
     }
 }
 
 /*
-  handle RTCM data from MAVLink GPS_RTCM_DATA, forwarding it over MAVLink
+  handle RTCM data from MAVLink GPS_RTCM_DATA, forwarding it over DroneCAN
  */
-void AP_GPS_DroneCAN::inject_data(const uint8_t *data, uint16_t len)
+void AP_GPS_DroneCAN::inject_rtcm(RTCM_Pool &pool)
 {
     // we only handle this if we are the first DroneCAN GPS or we are
     // using a different uavcan instance than the first GPS, as we
@@ -818,17 +810,10 @@ void AP_GPS_DroneCAN::inject_data(const uint8_t *data, uint16_t len)
     if (_detected_module == 0 ||
         _detected_modules[_detected_module].ap_dronecan != _detected_modules[0].ap_dronecan ||
         now_ms - _detected_modules[0].last_inject_ms > 2000) {
-        if (_rtcm_stream.buf == nullptr) {
-            // give enough space for a full round from a NTRIP server with all
-            // constellations
-            _rtcm_stream.buf = NEW_NOTHROW ByteBuffer(2400);
-            if (_rtcm_stream.buf == nullptr) {
-                return;
-            }
-        }
         _detected_modules[_detected_module].last_inject_ms = now_ms;
-        _rtcm_stream.buf->write(data, len);
-        send_rtcm();
+        send_rtcm(pool);
+    } else {
+        pool.discard(state.instance);
     }
 }
 
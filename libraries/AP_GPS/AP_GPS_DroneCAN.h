@@ -57,7 +57,7 @@ public:
     static void handle_relposheading_msg_trampoline(AP_DroneCAN *ap_dronecan, const CanardRxTransfer& transfer, const ardupilot_gnss_RelPosHeading& msg);
 #endif
     static bool inter_instance_pre_arm_checks(char failure_msg[], uint16_t failure_msg_len);
-    void inject_data(const uint8_t *data, uint16_t len) override;
+    void inject_rtcm(RTCM_Pool &pool) override;
 
     bool get_error_codes(uint32_t &error_codes) const override { error_codes = error_code; return seen_status; };
 
@@ -144,12 +144,11 @@ private:
     bool handle_param_get_set_response_int(AP_DroneCAN* ap_dronecan, const uint8_t node_id, const char* name, int32_t &value);
     bool handle_param_get_set_response_float(AP_DroneCAN* ap_dronecan, const uint8_t node_id, const char* name, float &value);
     void handle_param_save_response(AP_DroneCAN* ap_dronecan, const uint8_t node_id, bool success);
-    void send_rtcm(void);
+    void send_rtcm(RTCM_Pool &pool);
 
     // GNSS RTCM injection
     struct {
         uint32_t last_send_ms;
-        ByteBuffer *buf;
     } _rtcm_stream;
 
     // returns true if the supplied GPS_Type is a DroneCAN GPS type
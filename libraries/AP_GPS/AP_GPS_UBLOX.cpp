@@ -145,6 +145,11 @@ AP_GPS_UBLOX::AP_GPS_UBLOX(AP_GPS &_gps,
         state.gps_yaw_configured = true;
     }
 #endif
+
+#if AP_GPS_UBLOX_BLOCK_PARSER_ENABLED
+    // without the receive buffer we fall back to parsing byte by byte
+    _rx = NEW_NOTHROW uint8_t[RX_BUFFER_SIZE];
+#endif
 }
 
 AP_GPS_UBLOX::~AP_GPS_UBLOX()
@@ -152,6 +157,9 @@ AP_GPS_UBLOX::~AP_GPS_UBLOX()
 #if GPS_MOVING_BASELINE
     delete rtcm3_parser;
 #endif
+#if AP_GPS_UBLOX_BLOCK_PARSER_ENABLED
+    delete[] _rx;
+#endif
 
     free(config_GNSS);
 }
@@ -580,6 +588,29 @@ AP_GPS_UBLOX::read(void)
         }
     }
 
+#if AP_GPS_UBLOX_BLOCK_PARSER_ENABLED
+    if (_rx != nullptr) {
+        // process bytes received, a block at a time
+        uint32_t total = 0;
+        while (_read_block(parsed) && total < 8192U) {
+            const uint32_t available = port->available();
+            if (available == 0) {
+                break;
+            }
+            const ssize_t n = port->read(&_rx[_rx_len], MIN(available, uint32_t(RX_BUFFER_SIZE - _rx_len)));
+            if (n <= 0) {
+                break;
+            }
+#if AP_GPS_DEBUG_LOGGING_ENABLED
+            log_data(&_rx[_rx_len], n);
+#endif
+            _rx_len += n;
+            total += n;
+        }
+        return parsed;
+    }
+#endif
+
     const uint16_t numc = MIN(port->available(), 8192U);
     for (uint16_t i = 0; i < numc; i++) {        // Process bytes received
 
@@ -591,162 +622,330 @@ AP_GPS_UBLOX::read(void)
 #if AP_GPS_DEBUG_LOGGING_ENABLED
         log_data(&data, 1);
 #endif
+        if (!_read_byte(data, parsed)) {
+            break;
+        }
+    }
+    return parsed;
+}
 
+/*
+  feed one byte to the parse state machine. Returns false if the byte
+  completed a RTCMv3 packet, in which case parsing should stop
+ */
+bool
+AP_GPS_UBLOX::_read_byte(uint8_t data, bool &parsed)
+{
 #if GPS_MOVING_BASELINE
-        if (rtcm3_parser) {
-            if (rtcm3_parser->read(data)) {
-                // we've found a RTCMv3 packet. We stop parsing at
-                // this point and reset u-blox parse state. We need to
-                // stop parsing to give the higher level driver a
-                // chance to send the RTCMv3 packet to another (rover)
-                // GPS
-                _step = 0;
-                break;
-            }
+    if (rtcm3_parser) {
+        if (rtcm3_parser->read(data)) {
+            // we've found a RTCMv3 packet. We stop parsing at
+            // this point and reset u-blox parse state. We need to
+            // stop parsing to give the higher level driver a
+            // chance to send the RTCMv3 packet to another (rover)
+            // GPS
+            _step = 0;
+            return false;
         }
+    }
 #endif
 
-	reset:
+reset:
 #if AP_GPS_UBLOX_CFGV2_ENABLED
-        if (_step == 0) {
-            // reset the valget state machine
-            _cfg_v2.process_valget_complete(false);
-        }
+    if (_step == 0) {
+        // reset the valget state machine
+        _cfg_v2.process_valget_complete(false);
+    }
 #endif
-        switch(_step) {
-
-        // Message preamble detection
-        //
-        // If we fail to match any of the expected bytes, we reset
-        // the state machine and re-consider the failed byte as
-        // the first byte of the preamble.  This improves our
-        // chances of recovering from a mismatch and makes it less
-        // likely that we will be fooled by the preamble appearing
-        // as data in some other message.
-        //
-        case 1:
-            if (PREAMBLE2 == data) {
-                _step++;
-                break;
-            }
-            _step = 0;
-            Debug("reset %u", __LINE__);
-            FALLTHROUGH;
-        case 0:
-            if(PREAMBLE1 == data)
-                _step++;
-            break;
-
-        // Message header processing
-        //
-        // We sniff the class and message ID to decide whether we
-        // are going to gather the message bytes or just discard
-        // them.
-        //
-        // We always collect the length so that we can avoid being
-        // fooled by preamble bytes in messages.
-        //
-        case 2:
-            _step++;
-            _class = data;
-            _ck_b = _ck_a = data;                       // reset the checksum accumulators
-            break;
-        case 3:
+    switch(_step) {
+
+    // Message preamble detection
+    //
+    // If we fail to match any of the expected bytes, we reset
+    // the state machine and re-consider the failed byte as
+    // the first byte of the preamble.  This improves our
+    // chances of recovering from a mismatch and makes it less
+    // likely that we will be fooled by the preamble appearing
+    // as data in some other message.
+    //
+    case 1:
+        if (PREAMBLE2 == data) {
             _step++;
-            _ck_b += (_ck_a += data);                   // checksum byte
-            _msg_id = data;
             break;
-        case 4:
-            _step++;
-            _ck_b += (_ck_a += data);                   // checksum byte
-            _payload_length = data;                     // payload length low byte
-            break;
-        case 5:
+        }
+        _step = 0;
+        Debug("reset %u", __LINE__);
+        FALLTHROUGH;
+    case 0:
+        if(PREAMBLE1 == data)
             _step++;
-            _ck_b += (_ck_a += data);                   // checksum byte
+        break;
 
-            _payload_length += (uint16_t)(data<<8);
-            if ((_payload_length > sizeof(_buffer))
+    // Message header processing
+    //
+    // We sniff the class and message ID to decide whether we
+    // are going to gather the message bytes or just discard
+    // them.
+    //
+    // We always collect the length so that we can avoid being
+    // fooled by preamble bytes in messages.
+    //
+    case 2:
+        _step++;
+        _class = data;
+        _ck_b = _ck_a = data;                       // reset the checksum accumulators
+        break;
+    case 3:
+        _step++;
+        _ck_b += (_ck_a += data);                   // checksum byte
+        _msg_id = data;
+        break;
+    case 4:
+        _step++;
+        _ck_b += (_ck_a += data);                   // checksum byte
+        _payload_length = data;                     // payload length low byte
+        break;
+    case 5:
+        _step++;
+        _ck_b += (_ck_a += data);                   // checksum byte
+
+        _payload_length += (uint16_t)(data<<8);
+        if ((_payload_length > sizeof(_buffer))
 #if AP_GPS_UBLOX_CFGV2_ENABLED
-            && !(_class == CLASS_CFG || _msg_id == MSG_CFG_VALGET)
+        && !(_class == CLASS_CFG || _msg_id == MSG_CFG_VALGET)
 #endif
-            ) {
-                Debug("large payload %u", (unsigned)_payload_length);
-                // assume any payload bigger then what we know about is noise
-                _payload_length = 0;
-                _step = 0;
+        ) {
+            Debug("large payload %u", (unsigned)_payload_length);
+            // assume any payload bigger then what we know about is noise
+            _payload_length = 0;
+            _step = 0;
 				goto reset;
-            }
-            _payload_counter = 0;                       // prepare to receive payload
-            if (_payload_length == 0) {
-                // bypass payload and go straight to checksum
-                _step++;
-            }
-            break;
+        }
+        _payload_counter = 0;                       // prepare to receive payload
+        if (_payload_length == 0) {
+            // bypass payload and go straight to checksum
+            _step++;
+        }
+        break;
 
-        // Receive message data
-        //
-        case 6:
-            _ck_b += (_ck_a += data);                   // checksum byte
+    // Receive message data
+    //
+    case 6:
+        _ck_b += (_ck_a += data);                   // checksum byte
+#if AP_GPS_UBLOX_CFGV2_ENABLED
+        if (_class == CLASS_CFG && _msg_id == MSG_CFG_VALGET) {
+            CFGv2_Debug("V2 VALGET byte %u/%u: 0x%02x\n", (unsigned)_payload_counter, (unsigned)_payload_length, data);
+            _cfg_v2.process_valget_byte(data);
+        }
+#endif
+        if (_payload_counter < sizeof(_buffer)) {
+            _buffer[_payload_counter] = data;
+        }
+        if (++_payload_counter == _payload_length)
+            _step++;
+        break;
+
+    // Checksum and message processing
+    //
+    case 7:
+        _step++;
+        if (_ck_a != data) {
+            Debug("bad cka %x should be %x", data, _ck_a);
+            _step = 0;
 #if AP_GPS_UBLOX_CFGV2_ENABLED
             if (_class == CLASS_CFG && _msg_id == MSG_CFG_VALGET) {
-                CFGv2_Debug("V2 VALGET byte %u/%u: 0x%02x\n", (unsigned)_payload_counter, (unsigned)_payload_length, data);
-                _cfg_v2.process_valget_byte(data);
+                _cfg_v2.process_valget_complete(false);
             }
 #endif
-            if (_payload_counter < sizeof(_buffer)) {
-                _buffer[_payload_counter] = data;
+				goto reset;
+        }
+        break;
+    case 8:
+        _step = 0;
+        if (_ck_b != data) {
+            Debug("bad ckb %x should be %x", data, _ck_b);
+#if AP_GPS_UBLOX_CFGV2_ENABLED
+            if (_class == CLASS_CFG && _msg_id == MSG_CFG_VALGET) {
+                _cfg_v2.process_valget_complete(false);
             }
-            if (++_payload_counter == _payload_length)
-                _step++;
-            break;
+#endif
+            break;                                                  // bad checksum
+        }
 
-        // Checksum and message processing
-        //
-        case 7:
-            _step++;
-            if (_ck_a != data) {
-                Debug("bad cka %x should be %x", data, _ck_a);
-                _step = 0;
+#if GPS_MOVING_BASELINE
+        if (rtcm3_parser) {
+            // this is a uBlox packet, discard any partial RTCMv3 state
+            rtcm3_parser->reset();
+        }
+#endif
 #if AP_GPS_UBLOX_CFGV2_ENABLED
-                if (_class == CLASS_CFG && _msg_id == MSG_CFG_VALGET) {
-                    _cfg_v2.process_valget_complete(false);
-                }
+        if (_class == CLASS_CFG && _msg_id == MSG_CFG_VALGET) {
+            _cfg_v2.process_valget_complete(true);
+        }
 #endif
-				goto reset;
-            }
-            break;
-        case 8:
-            _step = 0;
-            if (_ck_b != data) {
-                Debug("bad ckb %x should be %x", data, _ck_b);
+        if (_parse_gps()) {
+            parsed = true;
+        }
+        break;
+    }
+    return true;
+}
+
+#if AP_GPS_UBLOX_BLOCK_PARSER_ENABLED
+/*
+  look for a UBX frame at the start of the len bytes at buf. n is set
+  to the number of bytes to skip, or to the length of the frame. We
+  resynchronise on the same bytes as the byte state machine, so both
+  parsers find the same frames in a stream
+ */
+AP_GPS_UBLOX::ScanResult
+AP_GPS_UBLOX::_scan_frame(const uint8_t *buf, uint16_t len, uint16_t &n)
+{
+    if (buf[0] != PREAMBLE1) {
+        const uint8_t *sync = (const uint8_t *)memchr(buf, PREAMBLE1, len);
+        n = sync != nullptr ? sync - buf : len;
+        return ScanResult::SKIP;
+    }
+    if (len >= 2 && buf[1] != PREAMBLE2) {
+        n = 1;
+        return ScanResult::SKIP;
+    }
+    if (len < 6) {
+        n = 0;
+        return ScanResult::PARTIAL;
+    }
+    const uint16_t payload_length = buf[4] | (buf[5] << 8);
+    if (payload_length > sizeof(ubx_msgbuffer)) {
 #if AP_GPS_UBLOX_CFGV2_ENABLED
-                if (_class == CLASS_CFG && _msg_id == MSG_CFG_VALGET) {
-                    _cfg_v2.process_valget_complete(false);
-                }
+        if (buf[2] == CLASS_CFG || buf[3] == MSG_CFG_VALGET) {
+            n = 0;
+            return ScanResult::BYTEWISE;
+        }
 #endif
-                break;                                                  // bad checksum
-            }
+        // assume any payload bigger then what we know about is
+        // noise, and re-consider the length high byte
+        n = 5;
+        return ScanResult::SKIP;
+    }
+    n = payload_length + 8;
+    if (len < n) {
+        return ScanResult::PARTIAL;
+    }
+    uint8_t ck_a = 0, ck_b = 0;
+    _update_checksum(&buf[2], payload_length + 4, ck_a, ck_b);
+    if (ck_a != buf[payload_length + 6]) {
+        // re-consider the failed byte as the first byte of the preamble
+        n = payload_length + 6;
+        return ScanResult::SKIP;
+    }
+    if (ck_b != buf[payload_length + 7]) {
+        return ScanResult::SKIP;
+    }
+    return ScanResult::FRAME;
+}
 
+/*
+  step over bytes of the receive buffer which are not part of a UBX
+  frame. Returns false if they completed a RTCMv3 packet, leaving pos
+  after its last byte
+ */
+bool
+AP_GPS_UBLOX::_skip_bytes(uint16_t &pos, uint16_t end)
+{
 #if GPS_MOVING_BASELINE
-            if (rtcm3_parser) {
-                // this is a uBlox packet, discard any partial RTCMv3 state
-                rtcm3_parser->reset();
+    if (rtcm3_parser) {
+        while (pos < end) {
+            if (rtcm3_parser->read(_rx[pos++])) {
+                return false;
             }
+        }
+    }
 #endif
+    pos = end;
+    return true;
+}
+
+/*
+  parse the frames in the receive buffer, keeping any partial frame
+  at the start of the buffer for the next call. Frames are checked as
+  a whole and parsed where they lie, without being copied. Returns
+  false if a RTCMv3 packet was found, in which case parsing should
+  stop
+ */
+bool
+AP_GPS_UBLOX::_read_block(bool &parsed)
+{
+    bool ret = true;
+    uint16_t pos = 0;
+    while (ret && pos < _rx_len) {
+        if (_step != 0) {
+            // finishing a frame too large for the receive buffer
+            ret = _read_byte(_rx[pos++], parsed);
+            continue;
+        }
+        uint16_t n;
+        const ScanResult result = _scan_frame(&_rx[pos], _rx_len - pos, n);
+        if (result == ScanResult::PARTIAL) {
+            break;
+        }
+        if (result == ScanResult::SKIP) {
+            ret = _skip_bytes(pos, pos + n);
+            continue;
+        }
+        if (result == ScanResult::BYTEWISE) {
+            ret = _read_byte(_rx[pos++], parsed);
+            continue;
+        }
+
+        const uint8_t *frame = &_rx[pos];
+#if GPS_MOVING_BASELINE
+        if (rtcm3_parser) {
+            // this is a uBlox packet, discard any partial RTCMv3 state
+            rtcm3_parser->reset();
+        }
+#endif
+        _class = frame[2];
+        _msg_id = frame[3];
+        _payload_length = n - 8;
 #if AP_GPS_UBLOX_CFGV2_ENABLED
-            if (_class == CLASS_CFG && _msg_id == MSG_CFG_VALGET) {
-                _cfg_v2.process_valget_complete(true);
+        if (_class == CLASS_CFG && _msg_id == MSG_CFG_VALGET) {
+            _cfg_v2.process_valget_complete(false);
+            for (uint16_t i=0; i<_payload_length; i++) {
+                _cfg_v2.process_valget_byte(frame[6+i]);
             }
+            _cfg_v2.process_valget_complete(true);
+        }
 #endif
-            if (_parse_gps()) {
-                parsed = true;
+        if (pos + 6 + sizeof(ubx_msgbuffer) <= RX_BUFFER_SIZE) {
+            _payload = (ubx_msgbuffer *)&frame[6];
+        } else {
+            // too near the end of the buffer to be parsed in place
+            memcpy(&_buffer, &frame[6], _payload_length);
+        }
+        if (_parse_gps()) {
+            parsed = true;
+        }
+        if (_payload != &_buffer) {
+#if AP_GPS_UBLOX_CFGV2_ENABLED
+            // read() starts by showing CFGv2 the last frame again, so
+            // keep the frames it looks at in _buffer as the byte
+            // parser does
+            if (_class == CLASS_ACK || _class == CLASS_CFG || _class == CLASS_MON) {
+                memcpy(&_buffer, &frame[6], _payload_length);
             }
-            break;
+#endif
+            _payload = &_buffer;
         }
+        pos += n;
     }
-    return parsed;
+
+    if (pos > 0) {
+        memmove(_rx, &_rx[pos], _rx_len - pos);
+        _rx_len -= pos;
+    }
+    return ret;
 }
+#endif // AP_GPS_UBLOX_BLOCK_PARSER_ENABLED
 
 // Private Methods /////////////////////////////////////////////////////////////
 void AP_GPS_UBLOX::log_mon_hw(void)
@@ -759,17 +958,17 @@ void AP_GPS_UBLOX::log_mon_hw(void)
         LOG_PACKET_HEADER_INIT(LOG_GPS_UBX1_MSG),
         time_us    : AP_HAL::micros64(),
         instance   : state.instance,
-        noisePerMS : _buffer.mon_hw_60.noisePerMS,
-        jamInd     : _buffer.mon_hw_60.jamInd,
-        aPower     : _buffer.mon_hw_60.aPower,
-        agcCnt     : _buffer.mon_hw_60.agcCnt,
+        noisePerMS : _payload->mon_hw_60.noisePerMS,
+        jamInd     : _payload->mon_hw_60.jamInd,
+        aPower     : _payload->mon_hw_60.aPower,
+        agcCnt     : _payload->mon_hw_60.agcCnt,
         config     : _unconfigured_messages,
     };
     if (_payload_length == 68) {
-        pkt.noisePerMS = _buffer.mon_hw_68.noisePerMS;
-        pkt.jamInd     = _buffer.mon_hw_68.jamInd;
-        pkt.aPower     = _buffer.mon_hw_68.aPower;
-        pkt.agcCnt     = _buffer.mon_hw_68.agcCnt;
+        pkt.noisePerMS = _payload->mon_hw_68.noisePerMS;
+        pkt.jamInd     = _payload->mon_hw_68.jamInd;
+        pkt.aPower     = _payload->mon_hw_68.aPower;
+        pkt.agcCnt     = _payload->mon_hw_68.agcCnt;
     }
     AP::logger().WriteBlock(&pkt, sizeof(pkt));
 #endif
@@ -786,10 +985,10 @@ void AP_GPS_UBLOX::log_mon_hw2(void)
         LOG_PACKET_HEADER_INIT(LOG_GPS_UBX2_MSG),
         time_us   : AP_HAL::micros64(),
         instance  : state.instance,
-        ofsI      : _buffer.mon_hw2.ofsI,
-        magI      : _buffer.mon_hw2.magI,
-        ofsQ      : _buffer.mon_hw2.ofsQ,
-        magQ      : _buffer.mon_hw2.magQ,
+        ofsI      : _payload->mon_hw2.ofsI,
+        magI      : _payload->mon_hw2.magI,
+        ofsQ      : _payload->mon_hw2.ofsQ,
+        magQ      : _payload->mon_hw2.magQ,
     };
     AP::logger().WriteBlock(&pkt, sizeof(pkt));
 #endif
@@ -802,7 +1001,7 @@ void AP_GPS_UBLOX::log_mon_rf(void)
         return;
     }
     // Use structured buffer
-    const ubx_mon_rf &rf = _buffer.mon_rf;
+    const ubx_mon_rf &rf = _payload->mon_rf;
     const uint8_t version = rf.version;
     const uint8_t nBlocks = rf.nBlocks;
     if (version != 0 || nBlocks == 0) {
@@ -867,16 +1066,16 @@ void AP_GPS_UBLOX::log_tim_tm2(void)
         "QBBBHHIIHIII",
         AP_HAL::micros64(),
         state.instance,
-        _buffer.tim_tm2.ch,
-        _buffer.tim_tm2.flags,
-        _buffer.tim_tm2.count,
-        _buffer.tim_tm2.wnR,
-        _buffer.tim_tm2.towMsR,
-        _buffer.tim_tm2.towSubMsR,
-        _buffer.tim_tm2.wnF,
-        _buffer.tim_tm2.towMsF,
-        _buffer.tim_tm2.towSubMsF,
-        _buffer.tim_tm2.accEst);
+        _payload->tim_tm2.ch,
+        _payload->tim_tm2.flags,
+        _payload->tim_tm2.count,
+        _payload->tim_tm2.wnR,
+        _payload->tim_tm2.towMsR,
+        _payload->tim_tm2.towSubMsR,
+        _payload->tim_tm2.wnF,
+        _payload->tim_tm2.towMsF,
+        _payload->tim_tm2.towSubMsF,
+        _payload->tim_tm2.accEst);
 #endif
 }
 #endif // UBLOX_TIM_TM2_LOGGING
@@ -1016,9 +1215,9 @@ AP_GPS_UBLOX::_parse_gps(void)
         Debug("ACK %u", (unsigned)_msg_id);
 
         if(_msg_id == MSG_ACK_ACK) {
-            switch(_buffer.ack.clsID) {
+            switch(_payload->ack.clsID) {
             case CLASS_CFG:
-                switch(_buffer.ack.msgID) {
+                switch(_payload->ack.msgID) {
                 case MSG_CFG_CFG:
                     _cfg_saved = true;
                     _cfg_needs_save = false;
@@ -1050,7 +1249,7 @@ AP_GPS_UBLOX::_parse_gps(void)
 
                 break;
             case CLASS_MON:
-                switch(_buffer.ack.msgID) {
+                switch(_payload->ack.msgID) {
                 case MSG_MON_HW:
                     _unconfigured_messages &= ~CONFIG_RATE_MON_HW;
                     break;
@@ -1061,11 +1260,11 @@ AP_GPS_UBLOX::_parse_gps(void)
             }
         }
         if(_msg_id == MSG_ACK_NACK) {
-            switch(_buffer.nack.clsID) {
+            switch(_payload->nack.clsID) {
             case CLASS_CFG:
-                switch(_buffer.nack.msgID) {
+                switch(_payload->nack.msgID) {
                 case MSG_CFG_VALGET:
-                    CFG_Debug("NACK VALGET 0x%x", (unsigned)_buffer.nack.msgID);
+                    CFG_Debug("NACK VALGET 0x%x", (unsigned)_payload->nack.msgID);
                     if (active_config.list != nullptr) {
                         /*
                           likely this device does not support fetching multiple keys at once, go one at a time
@@ -1096,7 +1295,7 @@ AP_GPS_UBLOX::_parse_gps(void)
                     break;
                 case MSG_CFG_VALSET:
                     if (active_config.list != nullptr) {
-                        CFG_Debug("NACK VALSET 0x%x 0x%x", (unsigned)_buffer.nack.msgID,
+                        CFG_Debug("NACK VALSET 0x%x 0x%x", (unsigned)_payload->nack.msgID,
                                   unsigned(active_config.list[active_config.set_index].key));
                         if (is_gnss_key(active_config.list[active_config.set_index].key)) {
                             GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "GPS %u: unable to configure band 0x%02x",
@@ -1115,29 +1314,29 @@ AP_GPS_UBLOX::_parse_gps(void)
         switch(_msg_id) {
         case  MSG_CFG_NAV_SETTINGS:
 	    Debug("Got settings %u min_elev %d drLimit %u\n", 
-                  (unsigned)_buffer.nav_settings.dynModel,
-                  (int)_buffer.nav_settings.minElev,
-                  (unsigned)_buffer.nav_settings.drLimit);
-            _buffer.nav_settings.mask = 0;
+                  (unsigned)_payload->nav_settings.dynModel,
+                  (int)_payload->nav_settings.minElev,
+                  (unsigned)_payload->nav_settings.drLimit);
+            _payload->nav_settings.mask = 0;
             if (gps._navfilter != AP_GPS::GPS_ENGINE_NONE &&
-                _buffer.nav_settings.dynModel != gps._navfilter) {
+                _payload->nav_settings.dynModel != gps._navfilter) {
                 // we've received the current nav settings, change the engine
                 // settings and send them back
                 Debug("Changing engine setting from %u to %u\n",
-                      (unsigned)_buffer.nav_settings.dynModel, (unsigned)gps._navfilter);
-                _buffer.nav_settings.dynModel = gps._navfilter;
-                _buffer.nav_settings.mask |= 1;
+                      (unsigned)_payload->nav_settings.dynModel, (unsigned)gps._navfilter);
+                _payload->nav_settings.dynModel = gps._navfilter;
+                _payload->nav_settings.mask |= 1;
             }
             if (gps._min_elevation != -100 &&
-                _buffer.nav_settings.minElev != gps._min_elevation) {
+                _payload->nav_settings.minElev != gps._min_elevation) {
                 Debug("Changing min elevation to %d\n", (int)gps._min_elevation);
-                _buffer.nav_settings.minElev = gps._min_elevation;
-                _buffer.nav_settings.mask |= 2;
+                _payload->nav_settings.minElev = gps._min_elevation;
+                _payload->nav_settings.mask |= 2;
             }
-            if (_buffer.nav_settings.mask != 0) {
+            if (_payload->nav_settings.mask != 0) {
                 _send_message(CLASS_CFG, MSG_CFG_NAV_SETTINGS,
-                              &_buffer.nav_settings,
-                              sizeof(_buffer.nav_settings));
+                              &_payload->nav_settings,
+                              sizeof(_payload->nav_settings));
                 _unconfigured_messages |= CONFIG_NAV_SETTINGS;
                 _cfg_needs_save = true;
             } else {
@@ -1148,20 +1347,20 @@ AP_GPS_UBLOX::_parse_gps(void)
 #if UBLOX_GNSS_SETTINGS
         case MSG_CFG_GNSS:
             if (params.gnss_mode != 0 && !supports_F9_config()) {
-                struct ubx_cfg_gnss start_gnss = _buffer.gnss;
+                struct ubx_cfg_gnss start_gnss = _payload->gnss;
                 uint8_t gnssCount = 0;
                 Debug("Got GNSS Settings %u %u %u %u:\n",
-                    (unsigned)_buffer.gnss.msgVer,
-                    (unsigned)_buffer.gnss.numTrkChHw,
-                    (unsigned)_buffer.gnss.numTrkChUse,
-                    (unsigned)_buffer.gnss.numConfigBlocks);
+                    (unsigned)_payload->gnss.msgVer,
+                    (unsigned)_payload->gnss.numTrkChHw,
+                    (unsigned)_payload->gnss.numTrkChUse,
+                    (unsigned)_payload->gnss.numConfigBlocks);
 #if UBLOX_DEBUGGING
-                for(int i = 0; i < _buffer.gnss.numConfigBlocks; i++) {
+                for(int i = 0; i < _payload->gnss.numConfigBlocks; i++) {
                     Debug("  %u %u %u 0x%08x\n",
-                    (unsigned)_buffer.gnss.configBlock[i].gnssId,
-                    (unsigned)_buffer.gnss.configBlock[i].resTrkCh,
-                    (unsigned)_buffer.gnss.configBlock[i].maxTrkCh,
-                    (unsigned)_buffer.gnss.configBlock[i].flags);
+                    (unsigned)_payload->gnss.configBlock[i].gnssId,
+                    (unsigned)_payload->gnss.configBlock[i].resTrkCh,
+                    (unsigned)_payload->gnss.configBlock[i].maxTrkCh,
+                    (unsigned)_payload->gnss.configBlock[i].flags);
                 }
 #endif
 
@@ -1170,31 +1369,31 @@ AP_GPS_UBLOX::_parse_gps(void)
                         gnssCount++;
                     }
                 }
-                for(int i = 0; i < _buffer.gnss.numConfigBlocks; i++) {
+                for(int i = 0; i < _payload->gnss.numConfigBlocks; i++) {
                     // Reserve an equal portion of channels for all enabled systems that supports it
-                    if(params.gnss_mode & (1 << _buffer.gnss.configBlock[i].gnssId)) {
-                        if(GNSS_SBAS !=_buffer.gnss.configBlock[i].gnssId && (_hardware_generation > UBLOX_M8 || GNSS_GAL !=_buffer.gnss.configBlock[i].gnssId)) {
-                            _buffer.gnss.configBlock[i].resTrkCh = (_buffer.gnss.numTrkChHw - 3) / (gnssCount * 2);
-                            _buffer.gnss.configBlock[i].maxTrkCh = _buffer.gnss.numTrkChHw;
+                    if(params.gnss_mode & (1 << _payload->gnss.configBlock[i].gnssId)) {
+                        if(GNSS_SBAS !=_payload->gnss.configBlock[i].gnssId && (_hardware_generation > UBLOX_M8 || GNSS_GAL !=_payload->gnss.configBlock[i].gnssId)) {
+                            _payload->gnss.configBlock[i].resTrkCh = (_payload->gnss.numTrkChHw - 3) / (gnssCount * 2);
+                            _payload->gnss.configBlock[i].maxTrkCh = _payload->gnss.numTrkChHw;
                         } else {
-                            if(GNSS_SBAS ==_buffer.gnss.configBlock[i].gnssId) {
-                                _buffer.gnss.configBlock[i].resTrkCh = 1;
-                                _buffer.gnss.configBlock[i].maxTrkCh = 3;
+                            if(GNSS_SBAS ==_payload->gnss.configBlock[i].gnssId) {
+                                _payload->gnss.configBlock[i].resTrkCh = 1;
+                                _payload->gnss.configBlock[i].maxTrkCh = 3;
                             }
-                            if(GNSS_GAL ==_buffer.gnss.configBlock[i].gnssId) {
-                                _buffer.gnss.configBlock[i].resTrkCh = (_buffer.gnss.numTrkChHw - 3) / (gnssCount * 2);
-                                _buffer.gnss.configBlock[i].maxTrkCh = 8; //Per the M8 receiver description UBX-13003221 - R16, 4.1.1.3 it is not recommended to set the number of galileo channels higher then eight
+                            if(GNSS_GAL ==_payload->gnss.configBlock[i].gnssId) {
+                                _payload->gnss.configBlock[i].resTrkCh = (_payload->gnss.numTrkChHw - 3) / (gnssCount * 2);
+                                _payload->gnss.configBlock[i].maxTrkCh = 8; //Per the M8 receiver description UBX-13003221 - R16, 4.1.1.3 it is not recommended to set the number of galileo channels higher then eight
                             }
                         }
-                        _buffer.gnss.configBlock[i].flags = _buffer.gnss.configBlock[i].flags | 0x00000001;
+                        _payload->gnss.configBlock[i].flags = _payload->gnss.configBlock[i].flags | 0x00000001;
                     } else {
-                        _buffer.gnss.configBlock[i].resTrkCh = 0;
-                        _buffer.gnss.configBlock[i].maxTrkCh = 0;
-                        _buffer.gnss.configBlock[i].flags = _buffer.gnss.configBlock[i].flags & 0xFFFFFFFE;
+                        _payload->gnss.configBlock[i].resTrkCh = 0;
+                        _payload->gnss.configBlock[i].maxTrkCh = 0;
+                        _payload->gnss.configBlock[i].flags = _payload->gnss.configBlock[i].flags & 0xFFFFFFFE;
                     }
                 }
-                if (memcmp(&start_gnss, &_buffer.gnss, sizeof(start_gnss))) {
-                    _send_message(CLASS_CFG, MSG_CFG_GNSS, &_buffer.gnss, 4 + (8 * _buffer.gnss.numConfigBlocks));
+                if (memcmp(&start_gnss, &_payload->gnss, sizeof(start_gnss))) {
+                    _send_message(CLASS_CFG, MSG_CFG_GNSS, &_payload->gnss, 4 + (8 * _payload->gnss.numConfigBlocks));
                     _unconfigured_messages |= CONFIG_GNSS;
                     _cfg_needs_save = true;
                 } else {
@@ -1209,16 +1408,16 @@ AP_GPS_UBLOX::_parse_gps(void)
         case MSG_CFG_SBAS:
             if (gps._sbas_mode != AP_GPS::SBAS_Mode::DoNotChange) {
 	        Debug("Got SBAS settings %u %u %u 0x%x 0x%x\n", 
-                      (unsigned)_buffer.sbas.mode,
-                      (unsigned)_buffer.sbas.usage,
-                      (unsigned)_buffer.sbas.maxSBAS,
-                      (unsigned)_buffer.sbas.scanmode2,
-                      (unsigned)_buffer.sbas.scanmode1);
-                if (_buffer.sbas.mode != gps._sbas_mode) {
-                    _buffer.sbas.mode = gps._sbas_mode;
+                      (unsigned)_payload->sbas.mode,
+                      (unsigned)_payload->sbas.usage,
+                      (unsigned)_payload->sbas.maxSBAS,
+                      (unsigned)_payload->sbas.scanmode2,
+                      (unsigned)_payload->sbas.scanmode1);
+                if (_payload->sbas.mode != gps._sbas_mode) {
+                    _payload->sbas.mode = gps._sbas_mode;
                     _send_message(CLASS_CFG, MSG_CFG_SBAS,
-                                  &_buffer.sbas,
-                                  sizeof(_buffer.sbas));
+                                  &_payload->sbas,
+                                  sizeof(_payload->sbas));
                     _unconfigured_messages |= CONFIG_SBAS;
                     _cfg_needs_save = true;
                 } else {
@@ -1236,20 +1435,20 @@ AP_GPS_UBLOX::_parse_gps(void)
                     _request_port();
                     return false;
                 }
-                _verify_rate(_buffer.msg_rate_6.msg_class, _buffer.msg_rate_6.msg_id,
-                             _buffer.msg_rate_6.rates[_ublox_port]);
+                _verify_rate(_payload->msg_rate_6.msg_class, _payload->msg_rate_6.msg_id,
+                             _payload->msg_rate_6.rates[_ublox_port]);
             } else {
-                _verify_rate(_buffer.msg_rate.msg_class, _buffer.msg_rate.msg_id,
-                             _buffer.msg_rate.rate);
+                _verify_rate(_payload->msg_rate.msg_class, _payload->msg_rate.msg_id,
+                             _payload->msg_rate.rate);
             }
             return false;
         case MSG_CFG_PRT:
-           _ublox_port = _buffer.prt.portID;
+           _ublox_port = _payload->prt.portID;
            return false;
         case MSG_CFG_RATE:
-            if(_buffer.nav_rate.measure_rate_ms != params.rate_ms ||
-               _buffer.nav_rate.nav_rate != 1 ||
-               _buffer.nav_rate.timeref != 0) {
+            if(_payload->nav_rate.measure_rate_ms != params.rate_ms ||
+               _payload->nav_rate.nav_rate != 1 ||
+               _payload->nav_rate.timeref != 0) {
                _configure_rate();
                 _unconfigured_messages |= CONFIG_RATE_NAV;
                 _cfg_needs_save = true;
@@ -1262,31 +1461,31 @@ AP_GPS_UBLOX::_parse_gps(void)
         case MSG_CFG_TP5: {
             // configure the PPS pin for 1Hz, zero delay
             Debug("Got TP5 ver=%u 0x%04x %u\n", 
-                  (unsigned)_buffer.nav_tp5.version,
-                  (unsigned)_buffer.nav_tp5.flags,
-                  (unsigned)_buffer.nav_tp5.freqPeriod);
+                  (unsigned)_payload->nav_tp5.version,
+                  (unsigned)_payload->nav_tp5.flags,
+                  (unsigned)_payload->nav_tp5.freqPeriod);
 #ifdef HAL_GPIO_PPS
             hal.gpio->attach_interrupt(HAL_GPIO_PPS, FUNCTOR_BIND_MEMBER(&AP_GPS_UBLOX::pps_interrupt, void, uint8_t, bool, uint32_t), AP_HAL::GPIO::INTERRUPT_FALLING);
 #endif
             const uint16_t desired_flags = 0x003f;
             const uint16_t desired_period_hz = _pps_freq;
 
-            if (_buffer.nav_tp5.flags != desired_flags ||
-                _buffer.nav_tp5.freqPeriod != desired_period_hz) {
-                _buffer.nav_tp5.tpIdx = 0;
-                _buffer.nav_tp5.reserved1[0] = 0;
-                _buffer.nav_tp5.reserved1[1] = 0;
-                _buffer.nav_tp5.antCableDelay = 0;
-                _buffer.nav_tp5.rfGroupDelay = 0;
-                _buffer.nav_tp5.freqPeriod = desired_period_hz;
-                _buffer.nav_tp5.freqPeriodLock = desired_period_hz;
-                _buffer.nav_tp5.pulseLenRatio = 1;
-                _buffer.nav_tp5.pulseLenRatioLock = 2;
-                _buffer.nav_tp5.userConfigDelay = 0;
-                _buffer.nav_tp5.flags = desired_flags;
+            if (_payload->nav_tp5.flags != desired_flags ||
+                _payload->nav_tp5.freqPeriod != desired_period_hz) {
+                _payload->nav_tp5.tpIdx = 0;
+                _payload->nav_tp5.reserved1[0] = 0;
+                _payload->nav_tp5.reserved1[1] = 0;
+                _payload->nav_tp5.antCableDelay = 0;
+                _payload->nav_tp5.rfGroupDelay = 0;
+                _payload->nav_tp5.freqPeriod = desired_period_hz;
+                _payload->nav_tp5.freqPeriodLock = desired_period_hz;
+                _payload->nav_tp5.pulseLenRatio = 1;
+                _payload->nav_tp5.pulseLenRatioLock = 2;
+                _payload->nav_tp5.userConfigDelay = 0;
+                _payload->nav_tp5.flags = desired_flags;
                 _send_message(CLASS_CFG, MSG_CFG_TP5,
-                              &_buffer.nav_tp5,
-                              sizeof(_buffer.nav_tp5));
+                              &_payload->nav_tp5,
+                              sizeof(_payload->nav_tp5));
                 _unconfigured_messages |= CONFIG_TP5;
                 _cfg_needs_save = true;
             } else {
@@ -1297,7 +1496,7 @@ AP_GPS_UBLOX::_parse_gps(void)
 #endif // CONFIGURE_PPS_PIN
         case MSG_CFG_VALGET: {
             uint8_t cfg_len = _payload_length - sizeof(ubx_cfg_valget);
-            const uint8_t *cfg_data = (const uint8_t *)(&_buffer) + sizeof(ubx_cfg_valget);
+            const uint8_t *cfg_data = (const uint8_t *)_payload + sizeof(ubx_cfg_valget);
             while (cfg_len >= 5) {
                 ConfigKey id;
                 memcpy(&id, cfg_data, sizeof(uint32_t));
@@ -1408,11 +1607,11 @@ AP_GPS_UBLOX::_parse_gps(void)
         case MSG_MON_VER: {
             bool check_L1L5 = false;
             _have_version = true;
-            strncpy(_version.hwVersion, _buffer.mon_ver.hwVersion, sizeof(_version.hwVersion));
-            strncpy(_version.swVersion, _buffer.mon_ver.swVersion, sizeof(_version.swVersion));
-            char* mod = (char*)memmem(_buffer.mon_ver.extension, sizeof(_buffer.mon_ver.extension), "MOD=", 4);
+            strncpy(_version.hwVersion, _payload->mon_ver.hwVersion, sizeof(_version.hwVersion));
+            strncpy(_version.swVersion, _payload->mon_ver.swVersion, sizeof(_version.swVersion));
+            char* mod = (char*)memmem(_payload->mon_ver.extension, sizeof(_payload->mon_ver.extension), "MOD=", 4);
 #if AP_GPS_UBLOX_CFGV2_ENABLED
-            char* protver_end = _buffer.mon_ver.extension + sizeof(_buffer.mon_ver.extension);
+            char* protver_end = _payload->mon_ver.extension + sizeof(_payload->mon_ver.extension);
 #endif
             if (mod != nullptr
 #if AP_GPS_UBLOX_CFGV2_ENABLED
@@ -1422,7 +1621,7 @@ AP_GPS_UBLOX::_parse_gps(void)
                 strncpy(_module, mod+4, UBLOX_MODULE_LEN-1);
             }
 #if AP_GPS_UBLOX_CFGV2_ENABLED
-            char* prot = (char*)memmem(_buffer.mon_ver.extension, sizeof(_buffer.mon_ver.extension), "PROTVER=", 8);
+            char* prot = (char*)memmem(_payload->mon_ver.extension, sizeof(_payload->mon_ver.extension), "PROTVER=", 8);
             if (prot != nullptr && (prot+8+UBLOX_PROTVER_LEN-1) < protver_end) {
                 Debug("Found PROTVER string %.20s", prot+8);
                 strncpy(_protver, prot+8, UBLOX_PROTVER_LEN-1);
@@ -1471,7 +1670,7 @@ AP_GPS_UBLOX::_parse_gps(void)
             }
             if (check_L1L5) {
                 // check if L1L5 in extension
-                if (memmem(_buffer.mon_ver.extension, sizeof(_buffer.mon_ver.extension), "L1L5", 4) != nullptr) {
+                if (memmem(_payload->mon_ver.extension, sizeof(_payload->mon_ver.extension), "L1L5", 4) != nullptr) {
                     supports_l5 = true;
                     GCS_SEND_TEXT(MAV_SEVERITY_INFO, "u-blox supports L5 Band");
                     _unconfigured_messages |= CONFIG_L5;
@@ -1487,10 +1686,10 @@ AP_GPS_UBLOX::_parse_gps(void)
 
 #if UBLOX_RXM_RAW_LOGGING
     if (_class == CLASS_RXM && _msg_id == MSG_RXM_RAW && gps._raw_data != 0) {
-        log_rxm_raw(_buffer.rxm_raw);
+        log_rxm_raw(_payload->rxm_raw);
         return false;
     } else if (_class == CLASS_RXM && _msg_id == MSG_RXM_RAWX && gps._raw_data != 0) {
-        log_rxm_rawx(_buffer.rxm_rawx);
+        log_rxm_rawx(_payload->rxm_rawx);
         return false;
     }
 #endif // UBLOX_RXM_RAW_LOGGING
@@ -1514,18 +1713,18 @@ AP_GPS_UBLOX::_parse_gps(void)
             _unconfigured_messages |= CONFIG_RATE_POSLLH;
             break;
         }
-        _check_new_itow(_buffer.posllh.itow);
-        _last_pos_time        = _buffer.posllh.itow;
-        state.location.lng    = _buffer.posllh.longitude;
-        state.location.lat    = _buffer.posllh.latitude;
+        _check_new_itow(_payload->posllh.itow);
+        _last_pos_time        = _payload->posllh.itow;
+        state.location.lng    = _payload->posllh.longitude;
+        state.location.lat    = _payload->posllh.latitude;
         state.have_undulation = true;
-        state.undulation = (_buffer.posllh.altitude_msl - _buffer.posllh.altitude_ellipsoid) * 0.001;
-        set_alt_amsl_cm(state, _buffer.posllh.altitude_msl / 10);
+        state.undulation = (_payload->posllh.altitude_msl - _payload->posllh.altitude_ellipsoid) * 0.001;
+        set_alt_amsl_cm(state, _payload->posllh.altitude_msl / 10);
 
         state.status          = next_fix;
         _new_position = true;
-        state.horizontal_accuracy = _buffer.posllh.horizontal_accuracy*1.0e-3f;
-        state.vertical_accuracy = _buffer.posllh.vertical_accuracy*1.0e-3f;
+        state.horizontal_accuracy = _payload->posllh.horizontal_accuracy*1.0e-3f;
+        state.vertical_accuracy = _payload->posllh.vertical_accuracy*1.0e-3f;
         state.have_horizontal_accuracy = true;
         state.have_vertical_accuracy = true;
 #if UBLOX_FAKE_3DLOCK
@@ -1538,22 +1737,22 @@ AP_GPS_UBLOX::_parse_gps(void)
         break;
     case MSG_STATUS:
         Debug("MSG_STATUS fix_status=%u fix_type=%u",
-              _buffer.status.fix_status,
-              _buffer.status.fix_type);
-        _check_new_itow(_buffer.status.itow);
+              _payload->status.fix_status,
+              _payload->status.fix_type);
+        _check_new_itow(_payload->status.itow);
         if (havePvtMsg) {
             // when we have PVT we don't need status, just change the rate for STATUS to zero
             _unconfigured_messages &= ~CONFIG_RATE_STATUS;
             _configure_message_rate(CLASS_NAV, _msg_id, 0);
             break;
         }
-        if (_buffer.status.fix_status & NAV_STATUS_FIX_VALID) {
-            if( (_buffer.status.fix_type == AP_GPS_UBLOX::FIX_3D) &&
-                (_buffer.status.fix_status & AP_GPS_UBLOX::NAV_STATUS_DGPS_USED)) {
+        if (_payload->status.fix_status & NAV_STATUS_FIX_VALID) {
+            if( (_payload->status.fix_type == AP_GPS_UBLOX::FIX_3D) &&
+                (_payload->status.fix_status & AP_GPS_UBLOX::NAV_STATUS_DGPS_USED)) {
                 next_fix = AP_GPS_FixType::DGPS;
-            }else if( _buffer.status.fix_type == AP_GPS_UBLOX::FIX_3D) {
+            }else if( _payload->status.fix_type == AP_GPS_UBLOX::FIX_3D) {
                 next_fix = AP_GPS_FixType::FIX_3D;
-            }else if (_buffer.status.fix_type == AP_GPS_UBLOX::FIX_2D) {
+            }else if (_payload->status.fix_type == AP_GPS_UBLOX::FIX_2D) {
                 next_fix = AP_GPS_FixType::FIX_2D;
             }else{
                 next_fix = AP_GPS_FixType::NONE;
@@ -1571,9 +1770,9 @@ AP_GPS_UBLOX::_parse_gps(void)
     case MSG_DOP:
         Debug("MSG_DOP");
         noReceivedHdop = false;
-        _check_new_itow(_buffer.dop.itow);
-        state.hdop        = _buffer.dop.hDOP;
-        state.vdop        = _buffer.dop.vDOP;
+        _check_new_itow(_payload->dop.itow);
+        state.hdop        = _payload->dop.hDOP;
+        state.vdop        = _payload->dop.vDOP;
 #if UBLOX_FAKE_3DLOCK
         state.hdop = 130;
         state.hdop = 170;
@@ -1581,20 +1780,20 @@ AP_GPS_UBLOX::_parse_gps(void)
         break;
     case MSG_SOL:
         Debug("MSG_SOL fix_status=%u fix_type=%u",
-              _buffer.solution.fix_status,
-              _buffer.solution.fix_type);
-        _check_new_itow(_buffer.solution.itow);
+              _payload->solution.fix_status,
+              _payload->solution.fix_type);
+        _check_new_itow(_payload->solution.itow);
         if (havePvtMsg) {
-            state.time_week = _buffer.solution.week;
+            state.time_week = _payload->solution.week;
             break;
         }
-        if (_buffer.solution.fix_status & NAV_STATUS_FIX_VALID) {
-            if( (_buffer.solution.fix_type == AP_GPS_UBLOX::FIX_3D) &&
-                (_buffer.solution.fix_status & AP_GPS_UBLOX::NAV_STATUS_DGPS_USED)) {
+        if (_payload->solution.fix_status & NAV_STATUS_FIX_VALID) {
+            if( (_payload->solution.fix_type == AP_GPS_UBLOX::FIX_3D) &&
+                (_payload->solution.fix_status & AP_GPS_UBLOX::NAV_STATUS_DGPS_USED)) {
                 next_fix = AP_GPS_FixType::DGPS;
-            }else if( _buffer.solution.fix_type == AP_GPS_UBLOX::FIX_3D) {
+            }else if( _payload->solution.fix_type == AP_GPS_UBLOX::FIX_3D) {
                 next_fix = AP_GPS_FixType::FIX_3D;
-            }else if (_buffer.solution.fix_type == AP_GPS_UBLOX::FIX_2D) {
+            }else if (_payload->solution.fix_type == AP_GPS_UBLOX::FIX_2D) {
                 next_fix = AP_GPS_FixType::FIX_2D;
             }else{
                 next_fix = AP_GPS_FixType::NONE;
@@ -1605,13 +1804,13 @@ AP_GPS_UBLOX::_parse_gps(void)
             state.status = AP_GPS_FixType::NONE;
         }
         if(noReceivedHdop) {
-            state.hdop = _buffer.solution.position_DOP;
+            state.hdop = _payload->solution.position_DOP;
         }
-        state.num_sats    = _buffer.solution.satellites;
+        state.num_sats    = _payload->solution.satellites;
         if (next_fix >= AP_GPS_FixType::FIX_2D) {
             state.last_gps_time_ms = AP_HAL::millis();
-            state.time_week_ms    = _buffer.solution.itow;
-            state.time_week       = _buffer.solution.week;
+            state.time_week_ms    = _payload->solution.itow;
+            state.time_week       = _payload->solution.week;
         }
 #if UBLOX_FAKE_3DLOCK
         next_fix = state.status;
@@ -1642,26 +1841,26 @@ AP_GPS_UBLOX::_parse_gps(void)
                                           static_cast<uint32_t>(RELPOSNED::refObsMiss) |
                                           static_cast<uint32_t>(RELPOSNED::carrSolnFloat);
 
-            _check_new_itow(_buffer.relposned.iTOW);
-            if (_buffer.relposned.iTOW != _last_relposned_itow+200) {
+            _check_new_itow(_payload->relposned.iTOW);
+            if (_payload->relposned.iTOW != _last_relposned_itow+200) {
                 // useful for looking at packet loss on links
-                MB_Debug("RELPOSNED ITOW %u %u\n", unsigned(_buffer.relposned.iTOW), unsigned(_last_relposned_itow));
+                MB_Debug("RELPOSNED ITOW %u %u\n", unsigned(_payload->relposned.iTOW), unsigned(_last_relposned_itow));
             }
-            _last_relposned_itow = _buffer.relposned.iTOW;
-            MB_Debug("RELPOSNED flags: %lx valid: %lx invalid: %lx\n", _buffer.relposned.flags, valid_mask, invalid_mask);
-            if (((_buffer.relposned.flags & valid_mask) == valid_mask) &&
-                ((_buffer.relposned.flags & invalid_mask) == 0)) {
-                if (calculate_moving_base_yaw(_buffer.relposned.relPosHeading * 1e-5,
-                                          _buffer.relposned.relPosLength * 0.01,
-                                          _buffer.relposned.relPosD*0.01)) {
+            _last_relposned_itow = _payload->relposned.iTOW;
+            MB_Debug("RELPOSNED flags: %lx valid: %lx invalid: %lx\n", _payload->relposned.flags, valid_mask, invalid_mask);
+            if (((_payload->relposned.flags & valid_mask) == valid_mask) &&
+                ((_payload->relposned.flags & invalid_mask) == 0)) {
+                if (calculate_moving_base_yaw(_payload->relposned.relPosHeading * 1e-5,
+                                          _payload->relposned.relPosLength * 0.01,
+                                          _payload->relposned.relPosD*0.01)) {
                     state.have_gps_yaw_accuracy = true;
-                    state.gps_yaw_accuracy = _buffer.relposned.accHeading * 1e-5;
+                    state.gps_yaw_accuracy = _payload->relposned.accHeading * 1e-5;
                     _last_relposned_ms = AP_HAL::millis();
                 }
-                state.relPosHeading = _buffer.relposned.relPosHeading * 1e-5;
-                state.relPosLength  = _buffer.relposned.relPosLength * 0.01;
-                state.relPosD       = _buffer.relposned.relPosD * 0.01;
-                state.accHeading    = _buffer.relposned.accHeading * 1e-5;
+                state.relPosHeading = _payload->relposned.relPosHeading * 1e-5;
+                state.relPosLength  = _payload->relposned.relPosLength * 0.01;
+                state.relPosD       = _payload->relposned.relPosD * 0.01;
+                state.accHeading    = _payload->relposned.accHeading * 1e-5;
                 state.relposheading_ts = AP_HAL::millis();
             } else {
                 state.have_gps_yaw_accuracy = false;
@@ -1679,7 +1878,7 @@ AP_GPS_UBLOX::_parse_gps(void)
         _unconfigured_messages &= ~CONFIG_RATE_STATUS;
 
         // position
-        _check_new_itow(_buffer.pvt.itow);
+        _check_new_itow(_payload->pvt.itow);
         // Only adjust if:
         // we already have a valid week,
         // PVT iTOW wrapped,
@@ -1687,20 +1886,20 @@ AP_GPS_UBLOX::_parse_gps(void)
         // (meaning we haven't already accepted the rollover via TIMEGPS/SOL)
         if (state.time_week != 0 &&
             _last_pvt_itow != 0 &&
-            _buffer.pvt.itow < _last_pvt_itow &&
+            _payload->pvt.itow < _last_pvt_itow &&
             state.time_week_ms > END_OF_WEEK_THRESHOLD_MS &&
-            _buffer.pvt.itow < START_OF_WEEK_THRESHOLD_MS) {
+            _payload->pvt.itow < START_OF_WEEK_THRESHOLD_MS) {
             state.time_week++;
         }
 
-        _last_pvt_itow = _buffer.pvt.itow;
-        _last_pos_time        = _buffer.pvt.itow;
-        state.location.lng    = _buffer.pvt.lon;
-        state.location.lat    = _buffer.pvt.lat;
+        _last_pvt_itow = _payload->pvt.itow;
+        _last_pos_time        = _payload->pvt.itow;
+        state.location.lng    = _payload->pvt.lon;
+        state.location.lat    = _payload->pvt.lat;
         state.have_undulation = true;
-        state.undulation = (_buffer.pvt.h_msl - _buffer.pvt.h_ellipsoid) * 0.001;
-        set_alt_amsl_cm(state, _buffer.pvt.h_msl / 10);
-        switch (_buffer.pvt.fix_type)
+        state.undulation = (_payload->pvt.h_msl - _payload->pvt.h_ellipsoid) * 0.001;
+        set_alt_amsl_cm(state, _payload->pvt.h_msl / 10);
+        switch (_payload->pvt.fix_type)
         {
             case 0:
                 state.status = AP_GPS_FixType::NONE;
@@ -1713,16 +1912,16 @@ AP_GPS_UBLOX::_parse_gps(void)
                 break;
             case 3:
                 state.status = AP_GPS_FixType::FIX_3D;
-                if (_buffer.pvt.flags & 0b00000010)  // diffsoln
+                if (_payload->pvt.flags & 0b00000010)  // diffsoln
                     state.status = AP_GPS_FixType::DGPS;
-                if (_buffer.pvt.flags & 0b01000000)  // carrsoln - float
+                if (_payload->pvt.flags & 0b01000000)  // carrsoln - float
                     state.status = AP_GPS_FixType::RTK_FLOAT;
-                if (_buffer.pvt.flags & 0b10000000)  // carrsoln - fixed
+                if (_payload->pvt.flags & 0b10000000)  // carrsoln - fixed
                     state.status = AP_GPS_FixType::RTK_FIXED;
                 break;
             case 4:
                 GCS_SEND_TEXT(MAV_SEVERITY_INFO,
-                                "Unexpected state %d", _buffer.pvt.flags);
+                                "Unexpected state %d", _payload->pvt.flags);
                 state.status = AP_GPS_FixType::FIX_3D;
                 break;
             case 5:
@@ -1734,35 +1933,35 @@ AP_GPS_UBLOX::_parse_gps(void)
         }
         next_fix = state.status;
         _new_position = true;
-        state.horizontal_accuracy = _buffer.pvt.h_acc*1.0e-3f;
-        state.vertical_accuracy = _buffer.pvt.v_acc*1.0e-3f;
+        state.horizontal_accuracy = _payload->pvt.h_acc*1.0e-3f;
+        state.vertical_accuracy = _payload->pvt.v_acc*1.0e-3f;
         state.have_horizontal_accuracy = true;
         state.have_vertical_accuracy = true;
         // SVs
-        state.num_sats    = _buffer.pvt.num_sv;
+        state.num_sats    = _payload->pvt.num_sv;
         // velocity     
-        _last_vel_time         = _buffer.pvt.itow;
-        state.ground_speed     = _buffer.pvt.gspeed*0.001f;          // m/s
-        state.ground_course    = wrap_360(_buffer.pvt.head_mot * 1.0e-5f);       // Heading 2D deg * 100000
+        _last_vel_time         = _payload->pvt.itow;
+        state.ground_speed     = _payload->pvt.gspeed*0.001f;          // m/s
+        state.ground_course    = wrap_360(_payload->pvt.head_mot * 1.0e-5f);       // Heading 2D deg * 100000
         state.have_vertical_velocity = true;
-        state.velocity.x = _buffer.pvt.velN * 0.001f;
-        state.velocity.y = _buffer.pvt.velE * 0.001f;
-        state.velocity.z = _buffer.pvt.velD * 0.001f;
+        state.velocity.x = _payload->pvt.velN * 0.001f;
+        state.velocity.y = _payload->pvt.velE * 0.001f;
+        state.velocity.z = _payload->pvt.velD * 0.001f;
         state.have_speed_accuracy = true;
-        state.speed_accuracy = _buffer.pvt.s_acc*0.001f;
+        state.speed_accuracy = _payload->pvt.s_acc*0.001f;
         _new_speed = true;
         // dop
         if(noReceivedHdop) {
-            state.hdop        = _buffer.pvt.p_dop;
-            state.vdop        = _buffer.pvt.p_dop;
+            state.hdop        = _payload->pvt.p_dop;
+            state.vdop        = _payload->pvt.p_dop;
         }
 
-        if (_buffer.pvt.fix_type >= 2) {
+        if (_payload->pvt.fix_type >= 2) {
             state.last_gps_time_ms = AP_HAL::millis();
         }
         
         // time
-        state.time_week_ms    = _buffer.pvt.itow;
+        state.time_week_ms    = _payload->pvt.itow;
 #if UBLOX_FAKE_3DLOCK
         state.location.lng = 1491652300L;
         state.location.lat = -353632610L;
@@ -1781,10 +1980,10 @@ AP_GPS_UBLOX::_parse_gps(void)
         break;
     case MSG_TIMEGPS:
         Debug("MSG_TIMEGPS");
-        _check_new_itow(_buffer.timegps.itow);
-        if (_buffer.timegps.valid & UBX_TIMEGPS_VALID_WEEK_MASK) {
-            state.time_week_ms = _buffer.timegps.itow;
-            state.time_week = _buffer.timegps.week;
+        _check_new_itow(_payload->timegps.itow);
+        if (_payload->timegps.valid & UBX_TIMEGPS_VALID_WEEK_MASK) {
+            state.time_week_ms = _payload->timegps.itow;
+            state.time_week = _payload->timegps.week;
             state.last_gps_time_ms = AP_HAL::millis();
         }
         break;
@@ -1794,17 +1993,17 @@ AP_GPS_UBLOX::_parse_gps(void)
             _unconfigured_messages |= CONFIG_RATE_VELNED;
             break;
         }
-        _check_new_itow(_buffer.velned.itow);
-        _last_vel_time         = _buffer.velned.itow;
-        state.ground_speed     = _buffer.velned.speed_2d*0.01f;          // m/s
-        state.ground_course    = wrap_360(_buffer.velned.heading_2d * 1.0e-5f);       // Heading 2D deg * 100000
+        _check_new_itow(_payload->velned.itow);
+        _last_vel_time         = _payload->velned.itow;
+        state.ground_speed     = _payload->velned.speed_2d*0.01f;          // m/s
+        state.ground_course    = wrap_360(_payload->velned.heading_2d * 1.0e-5f);       // Heading 2D deg * 100000
         state.have_vertical_velocity = true;
-        state.velocity.x = _buffer.velned.ned_north * 0.01f;
-        state.velocity.y = _buffer.velned.ned_east * 0.01f;
-        state.velocity.z = _buffer.velned.ned_down * 0.01f;
+        state.velocity.x = _payload->velned.ned_north * 0.01f;
+        state.velocity.y = _payload->velned.ned_east * 0.01f;
+        state.velocity.z = _payload->velned.ned_down * 0.01f;
         velocity_to_speed_course(state);
         state.have_speed_accuracy = true;
-        state.speed_accuracy = _buffer.velned.speed_accuracy*0.01f;
+        state.speed_accuracy = _payload->velned.speed_accuracy*0.01f;
 #if UBLOX_FAKE_3DLOCK
         state.speed_accuracy = 0;
 #endif
@@ -1814,8 +2013,8 @@ AP_GPS_UBLOX::_parse_gps(void)
         {
         Debug("MSG_NAV_SVINFO\n");
         static const uint8_t HardwareGenerationMask = 0x07;
-        _check_new_itow(_buffer.svinfo_header.itow);
-        _hardware_generation = _buffer.svinfo_header.globalFlags & HardwareGenerationMask;
+        _check_new_itow(_payload->svinfo_header.itow);
+        _hardware_generation = _payload->svinfo_header.globalFlags & HardwareGenerationMask;
         switch (_hardware_generation) {
             case UBLOX_5:
             case UBLOX_6:
@@ -1894,7 +2093,7 @@ AP_GPS_UBLOX::set_pps_desired_freq(uint8_t freq)
  *  update checksum for a set of bytes
  */
 void
-AP_GPS_UBLOX::_update_checksum(uint8_t *data, uint16_t len, uint8_t &ck_a, uint8_t &ck_b)
+AP_GPS_UBLOX::_update_checksum(const uint8_t *data, uint16_t len, uint8_t &ck_a, uint8_t &ck_b)
 {
     while (len--) {
         ck_a += *data;
@@ -136,6 +136,7 @@ class AP_GPS_UBLOX : public AP_GPS_Backend
     using CFGv2 = AP_GPS_UBLOX_CFGv2;
 #endif
     friend class AP_GPS_UBLOX_CFGv2;
+    friend class AP_GPS_UBLOX_Test;
 public:
     AP_GPS_UBLOX(AP_GPS &_gps, AP_GPS::Params &_params, AP_GPS::GPS_State &_state, AP_HAL::UARTDriver *_port, AP_GPS::GPS_Role role);
     ~AP_GPS_UBLOX() override;
@@ -625,7 +626,7 @@ private:
 #endif
 
     // Receive buffer
-    union PACKED {
+    union PACKED ubx_msgbuffer {
         DEFINE_BYTE_ARRAY_METHODS
         ubx_nav_posllh posllh;
         ubx_nav_status status;
@@ -666,6 +667,18 @@ private:
 #endif
     } _buffer;
 
+    // the payload being parsed, either _buffer or a frame in _rx
+    ubx_msgbuffer  *_payload { &_buffer };
+
+#if AP_GPS_UBLOX_BLOCK_PARSER_ENABLED
+    // the receive buffer holds the largest payload we decode plus
+    // room for the frames following it, so payloads parsed in place
+    // never read past its end
+    static constexpr uint16_t RX_BUFFER_SIZE = sizeof(ubx_msgbuffer) + 8 + 1024;
+    uint8_t        *_rx;
+    uint16_t        _rx_len;
+#endif
+
     enum class RELPOSNED {
         gnssFixOK          = 1U << 0,
         diffSoln           = 1U << 1,
@@ -874,6 +887,18 @@ private:
 
     // Buffer parse & GPS state update
     bool        _parse_gps();
+    bool        _read_byte(uint8_t data, bool &parsed);
+#if AP_GPS_UBLOX_BLOCK_PARSER_ENABLED
+    enum class ScanResult : uint8_t {
+        SKIP,       // skip bytes which are not part of a frame
+        PARTIAL,    // a frame which has not completely arrived
+        FRAME,      // a complete frame with a valid checksum
+        BYTEWISE,   // a frame too large for the receive buffer
+    };
+    static ScanResult _scan_frame(const uint8_t *buf, uint16_t len, uint16_t &n);
+    bool        _read_block(bool &parsed);
+    bool        _skip_bytes(uint16_t &pos, uint16_t end);
+#endif
 #if AP_GPS_UBLOX_CFGV2_ENABLED
     bool        _legacy_config_update(void);
     bool        _legacy_cfg_supported = true;
@@ -894,7 +919,7 @@ private:
     bool        _configure_list_valset(const config_list *list, uint8_t count, uint8_t layers=UBX_VALSET_LAYER_ALL);
     bool        _configure_valget(ConfigKey key);
     void        _configure_rate(void);
-    static void _update_checksum(uint8_t *data, uint16_t len, uint8_t &ck_a, uint8_t &ck_b);
+    static void _update_checksum(const uint8_t *data, uint16_t len, uint8_t &ck_a, uint8_t &ck_b);
     bool        _send_message(uint8_t msg_class, uint8_t msg_id, const void *msg, uint16_t size);
     bool        _request_message_rate(uint8_t msg_class, uint8_t msg_id);
     void        _request_next_config(void);
@@ -107,21 +107,21 @@ void AP_GPS_UBLOX_CFGv2::update()
         case AP_GPS_UBLOX::CLASS_ACK:
             switch (ubx_backend._msg_id) {
                 case AP_GPS_UBLOX::MSG_ACK_ACK:
-                    if (ubx_backend._buffer.ack.clsID == AP_GPS_UBLOX::CLASS_CFG) {
-                        handle_cfg_ack(ubx_backend._buffer.ack.msgID);
+                    if (ubx_backend._payload->ack.clsID == AP_GPS_UBLOX::CLASS_CFG) {
+                        handle_cfg_ack(ubx_backend._payload->ack.msgID);
                         //      Debug("GPS %d: ACK for class 0x%02x id 0x%02x",
                         //            ubx_backend.state.instance + 1,
-                        //            ubx_backend._buffer.ack.clsID,
-                        //            ubx_backend._buffer.ack.msgID);
+                        //            ubx_backend._payload->ack.clsID,
+                        //            ubx_backend._payload->ack.msgID);
                     }
                     break;
                 case AP_GPS_UBLOX::MSG_ACK_NACK:
-                    if (ubx_backend._buffer.nack.clsID == AP_GPS_UBLOX::CLASS_CFG) {
-                        handle_cfg_nack(ubx_backend._buffer.nack.msgID);
+                    if (ubx_backend._payload->nack.clsID == AP_GPS_UBLOX::CLASS_CFG) {
+                        handle_cfg_nack(ubx_backend._payload->nack.msgID);
                         //    Debug("GPS %d: NACK for class 0x%02x id 0x%02x",
                         //            ubx_backend.state.instance + 1,
-                        //            ubx_backend._buffer.nack.clsID,
-                        //            ubx_backend._buffer.nack.msgID);
+                        //            ubx_backend._payload->nack.clsID,
+                        //            ubx_backend._payload->nack.msgID);
                     }
                     break;
                 default:
@@ -134,7 +134,7 @@ void AP_GPS_UBLOX_CFGv2::update()
                     // accept partial packet; only need first 3 bytes to derive outputPort
                     // bits 4..2 map to output port per u-blox doc: 1=I2C,2=UART1,3=UART2,4=USB,5=SPI
                     // 4..2 map might not be present in older ublox firmware, so only update if non-zero
-                    uint8_t ublox_port = (uint8_t)((ubx_backend._buffer.mon_comms.txErrors >> 2) & 0x07);
+                    uint8_t ublox_port = (uint8_t)((ubx_backend._payload->mon_comms.txErrors >> 2) & 0x07);
                     if (ublox_port != 0) {
                         portId = ublox_port;
                     }
@@ -149,7 +149,7 @@ void AP_GPS_UBLOX_CFGv2::update()
                 case AP_GPS_UBLOX::MSG_CFG_PRT:
                     // for modules that don't support MON-COMMS method of port detection
                     // 0: I2C, 1: UART1, 2: UART2, 3: USB, 4: SPI; add 1 to convert to ublox port numbering
-                    portId = ubx_backend._buffer.prt.portID + 1;
+                    portId = ubx_backend._payload->prt.portID + 1;
                     break;
                 default:
                     break;
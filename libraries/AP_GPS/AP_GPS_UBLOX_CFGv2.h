@@ -48,6 +48,7 @@ class AP_GPS_UBLOX_CFGv2 {
     using ConfigKey = AP::UBXConfigKey;
 private:
     friend class AP_GPS_UBLOX;
+    friend class AP_GPS_UBLOX_Test;
 
 public:
     AP_GPS_UBLOX_CFGv2(AP_GPS_UBLOX &_ubx_backend);
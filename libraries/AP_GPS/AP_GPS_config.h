@@ -101,6 +101,22 @@
   #define AP_GPS_UBLOX_CFGV2_ENABLED AP_GPS_UBLOX_ENABLED && HAL_PROGRAM_SIZE_LIMIT_KB > 1024
 #endif
 
+// parse UBX frames in place from a block receive buffer rather than
+// one byte at a time
+#ifndef AP_GPS_UBLOX_BLOCK_PARSER_ENABLED
+  #define AP_GPS_UBLOX_BLOCK_PARSER_ENABLED (AP_GPS_UBLOX_ENABLED && HAL_MEM_CLASS >= HAL_MEM_CLASS_300)
+#endif
+
+// bytes of RTCM data held for writing to the GPS receivers, enough
+// for a full round from a NTRIP server with all constellations
+#ifndef AP_GPS_RTCM_POOL_SIZE
+  #if HAL_MEM_CLASS >= HAL_MEM_CLASS_500
+    #define AP_GPS_RTCM_POOL_SIZE 4096
+  #else
+    #define AP_GPS_RTCM_POOL_SIZE 2400
+  #endif
+#endif
+
 #ifndef AP_GPS_RTCM_DECODE_ENABLED
   #define AP_GPS_RTCM_DECODE_ENABLED HAL_PROGRAM_SIZE_LIMIT_KB > 1024
 #endif
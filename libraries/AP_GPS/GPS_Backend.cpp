@@ -126,6 +126,35 @@ AP_GPS_Backend::inject_data(const uint8_t *data, uint16_t len)
     }
 }
 
+void
+AP_GPS_Backend::inject_rtcm(RTCM_Pool &pool)
+{
+    const uint8_t *data;
+    uint16_t len;
+    while ((len = pool.peek(state.instance, data)) > 0) {
+        if (port == nullptr) {
+            // not all backends have valid ports
+            pool.discard(state.instance);
+            return;
+        }
+        // write straight from the pool. Only start a frame the port
+        // can take whole, so a frame dropped from the pool is never
+        // cut short at the receiver; one too big for the port is
+        // written a piece at a time, starting once the port is idle.
+        // inject_data() needs txspace() > len
+        const uint32_t space = port->txspace();
+        if (space <= len) {
+            if (space <= 1 ||
+                (!pool.part_written(state.instance) && port->tx_pending())) {
+                return;
+            }
+            len = space - 1;
+        }
+        inject_data(data, len);
+        pool.advance(state.instance, len);
+    }
+}
+
 void AP_GPS_Backend::_detection_message(char *buffer, const uint8_t buflen) const
 {
     const uint8_t instance = state.instance;
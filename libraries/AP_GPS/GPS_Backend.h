@@ -68,6 +68,10 @@ public:
 
     virtual void inject_data(const uint8_t *data, uint16_t len);
 
+    // write pending RTCM data from the pool to the GPS. Called with the
+    // pool semaphore held
+    virtual void inject_rtcm(RTCM_Pool &pool);
+
 #if HAL_GCS_ENABLED
     //MAVLink methods
     virtual bool supports_mavlink_gps_rtk_message() const { return false; }
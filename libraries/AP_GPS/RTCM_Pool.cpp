@@ -0,0 +1,232 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  pool of RTCM data waiting to be written to GPS receivers
+*/
+
+#include "RTCM_Pool.h"
+
+#if AP_GPS_ENABLED
+
+#include <string.h>
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Math/AP_Math.h>
+
+/*
+  find room for len bytes after the newest frame, wrapping to the
+  start of the buffer if needed
+ */
+bool RTCM_Pool::alloc(uint16_t len, uint16_t &offset)
+{
+    if (head == tail) {
+        offset = 0;
+        return true;
+    }
+    const Frame &oldest = frame(tail);
+    const Frame &newest = frame(head - 1);
+    const uint16_t end = newest.offset + newest.len;
+    if (newest.offset >= oldest.offset) {
+        // free space is after the newest frame and before the oldest
+        if (AP_GPS_RTCM_POOL_SIZE - end >= len) {
+            offset = end;
+            return true;
+        }
+        if (oldest.offset >= len) {
+            offset = 0;
+            return true;
+        }
+        return false;
+    }
+    // free space is between the newest and the oldest frames
+    if (oldest.offset - end >= len) {
+        offset = end;
+        return true;
+    }
+    return false;
+}
+
+// drop the oldest frame, counting it against the consumers still to write it
+void RTCM_Pool::drop_oldest()
+{
+    const Frame &f = frame(tail);
+    for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+        if (!(f.pending & (1U<<i))) {
+            continue;
+        }
+        if (cursor[i].seq == tail && cursor[i].offset != 0) {
+            stats[i].truncated++;
+        } else {
+            stats[i].dropped++;
+        }
+    }
+    tail++;
+    clamp_cursors();
+}
+
+// free the oldest frames once all their consumers have written them
+void RTCM_Pool::release()
+{
+    while (tail != head && frame(tail).pending == 0) {
+        tail++;
+    }
+    clamp_cursors();
+}
+
+/*
+  move cursors left behind the oldest frame up to it. A cursor can
+  only be left behind by frames it was not going to write, or by a
+  dropped frame
+ */
+void RTCM_Pool::clamp_cursors()
+{
+    for (auto &c : cursor) {
+        if (uint16_t(c.seq - tail) > uint16_t(head - tail)) {
+            c.seq = tail;
+            c.offset = 0;
+        }
+    }
+}
+
+// move a consumer's cursor past frames which are not for it
+void RTCM_Pool::skip_unaddressed(uint8_t consumer)
+{
+    auto &c = cursor[consumer];
+    while (c.seq != head && !(frame(c.seq).pending & (1U<<consumer))) {
+        c.seq++;
+        c.offset = 0;
+    }
+}
+
+bool RTCM_Pool::pending(uint8_t consumer)
+{
+    WITH_SEMAPHORE(sem);
+
+    for (uint16_t seq = cursor[consumer].seq; seq != head; seq++) {
+        if (frame(seq).pending & (1U<<consumer)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool RTCM_Pool::add(const uint8_t *data, uint16_t len, uint8_t mask)
+{
+    if (len == 0 || mask == 0) {
+        return true;
+    }
+
+    WITH_SEMAPHORE(sem);
+
+    if (buffer == nullptr) {
+        buffer = NEW_NOTHROW uint8_t[AP_GPS_RTCM_POOL_SIZE];
+    }
+    if (buffer == nullptr || len > AP_GPS_RTCM_POOL_SIZE) {
+        for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+            if (mask & (1U<<i)) {
+                stats[i].dropped++;
+            }
+        }
+        return false;
+    }
+
+    uint16_t offset;
+    while (uint16_t(head - tail) >= MAX_FRAMES || !alloc(len, offset)) {
+        drop_oldest();
+    }
+
+    Frame &f = frame(head);
+    f.receipt_us = AP_HAL::micros();
+    f.offset = offset;
+    f.len = len;
+    f.pending = mask;
+    memcpy(&buffer[offset], data, len);
+    head++;
+    return true;
+}
+
+uint16_t RTCM_Pool::peek(uint8_t consumer, const uint8_t *&data)
+{
+    WITH_SEMAPHORE(sem);
+
+    skip_unaddressed(consumer);
+    const auto &c = cursor[consumer];
+    if (c.seq == head) {
+        return 0;
+    }
+    const Frame &f = frame(c.seq);
+    data = &buffer[f.offset + c.offset];
+    return f.len - c.offset;
+}
+
+uint16_t RTCM_Pool::copy(uint8_t consumer, uint8_t *buf, uint16_t len)
+{
+    WITH_SEMAPHORE(sem);
+
+    skip_unaddressed(consumer);
+    uint16_t offset = cursor[consumer].offset;
+    uint16_t copied = 0;
+    for (uint16_t seq = cursor[consumer].seq; seq != head && copied < len; seq++) {
+        const Frame &f = frame(seq);
+        if (!(f.pending & (1U<<consumer))) {
+            continue;
+        }
+        const uint16_t n = MIN(uint16_t(f.len - offset), uint16_t(len - copied));
+        memcpy(&buf[copied], &buffer[f.offset + offset], n);
+        copied += n;
+        offset = 0;
+    }
+    return copied;
+}
+
+void RTCM_Pool::advance(uint8_t consumer, uint16_t len)
+{
+    WITH_SEMAPHORE(sem);
+
+    auto &c = cursor[consumer];
+    auto &s = stats[consumer];
+    while (len > 0) {
+        skip_unaddressed(consumer);
+        if (c.seq == head) {
+            break;
+        }
+        Frame &f = frame(c.seq);
+        const uint16_t n = MIN(uint16_t(f.len - c.offset), len);
+        c.offset += n;
+        len -= n;
+        if (c.offset == f.len) {
+            f.pending &= ~(1U<<consumer);
+            c.seq++;
+            c.offset = 0;
+            s.frames++;
+            s.latency_us = AP_HAL::micros() - f.receipt_us;
+            s.max_latency_us = MAX(s.max_latency_us, s.latency_us);
+        }
+    }
+    release();
+}
+
+void RTCM_Pool::discard(uint8_t consumer)
+{
+    WITH_SEMAPHORE(sem);
+
+    auto &c = cursor[consumer];
+    for (; c.seq != head; c.seq++) {
+        frame(c.seq).pending &= ~(1U<<consumer);
+    }
+    c.offset = 0;
+    release();
+}
+
+#endif // AP_GPS_ENABLED
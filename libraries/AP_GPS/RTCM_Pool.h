@@ -0,0 +1,116 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  pool of RTCM data waiting to be written to GPS receivers
+
+  Each frame of data is stored once, along with the mask of GPS
+  instances still to write it, which acts as its reference count. Each
+  instance keeps a cursor into the frames, so a receiver which can't
+  take all its data at once picks up where it left off. When there is
+  no room for a new frame the oldest frames are dropped. Dropping a
+  frame a consumer has part written cuts the RTCM message short at the
+  receiver, so consumers should only start a frame they can finish.
+*/
+#pragma once
+
+#include "AP_GPS_config.h"
+
+#if AP_GPS_ENABLED
+
+#include <stdint.h>
+#include <AP_HAL/Semaphores.h>
+
+class RTCM_Pool {
+public:
+    static_assert(GPS_MAX_RECEIVERS <= 8, "consumer mask too small");
+
+    ~RTCM_Pool() { delete[] buffer; }
+
+    struct Stats {
+        uint32_t frames;            // frames written
+        uint32_t dropped;           // frames dropped before they were written
+        uint32_t truncated;         // frames dropped part way through being written
+        uint32_t latency_us;        // receipt to write of the last frame
+        uint32_t max_latency_us;    // largest latency since reset_max_latency()
+    };
+
+    // store a frame for the consumers in mask. Returns false if it was dropped
+    bool add(const uint8_t *data, uint16_t len, uint8_t mask);
+
+    /*
+      return the length of the data the consumer has still to write
+      from its current frame, pointing data at it. The caller must hold
+      the semaphore until it has called advance()
+     */
+    uint16_t peek(uint8_t consumer, const uint8_t *&data);
+
+    // copy up to len bytes of pending data without consuming them
+    uint16_t copy(uint8_t consumer, uint8_t *buf, uint16_t len);
+
+    // mark len bytes of pending data as written
+    void advance(uint8_t consumer, uint16_t len);
+
+    // drop all data pending for a consumer
+    void discard(uint8_t consumer);
+
+    // true if there is data pending for a consumer
+    bool pending(uint8_t consumer);
+
+    // true if the consumer has written part of its current frame
+    bool part_written(uint8_t consumer) const { return cursor[consumer].offset != 0; }
+
+    // true once data has been added
+    bool in_use() const { return buffer != nullptr; }
+
+    const Stats &get_stats(uint8_t consumer) const { return stats[consumer]; }
+    void reset_max_latency(uint8_t consumer) { stats[consumer].max_latency_us = 0; }
+
+    HAL_Semaphore &get_semaphore() { return sem; }
+
+private:
+    static const uint8_t MAX_FRAMES = 32;
+    struct Frame {
+        uint32_t receipt_us;
+        uint16_t offset;
+        uint16_t len;
+        uint8_t pending;    // consumers yet to write the frame
+    } frames[MAX_FRAMES];
+
+    // frame storage, allocated on first use
+    uint8_t *buffer;
+
+    // sequence numbers of the oldest frame and the next frame added
+    uint16_t tail;
+    uint16_t head;
+
+    struct {
+        uint16_t seq;       // frame being written
+        uint16_t offset;    // bytes of it already written
+    } cursor[GPS_MAX_RECEIVERS];
+
+    Stats stats[GPS_MAX_RECEIVERS];
+
+    HAL_Semaphore sem;
+
+    Frame &frame(uint16_t seq) { return frames[seq % MAX_FRAMES]; }
+    const Frame &frame(uint16_t seq) const { return frames[seq % MAX_FRAMES]; }
+    bool alloc(uint16_t len, uint16_t &offset);
+    void drop_oldest();
+    void release();
+    void clamp_cursors();
+    void skip_unaddressed(uint8_t consumer);
+};
+
+#endif // AP_GPS_ENABLED
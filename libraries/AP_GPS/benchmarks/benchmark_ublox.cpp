@@ -0,0 +1,143 @@
+/*
+  benchmarks of reading UBX from a serial port, with the per byte
+  state machine and with the block parser. The stream is laid out
+  like a capture from an F9P moving baseline base at 10Hz: PVT, DOP,
+  RELPOSNED and RXM-RAWX with 40 measurements each epoch, MON-HW once
+  a second and RTCMv3 MSM7 packets for the rover in between
+ */
+#include <AP_gbenchmark.h>
+
+#include <AP_GPS/AP_GPS_UBLOX.h>
+#include <AP_Math/AP_Math.h>
+
+#include <vector>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+#if AP_GPS_UBLOX_BLOCK_PARSER_ENABLED
+
+class AP_GPS_UBLOX_Test
+{
+public:
+    // make the driver fall back to parsing byte by byte
+    static void disable_block_parser(AP_GPS_UBLOX &ubx)
+    {
+        delete[] ubx._rx;
+        ubx._rx = nullptr;
+    }
+};
+
+// a UART which returns the bytes of a capture and swallows writes
+class CaptureUart : public AP_HAL::UARTDriver {
+public:
+    CaptureUart(const std::vector<uint8_t> &_capture) : capture(_capture) {}
+    void rewind() { ofs = 0; }
+    bool is_initialized() override { return true; }
+    bool tx_pending() override { return false; }
+    uint32_t txspace() override { return 1024; }
+
+protected:
+    uint32_t _available() override { return capture.size() - ofs; }
+    void _begin(uint32_t baud, uint16_t rxSpace, uint16_t txSpace) override {}
+    void _end() override {}
+    void _flush() override {}
+    size_t _write(const uint8_t *buffer, size_t size) override { return size; }
+    ssize_t _read(uint8_t *buf, uint16_t count) override
+    {
+        const uint32_t n = MIN(uint32_t(count), uint32_t(capture.size() - ofs));
+        memcpy(buf, &capture[ofs], n);
+        ofs += n;
+        return n;
+    }
+    bool _discard_input() override { return false; }
+
+private:
+    const std::vector<uint8_t> &capture;
+    uint32_t ofs = 0;
+};
+
+static AP_GPS gps;
+
+static void add_ubx(std::vector<uint8_t> &s, uint8_t msg_class, uint8_t msg_id, uint16_t len)
+{
+    const size_t start = s.size();
+    s.insert(s.end(), { 0xb5, 0x62, msg_class, msg_id, uint8_t(len & 0xFF), uint8_t(len >> 8) });
+    for (uint16_t i=0; i<len; i++) {
+        s.push_back(get_random16());
+    }
+    uint8_t ck_a = 0, ck_b = 0;
+    for (size_t i=start+2; i<s.size(); i++) {
+        ck_b += (ck_a += s[i]);
+    }
+    s.push_back(ck_a);
+    s.push_back(ck_b);
+}
+
+static void add_rtcm3(std::vector<uint8_t> &s, uint16_t len)
+{
+    s.insert(s.end(), { 0xd3, uint8_t(len >> 8), uint8_t(len & 0xFF) });
+    for (uint16_t i=0; i<len+3; i++) {
+        s.push_back(get_random16());
+    }
+}
+
+static const std::vector<uint8_t> &capture()
+{
+    static std::vector<uint8_t> s;
+    if (s.empty()) {
+        for (uint8_t epoch=0; epoch<50; epoch++) {
+            add_ubx(s, 0x01, 0x07, 92);             // NAV-PVT
+            add_ubx(s, 0x01, 0x04, 18);             // NAV-DOP
+            add_ubx(s, 0x01, 0x3c, 64);             // NAV-RELPOSNED
+            add_ubx(s, 0x02, 0x15, 16 + 32*40);     // RXM-RAWX
+            if (epoch % 10 == 0) {
+                add_ubx(s, 0x0a, 0x09, 60);         // MON-HW
+            }
+            add_rtcm3(s, 380);                      // 1077
+            add_rtcm3(s, 250);                      // 1087
+            add_rtcm3(s, 300);                      // 1097
+            add_rtcm3(s, 19);                       // 1005
+        }
+    }
+    return s;
+}
+
+// read the whole capture through AP_GPS_UBLOX::read(), as the GPS
+// update loop would
+static void read_capture(benchmark::State& state, bool block)
+{
+    const std::vector<uint8_t> &s = capture();
+    AP_GPS::Params params;
+    AP_GPS::GPS_State gps_state {};
+    CaptureUart uart(s);
+    AP_GPS_UBLOX *ubx = NEW_NOTHROW AP_GPS_UBLOX(gps, params, gps_state, &uart, AP_GPS::GPS_ROLE_NORMAL);
+    if (!block) {
+        AP_GPS_UBLOX_Test::disable_block_parser(*ubx);
+    }
+    while (state.KeepRunning()) {
+        uart.rewind();
+        while (uart.available() > 0) {
+            bool parsed = ubx->read();
+            gbenchmark_escape(&parsed);
+        }
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * s.size());
+    delete ubx;
+}
+
+static void BM_UBXReadBytewise(benchmark::State& state)
+{
+    read_capture(state, false);
+}
+
+static void BM_UBXReadBlock(benchmark::State& state)
+{
+    read_capture(state, true);
+}
+
+BENCHMARK(BM_UBXReadBytewise);
+BENCHMARK(BM_UBXReadBlock);
+
+#endif // AP_GPS_UBLOX_BLOCK_PARSER_ENABLED
+
+BENCHMARK_MAIN();
@@ -17,6 +17,7 @@
 #include <AP_gtest.h>
 
 #include <AP_GPS/AP_GPS_NMEA.h>
+#include <AP_GPS/AP_GPS_UBLOX.h>
 
 const AP_HAL::HAL &hal = AP_HAL::get_HAL();
 
@@ -62,4 +63,148 @@ TEST(AP_GPS_NMEA, parse_decimal_100)
     ASSERT_EQ(-100, test.parse_decimal_100("-1"));
 }
 
+#if AP_GPS_UBLOX_BLOCK_PARSER_ENABLED
+class AP_GPS_UBLOX_Test
+{
+public:
+    using ScanResult = AP_GPS_UBLOX::ScanResult;
+
+    static ScanResult scan_frame(const uint8_t *buf, uint16_t len, uint16_t &n)
+    {
+        return AP_GPS_UBLOX::_scan_frame(buf, len, n);
+    }
+
+#if AP_GPS_UBLOX_CFGV2_ENABLED
+    static void fill_buffer(AP_GPS_UBLOX &ubx, uint8_t value)
+    {
+        memset(&ubx._buffer, value, sizeof(ubx._buffer));
+    }
+
+    static uint8_t cfg_v2_port(const AP_GPS_UBLOX &ubx)
+    {
+        return ubx._cfg_v2.portId;
+    }
+
+    static uint8_t legacy_port(const AP_GPS_UBLOX &ubx)
+    {
+        return ubx._ublox_port;
+    }
+
+    // build a CFG-PRT frame for a port, returning its length
+    static uint16_t cfg_prt_frame(uint8_t *buf, uint8_t port_id)
+    {
+        const uint16_t len = 20;
+        memset(buf, 0, len + 8);
+        buf[0] = AP_GPS_UBLOX::PREAMBLE1;
+        buf[1] = AP_GPS_UBLOX::PREAMBLE2;
+        buf[2] = AP_GPS_UBLOX::CLASS_CFG;
+        buf[3] = AP_GPS_UBLOX::MSG_CFG_PRT;
+        buf[4] = len;
+        buf[6] = port_id;
+        uint8_t ck_a = 0, ck_b = 0;
+        AP_GPS_UBLOX::_update_checksum(&buf[2], len + 4, ck_a, ck_b);
+        buf[6+len] = ck_a;
+        buf[7+len] = ck_b;
+        return len + 8;
+    }
+#endif
+};
+
+TEST(AP_GPS_UBLOX, scan_frame)
+{
+    using ScanResult = AP_GPS_UBLOX_Test::ScanResult;
+
+    // noise, then a NAV-DOP frame with an empty payload
+    uint8_t buf[] { 0x00, 0x62, 0xb5, 0x62, 0x01, 0x04, 0x00, 0x00, 0x05, 0x10 };
+    uint16_t n;
+    ASSERT_EQ(ScanResult::SKIP, AP_GPS_UBLOX_Test::scan_frame(buf, sizeof(buf), n));
+    ASSERT_EQ(2, n);
+    ASSERT_EQ(ScanResult::FRAME, AP_GPS_UBLOX_Test::scan_frame(&buf[2], sizeof(buf)-2, n));
+    ASSERT_EQ(8, n);
+
+    // the frame has not completely arrived
+    ASSERT_EQ(ScanResult::PARTIAL, AP_GPS_UBLOX_Test::scan_frame(&buf[2], 4, n));
+    ASSERT_EQ(ScanResult::PARTIAL, AP_GPS_UBLOX_Test::scan_frame(&buf[2], 7, n));
+
+    // a bad ck_a byte is re-considered as the start of a frame
+    buf[8]++;
+    ASSERT_EQ(ScanResult::SKIP, AP_GPS_UBLOX_Test::scan_frame(&buf[2], sizeof(buf)-2, n));
+    ASSERT_EQ(6, n);
+
+    // a bad ck_b byte is not
+    buf[8]--;
+    buf[9]++;
+    ASSERT_EQ(ScanResult::SKIP, AP_GPS_UBLOX_Test::scan_frame(&buf[2], sizeof(buf)-2, n));
+    ASSERT_EQ(8, n);
+
+    // a payload larger than any we decode is noise
+    buf[7] = 0xff;
+    ASSERT_EQ(ScanResult::SKIP, AP_GPS_UBLOX_Test::scan_frame(&buf[2], sizeof(buf)-2, n));
+    ASSERT_EQ(5, n);
+}
+
+#if AP_GPS_UBLOX_CFGV2_ENABLED
+// a UART which returns the bytes fed to it and swallows writes
+class FeedUart : public AP_HAL::UARTDriver {
+public:
+    void feed(const uint8_t *buf, uint16_t len)
+    {
+        memcpy(&data[data_len], buf, len);
+        data_len += len;
+    }
+    bool is_initialized() override { return true; }
+    bool tx_pending() override { return false; }
+    uint32_t txspace() override { return 1024; }
+
+protected:
+    uint32_t _available() override { return data_len - ofs; }
+    void _begin(uint32_t baud, uint16_t rxSpace, uint16_t txSpace) override {}
+    void _end() override {}
+    void _flush() override {}
+    size_t _write(const uint8_t *buffer, size_t size) override { return size; }
+    ssize_t _read(uint8_t *buf, uint16_t count) override
+    {
+        const uint16_t n = MIN(count, uint16_t(data_len - ofs));
+        memcpy(buf, &data[ofs], n);
+        ofs += n;
+        return n;
+    }
+    bool _discard_input() override { return false; }
+
+private:
+    uint8_t data[256];
+    uint16_t data_len = 0;
+    uint16_t ofs = 0;
+};
+
+static AP_GPS gps;
+
+// a frame parsed in place must still be seen by the CFGv2 update at
+// the start of the next read(), as it is with the byte parser
+TEST(AP_GPS_UBLOX, cfg_v2_after_block)
+{
+    AP_GPS::Params params;
+    AP_GPS::GPS_State state {};
+    FeedUart uart;
+    AP_GPS_UBLOX *ubx = NEW_NOTHROW AP_GPS_UBLOX(gps, params, state, &uart, AP_GPS::GPS_ROLE_NORMAL);
+    ASSERT_NE(nullptr, ubx);
+
+    // anything left behind in _buffer must not be mistaken for the frame
+    AP_GPS_UBLOX_Test::fill_buffer(*ubx, 0x55);
+
+    // CFG-PRT for UART1
+    uint8_t buf[64];
+    uart.feed(buf, AP_GPS_UBLOX_Test::cfg_prt_frame(buf, 1));
+    ubx->read();
+    EXPECT_EQ(1, AP_GPS_UBLOX_Test::legacy_port(*ubx));
+
+    // nothing more arrives
+    ubx->read();
+    EXPECT_EQ(2, AP_GPS_UBLOX_Test::cfg_v2_port(*ubx));
+
+    delete ubx;
+}
+#endif // AP_GPS_UBLOX_CFGV2_ENABLED
+#endif // AP_GPS_UBLOX_BLOCK_PARSER_ENABLED
+
 AP_GTEST_MAIN()
@@ -0,0 +1,125 @@
+#include <AP_gtest.h>
+
+#include <AP_GPS/RTCM_Pool.h>
+
+const AP_HAL::HAL &hal = AP_HAL::get_HAL();
+
+static const uint8_t frame1[] { 0xd3, 0x00, 0x02, 0x11, 0x22, 0x01, 0x02, 0x03 };
+static const uint8_t frame2[] { 0xd3, 0x00, 0x01, 0x33, 0x04, 0x05, 0x06 };
+
+// each consumer writes the same stored frame, at its own pace
+TEST(RTCM_Pool, shared_frame)
+{
+    RTCM_Pool pool {};
+    EXPECT_TRUE(pool.add(frame1, sizeof(frame1), 0x3));
+    EXPECT_TRUE(pool.pending(0));
+    EXPECT_TRUE(pool.pending(1));
+
+    const uint8_t *data;
+    ASSERT_EQ(sizeof(frame1), pool.peek(0, data));
+    EXPECT_EQ(0, memcmp(data, frame1, sizeof(frame1)));
+    pool.advance(0, 3);
+    ASSERT_EQ(sizeof(frame1) - 3, pool.peek(0, data));
+    EXPECT_EQ(0, memcmp(data, &frame1[3], sizeof(frame1) - 3));
+    pool.advance(0, sizeof(frame1) - 3);
+    EXPECT_EQ(0, pool.peek(0, data));
+    EXPECT_EQ(1U, pool.get_stats(0).frames);
+
+    ASSERT_EQ(sizeof(frame1), pool.peek(1, data));
+    EXPECT_EQ(0, memcmp(data, frame1, sizeof(frame1)));
+    pool.advance(1, sizeof(frame1));
+    EXPECT_FALSE(pool.pending(1));
+}
+
+// frames are only given to the consumers they were added for
+TEST(RTCM_Pool, addressing)
+{
+    RTCM_Pool pool {};
+    EXPECT_TRUE(pool.add(frame1, sizeof(frame1), 0x1));
+    EXPECT_TRUE(pool.add(frame2, sizeof(frame2), 0x2));
+
+    const uint8_t *data;
+    ASSERT_EQ(sizeof(frame2), pool.peek(1, data));
+    EXPECT_EQ(0, memcmp(data, frame2, sizeof(frame2)));
+
+    pool.discard(0);
+    EXPECT_EQ(0, pool.peek(0, data));
+    EXPECT_EQ(0U, pool.get_stats(0).frames);
+}
+
+// only frames addressed to a consumer are pending for it
+TEST(RTCM_Pool, pending_addressed)
+{
+    RTCM_Pool pool {};
+    EXPECT_FALSE(pool.pending(0));
+    EXPECT_TRUE(pool.add(frame1, sizeof(frame1), 0x2));
+    EXPECT_FALSE(pool.pending(0));
+    EXPECT_TRUE(pool.pending(1));
+
+    EXPECT_TRUE(pool.add(frame2, sizeof(frame2), 0x1));
+    EXPECT_TRUE(pool.pending(0));
+    pool.advance(0, sizeof(frame2));
+    EXPECT_FALSE(pool.pending(0));
+    EXPECT_TRUE(pool.pending(1));
+}
+
+// copy() gathers data across frames without consuming it
+TEST(RTCM_Pool, copy)
+{
+    RTCM_Pool pool {};
+    EXPECT_TRUE(pool.add(frame1, sizeof(frame1), 0x1));
+    EXPECT_TRUE(pool.add(frame2, sizeof(frame2), 0x1));
+
+    uint8_t buf[32];
+    ASSERT_EQ(sizeof(frame1) + sizeof(frame2), pool.copy(0, buf, sizeof(buf)));
+    EXPECT_EQ(0, memcmp(buf, frame1, sizeof(frame1)));
+    EXPECT_EQ(0, memcmp(&buf[sizeof(frame1)], frame2, sizeof(frame2)));
+
+    pool.advance(0, sizeof(frame1) + 2);
+    ASSERT_EQ(sizeof(frame2) - 2, pool.copy(0, buf, sizeof(buf)));
+    EXPECT_EQ(0, memcmp(buf, &frame2[2], sizeof(frame2) - 2));
+    EXPECT_EQ(1U, pool.get_stats(0).frames);
+}
+
+// a consumer which never writes has its oldest frames dropped
+TEST(RTCM_Pool, drop_oldest)
+{
+    RTCM_Pool pool {};
+    uint8_t big[AP_GPS_RTCM_POOL_SIZE / 3] {};
+    for (uint8_t i=0; i<10; i++) {
+        big[0] = i;
+        EXPECT_TRUE(pool.add(big, sizeof(big), 0x1));
+    }
+    const RTCM_Pool::Stats &stats = pool.get_stats(0);
+    EXPECT_EQ(7U, stats.dropped);
+
+    const uint8_t *data;
+    for (uint8_t i=7; i<10; i++) {
+        ASSERT_EQ(sizeof(big), pool.peek(0, data));
+        EXPECT_EQ(i, data[0]);
+        pool.advance(0, sizeof(big));
+    }
+    EXPECT_EQ(3U, stats.frames);
+    EXPECT_FALSE(pool.pending(0));
+
+    // dropping a frame part way through writing it is counted apart
+    // from frames which were never started
+    EXPECT_TRUE(pool.add(big, sizeof(big), 0x1));
+    pool.advance(0, 10);
+    EXPECT_TRUE(pool.part_written(0));
+    for (uint8_t i=0; i<3; i++) {
+        EXPECT_TRUE(pool.add(big, sizeof(big), 0x1));
+    }
+    EXPECT_EQ(1U, stats.truncated);
+    EXPECT_EQ(7U, stats.dropped);
+    EXPECT_FALSE(pool.part_written(0));
+    ASSERT_EQ(sizeof(big), pool.peek(0, data));
+    pool.discard(0);
+
+    // larger than the pool
+    uint8_t huge[AP_GPS_RTCM_POOL_SIZE + 1] {};
+    EXPECT_FALSE(pool.add(huge, sizeof(huge), 0x1));
+    EXPECT_EQ(8U, stats.dropped);
+}
+
+AP_GTEST_MAIN()
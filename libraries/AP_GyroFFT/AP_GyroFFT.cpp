@@ -169,8 +169,8 @@ const AP_Param::GroupInfo AP_GyroFFT::var_info[] = {
 
     // @Param: OPTIONS
     // @DisplayName: FFT options
-    // @Description: FFT configuration options. Values: 1:Apply the FFT *after* the filter bank,2:Check noise at the motor frequencies using ESC data as a reference
-    // @Bitmask: 0:Enable post-filter FFT,1:Check motor noise
+    // @Description: FFT configuration options. Values: 1:Apply the FFT *after* the filter bank,2:Check noise at the motor frequencies using ESC data as a reference,4:Analyse all three axes in each cycle rather than one axis per cycle, reducing tracking latency at the cost of three times the CPU load. Only recommended on boards with spare CPU such as Linux boards
+    // @Bitmask: 0:Enable post-filter FFT,1:Check motor noise,2:Analyse all axes each cycle
     // @User: Advanced
     // @RebootRequired: True
     AP_GROUPINFO("OPTIONS", 15, AP_GyroFFT, _options, 0),
@@ -232,9 +232,12 @@ __INITFUNC__ void AP_GyroFFT::init(uint16_t loop_rate_hz)
         _num_frames.set(constrain_int16(_num_frames, 2, AP_HAL::DSP::MAX_SLIDING_WINDOW_SIZE));
     }
 
+    // analysing all axes each cycle requires a DSP state per axis
+    const uint8_t num_states = analyse_all_axes() ? XYZ_AXIS_COUNT : 1;
+
     // check that we have enough memory for the window size requested
-    // INS: XYZ_AXIS_COUNT * INS_MAX_INSTANCES * _window_size, DSP: 3 * _window_size, FFT: XYZ_AXIS_COUNT + 3 * _window_size
-    const uint32_t allocation_count = (XYZ_AXIS_COUNT * INS_MAX_INSTANCES + 3 + XYZ_AXIS_COUNT + 3 + _num_frames) * sizeof(float);
+    // INS: XYZ_AXIS_COUNT * INS_MAX_INSTANCES * _window_size, DSP: 3 * _window_size per state, FFT: XYZ_AXIS_COUNT + 3 * _window_size
+    const uint32_t allocation_count = (XYZ_AXIS_COUNT * INS_MAX_INSTANCES + (3 + _num_frames) * num_states + XYZ_AXIS_COUNT + 3) * sizeof(float);
     if (allocation_count * FFT_DEFAULT_WINDOW_SIZE > hal.util->available_memory() / 2) {
         GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "AP_GyroFFT: disabled, required %u bytes", (unsigned int)allocation_count * FFT_DEFAULT_WINDOW_SIZE);
         return;
@@ -312,11 +315,23 @@ __INITFUNC__ void AP_GyroFFT::init(uint16_t loop_rate_hz)
 #endif  // AP_INERTIALSENSOR_HARMONICNOTCH_ENABLED
 
     // initialise the HAL DSP subsystem
-    _state = hal.dsp->fft_init(_window_size, _fft_sampling_rate_hz, _num_frames);
-    if (_state == nullptr) {
-        GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "Failed to initialize DSP engine");
-        return;
+    for (uint8_t i = 0; i < num_states; i++) {
+        _axis_state[i] = hal.dsp->fft_init(_window_size, _fft_sampling_rate_hz, _num_frames);
+        if (_axis_state[i] == nullptr) {
+            GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "Failed to initialize DSP engine");
+            // don't leak the states already created
+            for (uint8_t j = 0; j < i; j++) {
+                delete _axis_state[j];
+                _axis_state[j] = nullptr;
+            }
+            return;
+        }
+    }
+    // when analysing one axis per cycle the axes share a state
+    for (uint8_t i = num_states; i < XYZ_AXIS_COUNT; i++) {
+        _axis_state[i] = _axis_state[0];
     }
+    _state = _axis_state[0];
 
     // per-axis frame time
     _frame_time_ms = _samples_per_frame * 1000 / _fft_sampling_rate_hz;
@@ -452,6 +467,39 @@ uint16_t AP_GyroFFT::run_cycle()
 
     _sem.give();
 
+    uint16_t new_sample_count;
+    if (analyse_all_axes()) {
+        // analyse every axis that has a full window, finishing back on the starting axis
+        new_sample_count = UINT16_MAX;
+        for (uint8_t i = 0; i < XYZ_AXIS_COUNT; i++) {
+            if (get_available_samples(_update_axis) >= _state->_window_size) {
+                analyse_axis(config);
+            }
+            _update_axis = (_update_axis + 1) % XYZ_AXIS_COUNT;
+            _state = _axis_state[_update_axis];
+            new_sample_count = MIN(new_sample_count, get_available_samples(_update_axis));
+        }
+    } else {
+        analyse_axis(config);
+        // move onto the next axis
+        _update_axis = (_update_axis + 1) % XYZ_AXIS_COUNT;
+        _state = _axis_state[_update_axis];
+        // samples remaining in the next axis
+        new_sample_count = get_available_samples(_update_axis);
+    }
+
+    // ready to receive another frame, because lock contention is so expensive we don't lock
+    // around this flag but rather rely on the semaphore at the beginning of the loop to
+    // ensure eventual visibility to the main loop
+    _thread_state._analysis_started = false;
+
+    return new_sample_count;
+}
+
+// analyse a frame of gyro data on the current update axis
+// called from FFT thread
+void AP_GyroFFT::analyse_axis(const EngineConfig& config)
+{
     uint32_t now = AP_HAL::micros();
 
     // get the appropriate gyro buffer
@@ -508,17 +556,6 @@ uint16_t AP_GyroFFT::run_cycle()
         _state->_freq_bins[_state->_peak_data[1]._bin],
         _state->_freq_bins[_state->_peak_data[2]._bin]);
 #endif
-
-    // move onto the next axis
-    _update_axis = (_update_axis + 1) % XYZ_AXIS_COUNT;
-
-    // ready to receive another frame, because lock contention is so expensive we don't lock
-    // around this flag but rather rely on the semaphore at the beginning of the loop to
-    // ensure eventual visibility to the main loop
-    _thread_state._analysis_started = false;
-
-    // samples remaining in the next axis
-    return get_available_samples(_update_axis);
 }
 
 // whether analysis can be run again or not
@@ -719,8 +756,14 @@ void AP_GyroFFT::start_notch_tune()
         return;
     }
 
-    if (!hal.dsp->fft_start_average(_state)) {
-        GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "FFT: Unable to start FFT averaging");
+    for (uint8_t i = 0; i < XYZ_AXIS_COUNT; i++) {
+        // the axes may share a state
+        if (i > 0 && _axis_state[i] == _axis_state[0]) {
+            break;
+        }
+        if (!hal.dsp->fft_start_average(_axis_state[i])) {
+            GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "FFT: Unable to start FFT averaging");
+        }
     }
     // throttle averaging for average fft calculation
     _avg_throttle_out = 0.0f;
@@ -766,7 +809,23 @@ void AP_GyroFFT::stop_notch_tune()
 
     float freqs[FrequencyPeak::MAX_TRACKED_PEAKS] {};
 
-    uint16_t numpeaks = hal.dsp->fft_stop_average(_state, _config._fft_start_bin, _config._fft_end_bin, freqs);
+    // with a state per axis fold the averages of the other axes into the first axis
+    // so that the peaks are found across all axes as they are with a shared state
+    AP_HAL::DSP::FFTWindowState* fft = _axis_state[0];
+    for (uint8_t i = 1; i < XYZ_AXIS_COUNT && _axis_state[i] != fft; i++) {
+        AP_HAL::DSP::FFTWindowState* axis_fft = _axis_state[i];
+        if (!axis_fft->_averaging || !fft->_averaging) {
+            continue;
+        }
+        for (uint16_t b = 0; b < fft->_bin_count; b++) {
+            fft->_avg_freq_bins[b] += axis_fft->_avg_freq_bins[b];
+        }
+        fft->_averaging_samples += axis_fft->_averaging_samples;
+        axis_fft->_averaging = false;
+        axis_fft->_averaging_samples = 0;
+    }
+
+    uint16_t numpeaks = hal.dsp->fft_stop_average(fft, _config._fft_start_bin, _config._fft_end_bin, freqs);
 
     if (numpeaks == 0) {
         return;
@@ -1436,6 +1495,7 @@ float AP_GyroFFT::self_test(float frequency, FloatBuffer& test_window)
     }
 
     _update_axis = 0;
+    _state = _axis_state[0];
 
     // if using averaging we need to process _num_frames in order to not bias the result
     for (uint8_t i = 1; i < _num_frames; i++) {
@@ -40,7 +40,8 @@ public:
 
     enum class Options : uint32_t {
         FFTPostFilter = 1 << 0,
-        ESCNoiseCheck = 1 << 1
+        ESCNoiseCheck = 1 << 1,
+        AllAxesPerCycle = 1 << 2
     };
 
     AP_GyroFFT();
@@ -111,6 +112,8 @@ public:
     bool using_post_filter_samples() const { return (_options & uint32_t(Options::FFTPostFilter)) != 0; }
     // post filter mask of IMUs
     bool check_esc_noise() const { return (_options & uint32_t(Options::ESCNoiseCheck)) != 0; }
+    // analyse every axis in each cycle rather than one axis per cycle
+    bool analyse_all_axes() const { return (_options & uint32_t(Options::AllAxesPerCycle)) != 0; }
     // look for a frequency in the detected noise
     float has_noise_at_frequency_hz(float freq) const;
     static float calculate_notch_frequency(float* freqs, uint16_t numpeaks, float harmonic_fit, uint8_t& harmonics);
@@ -220,6 +223,8 @@ private:
     bool analysis_enabled() const { return _initialized && _analysis_enabled && _thread_created; };
     // whether analysis can be run again or not
     bool start_analysis();
+    // analyse a frame of the current update axis
+    void analyse_axis(const EngineConfig& config);
     // return samples available in the gyro window
     uint16_t get_available_samples(uint8_t axis) {
         return _sample_mode == 0 ?_ins->get_raw_gyro_window(axis).available() : _downsampled_gyro_data[axis].available();
@@ -281,8 +286,10 @@ private:
     // count of oversamples
     uint16_t _oversampled_gyro_count;
 
-    // state of the FFT engine
+    // state of the FFT engine for the current update axis
     AP_HAL::DSP::FFTWindowState* _state;
+    // state of the FFT engine for each axis, shared between the axes unless analysing all axes per cycle
+    AP_HAL::DSP::FFTWindowState* _axis_state[XYZ_AXIS_COUNT];
     // update state machine step information
     uint8_t _update_axis;
     // noise base of the gyros
@@ -126,6 +126,15 @@ public:
         return false;
     }
 
+    /*
+      pin the calling thread to a single CPU on a multi-core
+      system. cpu_index counts through the CPUs the process may run
+      on, wrapping if there are fewer. Returns false if not supported
+     */
+    virtual bool set_thread_affinity(uint8_t cpu_index) {
+        return false;
+    }
+
 private:
 
     AP_HAL::Proc _delay_cb;
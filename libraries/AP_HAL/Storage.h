@@ -3,6 +3,8 @@
 #include <stdint.h>
 #include "AP_HAL_Namespace.h"
 
+class ExpandingString;
+
 class AP_HAL::Storage {
 public:
     virtual void init() = 0;
@@ -12,4 +14,7 @@ public:
     virtual void _timer_tick(void) {};
     virtual bool healthy(void) { return true; }
     virtual bool get_storage_ptr(void *&ptr, size_t &size) { return false; }
+
+    // request information on storage writes
+    virtual void storage_info(ExpandingString &str) {}
 };
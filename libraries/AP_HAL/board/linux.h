@@ -88,6 +88,11 @@
 #define HAL_GYROFFT_ENABLED 0
 #endif
 
+// the DSP backend is built, and tested, even when GyroFFT is not
+#ifndef HAL_WITH_DSP
+#define HAL_WITH_DSP 1
+#endif
+
 #ifndef HAL_LINUX_USE_VIRTUAL_CAN
 #define HAL_LINUX_USE_VIRTUAL_CAN 0
 #endif
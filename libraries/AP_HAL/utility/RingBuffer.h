@@ -461,6 +461,280 @@ private:
     HAL_Semaphore sem;
 };
 
+#ifndef AP_HAL_CACHE_LINE_SIZE
+#define AP_HAL_CACHE_LINE_SIZE 64
+#endif
+
+/*
+  lock-free ring buffer class for objects of fixed size, for use when
+  there is exactly one producer thread and one consumer thread.
+
+  Unlike ObjectBuffer_TS no semaphore is taken; the read and write
+  indexes are published with acquire/release ordering and kept on
+  separate cache lines, and each side keeps a cached copy of the other
+  side's index so that it only touches the shared line when the
+  buffer looks full (producer) or empty (consumer).
+
+  The size is rounded up to a power of 2 and all slots are usable.
+
+  Producer side: space(), push(), reserve(), commit()
+  Consumer side: available(), is_empty(), pop(), peek(), readptr(), advance(), clear()
+ */
+template <class T>
+class ObjectBuffer_SPSC {
+public:
+    ObjectBuffer_SPSC(uint32_t _size = 0) {
+        set_size(_size);
+    }
+    ~ObjectBuffer_SPSC(void) {
+        delete[] buffer;
+    }
+
+    /* Do not allow copies */
+    ObjectBuffer_SPSC(const ObjectBuffer_SPSC &other) = delete;
+    ObjectBuffer_SPSC &operator=(const ObjectBuffer_SPSC &) = delete;
+
+    // a contiguous run of objects within the buffer
+    struct Span {
+        T *data;
+        uint32_t n;
+    };
+
+    // return size of ringbuffer
+    uint32_t get_size(void) const {
+        return buffer == nullptr ? 0 : mask + 1;
+    }
+
+    // set size of ringbuffer, rounding up to a power of 2. Must not
+    // be called while either thread is using the buffer
+    bool set_size(uint32_t _size) {
+        delete[] buffer;
+        buffer = nullptr;
+        mask = 0;
+        prod.tail = prod.head_cache = 0;
+        cons.head = cons.tail_cache = 0;
+        if (_size == 0) {
+            return true;
+        }
+        uint32_t alloc = 1;
+        while (alloc < _size) {
+            if (alloc >= (1U<<31)) {
+                return false;
+            }
+            alloc <<= 1;
+        }
+        buffer = NEW_NOTHROW T[alloc];
+        if (buffer == nullptr) {
+            return false;
+        }
+        mask = alloc - 1;
+        return true;
+    }
+
+    // return number of objects available to be read
+    uint32_t available(void) const {
+        return prod.tail.load(std::memory_order_acquire) - cons.head.load(std::memory_order_acquire);
+    }
+
+    // return number of objects that could be written
+    uint32_t space(void) const {
+        return get_size() - available();
+    }
+
+    // true is available() == 0
+    bool is_empty(void) const WARN_IF_UNUSED {
+        return available() == 0;
+    }
+
+    // push one object onto the back of the queue
+    bool push(const T &object) {
+        const uint32_t t = prod.tail.load(std::memory_order_relaxed);
+        if (producer_space(t, 1) == 0) {
+            return false;
+        }
+        buffer[t & mask] = object;
+        prod.tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // push N objects onto the back of the queue. Either all objects
+    // are pushed or none are
+    bool push(const T *objects, uint32_t n) {
+        Span span[2];
+        if (reserve(span, n) == 0 && n > 0) {
+            return false;
+        }
+        for (uint8_t i = 0; i < 2 && n > 0; i++) {
+            for (uint32_t j = 0; j < span[i].n; j++) {
+                span[i].data[j] = *objects++;
+            }
+            n -= span[i].n;
+        }
+        commit_reserved();
+        return true;
+    }
+
+    /*
+      reserve space for n objects and return up to two spans which
+      the producer can fill in place, returning the number of spans.
+      Returns 0 if there is not enough space. The objects become
+      visible to the consumer when commit() is called
+     */
+    uint8_t reserve(Span span[2], uint32_t n) {
+        const uint32_t t = prod.tail.load(std::memory_order_relaxed);
+        if (n == 0 || producer_space(t, n) < n) {
+            return 0;
+        }
+        const uint32_t ofs = t & mask;
+        const uint32_t contiguous = mask + 1 - ofs;
+        const uint32_t first = n < contiguous ? n : contiguous;
+        span[0].data = &buffer[ofs];
+        span[0].n = first;
+        prod.reserved = n;
+        if (first == n) {
+            span[1].data = nullptr;
+            span[1].n = 0;
+            return 1;
+        }
+        span[1].data = &buffer[0];
+        span[1].n = n - first;
+        return 2;
+    }
+
+    // publish n objects previously written via reserve(). n may be
+    // less than was reserved
+    bool commit(uint32_t n) {
+        if (n > prod.reserved) {
+            return false;
+        }
+        prod.reserved = n;
+        commit_reserved();
+        return true;
+    }
+
+    // pop earliest object off the front of the queue
+    bool pop(T &object) WARN_IF_UNUSED {
+        const uint32_t h = cons.head.load(std::memory_order_relaxed);
+        if (consumer_available(h, 1) == 0) {
+            return false;
+        }
+        object = buffer[h & mask];
+        cons.head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // pop up to n objects off the front of the queue, returning the
+    // number of objects popped
+    uint32_t pop(T *objects, uint32_t n) {
+        const uint32_t h = cons.head.load(std::memory_order_relaxed);
+        const uint32_t avail = consumer_available(h, n);
+        if (n > avail) {
+            n = avail;
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            objects[i] = buffer[(h + i) & mask];
+        }
+        cons.head.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    // copy out the object at the front of the queue without removing it
+    bool peek(T &object) WARN_IF_UNUSED {
+        const uint32_t h = cons.head.load(std::memory_order_relaxed);
+        if (consumer_available(h, 1) == 0) {
+            return false;
+        }
+        object = buffer[h & mask];
+        return true;
+    }
+
+    /*
+      return a pointer to first contiguous array of available
+      objects. Return nullptr if none available. The objects remain
+      valid until advance() is called
+     */
+    const T *readptr(uint32_t &n) {
+        const uint32_t h = cons.head.load(std::memory_order_relaxed);
+        const uint32_t avail = consumer_available(h, 1);
+        if (avail == 0) {
+            return nullptr;
+        }
+        const uint32_t ofs = h & mask;
+        const uint32_t contiguous = mask + 1 - ofs;
+        n = avail < contiguous ? avail : contiguous;
+        return &buffer[ofs];
+    }
+
+    // advance the read pointer (discarding objects)
+    bool advance(uint32_t n) {
+        const uint32_t h = cons.head.load(std::memory_order_relaxed);
+        if (n > consumer_available(h, n)) {
+            return false;
+        }
+        cons.head.store(h + n, std::memory_order_release);
+        return true;
+    }
+
+    // discard the buffer content. Must be called from the consumer
+    void clear(void) {
+        // the cached write index must move with the head, or it would
+        // be left behind it and available objects would underflow
+        cons.tail_cache = prod.tail.load(std::memory_order_acquire);
+        cons.head.store(cons.tail_cache, std::memory_order_release);
+    }
+
+private:
+    // space as seen by the producer, refreshing the cached read index
+    // only when the buffer looks too full for the request
+    uint32_t producer_space(uint32_t t, uint32_t needed) {
+        uint32_t space = get_size() - (t - prod.head_cache);
+        if (space < needed) {
+            prod.head_cache = cons.head.load(std::memory_order_acquire);
+            space = get_size() - (t - prod.head_cache);
+        }
+        return space;
+    }
+
+    // objects available as seen by the consumer, refreshing the
+    // cached write index only when the buffer looks too empty for
+    // the request
+    uint32_t consumer_available(uint32_t h, uint32_t needed) {
+        uint32_t avail = cons.tail_cache - h;
+        if (avail < needed) {
+            cons.tail_cache = prod.tail.load(std::memory_order_acquire);
+            avail = cons.tail_cache - h;
+        }
+        return avail;
+    }
+
+    void commit_reserved(void) {
+        prod.tail.store(prod.tail.load(std::memory_order_relaxed) + prod.reserved, std::memory_order_release);
+        prod.reserved = 0;
+    }
+
+    T *buffer = nullptr;
+    uint32_t mask;
+
+    uint8_t _pad0[AP_HAL_CACHE_LINE_SIZE];
+
+    // written by the producer only
+    struct {
+        std::atomic<uint32_t> tail{0};
+        uint32_t head_cache;
+        uint32_t reserved;
+    } prod;
+
+    uint8_t _pad1[AP_HAL_CACHE_LINE_SIZE];
+
+    // written by the consumer only
+    struct {
+        std::atomic<uint32_t> head{0};
+        uint32_t tail_cache;
+    } cons;
+
+    uint8_t _pad2[AP_HAL_CACHE_LINE_SIZE];
+};
+
 /*
   ring buffer class for objects of fixed size with pointer
   access. Note that this is not thread safe, buf offers efficient
@@ -592,3 +866,4 @@ private:
 typedef ObjectBuffer<float> FloatBuffer;
 typedef ObjectBuffer_TS<float> FloatBuffer_TS;
 typedef ObjectArray<float> FloatArray;
+typedef ObjectBuffer_SPSC<uint8_t> ByteBuffer_SPSC;
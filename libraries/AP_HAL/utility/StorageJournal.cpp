@@ -0,0 +1,186 @@
+/*
+  write-back journal for storage kept in a file on a POSIX filesystem
+ */
+#include "StorageJournal.h"
+
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <AP_Common/ExpandingString.h>
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/crc.h>
+
+#define STORAGE_JOURNAL_MAGIC 0x4A525453 // STRJ
+
+// commit latency is wall clock time, as the simulated clock may be stopped
+static uint64_t monotonic_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000ULL + ts.tv_nsec / 1000ULL;
+}
+
+StorageJournal::~StorageJournal()
+{
+    if (fd != -1) {
+        close(fd);
+    }
+    free(batch);
+}
+
+bool StorageJournal::init(const char *path, uint32_t _size, uint32_t line_size)
+{
+    size = _size;
+    // the most ranges a batch can have is every other line dirty
+    max_ranges = size / (2 * line_size) + 1;
+    batch = (uint8_t *)calloc(1, sizeof(header) + max_ranges * sizeof(range) + size);
+    if (batch == nullptr) {
+        return false;
+    }
+    fd = open(path, O_RDWR|O_CREAT|O_CLOEXEC, 0644);
+    return fd != -1;
+}
+
+void StorageJournal::begin()
+{
+    num_ranges = 0;
+    data_len = 0;
+}
+
+bool StorageJournal::add(uint32_t offset, const uint8_t *src, uint32_t len)
+{
+    if (offset + len > size || data_len + len > size) {
+        return false;
+    }
+    range *r = ranges();
+    if (num_ranges > 0 &&
+        r[num_ranges-1].offset + r[num_ranges-1].length == offset) {
+        // coalesce with the previous range
+        r[num_ranges-1].length += len;
+    } else {
+        if (num_ranges == max_ranges) {
+            return false;
+        }
+        r[num_ranges].offset = offset;
+        r[num_ranges].length = len;
+        num_ranges++;
+    }
+    memcpy(&data()[data_len], src, len);
+    data_len += len;
+    return true;
+}
+
+/*
+  write the ranges of the batch to the storage file
+ */
+bool StorageJournal::apply(int storage_fd) const
+{
+    const range *r = ranges();
+    const uint8_t *d = data();
+    for (uint16_t i=0; i<num_ranges; i++) {
+        if (pwrite(storage_fd, d, r[i].length, r[i].offset) != ssize_t(r[i].length)) {
+            return false;
+        }
+        d += r[i].length;
+    }
+    return true;
+}
+
+bool StorageJournal::commit(int storage_fd)
+{
+    if (num_ranges == 0) {
+        return true;
+    }
+    const uint64_t start_us = monotonic_us();
+
+    const uint32_t ranges_len = num_ranges * sizeof(range);
+    header h {};
+    h.magic = STORAGE_JOURNAL_MAGIC;
+    h.length = data_len;
+    h.num_ranges = num_ranges;
+    h.crc = crc_crc32(crc_crc32(0, (const uint8_t *)ranges(), ranges_len), data(), data_len);
+
+    // once the journal is synced the batch survives an interrupted commit
+    const bool ok =
+        pwrite(fd, &h, sizeof(h), 0) == sizeof(h) &&
+        pwrite(fd, ranges(), ranges_len, sizeof(h)) == ssize_t(ranges_len) &&
+        pwrite(fd, data(), data_len, sizeof(h) + ranges_len) == ssize_t(data_len) &&
+        fsync(fd) == 0 &&
+        apply(storage_fd) &&
+        fsync(storage_fd) == 0;
+    if (!ok) {
+        stats.failures++;
+        return false;
+    }
+
+    // the storage file is complete, so the journal is no longer
+    // needed. Replaying it again would be harmless, so no sync
+    const uint32_t no_magic = 0;
+    if (pwrite(fd, &no_magic, sizeof(no_magic), 0) != sizeof(no_magic)) {
+        stats.failures++;
+    }
+
+    stats.commits++;
+    stats.written_bytes += sizeof(h) + ranges_len + 2 * data_len;
+    stats.last_commit_us = monotonic_us() - start_us;
+    stats.max_commit_us = MAX(stats.max_commit_us, stats.last_commit_us);
+    return true;
+}
+
+bool StorageJournal::replay(int storage_fd, uint8_t *buffer)
+{
+    header h;
+    if (pread(fd, &h, sizeof(h), 0) != sizeof(h) || h.magic != STORAGE_JOURNAL_MAGIC) {
+        // nothing to replay
+        return true;
+    }
+    num_ranges = h.num_ranges;
+    data_len = h.length;
+    const uint32_t ranges_len = num_ranges * sizeof(range);
+    bool valid = num_ranges <= max_ranges && data_len <= size &&
+        pread(fd, ranges(), ranges_len, sizeof(h)) == ssize_t(ranges_len) &&
+        pread(fd, data(), data_len, sizeof(h) + ranges_len) == ssize_t(data_len) &&
+        crc_crc32(crc_crc32(0, (const uint8_t *)ranges(), ranges_len), data(), data_len) == h.crc;
+    uint32_t total = 0;
+    for (uint16_t i=0; valid && i<num_ranges; i++) {
+        const range &r = ranges()[i];
+        valid = r.offset < size && r.length <= size - r.offset;
+        total += r.length;
+    }
+    if (valid && total == data_len) {
+        // the commit was interrupted after the journal was synced
+        const uint8_t *d = data();
+        for (uint16_t i=0; i<num_ranges; i++) {
+            memcpy(&buffer[ranges()[i].offset], d, ranges()[i].length);
+            d += ranges()[i].length;
+        }
+        if (!apply(storage_fd) || fsync(storage_fd) != 0) {
+            return false;
+        }
+    }
+    // otherwise the commit was interrupted while writing the
+    // journal, and the storage file was not touched
+    const uint32_t no_magic = 0;
+    begin();
+    return pwrite(fd, &no_magic, sizeof(no_magic), 0) == sizeof(no_magic) && fsync(fd) == 0;
+}
+
+void StorageJournal::info(ExpandingString &str) const
+{
+    const uint64_t changed = MAX(stats.changed_bytes, 1U);
+    str.printf("commits=%u failures=%u changed=%llu written=%llu amplification=%.2f commit_us=%u max_commit_us=%u\n",
+               unsigned(stats.commits),
+               unsigned(stats.failures),
+               (unsigned long long)stats.changed_bytes,
+               (unsigned long long)stats.written_bytes,
+               double(stats.written_bytes) / changed,
+               unsigned(stats.last_commit_us),
+               unsigned(stats.max_commit_us));
+}
+
+#endif // CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX
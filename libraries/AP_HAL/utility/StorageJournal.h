@@ -0,0 +1,88 @@
+/*
+  write-back journal for storage kept in a file on a POSIX filesystem
+
+  Dirty ranges of the storage image are gathered into a batch and
+  committed together. The batch is first written to a journal file
+  and synced, then applied to the storage file and synced, so an
+  interrupted commit is either lost as a whole or replayed as a whole
+  when the storage is next opened.
+ */
+#pragma once
+
+#include <AP_HAL/AP_HAL_Boards.h>
+
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+
+#include <stdint.h>
+#include <AP_Common/AP_Common.h>
+
+class ExpandingString;
+
+class StorageJournal {
+public:
+    ~StorageJournal();
+
+    /*
+      open the journal at path for storage of size bytes written in
+      lines of line_size bytes
+     */
+    bool init(const char *path, uint32_t size, uint32_t line_size);
+
+    /*
+      apply a journal left by an interrupted commit to the storage
+      file and to the in-memory image buffer
+     */
+    bool replay(int fd, uint8_t *buffer);
+
+    // start a new batch
+    void begin();
+
+    // add a range of the storage image to the batch
+    bool add(uint32_t offset, const uint8_t *data, uint32_t len);
+
+    // write the batch to the storage file fd
+    bool commit(int fd);
+
+    // count bytes changed by callers, for the write amplification
+    void count_changed(uint32_t len) { stats.changed_bytes += len; }
+
+    // report commit statistics
+    void info(ExpandingString &str) const;
+
+private:
+    struct PACKED header {
+        uint32_t magic;
+        uint32_t crc;
+        uint32_t length;
+        uint16_t num_ranges;
+        uint16_t reserved;
+    };
+    struct PACKED range {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    int fd = -1;
+    uint32_t size;
+
+    // the batch: header, ranges, then the data of each range
+    uint8_t *batch;
+    uint16_t max_ranges;
+    uint16_t num_ranges;
+    uint32_t data_len;
+
+    struct {
+        uint32_t commits;
+        uint32_t failures;
+        uint64_t changed_bytes;
+        uint64_t written_bytes;
+        uint32_t last_commit_us;
+        uint32_t max_commit_us;
+    } stats;
+
+    range *ranges() const { return (range *)&batch[sizeof(header)]; }
+    uint8_t *data() const { return &batch[sizeof(header) + max_ranges * sizeof(range)]; }
+    bool apply(int storage_fd) const;
+};
+
+#endif // CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX
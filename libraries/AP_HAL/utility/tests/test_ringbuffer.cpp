@@ -17,7 +17,9 @@
 #include <AP_gtest.h>
 
 #include <string.h>
+#include <thread>
 #include <utility>
+#include <AP_Common/AP_Common.h>
 #include <AP_HAL/utility/RingBuffer.h>
 
 TEST(ByteBufferTest, Basic)
@@ -185,4 +187,142 @@ TEST(ObjectBufferTest, PeekTest)
     }
 }
 
+TEST(ObjectBufferSPSCTest, Basic)
+{
+    // size is rounded up to a power of 2, and every slot is usable
+    ObjectBuffer_SPSC<uint32_t> x{5};
+    EXPECT_EQ(x.get_size(), 8U);
+    EXPECT_EQ(x.space(), 8U);
+    EXPECT_TRUE(x.is_empty());
+
+    for (uint32_t i=0; i<8; i++) {
+        EXPECT_TRUE(x.push(i));
+    }
+    EXPECT_FALSE(x.push(99U));
+    EXPECT_EQ(x.available(), 8U);
+    EXPECT_EQ(x.space(), 0U);
+
+    uint32_t v;
+    EXPECT_TRUE(x.peek(v));
+    EXPECT_EQ(v, 0U);
+    EXPECT_TRUE(x.pop(v));
+    EXPECT_EQ(v, 0U);
+
+    // batch push is all or nothing
+    const uint32_t three[3] {100, 101, 102};
+    EXPECT_FALSE(x.push(three, 3));
+    EXPECT_TRUE(x.push(three, 1));
+
+    uint32_t out[10] {};
+    EXPECT_EQ(x.pop(out, ARRAY_SIZE(out)), 8U);
+    EXPECT_EQ(out[0], 1U);
+    EXPECT_EQ(out[7], 100U);
+    EXPECT_TRUE(x.is_empty());
+    EXPECT_FALSE(x.pop(v));
+}
+
+TEST(ObjectBufferSPSCTest, ReserveCommit)
+{
+    ObjectBuffer_SPSC<uint16_t> x{8};
+
+    // move the indexes so that a reservation wraps
+    for (uint16_t i=0; i<5; i++) {
+        EXPECT_TRUE(x.push(i));
+    }
+    EXPECT_TRUE(x.advance(5));
+
+    ObjectBuffer_SPSC<uint16_t>::Span span[2];
+    EXPECT_EQ(x.reserve(span, 9), 0U);
+    EXPECT_EQ(x.reserve(span, 6), 2U);
+    EXPECT_EQ(span[0].n, 3U);
+    EXPECT_EQ(span[1].n, 3U);
+    for (uint8_t i=0; i<2; i++) {
+        for (uint32_t j=0; j<span[i].n; j++) {
+            span[i].data[j] = 10 + i*3 + j;
+        }
+    }
+    // nothing is visible until committed, and we may commit less
+    // than we reserved
+    EXPECT_TRUE(x.is_empty());
+    EXPECT_FALSE(x.commit(7));
+    EXPECT_TRUE(x.commit(4));
+    EXPECT_EQ(x.available(), 4U);
+
+    // readptr only returns the contiguous part
+    uint32_t n = 0;
+    const uint16_t *p = x.readptr(n);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(n, 3U);
+    EXPECT_EQ(p[0], 10U);
+    EXPECT_TRUE(x.advance(n));
+    p = x.readptr(n);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(n, 1U);
+    EXPECT_EQ(p[0], 13U);
+
+    x.clear();
+    EXPECT_TRUE(x.is_empty());
+    EXPECT_EQ(x.readptr(n), nullptr);
+}
+
+TEST(ObjectBufferSPSCTest, Clear)
+{
+    ObjectBuffer_SPSC<uint32_t> x{8};
+    uint32_t v;
+
+    // leave the consumer's cached write index behind the producer's
+    EXPECT_TRUE(x.push(1U));
+    EXPECT_TRUE(x.pop(v));
+    for (uint32_t i=0; i<3; i++) {
+        EXPECT_TRUE(x.push(10 + i));
+    }
+
+    x.clear();
+    EXPECT_TRUE(x.is_empty());
+    EXPECT_FALSE(x.pop(v));
+    EXPECT_FALSE(x.peek(v));
+    uint32_t n = 0;
+    EXPECT_EQ(x.readptr(n), nullptr);
+    EXPECT_FALSE(x.advance(1));
+
+    EXPECT_TRUE(x.push(42U));
+    EXPECT_EQ(x.available(), 1U);
+    EXPECT_TRUE(x.pop(v));
+    EXPECT_EQ(v, 42U);
+    EXPECT_FALSE(x.pop(v));
+}
+
+TEST(ObjectBufferSPSCTest, Threaded)
+{
+    ObjectBuffer_SPSC<uint32_t> x{64};
+    const uint32_t count = 200000;
+
+    std::thread producer([&x, count]() {
+        uint32_t i = 0;
+        while (i < count) {
+            uint32_t block[7];
+            uint32_t n = 0;
+            for (; n < ARRAY_SIZE(block) && i + n < count; n++) {
+                block[n] = i + n;
+            }
+            if (x.push(block, n)) {
+                i += n;
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    bool in_order = true;
+    while (expected < count) {
+        uint32_t block[13];
+        const uint32_t n = x.pop(block, ARRAY_SIZE(block));
+        for (uint32_t i=0; i<n; i++) {
+            in_order &= (block[i] == expected++);
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(in_order);
+    EXPECT_TRUE(x.is_empty());
+}
+
 AP_GTEST_MAIN()
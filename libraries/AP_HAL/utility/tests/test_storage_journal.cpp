@@ -0,0 +1,108 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <AP_gtest.h>
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_HAL/utility/StorageJournal.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+static const uint32_t size = 4096;
+static const uint32_t line_size = 64;
+static const char *storage_path = "test_storage_journal.bin";
+static const char *journal_path = "test_storage_journal.jnl";
+
+static int open_storage()
+{
+    unlink(storage_path);
+    unlink(journal_path);
+    const int fd = open(storage_path, O_RDWR|O_CREAT, 0644);
+    uint8_t zero[size] {};
+    EXPECT_EQ(pwrite(fd, zero, size, 0), ssize_t(size));
+    return fd;
+}
+
+TEST(StorageJournal, CommitCoalescesRanges)
+{
+    const int fd = open_storage();
+    uint8_t image[size];
+    for (uint32_t i=0; i<size; i++) {
+        image[i] = i * 7;
+    }
+
+    StorageJournal journal;
+    ASSERT_TRUE(journal.init(journal_path, size, line_size));
+    journal.begin();
+    // two adjacent lines and one on its own
+    EXPECT_TRUE(journal.add(0, &image[0], line_size));
+    EXPECT_TRUE(journal.add(line_size, &image[line_size], line_size));
+    EXPECT_TRUE(journal.add(10*line_size, &image[10*line_size], line_size));
+    EXPECT_TRUE(journal.commit(fd));
+
+    uint8_t file[size];
+    EXPECT_EQ(pread(fd, file, size, 0), ssize_t(size));
+    EXPECT_EQ(memcmp(file, image, 2*line_size), 0);
+    EXPECT_EQ(memcmp(&file[10*line_size], &image[10*line_size], line_size), 0);
+    EXPECT_EQ(file[2*line_size], 0);
+
+    // a completed commit leaves nothing to replay
+    uint8_t buffer[size] {};
+    EXPECT_TRUE(journal.replay(fd, buffer));
+    EXPECT_EQ(buffer[1], 0);
+
+    close(fd);
+}
+
+TEST(StorageJournal, ReplayInterruptedCommit)
+{
+    const int fd = open_storage();
+    uint8_t image[size];
+    memset(image, 0x5A, sizeof(image));
+
+    {
+        StorageJournal journal;
+        ASSERT_TRUE(journal.init(journal_path, size, line_size));
+        journal.begin();
+        EXPECT_TRUE(journal.add(3*line_size, &image[3*line_size], 2*line_size));
+        // commit to a storage file we can't write, as if interrupted
+        // after the journal was synced
+        const int ro_fd = open(storage_path, O_RDONLY);
+        EXPECT_FALSE(journal.commit(ro_fd));
+        close(ro_fd);
+    }
+
+    uint8_t file[size];
+    EXPECT_EQ(pread(fd, file, size, 0), ssize_t(size));
+    EXPECT_EQ(file[3*line_size], 0);
+
+    StorageJournal journal;
+    ASSERT_TRUE(journal.init(journal_path, size, line_size));
+    uint8_t buffer[size] {};
+    EXPECT_TRUE(journal.replay(fd, buffer));
+    EXPECT_EQ(buffer[3*line_size], 0x5A);
+    EXPECT_EQ(buffer[5*line_size-1], 0x5A);
+    EXPECT_EQ(buffer[5*line_size], 0);
+    EXPECT_EQ(pread(fd, file, size, 0), ssize_t(size));
+    EXPECT_EQ(memcmp(file, buffer, size), 0);
+
+    close(fd);
+    unlink(storage_path);
+    unlink(journal_path);
+}
+
+AP_GTEST_MAIN()
@@ -0,0 +1,244 @@
+/*
+ * This file is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "DSP.h"
+
+#if HAL_WITH_DSP
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <AP_Math/AP_Math.h>
+#include <GCS_MAVLink/GCS.h>
+
+using namespace Linux;
+
+extern const AP_HAL::HAL& hal;
+
+// FFT buffers are aligned to the cache line so that a window starts on a line boundary
+#define DSP_BUFFER_ALIGNMENT 64
+
+static void *aligned_calloc(size_t size)
+{
+    void *ptr = nullptr;
+    if (posix_memalign(&ptr, DSP_BUFFER_ALIGNMENT, size) != 0) {
+        return nullptr;
+    }
+    memset(ptr, 0, size);
+    return ptr;
+}
+
+// initialize the FFT state machine
+AP_HAL::DSP::FFTWindowState* DSP::fft_init(uint16_t window_size, uint16_t sample_rate, uint8_t sliding_window_size)
+{
+    DSP::FFTWindowStateLinux* fft = NEW_NOTHROW DSP::FFTWindowStateLinux(window_size, sample_rate, sliding_window_size);
+    if (fft == nullptr || fft->_hanning_window == nullptr || fft->_rfft_data == nullptr || fft->_freq_bins == nullptr || fft->_derivative_freq_bins == nullptr
+        || fft->_buf == nullptr || fft->_twiddle == nullptr || fft->_split_twiddle == nullptr || fft->_bitrev == nullptr) {
+        delete fft;
+        return nullptr;
+    }
+    return fft;
+}
+
+// start an FFT analysis
+void DSP::fft_start(AP_HAL::DSP::FFTWindowState* state, FloatBuffer& samples, uint16_t advance)
+{
+    step_hanning((FFTWindowStateLinux*)state, samples, advance);
+}
+
+// perform remaining steps of an FFT analysis
+uint16_t DSP::fft_analyse(AP_HAL::DSP::FFTWindowState* state, uint16_t start_bin, uint16_t end_bin, float noise_att_cutoff)
+{
+    FFTWindowStateLinux* fft = (FFTWindowStateLinux*)state;
+    step_fft(fft);
+    step_cmplx_mag(fft, start_bin, end_bin, noise_att_cutoff);
+    return step_calc_frequencies(fft, start_bin, end_bin);
+}
+
+// create an instance of the FFT state machine
+DSP::FFTWindowStateLinux::FFTWindowStateLinux(uint16_t window_size, uint16_t sample_rate, uint8_t sliding_window_size)
+    : AP_HAL::DSP::FFTWindowState::FFTWindowState(window_size, sample_rate, sliding_window_size)
+{
+    if (_freq_bins == nullptr || _hanning_window == nullptr || _rfft_data == nullptr || _derivative_freq_bins == nullptr) {
+        GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "Failed to allocate window for DSP");
+        return;
+    }
+
+    // the complex FFT is half the length of the window
+    const uint16_t len = _bin_count;
+
+    _buf = (float*)aligned_calloc(sizeof(float) * len * 2);
+    _twiddle = (float*)aligned_calloc(sizeof(float) * len);
+    _split_twiddle = (float*)aligned_calloc(sizeof(float) * len * 2);
+    _bitrev = (uint16_t*)aligned_calloc(sizeof(uint16_t) * len);
+    if (_buf == nullptr || _twiddle == nullptr || _split_twiddle == nullptr || _bitrev == nullptr) {
+        GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "Failed to allocate window for DSP");
+        return;
+    }
+
+    // len/2 twiddles of the complex FFT
+    for (uint16_t i = 0; i < len / 2; i++) {
+        const double angle = 2.0 * M_PI * i / len;
+        _twiddle[i*2] = cos(angle);
+        _twiddle[i*2+1] = -sin(angle);
+    }
+
+    // len twiddles to split the complex FFT into the real FFT
+    for (uint16_t i = 0; i < len; i++) {
+        const double angle = 2.0 * M_PI * i / window_size;
+        _split_twiddle[i*2] = cos(angle);
+        _split_twiddle[i*2+1] = -sin(angle);
+    }
+
+    // bit reversed order of the complex samples
+    uint16_t bits = 0;
+    while ((1U << bits) < len) {
+        bits++;
+    }
+    for (uint16_t i = 0; i < len; i++) {
+        uint16_t r = 0;
+        for (uint16_t b = 0; b < bits; b++) {
+            r |= ((i >> b) & 1U) << (bits - 1 - b);
+        }
+        _bitrev[i] = r;
+    }
+}
+
+DSP::FFTWindowStateLinux::~FFTWindowStateLinux()
+{
+    free(_buf);
+    free(_twiddle);
+    free(_split_twiddle);
+    free(_bitrev);
+}
+
+// step 1: copy the incoming samples into the FFT buffer in bit reversed order, applying the Hanning window
+void DSP::step_hanning(FFTWindowStateLinux* fft, FloatBuffer& samples, uint16_t advance)
+{
+    // _freq_bins is free until the FFT has been calculated so use it to unwrap the ring buffer
+    uint32_t read_window = samples.peek(&fft->_freq_bins[0], fft->_window_size);
+    if (read_window != fft->_window_size) {
+        return;
+    }
+    samples.advance(advance);
+
+    // even samples are the real part and odd samples the imaginary part
+    const float* in = fft->_freq_bins;
+    const float* window = fft->_hanning_window;
+    float* buf = fft->_buf;
+    for (uint16_t i = 0; i < fft->_bin_count; i++) {
+        const uint16_t j = fft->_bitrev[i] * 2;
+        buf[i*2] = in[j] * window[j];
+        buf[i*2+1] = in[j+1] * window[j+1];
+    }
+}
+
+// step 2: perform the FFT on the windowed data
+void DSP::step_fft(FFTWindowStateLinux* fft)
+{
+    const uint16_t len = fft->_bin_count;
+    float* buf = fft->_buf;
+    const float* twiddle = fft->_twiddle;
+
+    // radix-2 decimation in time butterflies, the input is already in bit reversed order
+    for (uint16_t half = 1; half < len; half <<= 1) {
+        const uint16_t twiddle_step = len / (half * 2);
+        for (uint16_t start = 0; start < len; start += half * 2) {
+            for (uint16_t k = 0; k < half; k++) {
+                const float wr = twiddle[k * twiddle_step * 2];
+                const float wi = twiddle[k * twiddle_step * 2 + 1];
+                float* a = &buf[(start + k) * 2];
+                float* b = &buf[(start + k + half) * 2];
+                const float tr = wr * b[0] - wi * b[1];
+                const float ti = wr * b[1] + wi * b[0];
+                b[0] = a[0] - tr;
+                b[1] = a[1] - ti;
+                a[0] += tr;
+                a[1] += ti;
+            }
+        }
+    }
+
+    /*
+      split the complex FFT Z of the even and odd samples into the real FFT X:
+        X[k] = (Z[k] + Z*[len-k]) / 2 - i W^k (Z[k] - Z*[len-k]) / 2
+      DC and nyquist are real only
+     */
+    float* rfft = fft->_rfft_data;
+    rfft[0] = buf[0] + buf[1];
+    rfft[1] = 0.0f;
+    rfft[len*2] = buf[0] - buf[1];
+    rfft[len*2+1] = 0.0f;
+
+    const float* split = fft->_split_twiddle;
+    for (uint16_t k = 1; k < len; k++) {
+        const float zr = buf[k*2];
+        const float zi = buf[k*2+1];
+        const float cr = buf[(len - k)*2];
+        const float ci = -buf[(len - k)*2+1];
+
+        const float er = 0.5f * (zr + cr);
+        const float ei = 0.5f * (zi + ci);
+        const float or_ = 0.5f * (zi - ci);
+        const float oi = -0.5f * (zr - cr);
+
+        const float wr = split[k*2];
+        const float wi = split[k*2+1];
+        rfft[k*2] = er + wr * or_ - wi * oi;
+        rfft[k*2+1] = ei + wr * oi + wi * or_;
+    }
+
+    // power in each bin, up to and including nyquist
+    for (uint16_t i = 0; i <= len; i++) {
+        fft->_freq_bins[i] = sq(rfft[i*2]) + sq(rfft[i*2+1]);
+    }
+}
+
+void DSP::vector_max_float(const float* vin, uint16_t len, float* maxValue, uint16_t* maxIndex) const
+{
+    *maxValue = vin[0];
+    *maxIndex = 0;
+    for (uint16_t i = 1; i < len; i++) {
+        if (vin[i] > *maxValue) {
+            *maxValue = vin[i];
+            *maxIndex = i;
+        }
+    }
+}
+
+void DSP::vector_scale_float(const float* vin, float scale, float* vout, uint16_t len) const
+{
+    for (uint16_t i = 0; i < len; i++) {
+        vout[i] = vin[i] * scale;
+    }
+}
+
+void DSP::vector_add_float(const float* vin1, const float* vin2, float* vout, uint16_t len) const
+{
+    for (uint16_t i = 0; i < len; i++) {
+        vout[i] = vin1[i] + vin2[i];
+    }
+}
+
+float DSP::vector_mean_float(const float* vin, uint16_t len) const
+{
+    float mean_value = 0.0f;
+    for (uint16_t i = 0; i < len; i++) {
+        mean_value += vin[i];
+    }
+    mean_value /= len;
+    return mean_value;
+}
+
+#endif // HAL_WITH_DSP
@@ -0,0 +1,69 @@
+/*
+ * This file is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <AP_HAL/AP_HAL.h>
+
+#if HAL_WITH_DSP
+
+namespace Linux {
+
+/*
+  FFT analysis for Linux boards. The window is treated as N/2 complex
+  samples and transformed with an N/2 point complex FFT, which is then
+  split into the N point real FFT. Twiddles and the bit reversal order
+  are calculated once when the window is created, and the Hanning
+  window is applied while copying the samples into bit reversed order
+ */
+class DSP : public AP_HAL::DSP {
+public:
+    // initialise an FFT instance
+    virtual FFTWindowState* fft_init(uint16_t window_size, uint16_t sample_rate, uint8_t sliding_window_size) override;
+    // start an FFT analysis with an ObjectBuffer
+    virtual void fft_start(FFTWindowState* state, FloatBuffer& samples, uint16_t advance) override;
+    // perform remaining steps of an FFT analysis
+    virtual uint16_t fft_analyse(FFTWindowState* state, uint16_t start_bin, uint16_t end_bin, float noise_att_cutoff) override;
+
+    // Linux FFT state
+    class FFTWindowStateLinux : public AP_HAL::DSP::FFTWindowState {
+        friend class Linux::DSP;
+
+    public:
+        FFTWindowStateLinux(uint16_t window_size, uint16_t sample_rate, uint8_t sliding_window_size);
+        virtual ~FFTWindowStateLinux();
+
+    private:
+        // N/2 point complex FFT data, interleaved real and imaginary
+        float* _buf;
+        // twiddles of the N/2 point complex FFT, interleaved cos and -sin
+        float* _twiddle;
+        // twiddles splitting the N/2 point complex FFT into the N point real FFT
+        float* _split_twiddle;
+        // for each complex sample, the index of the sample pair that is loaded into it
+        uint16_t* _bitrev;
+    };
+
+private:
+    void step_hanning(FFTWindowStateLinux* fft, FloatBuffer& samples, uint16_t advance);
+    void step_fft(FFTWindowStateLinux* fft);
+    void vector_max_float(const float* vin, uint16_t len, float* maxValue, uint16_t* maxIndex) const override;
+    void vector_scale_float(const float* vin, float scale, float* vout, uint16_t len) const override;
+    float vector_mean_float(const float* vin, uint16_t len) const override;
+    void vector_add_float(const float* vin1, const float* vin2, float* vout, uint16_t len) const override;
+};
+
+}
+
+#endif // HAL_WITH_DSP
@@ -424,3 +424,29 @@ bool Scheduler::thread_create(AP_HAL::MemberProc proc, const char *name, uint32_
 
     return true;
 }
+
+/*
+  pin the calling thread to one of the CPUs the process may run on
+*/
+bool Scheduler::set_thread_affinity(uint8_t cpu_index)
+{
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return false;
+    }
+    const int count = CPU_COUNT(&allowed);
+    if (count < 2) {
+        return false;
+    }
+    int n = cpu_index % count;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed) || n-- > 0) {
+            continue;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    }
+    return false;
+}
@@ -53,6 +53,8 @@ public:
       create a new thread
      */
     bool thread_create(AP_HAL::MemberProc, const char *name, uint32_t stack_size, priority_base base, int8_t priority) override;
+
+    bool set_thread_affinity(uint8_t cpu_index) override;
     
     /*
       set cpu affinity mask to be applied on initialization - setting it
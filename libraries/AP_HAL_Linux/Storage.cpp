@@ -3,6 +3,7 @@
 #include <assert.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <stdio.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -15,11 +16,16 @@ using namespace Linux;
 /*
   This stores 'eeprom' data on the SD card, with a 4k size, and a
   in-memory buffer. This keeps the latency down.
+
+  Writes are committed to the file in batches through a journal, so a
+  burst of writes such as a mission upload costs one commit, and a
+  batch is never half written.
  */
 
 // name the storage file after the sketch so you can use the same board
 // card for ArduCopter and ArduPlane
 #define STORAGE_FILE AP_BUILD_TARGET_NAME ".stg"
+#define STORAGE_JOURNAL_FILE STORAGE_FILE ".jnl"
 
 extern const AP_HAL::HAL& hal;
 
@@ -157,6 +163,15 @@ void Storage::init()
         AP_HAL::panic("Failed to read %s (%m)", dpath);
     }
 
+    // complete any commit that was interrupted
+    char journal_path[PATH_MAX];
+    snprintf(journal_path, sizeof(journal_path), "%s/" STORAGE_JOURNAL_FILE, dpath);
+    if (!_journal.init(journal_path, sizeof(_buffer), LINUX_STORAGE_LINE_SIZE) ||
+        !_journal.replay(fd, _buffer)) {
+        close(fd);
+        AP_HAL::panic("Failed to open storage journal %s (%m)", journal_path);
+    }
+
     _fd = fd;
     _initialised = true;
 }
@@ -173,6 +188,11 @@ void Storage::_mark_dirty(uint16_t loc, uint16_t length)
     if (length == 0) {
         return;
     }
+    const uint32_t now_ms = AP_HAL::millis();
+    if (_dirty_mask == 0) {
+        _first_dirty_ms = now_ms;
+    }
+    _last_write_ms = now_ms;
     uint16_t end = loc + length - 1;
     for (uint8_t line=loc>>LINUX_STORAGE_LINE_SHIFT;
          line <= end>>LINUX_STORAGE_LINE_SHIFT;
@@ -199,6 +219,7 @@ void Storage::write_block(uint16_t loc, const void *src, size_t n)
         init();
         memcpy(&_buffer[loc], src, n);
         _mark_dirty(loc, n);
+        _journal.count_changed(n);
     }
 }
 
@@ -208,50 +229,37 @@ void Storage::_timer_tick(void)
         return;
     }
 
-    // write out the first dirty set of lines. We don't write more
-    // than one to keep the latency of this call to a minimum
-    uint8_t i, n;
-    for (i=0; i<LINUX_STORAGE_NUM_LINES; i++) {
-        if (_dirty_mask & (1<<i)) {
-            break;
-        }
-    }
-    if (i == LINUX_STORAGE_NUM_LINES) {
-        // this shouldn't be possible
+    // let a burst of writes finish so it is committed as one batch
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - _last_write_ms < LINUX_STORAGE_COALESCE_MS &&
+        now_ms - _first_dirty_ms < LINUX_STORAGE_MAX_DELAY_MS) {
         return;
     }
-    uint32_t write_mask = (1U<<i);
-    // see how many lines to write
-    for (n=1; (i+n) < LINUX_STORAGE_NUM_LINES &&
-             n < (LINUX_STORAGE_MAX_WRITE>>LINUX_STORAGE_LINE_SHIFT); n++) {
-        if (!(_dirty_mask & (1<<(n+i)))) {
-            break;
-        }
-        // mark that line clean
-        write_mask |= (1<<(n+i));
-    }
 
     /*
-      write the lines. This also updates _dirty_mask. Note that
-      because this is a SCHED_FIFO thread it will not be preempted
-      by the main task except during blocking calls. This means we
-      don't need a semaphore around the _dirty_mask updates.
+      take the dirty lines before copying them, so a line written
+      while it is being copied is marked dirty again and goes in the
+      next batch
      */
-    if (lseek(_fd, i<<LINUX_STORAGE_LINE_SHIFT, SEEK_SET) == (i<<LINUX_STORAGE_LINE_SHIFT)) {
-        _dirty_mask &= ~write_mask;
-        if (write(_fd, &_buffer[i<<LINUX_STORAGE_LINE_SHIFT], n<<LINUX_STORAGE_LINE_SHIFT) != n<<LINUX_STORAGE_LINE_SHIFT) {
-            // write error - likely EINTR
-            _dirty_mask |= write_mask;
-            close(_fd);
-            _fd = -1;
-        }
-        if (_dirty_mask == 0) {
-            if (fsync(_fd) != 0) {
-                close(_fd);
-                _fd = -1;
-            }
+    const uint32_t write_mask = __atomic_fetch_and(&_dirty_mask, 0U, __ATOMIC_SEQ_CST);
+
+    _journal.begin();
+    for (uint8_t i=0; i<LINUX_STORAGE_NUM_LINES; i++) {
+        if (write_mask & (1U<<i)) {
+            _journal.add(i<<LINUX_STORAGE_LINE_SHIFT, &_buffer[i<<LINUX_STORAGE_LINE_SHIFT], LINUX_STORAGE_LINE_SIZE);
         }
     }
+    if (!_journal.commit(_fd)) {
+        // write error, the journal keeps the file consistent so
+        // retry the whole batch
+        __atomic_fetch_or(&_dirty_mask, write_mask, __ATOMIC_SEQ_CST);
+        _first_dirty_ms = now_ms;
+    }
+}
+
+void Storage::storage_info(ExpandingString &str)
+{
+    _journal.info(str);
 }
 
 /*
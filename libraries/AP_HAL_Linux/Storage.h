@@ -1,13 +1,25 @@
 #pragma once
 
 #include <AP_HAL/AP_HAL.h>
+#include <AP_HAL/utility/StorageJournal.h>
 
 #define LINUX_STORAGE_SIZE HAL_STORAGE_SIZE
-#define LINUX_STORAGE_MAX_WRITE 512
 #define LINUX_STORAGE_LINE_SHIFT 9
 #define LINUX_STORAGE_LINE_SIZE (1<<LINUX_STORAGE_LINE_SHIFT)
 #define LINUX_STORAGE_NUM_LINES (LINUX_STORAGE_SIZE/LINUX_STORAGE_LINE_SIZE)
 
+// dirty lines are committed together once writes have stopped for
+// LINUX_STORAGE_COALESCE_MS, or LINUX_STORAGE_MAX_DELAY_MS after the
+// first of them was written
+#ifndef LINUX_STORAGE_COALESCE_MS
+#define LINUX_STORAGE_COALESCE_MS 50
+#endif
+#ifndef LINUX_STORAGE_MAX_DELAY_MS
+#define LINUX_STORAGE_MAX_DELAY_MS 500
+#endif
+
+static_assert(LINUX_STORAGE_NUM_LINES <= 32, "dirty mask too small");
+
 namespace Linux {
 
 class Storage : public AP_HAL::Storage
@@ -36,6 +48,8 @@ public:
 
     virtual void _timer_tick(void) override;
 
+    void storage_info(ExpandingString &str) override;
+
 protected:
     void _mark_dirty(uint16_t loc, uint16_t length);
     int _storage_create(const char *dpath);
@@ -43,6 +57,9 @@ protected:
     int _fd;
     volatile bool _initialised;
     volatile uint32_t _dirty_mask;
+    volatile uint32_t _first_dirty_ms;
+    volatile uint32_t _last_write_ms;
+    StorageJournal _journal;
     uint8_t _buffer[LINUX_STORAGE_SIZE];
 };
 
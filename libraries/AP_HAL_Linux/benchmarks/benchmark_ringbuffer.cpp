@@ -0,0 +1,130 @@
+/*
+  compare the semaphore protected ObjectBuffer_TS with the lock-free
+  single producer/single consumer ObjectBuffer_SPSC
+ */
+#include <AP_gbenchmark.h>
+
+#include <AP_Common/AP_Common.h>
+#include <AP_HAL/AP_HAL.h>
+#include <AP_HAL/utility/RingBuffer.h>
+
+#include <thread>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// a sample of the sort of size passed from IMU backends
+struct Sample {
+    float x, y, z;
+    uint32_t t;
+};
+
+static void BM_ObjectBufferTS_PushPop(benchmark::State& state)
+{
+    ObjectBuffer_TS<Sample> buf(256);
+    Sample s {}, out;
+
+    while (state.KeepRunning()) {
+        buf.push(s);
+        bool ok = buf.pop(out);
+        gbenchmark_escape(&ok);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ObjectBufferTS_PushPop);
+
+static void BM_ObjectBufferSPSC_PushPop(benchmark::State& state)
+{
+    ObjectBuffer_SPSC<Sample> buf(256);
+    Sample s {}, out;
+
+    while (state.KeepRunning()) {
+        buf.push(s);
+        bool ok = buf.pop(out);
+        gbenchmark_escape(&ok);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ObjectBufferSPSC_PushPop);
+
+static void BM_ObjectBufferTS_Batch(benchmark::State& state)
+{
+    const uint32_t n = state.range_x();
+    ObjectBuffer_TS<Sample> buf(256);
+    Sample in[64] {}, out;
+
+    while (state.KeepRunning()) {
+        buf.push(in, n);
+        // ObjectBuffer_TS has no batch pop
+        for (uint32_t i=0; i<n; i++) {
+            bool ok = buf.pop(out);
+            gbenchmark_escape(&ok);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_ObjectBufferTS_Batch)->Arg(8)->Arg(64);
+
+static void BM_ObjectBufferSPSC_Batch(benchmark::State& state)
+{
+    const uint32_t n = state.range_x();
+    ObjectBuffer_SPSC<Sample> buf(256);
+    Sample in[64] {}, out[64];
+
+    while (state.KeepRunning()) {
+        buf.push(in, n);
+        uint32_t got = buf.pop(out, n);
+        gbenchmark_escape(&got);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_ObjectBufferSPSC_Batch)->Arg(8)->Arg(64);
+
+/*
+  one producer thread pushing while the benchmark thread pops, which
+  is the pattern for backend threads feeding the main loop
+ */
+template <class Buffer>
+static void run_threaded(benchmark::State& state, Buffer &buf)
+{
+    std::atomic<bool> stop {false};
+    std::thread producer([&buf, &stop]() {
+        Sample s {};
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (buf.push(s)) {
+                s.t++;
+            }
+        }
+    });
+
+    Sample out;
+    while (state.KeepRunning()) {
+        while (!buf.pop(out)) {
+        }
+        gbenchmark_escape(&out);
+    }
+    stop = true;
+    producer.join();
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_ObjectBufferTS_Threaded(benchmark::State& state)
+{
+    ObjectBuffer_TS<Sample> buf(256);
+    run_threaded(state, buf);
+}
+
+BENCHMARK(BM_ObjectBufferTS_Threaded)->UseRealTime();
+
+static void BM_ObjectBufferSPSC_Threaded(benchmark::State& state)
+{
+    ObjectBuffer_SPSC<Sample> buf(256);
+    run_threaded(state, buf);
+}
+
+BENCHMARK(BM_ObjectBufferSPSC_Threaded)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,108 @@
+/*
+ * This file is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <AP_gtest.h>
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_HAL_Linux/DSP.h>
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL &hal = AP_HAL::get_HAL();
+
+#if HAL_WITH_DSP
+
+using namespace Linux;
+
+static const uint16_t sample_rate = 1000;
+
+static float random_float(float min, float max)
+{
+    return linear_interpolate(min, max, get_random16(), 0, 0xFFFF);
+}
+
+/*
+  run one window of samples through the FFT, returning the state
+  holding the result
+ */
+static DSP::FFTWindowState *analyse(DSP &dsp, const float *samples, uint16_t window_size)
+{
+    DSP::FFTWindowState *fft = dsp.fft_init(window_size, sample_rate, 0);
+    if (fft == nullptr) {
+        return nullptr;
+    }
+    FloatBuffer buffer { window_size };
+    buffer.push(samples, window_size);
+    dsp.fft_start(fft, buffer, window_size);
+    dsp.fft_analyse(fft, 1, fft->_bin_count - 1, 0.5f);
+    return fft;
+}
+
+// the split real FFT gives the same result as a direct DFT of the windowed samples
+TEST(LinuxDSP, rfft)
+{
+    DSP dsp;
+    float samples[1024];
+    for (uint16_t window_size = 16; window_size <= ARRAY_SIZE(samples); window_size *= 2) {
+        for (uint8_t n = 0; n < 5; n++) {
+            for (uint16_t i = 0; i < window_size; i++) {
+                samples[i] = random_float(-100, 100);
+            }
+            DSP::FFTWindowState *fft = analyse(dsp, samples, window_size);
+            ASSERT_NE(fft, nullptr);
+
+            // direct DFT in double precision, including the DC and nyquist bins
+            double scale = 0;
+            for (uint16_t i = 0; i < window_size; i++) {
+                scale += fabsf(samples[i] * fft->_hanning_window[i]);
+            }
+            for (uint16_t k = 0; k <= fft->_bin_count; k++) {
+                double re = 0, im = 0;
+                for (uint16_t i = 0; i < window_size; i++) {
+                    const double angle = 2.0 * M_PI * ((uint32_t(k) * i) % window_size) / window_size;
+                    re += samples[i] * fft->_hanning_window[i] * cos(angle);
+                    im -= samples[i] * fft->_hanning_window[i] * sin(angle);
+                }
+                EXPECT_NEAR(fft->_rfft_data[k*2], re, scale * 1e-5);
+                EXPECT_NEAR(fft->_rfft_data[k*2+1], im, scale * 1e-5);
+            }
+            // the nyquist bin holds its power, which is not scaled by the analysis
+            EXPECT_FLOAT_EQ(fft->_freq_bins[fft->_bin_count], sq(fft->_rfft_data[fft->_bin_count*2]));
+            delete fft;
+        }
+    }
+}
+
+// the strongest peak of a tone is found in its bin
+TEST(LinuxDSP, tone)
+{
+    DSP dsp;
+    const uint16_t window_size = 128;
+    float samples[window_size];
+    for (uint8_t n = 0; n < 20; n++) {
+        const float phase = random_float(0, M_2PI);
+        const uint16_t bin = 4 + get_random16() % (window_size / 2 - 8);
+        const float freq = bin * float(sample_rate) / window_size;
+        for (uint16_t i = 0; i < window_size; i++) {
+            samples[i] = 10 * sinf(M_2PI * freq * i / sample_rate + phase) + random_float(-1, 1);
+        }
+        DSP::FFTWindowState *fft = analyse(dsp, samples, window_size);
+        ASSERT_NE(fft, nullptr);
+        EXPECT_EQ(fft->_peak_data[DSP::CENTER]._bin, bin);
+        delete fft;
+    }
+}
+
+#endif // HAL_WITH_DSP
+
+AP_GTEST_MAIN()
@@ -20,4 +20,6 @@ class GPIO;
 class DigitalSource;
 class DSP;
 class CANIface;
+class SwarmClock;
+class SwarmBus;
 }  // namespace HALSITL
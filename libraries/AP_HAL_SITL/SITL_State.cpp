@@ -26,11 +26,23 @@
 #include <AP_HAL/utility/Socket_native.h>
 
 #include <AP_HAL/SIMState.h>
+#include <AP_Logger/AP_Logger.h>
+
+#include <sched.h>
+#include <time.h>
 
 extern const AP_HAL::HAL& hal;
 
 using namespace HALSITL;
 
+// wall clock time for measuring how fast the simulation runs
+static uint64_t wall_time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000ULL + ts.tv_nsec / 1000ULL;
+}
+
 /*
   setup for SITL handling
  */
@@ -114,7 +126,9 @@ void SITL_State::_fdm_input_step(void)
     }
 
     // trigger all APM timers.
+    const uint64_t timers_start_us = wall_time_us();
     HALSITL::Scheduler::timer_event();
+    sim_timing.timers_us += wall_time_us() - timers_start_us;
     _scheduler->sitl_end_atomic();
 }
 
@@ -122,7 +136,12 @@ void SITL_State::_fdm_input_step(void)
 void SITL_State::wait_clock(uint64_t wait_time_usec)
 {
     float speedup = sitl_model->get_speedup();
-    if (speedup < 1) {
+    // a negative speedup runs as fast as possible
+    const bool max_speed = speedup < 0;
+    if (max_speed) {
+        // for purposes of sleeps treat as a high speedup
+        speedup = 100.0;
+    } else if (speedup < 1) {
         // for purposes of sleeps treat low speedups as 1
         speedup = 1.0;
     }
@@ -147,6 +166,12 @@ void SITL_State::wait_clock(uint64_t wait_time_usec)
                 }
             }
 #endif
+            if (max_speed) {
+                // simulated time moves on as fast as the main thread
+                // can run, so only give up the CPU
+                sched_yield();
+                continue;
+            }
             // most devices can't sleep for 10us - so this is also
             // essentially a yield.  At 30x speedup a 10us wall-clock
             // sleep here can equate to your thread sleeping for 300us
@@ -247,12 +272,19 @@ void SITL_State::_fdm_input_local(void)
     multicast_servo_update(input);
 
     // update the model
+    const uint64_t physics_start_us = wall_time_us();
+    const uint64_t sleep_start_us = sitl_model->get_sleep_time_us();
     sitl_model->update_home();
     sitl_model->update_model(input);
 
     // get FDM output from the model
     sitl_model->fill_fdm(_sitl->state);
 
+    // sleeps to hold the speedup are counted as waiting, not physics
+    const uint64_t slept_us = sitl_model->get_sleep_time_us() - sleep_start_us;
+    sim_timing.physics_us += wall_time_us() - physics_start_us - slept_us;
+    sim_timing.wait_us += slept_us;
+
 #if HAL_NUM_CAN_IFACES
     if (CANIface::num_interfaces() > 0) {
         multicast_state_send();
@@ -264,18 +296,82 @@ void SITL_State::_fdm_input_local(void)
     ride_along.send(_sitl->state,sitl_model->get_position_relhome());
 #endif  // AP_SIM_JSON_MASTER_ENABLED
 
+    const uint64_t devices_start_us = wall_time_us();
     sim_update();
+    const uint64_t devices_end_us = wall_time_us();
+    sim_timing.devices_us += devices_end_us - devices_start_us;
 
     if (_use_fg_view) {
         _output_to_flightgear();
     }
 
+    // don't run ahead of the rest of the swarm
+    lockstep.step(_sitl->state.timestamp_us);
+    sim_timing.wait_us += wall_time_us() - devices_end_us;
+
     // update simulation time
     hal.scheduler->stop_clock(_sitl->state.timestamp_us);
 
     set_height_agl();
 
     _update_count++;
+
+    update_sim_timing();
+}
+
+/*
+  once a second of wall clock time work out the speedup achieved, and
+  for each part of the simulation the speedup it would allow if it
+  were the only thing running, so the limiting part can be found
+ */
+void SITL_State::update_sim_timing(void)
+{
+    const uint64_t now_us = wall_time_us();
+    const uint64_t sim_now_us = _sitl->state.timestamp_us;
+    if (sim_timing.last_wall_us == 0) {
+        sim_timing = {};
+        sim_timing.last_wall_us = now_us;
+        sim_timing.last_sim_us = sim_now_us;
+        return;
+    }
+    const uint64_t wall_dt_us = now_us - sim_timing.last_wall_us;
+    if (wall_dt_us < 1000000) {
+        return;
+    }
+    const float sim_dt_us = sim_now_us - sim_timing.last_sim_us;
+    const uint64_t busy_us = sim_timing.physics_us + sim_timing.devices_us + sim_timing.timers_us + sim_timing.wait_us;
+    const uint64_t vehicle_us = wall_dt_us > busy_us ? wall_dt_us - busy_us : 0;
+
+#if HAL_LOGGING_ENABLED
+    // examples have no logger
+    AP_Logger *logger = AP_Logger::get_singleton();
+// @LoggerMessage: SIMT
+// @Description: Simulation speed, and the speedup each part of the simulation would allow on its own
+// @Field: TimeUS: Time since system startup
+// @Field: Spd: Achieved simulation speedup
+// @Field: Phys: Speedup allowed by the physics model
+// @Field: Dev: Speedup allowed by the simulated devices
+// @Field: Tmr: Speedup allowed by the timer callbacks, including sensor drivers
+// @Field: Veh: Speedup allowed by the vehicle main loop and other threads
+// @Field: Wait: Fraction of the time spent waiting for the wall clock or for other instances
+    if (logger != nullptr) {
+        logger->WriteStreaming(
+            "SIMT",
+            "TimeUS,Spd,Phys,Dev,Tmr,Veh,Wait",
+            "Qffffff",
+            AP_HAL::micros64(),
+            sim_dt_us / wall_dt_us,
+            sim_dt_us / MAX(sim_timing.physics_us, 1U),
+            sim_dt_us / MAX(sim_timing.devices_us, 1U),
+            sim_dt_us / MAX(sim_timing.timers_us, 1U),
+            sim_dt_us / MAX(vehicle_us, 1U),
+            float(sim_timing.wait_us) / wall_dt_us);
+    }
+#endif
+
+    sim_timing = {};
+    sim_timing.last_wall_us = now_us;
+    sim_timing.last_sim_us = sim_now_us;
 }
 
 /*
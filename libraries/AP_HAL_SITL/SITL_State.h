@@ -6,6 +6,7 @@
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
 
 #include "SITL_State_common.h"
+#include "Swarm.h"
 
 #if defined(HAL_BUILD_AP_PERIPH)
 #include "SITL_Periph_State.h"
@@ -133,6 +134,20 @@ private:
 
     uint16_t mc_servo[SITL_NUM_CHANNELS];
     void check_servo_input(void);
+
+    // simulated clock shared with other instances on this host
+    SwarmClock lockstep;
+
+    // wall clock time spent in each part of the simulation
+    struct {
+        uint64_t last_wall_us;
+        uint64_t last_sim_us;
+        uint64_t physics_us;
+        uint64_t devices_us;
+        uint64_t timers_us;
+        uint64_t wait_us;
+    } sim_timing;
+    void update_sim_timing(void);
 };
 
 #endif // defined(HAL_BUILD_AP_PERIPH)
@@ -118,6 +118,7 @@ void SITL_State::_usage(void)
            "\t--start-time TIMESTR     set simulation start time in UNIX timestamp\n"
            "\t--sysid ID               set MAV_SYSID\n"
            "\t--slave number           set the number of JSON slaves\n"
+           "\t--lockstep COUNT[:NAME]  run on one simulated clock with instances 0 to COUNT-1 on this host\n"
            "\t--use_sim_time <true|false>  use ROS2 simulation clock for DDS topics. Defaults to false\n"
         );
 }
@@ -271,6 +272,9 @@ void SITL_State::_parse_command_line(int argc, char * const argv[])
     uint8_t num_net_device_strings = 0;
 #endif  // AP_SIM_SERIALDEVICE_NETWORK_ENABLED
 
+    // COUNT[:NAME] string from --lockstep option
+    const char *lockstep_str = nullptr;
+
     // Set default start time to the real system time.
     // This will be overwritten if argument provided.
     static struct timeval first_tv;
@@ -315,6 +319,7 @@ void SITL_State::_parse_command_line(int argc, char * const argv[])
         CMDLINE_START_TIME,
         CMDLINE_SYSID,
         CMDLINE_SLAVE,
+        CMDLINE_LOCKSTEP,
         CMDLINE_LIST_MODELS,
 #if STORAGE_USE_FLASH
         CMDLINE_SET_STORAGE_FLASH_ENABLED,
@@ -380,6 +385,7 @@ void SITL_State::_parse_command_line(int argc, char * const argv[])
         {"start-time",      true,   0, CMDLINE_START_TIME},
         {"sysid",           true,   0, CMDLINE_SYSID},
         {"slave",           true,   0, CMDLINE_SLAVE},
+        {"lockstep",        true,   0, CMDLINE_LOCKSTEP},
         {"list-models",     false,  0, CMDLINE_LIST_MODELS},
 #if STORAGE_USE_FLASH
         {"set-storage-flash-enabled", true,   0, CMDLINE_SET_STORAGE_FLASH_ENABLED},
@@ -607,6 +613,10 @@ void SITL_State::_parse_command_line(int argc, char * const argv[])
 #endif  // AP_SIM_JSON_MASTER_ENABLED
             break;
         }
+        case CMDLINE_LOCKSTEP:
+            // joined once the instance number is known
+            lockstep_str = gopt.optarg;
+            break;
         case CMDLINE_LIST_MODELS:
             list_models_and_exit();
             break;
@@ -616,6 +626,13 @@ void SITL_State::_parse_command_line(int argc, char * const argv[])
         }
     }
 
+    if (lockstep_str != nullptr) {
+        const char *name = strchr(lockstep_str, ':');
+        if (!lockstep.init(name?name+1:"sitl", _instance, atoi(lockstep_str))) {
+            exit(1);
+        }
+    }
+
     // if no explicit --defaults was given, try resolving via the embedded
     // vehicleinfo.json. This makes the binary self-sufficient: a user
     // running `arduplane --model=quadplane-tilt` from a directory without
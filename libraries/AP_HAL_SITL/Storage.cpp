@@ -111,6 +111,14 @@ void Storage::_storage_open(void)
             log_fd = -1;
             return;
         }
+        // complete any commit that was interrupted
+        if (!_journal.init(HAL_STORAGE_FILE ".jnl", HAL_STORAGE_SIZE, STORAGE_LINE_SIZE) ||
+            !_journal.replay(log_fd, _buffer)) {
+            hal.console->printf("journal failed for " HAL_STORAGE_FILE "\n");
+            close(log_fd);
+            log_fd = -1;
+            return;
+        }
         _initialisedType = StorageBackend::SDCard;  // AKA POSIX
         return;
     }
@@ -131,6 +139,13 @@ void Storage::_mark_dirty(uint16_t loc, uint16_t length)
     if (length == 0) {
         return;
     }
+#if STORAGE_USE_POSIX
+    const uint32_t now_ms = AP_HAL::millis();
+    if (_dirty_mask.empty()) {
+        _first_dirty_ms = now_ms;
+    }
+    _last_write_ms = now_ms;
+#endif
     uint16_t end = loc + length - 1;
     for (uint16_t line=loc>>STORAGE_LINE_SHIFT;
          line <= end>>STORAGE_LINE_SHIFT;
@@ -157,6 +172,9 @@ void Storage::write_block(uint16_t loc, const void *src, size_t n)
         _storage_open();
         memcpy(&_buffer[loc], src, n);
         _mark_dirty(loc, n);
+#if STORAGE_USE_POSIX
+        _journal.count_changed(n);
+#endif
     }
 }
 
@@ -170,6 +188,13 @@ void Storage::_timer_tick(void)
         return;
     }
 
+#if STORAGE_USE_POSIX
+    if (_initialisedType == StorageBackend::SDCard) {
+        _posix_commit();
+        return;
+    }
+#endif
+
     // write out the first dirty line. We don't write more
     // than one to keep the latency of this call to a minimum
     uint16_t i;
@@ -215,6 +240,52 @@ void Storage::_timer_tick(void)
 #endif
 }
 
+#if STORAGE_USE_POSIX
+/*
+  commit all the dirty lines to the storage file in one batch, once
+  writes have stopped for a moment
+ */
+void Storage::_posix_commit(void)
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    if (log_fd == -1 ||
+        (now_ms - _last_write_ms < STORAGE_COALESCE_MS &&
+         now_ms - _first_dirty_ms < STORAGE_MAX_DELAY_MS)) {
+        return;
+    }
+
+    Bitmask<STORAGE_NUM_LINES> batch_mask;
+    batch_mask = _dirty_mask;
+    _journal.begin();
+    for (uint16_t i=0; i<STORAGE_NUM_LINES; i++) {
+        if (batch_mask.get(i)) {
+            // clear before copying, so a line written during the
+            // copy goes in the next batch
+            _dirty_mask.clear(i);
+            _journal.add(STORAGE_LINE_SIZE*i, &_buffer[STORAGE_LINE_SIZE*i], STORAGE_LINE_SIZE);
+        }
+    }
+    if (!_journal.commit(log_fd)) {
+        // retry the whole batch
+        for (uint16_t i=0; i<STORAGE_NUM_LINES; i++) {
+            if (batch_mask.get(i)) {
+                _dirty_mask.set(i);
+            }
+        }
+        _first_dirty_ms = now_ms;
+    }
+}
+#endif // STORAGE_USE_POSIX
+
+void Storage::storage_info(ExpandingString &str)
+{
+#if STORAGE_USE_POSIX
+    if (_initialisedType == StorageBackend::SDCard) {
+        _journal.info(str);
+    }
+#endif
+}
+
 #if STORAGE_USE_FLASH
 
 /*
@@ -5,6 +5,7 @@
 #include "AP_HAL_SITL_Namespace.h"
 #include <AP_FlashStorage/AP_FlashStorage.h>
 #include <AP_RAMTRON/AP_RAMTRON.h>
+#include <AP_HAL/utility/StorageJournal.h>
 
 #ifndef STORAGE_USE_FLASH
 #define STORAGE_USE_FLASH 1
@@ -23,6 +24,12 @@
 #define STORAGE_LINE_SIZE (1<<STORAGE_LINE_SHIFT)
 #define STORAGE_NUM_LINES (HAL_STORAGE_SIZE/STORAGE_LINE_SIZE)
 
+// dirty lines of the POSIX backend are committed together once writes
+// have stopped for STORAGE_COALESCE_MS, or STORAGE_MAX_DELAY_MS after
+// the first of them was written
+#define STORAGE_COALESCE_MS 50
+#define STORAGE_MAX_DELAY_MS 500
+
 class HALSITL::Storage : public AP_HAL::Storage {
 public:
     void init() override {}
@@ -32,6 +39,7 @@ public:
 
     void _timer_tick(void) override;
     bool healthy(void) override;
+    void storage_info(ExpandingString &str) override;
 
 private:
     enum class StorageBackend: uint8_t {
@@ -73,6 +81,10 @@ private:
 
 #if STORAGE_USE_POSIX
     int log_fd;
+    StorageJournal _journal;
+    uint32_t _first_dirty_ms;
+    uint32_t _last_write_ms;
+    void _posix_commit(void);
 #endif
 
 #if STORAGE_USE_FRAM
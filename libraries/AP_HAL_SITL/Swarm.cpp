@@ -0,0 +1,263 @@
+/*
+  shared memory support for running a swarm of SITL instances on one
+  host
+ */
+#include "Swarm.h"
+
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <AP_Common/AP_Common.h>
+#include <AP_Math/AP_Math.h>
+
+using namespace HALSITL;
+
+/*
+  map a named shared memory region, creating it zero filled if it
+  does not already exist
+ */
+static void *map_shared(const char *kind, const char *name, size_t size)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/ap_sitl_%s_%s", kind, name);
+    const int fd = shm_open(path, O_RDWR|O_CREAT|O_CLOEXEC, 0666);
+    if (fd == -1) {
+        ::fprintf(stderr, "shm_open(%s) failed - %s\n", path, strerror(errno));
+        return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 ||
+        (size_t(st.st_size) < size && ftruncate(fd, size) != 0)) {
+        ::fprintf(stderr, "failed to size %s - %s\n", path, strerror(errno));
+        close(fd);
+        return nullptr;
+    }
+    void *ptr = mmap(nullptr, size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        ::fprintf(stderr, "mmap of %s failed - %s\n", path, strerror(errno));
+        return nullptr;
+    }
+    return ptr;
+}
+
+static bool process_running(int32_t pid)
+{
+    return pid > 0 && (kill(pid, 0) == 0 || errno != ESRCH);
+}
+
+static SwarmClock *exiting_clock;
+
+static void swarm_clock_leave(void)
+{
+    exiting_clock->leave();
+}
+
+bool SwarmClock::init(const char *name, uint8_t _instance, uint8_t _count)
+{
+    if (_count > MAX_INSTANCES || _instance >= _count) {
+        ::fprintf(stderr, "lockstep instance %u must be less than %u\n",
+                  unsigned(_instance), unsigned(MIN(_count, MAX_INSTANCES)));
+        return false;
+    }
+    shared = (shared_state *)map_shared("lockstep", name, sizeof(shared_state));
+    if (shared == nullptr) {
+        return false;
+    }
+    instance = _instance;
+    count = _count;
+    seen_running = 1ULL << instance;
+
+    // the time must be valid before other instances see our pid
+    slot &me = shared->slots[instance];
+    __atomic_store_n(&me.time_us, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&me.pid, int32_t(getpid()), __ATOMIC_RELEASE);
+
+    exiting_clock = this;
+    atexit(swarm_clock_leave);
+
+    ::printf("Lockstep with %u instances as instance %u\n", unsigned(count), unsigned(instance));
+    return true;
+}
+
+/*
+  return true if we need to wait for instance i to reach time_us.
+  Instances that have not started yet are waited for, instances which
+  have since exited are not
+ */
+bool SwarmClock::other_is_behind(uint8_t i, uint64_t time_us, bool check_running)
+{
+    const slot &s = shared->slots[i];
+    const int32_t pid = __atomic_load_n(&s.pid, __ATOMIC_ACQUIRE);
+    const uint64_t other_time_us = __atomic_load_n(&s.time_us, __ATOMIC_RELAXED);
+    const uint64_t mask = 1ULL << i;
+    if ((seen_running & mask) == 0) {
+        // the slot may be left over from an earlier run
+        if (!check_running || !process_running(pid)) {
+            return true;
+        }
+        seen_running |= mask;
+    }
+    if (other_time_us >= time_us) {
+        return false;
+    }
+    return !check_running || process_running(pid);
+}
+
+void SwarmClock::step(uint64_t time_us)
+{
+    if (shared == nullptr) {
+        return;
+    }
+    __atomic_store_n(&shared->slots[instance].time_us, time_us, __ATOMIC_RELEASE);
+
+    for (uint8_t i=0; i<count; i++) {
+        if (i == instance) {
+            continue;
+        }
+        uint32_t spins = 0;
+        while (other_is_behind(i, time_us, spins % 1000 == 0)) {
+            if (spins == 0 && (seen_running & (1ULL << i)) == 0) {
+                ::printf("Lockstep waiting for instance %u\n", unsigned(i));
+            }
+            // the other instance is normally less than a frame
+            // behind, so yield rather than sleep at first
+            if (spins < 100) {
+                sched_yield();
+            } else {
+                usleep(10);
+            }
+            spins++;
+        }
+    }
+}
+
+void SwarmClock::leave()
+{
+    if (shared == nullptr) {
+        return;
+    }
+    __atomic_store_n(&shared->slots[instance].time_us, UINT64_MAX, __ATOMIC_RELEASE);
+}
+
+bool SwarmBus::init(const char *name)
+{
+    shared = (shared_state *)map_shared("bus", name, sizeof(shared_state));
+    if (shared == nullptr) {
+        return false;
+    }
+    pid = getpid();
+    lock();
+    read_ofs = shared->head;
+    unlock();
+    return true;
+}
+
+/*
+  the lock is held for a copy at most, so spin. If the holder has
+  died take the lock from it
+ */
+void SwarmBus::lock()
+{
+    uint32_t spins = 0;
+    while (true) {
+        int32_t owner = 0;
+        if (__atomic_compare_exchange_n(&shared->lock_pid, &owner, int32_t(pid), false,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            return;
+        }
+        if (++spins % 1000 == 0 && !process_running(owner) &&
+            __atomic_compare_exchange_n(&shared->lock_pid, &owner, int32_t(pid), false,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            return;
+        }
+        sched_yield();
+    }
+}
+
+void SwarmBus::unlock()
+{
+    __atomic_store_n(&shared->lock_pid, 0, __ATOMIC_RELEASE);
+}
+
+void SwarmBus::copy_in(uint64_t ofs, const void *src, uint32_t len)
+{
+    const uint32_t pos = ofs % BUS_SIZE;
+    const uint32_t n1 = MIN(len, BUS_SIZE - pos);
+    memcpy(&shared->data[pos], src, n1);
+    memcpy(&shared->data[0], (const uint8_t *)src + n1, len - n1);
+}
+
+void SwarmBus::copy_out(uint64_t ofs, void *dst, uint32_t len) const
+{
+    const uint32_t pos = ofs % BUS_SIZE;
+    const uint32_t n1 = MIN(len, BUS_SIZE - pos);
+    memcpy(dst, &shared->data[pos], n1);
+    memcpy((uint8_t *)dst + n1, &shared->data[0], len - n1);
+}
+
+/*
+  each packet on the bus is its length and the pid of the sender
+  followed by the data
+ */
+struct PACKED swarm_bus_header {
+    uint16_t len;
+    int32_t pid;
+};
+
+ssize_t SwarmBus::send(const uint8_t *buf, uint16_t len)
+{
+    if (sizeof(swarm_bus_header) + len > BUS_SIZE / 4) {
+        return -1;
+    }
+    const swarm_bus_header hdr { len, int32_t(pid) };
+    lock();
+    copy_in(shared->head, &hdr, sizeof(hdr));
+    copy_in(shared->head + sizeof(hdr), buf, len);
+    shared->head += sizeof(hdr) + len;
+    unlock();
+    return len;
+}
+
+ssize_t SwarmBus::recv(uint8_t *buf, uint16_t len)
+{
+    uint16_t n = 0;
+    lock();
+    if (shared->head - read_ofs > BUS_SIZE) {
+        // we have been overrun, drop everything unread
+        read_ofs = shared->head;
+    }
+    while (read_ofs < shared->head) {
+        swarm_bus_header hdr;
+        copy_out(read_ofs, &hdr, sizeof(hdr));
+        if (hdr.pid != pid) {
+            if (n + hdr.len > len) {
+                if (n != 0) {
+                    // leave it for the next read
+                    break;
+                }
+                // it will never fit, so truncate it as a UDP socket
+                // would rather than stalling the bus for this reader
+                copy_out(read_ofs + sizeof(hdr), buf, len);
+                read_ofs += sizeof(hdr) + hdr.len;
+                n = len;
+                break;
+            }
+            copy_out(read_ofs + sizeof(hdr), &buf[n], hdr.len);
+            n += hdr.len;
+        }
+        read_ofs += sizeof(hdr) + hdr.len;
+    }
+    unlock();
+    return n;
+}
+
+#endif // CONFIG_HAL_BOARD == HAL_BOARD_SITL
@@ -0,0 +1,91 @@
+/*
+  shared memory support for running a swarm of SITL instances on one
+  host
+
+  SwarmClock keeps the simulated clocks of the instances in
+  lockstep. Each instance publishes the simulated time it has reached
+  and only steps its physics past a time once every other instance
+  has reached it, so the swarm runs on one clock as fast as the
+  slowest instance allows, with no wall clock synchronisation between
+  the processes.
+
+  SwarmBus is an in-memory broadcast link for the UART "shm:" device
+  type, in place of UDP multicast. Every packet written by one
+  instance is read by all the others attached to the same bus.
+ */
+#pragma once
+
+#include <AP_HAL/AP_HAL.h>
+
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
+
+#include <stdint.h>
+#include <sys/types.h>
+#include "AP_HAL_SITL_Namespace.h"
+
+class HALSITL::SwarmClock {
+public:
+    static const uint8_t MAX_INSTANCES = 64;
+
+    // join the swarm called name of count instances as the given instance
+    bool init(const char *name, uint8_t instance, uint8_t count);
+
+    bool enabled() const { return shared != nullptr; }
+
+    // publish our simulated time and wait for all other instances to reach it
+    void step(uint64_t time_us);
+
+    // leave the swarm, so other instances no longer wait for us
+    void leave();
+
+private:
+    struct slot {
+        volatile int32_t pid;
+        volatile uint64_t time_us;
+    };
+    struct shared_state {
+        slot slots[MAX_INSTANCES];
+    };
+    shared_state *shared;
+    uint8_t instance;
+    uint8_t count;
+
+    // instances we have seen running, so we can tell an instance that
+    // has not started yet from one that has died
+    uint64_t seen_running;
+
+    bool other_is_behind(uint8_t i, uint64_t time_us, bool check_running);
+};
+
+class HALSITL::SwarmBus {
+public:
+    // attach to the bus called name
+    bool init(const char *name);
+
+    // broadcast a packet to the other instances on the bus
+    ssize_t send(const uint8_t *buf, uint16_t len);
+
+    // read whole packets from other instances, up to len bytes
+    ssize_t recv(uint8_t *buf, uint16_t len);
+
+private:
+    static const uint32_t BUS_SIZE = 65536;
+
+    struct shared_state {
+        volatile int32_t lock_pid;
+        volatile uint64_t head;
+        uint8_t data[BUS_SIZE];
+    };
+    shared_state *shared;
+    pid_t pid;
+
+    // bus offset of the next packet we will read
+    uint64_t read_ofs;
+
+    void lock();
+    void unlock();
+    void copy_in(uint64_t ofs, const void *src, uint32_t len);
+    void copy_out(uint64_t ofs, void *dst, uint32_t len) const;
+};
+
+#endif // CONFIG_HAL_BOARD == HAL_BOARD_SITL
@@ -92,6 +92,7 @@ void UARTDriver::_begin(uint32_t baud, uint16_t rxSpace, uint16_t txSpace)
              udpclient:127.0.0.1:14550
              mcast:
              mcast:239.255.145.50:14550
+             shm:swarm        // in-memory link to other instances on this host
              uart:/dev/ttyUSB0:57600
              sim:ParticleSensor_SDS021:
              file:/tmp/my-device-capture.BIN
@@ -152,6 +153,13 @@ void UARTDriver::_begin(uint32_t baud, uint16_t rxSpace, uint16_t txSpace)
                 ::printf("UDP multicast connection %s:%u\n", ip, port);
                 _udp_start_multicast(ip, port);
             }
+        } else if (strcmp(devtype, "shm") == 0) {
+            // shared memory broadcast between instances
+            const char *name = args1 && *args1?args1:"mavlink";
+            if (!_connected) {
+                ::printf("SHM connection %s\n", name);
+                _swarm_bus_start(name);
+            }
         } else if (strcmp(devtype,"none") == 0) {
             // skipping port
             ::printf("Skipping port %s\n", args1);
@@ -633,6 +641,23 @@ void UARTDriver::_udp_start_multicast(const char *address, uint16_t port)
 }
 
 
+/*
+  start an in-memory broadcast connection to other instances on this
+  host. Like multicast each write is kept as a single packet
+ */
+void UARTDriver::_swarm_bus_start(const char *name)
+{
+    if (_connected) {
+        return;
+    }
+    _swarm_bus = NEW_NOTHROW SwarmBus();
+    if (_swarm_bus == nullptr || !_swarm_bus->init(name)) {
+        AP_HAL::panic("Failed to attach to shm bus %s", name);
+    }
+    _packetise = true;
+    _connected = true;
+}
+
 /*
   start a UART connection for the serial port
  */
@@ -883,7 +908,12 @@ void UARTDriver::handle_writing_from_writebuffer_to_device()
             // keep as a single UDP packet
             uint8_t tmpbuf[n];
             _writebuffer.peekbytes(tmpbuf, n);
-            ssize_t ret = send(_fd, tmpbuf, n, MSG_DONTWAIT);
+            ssize_t ret;
+            if (_swarm_bus != nullptr) {
+                ret = _swarm_bus->send(tmpbuf, n);
+            } else {
+                ret = send(_fd, tmpbuf, n, MSG_DONTWAIT);
+            }
             if (ret > 0) {
                 _writebuffer.advance(ret);
                 _tx_stats_bytes += ret;
@@ -996,6 +1026,8 @@ void UARTDriver::handle_reading_from_device_to_readbuffer()
                 nread = 0;
             }
         }
+    } else if (_swarm_bus != nullptr) {
+        nread = _swarm_bus->recv((uint8_t *)buf, space);
     } else if (_sim_serial_device != nullptr) {
         nread = _sim_serial_device->read_from_device(buf, space);
     } else if (logic_async_csv.active) {
@@ -13,6 +13,8 @@
 
 #include <SITL/SIM_SerialDevice.h>
 
+#include "Swarm.h"
+
 class HALSITL::UARTDriver : public AP_HAL::UARTDriver {
 public:
     friend class HALSITL::SITL_State;
@@ -81,6 +83,9 @@ private:
     // file descriptor for reading multicast packets
     int _mc_fd;
 
+    // in-memory broadcast link to other instances on this host
+    SwarmBus *_swarm_bus = nullptr;
+
     uint8_t _portNumber;
     bool _connected = false; // true if a client has connected
     bool _use_send_recv = false;
@@ -106,6 +111,7 @@ private:
     void _tcp_start_client(const char *address, uint16_t port);
     void _udp_start_client(const char *address, uint16_t port);
     void _udp_start_multicast(const char *address, uint16_t port);
+    void _swarm_bus_start(const char *name);
     void _check_connection(void);
     static bool _select_check(int );
 
@@ -67,6 +67,26 @@ float AP_InertialSensor_SITL::get_temperature(void)
 #endif
 }
 
+/*
+  rotation from the board to the sensor frame for SIM_BRD_TRIM, or
+  nullptr if there is no trim. This is needed for every sample so is
+  only recalculated when the trim changes
+ */
+const Matrix3f *AP_InertialSensor_SITL::board_trim_rotation()
+{
+    const Vector3f &board_trim = sitl->board_trim.get();
+    if (board_trim.is_zero()) {
+        return nullptr;
+    }
+    if (board_trim != last_board_trim) {
+        Matrix3f rotation;
+        rotation.from_euler(board_trim.x, board_trim.y, board_trim.z);
+        board_trim_rot = rotation.transposed();
+        last_board_trim = board_trim;
+    }
+    return &board_trim_rot;
+}
+
 /*
   generate an accelerometer sample
  */
@@ -75,6 +95,12 @@ void AP_InertialSensor_SITL::generate_accel()
     Vector3f accel_accum;
     uint8_t nsamples = enable_fast_sampling(accel_instance) ? 4 : 1;
 
+    // these don't change between the samples of a call
+    const Matrix3f *trim_rotation = board_trim_rotation();
+#if HAL_INS_TEMPERATURE_CAL_ENABLE
+    const float T = get_temperature();
+#endif
+
     for (uint8_t j = 0; j < nsamples; j++) {
 
         Vector3f accel = Vector3f(sitl->state.xAccel,
@@ -84,11 +110,8 @@ void AP_InertialSensor_SITL::generate_accel()
         // SIM_BRD_TRIM: simulate a rigid board mounting offset by rotating
         // the sensor frame.  Applied to both accel (here) and gyro so the two
         // stay consistent, as a real tilted mount would.
-        const Vector3f &board_trim = sitl->board_trim.get();
-        if (!board_trim.is_zero()) {
-            Matrix3f trim_rotation;
-            trim_rotation.from_euler(board_trim.x, board_trim.y, board_trim.z);
-            accel = trim_rotation.transposed() * accel;
+        if (trim_rotation != nullptr) {
+            accel = *trim_rotation * accel;
         }
 
         // add scaling
@@ -183,7 +206,6 @@ void AP_InertialSensor_SITL::generate_accel()
         }
 
 #if HAL_INS_TEMPERATURE_CAL_ENABLE
-        const float T = get_temperature();
         sitl->imu_tcal[gyro_instance].sitl_apply_accel(T, accel);
 #endif
 
@@ -215,7 +237,13 @@ void AP_InertialSensor_SITL::generate_gyro()
     Vector3f gyro_accum;
     uint8_t nsamples = enable_fast_sampling(gyro_instance) ? 8 : 1;
 
+    // these don't change between the samples of a call
     const float _gyro_drift = gyro_drift();
+    const Matrix3f *trim_rotation = board_trim_rotation();
+#if HAL_INS_TEMPERATURE_CAL_ENABLE
+    const float T = get_temperature();
+#endif
+
     for (uint8_t j = 0; j < nsamples; j++) {
         float p = radians(sitl->state.rollRate) + _gyro_drift;
         float q = radians(sitl->state.pitchRate) + _gyro_drift;
@@ -281,15 +309,12 @@ void AP_InertialSensor_SITL::generate_gyro()
         Vector3f gyro {p, q, r};
 
         // SIM_BRD_TRIM: rigid board mounting offset, same rotation as accel:
-        const Vector3f &board_trim = sitl->board_trim.get();
-        if (!board_trim.is_zero()) {
-            Matrix3f trim_rotation;
-            trim_rotation.from_euler(board_trim.x, board_trim.y, board_trim.z);
-            gyro = trim_rotation.transposed() * gyro;
+        if (trim_rotation != nullptr) {
+            gyro = *trim_rotation * gyro;
         }
 
 #if HAL_INS_TEMPERATURE_CAL_ENABLE
-        sitl->imu_tcal[gyro_instance].sitl_apply_gyro(get_temperature(), gyro);
+        sitl->imu_tcal[gyro_instance].sitl_apply_gyro(T, gyro);
 #endif
 
         // add in gyro scaling
@@ -31,6 +31,7 @@ private:
     void generate_accel();
     void generate_gyro();
     float get_temperature(void);
+    const Matrix3f *board_trim_rotation();
     void update_file();
     void update_from_frame();
 #if AP_SIM_INS_FILE_ENABLED
@@ -54,6 +55,10 @@ private:
     float gyro_motor_phase[32];
     float accel_motor_phase[32];
     uint32_t temp_start_ms;
+
+    // SIM_BRD_TRIM the rotation was calculated for
+    Vector3f last_board_trim;
+    Matrix3f board_trim_rot;
 #if AP_SIM_INS_FILE_ENABLED
     int gyro_fd = -1;
     int accel_fd = -1;
@@ -204,6 +204,16 @@ const AP_Param::GroupInfo AP_Logger::var_info[] = {
     // @RebootRequired: True
     AP_GROUPINFO("_MAX_FILES", 12, AP_Logger, _params.max_log_files, MAX_LOG_FILES),
 
+#if HAL_LOGGER_COMPRESSION_ENABLED
+    // @Param: _COMPRESS
+    // @DisplayName: Log compression
+    // @Description: Bitmap of Logger backends which write compressed logs. Compressed logs are made of independently compressed blocks of log messages, and need a log reader which supports them.
+    // @Bitmask: 0:File,1:MAVLink
+    // @User: Advanced
+    // @RebootRequired: True
+    AP_GROUPINFO("_COMPRESS", 13, AP_Logger, _params.compress, 0),
+#endif
+
     AP_GROUPEND
 };
 
@@ -903,6 +913,7 @@ void AP_Logger::periodic_tasks() {
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX
     // currently only AP_Logger_File support this:
 void AP_Logger::flush(void) {
+     FOR_EACH_BACKEND(flush_compressed());
      FOR_EACH_BACKEND(flush());
 }
 #endif
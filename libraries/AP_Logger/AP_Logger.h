@@ -360,6 +360,9 @@ public:
         AP_Float blk_ratemax;
         AP_Float disarm_ratemax;
         AP_Int16 max_log_files;
+#if HAL_LOGGER_COMPRESSION_ENABLED
+        AP_Int8 compress;
+#endif
     } _params;
 
     const struct LogStructure *structure(uint16_t num) const;
@@ -75,6 +75,8 @@ void AP_Logger_Backend::periodic_1Hz()
         stop_logging_async();
     }
     df_stats_log();
+    // limit how far behind the log can be while a compressed block fills
+    flush_compressed();
 }
 
 void AP_Logger_Backend::periodic_fullrate()
@@ -98,6 +100,28 @@ void AP_Logger_Backend::periodic_tasks()
 
 void AP_Logger_Backend::start_new_log_reset_variables()
 {
+#if HAL_LOGGER_COMPRESSION_ENABLED
+    {
+        // the compressor is never freed as writers check for it
+        // without the semaphore
+        WITH_SEMAPHORE(compress_sem);
+        const uint16_t block_size = compress_block_size();
+        if (compressor == nullptr && block_size != 0) {
+            AP_Logger_Compressor *c = NEW_NOTHROW AP_Logger_Compressor();
+            if (c != nullptr && c->init(block_size)) {
+                compressor = c;
+            } else {
+                delete c;
+                DEV_PRINTF("AP_Logger: no memory for compression\n");
+            }
+        }
+        if (compressor != nullptr) {
+            // backends flush the block when they stop logging, so
+            // anything left is from a previous log that couldn't take it
+            compressor->reset();
+        }
+    }
+#endif
     _dropped = 0;
     _startup_messagewriter->reset();
     _front.backend_starting_new_log(this);
@@ -465,9 +489,68 @@ bool AP_Logger_Backend::WritePrioritisedBlock(const void *pBuffer, uint16_t size
         return false;
     }
 
+#if HAL_LOGGER_COMPRESSION_ENABLED
+    if (compressor != nullptr) {
+        return write_compressed(pBuffer, size, is_critical);
+    }
+#endif
+
     return _WritePrioritisedBlock(pBuffer, size, is_critical);
 }
 
+#if HAL_LOGGER_COMPRESSION_ENABLED
+/*
+  add a record to the compressed block, passing the block to the
+  backend as a single frame when it is full. A frame the backend
+  can't take yet is kept and retried, and records are refused
+  until it goes
+ */
+bool AP_Logger_Backend::write_compressed(const void *pBuffer, uint16_t size, bool is_critical)
+{
+    WITH_SEMAPHORE(compress_sem);
+
+    const uint8_t *record = (const uint8_t *)pBuffer;
+    if (size < LOG_PACKET_HEADER_LEN || size > LOG_PACKET_MAX_LEN) {
+        // not a single record, write it as it is after the block
+        return write_compressed_frame(is_critical) &&
+            _WritePrioritisedBlock(pBuffer, size, is_critical);
+    }
+    if (compressor->add(record, size)) {
+        return true;
+    }
+    // the backend counts a frame it can't take as dropped
+    return write_compressed_frame(is_critical) &&
+        compressor->add(record, size);
+}
+
+bool AP_Logger_Backend::write_compressed_frame(bool is_critical)
+{
+    uint16_t len;
+    const uint8_t *frame = compressor->frame(len);
+    if (len == 0) {
+        return true;
+    }
+    if (!_WritePrioritisedBlock(frame, len, is_critical)) {
+        return false;
+    }
+    compressor->release_frame();
+    return true;
+}
+#endif // HAL_LOGGER_COMPRESSION_ENABLED
+
+void AP_Logger_Backend::flush_compressed(void)
+{
+#if HAL_LOGGER_COMPRESSION_ENABLED
+    if (compressor == nullptr) {
+        return;
+    }
+    WITH_SEMAPHORE(compress_sem);
+    if (compressor != nullptr) {
+        write_compressed_frame(true);
+    }
+#endif
+}
+
 bool AP_Logger_Backend::ShouldLog(bool is_critical)
 {
     if (!_front.WritesEnabled()) {
@@ -696,6 +779,9 @@ void AP_Logger_Backend::Write_AP_Logger_Stats_File(const struct df_stats &_stats
         buf_space_min   : _stats.buf_space_min,
         buf_space_max   : _stats.buf_space_max,
         buf_space_avg   : (_stats.blocks) ? (_stats.buf_space_sigma / _stats.blocks) : 0,
+        io_bytes        : _stats.io_bytes,
+        io_writes       : _stats.io_writes,
+        io_us           : _stats.io_us,
     };
     WriteBlock(&pkt, sizeof(pkt));
 }
@@ -713,6 +799,13 @@ void AP_Logger_Backend::df_stats_gather(const uint16_t bytes_written, uint32_t s
     stats.blocks++;
 }
 
+void AP_Logger_Backend::df_stats_io_gather(const uint32_t bytes_written, const uint32_t write_us)
+{
+    stats.io_bytes += bytes_written;
+    stats.io_writes++;
+    stats.io_us += write_us;
+}
+
 void AP_Logger_Backend::df_stats_clear() {
     memset(&stats, '\0', sizeof(stats));
     stats.buf_space_min = -1;
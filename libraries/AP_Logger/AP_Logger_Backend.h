@@ -10,6 +10,7 @@
 #include <AP_Mission/AP_Mission.h>
 #include <AP_Vehicle/ModeReason.h>
 #include "LogStructure.h"
+#include "AP_Logger_Compress.h"
 
 class LoggerMessageWriter_DFLogStart;
 
@@ -71,6 +72,9 @@ public:
 
     bool WritePrioritisedBlock(const void *pBuffer, uint16_t size, bool is_critical, bool writev_streaming=false);
 
+    // pass any partly filled compressed block to the backend
+    void flush_compressed(void);
+
     // high level interface, indexed by the position in the list of logs
     virtual uint16_t find_last_log() = 0;
     virtual void get_log_boundaries(uint16_t list_entry, uint32_t & start_page, uint32_t & end_page) = 0;
@@ -247,9 +251,15 @@ protected:
 
     virtual bool _WritePrioritisedBlock(const void *pBuffer, uint16_t size, bool is_critical) = 0;
 
+    // size of the blocks of records to compress when compression is
+    // enabled for this backend, or zero to write records as they are
+    virtual uint16_t compress_block_size() const { return 0; }
+
     bool _initialised;
 
     void df_stats_gather(uint16_t bytes_written, uint32_t space_remaining);
+    // record a write to storage from the IO thread
+    void df_stats_io_gather(uint32_t bytes_written, uint32_t write_us);
     void df_stats_log();
     void df_stats_clear();
 
@@ -263,9 +273,20 @@ private:
         uint32_t buf_space_min;
         uint32_t buf_space_max;
         uint32_t buf_space_sigma;
+        uint32_t io_bytes;
+        uint16_t io_writes;
+        uint32_t io_us;
     };
     struct df_stats stats;
 
+#if HAL_LOGGER_COMPRESSION_ENABLED
+    // records are gathered into compressed blocks when enabled
+    AP_Logger_Compressor *compressor;
+    HAL_Semaphore compress_sem;
+    bool write_compressed(const void *pBuffer, uint16_t size, bool is_critical);
+    bool write_compressed_frame(bool is_critical);
+#endif
+
     uint32_t _last_periodic_1Hz;
     uint32_t _last_periodic_10Hz;
     bool have_logged_armed;
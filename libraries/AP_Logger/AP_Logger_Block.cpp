@@ -532,6 +532,8 @@ void AP_Logger_Block::stop_logging(void)
 // stop logging and flush any remaining data
 void AP_Logger_Block::stop_logging_async(void)
 {
+    // the partly filled compressed block is written with the rest
+    flush_compressed();
     stop_log_pending = true;
 }
 
@@ -920,7 +922,9 @@ void AP_Logger_Block::write_log_page()
     if (nbytes <  pagesize) {
         memset(&buffer[sizeof(ph) + nbytes], 0, pagesize - nbytes);
     }
+    const uint32_t write_start_us = AP_HAL::micros();
     FinishWrite();
+    df_stats_io_gather(df_PageSize, AP_HAL::micros() - write_start_us);
     df_Write_FilePage++;
 }
 
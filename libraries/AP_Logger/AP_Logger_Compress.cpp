@@ -0,0 +1,310 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_Logger_Compress.h"
+
+#if HAL_LOGGER_COMPRESSION_ENABLED
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <AP_Common/AP_Common.h>
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/crc.h>
+
+#include "LogStructure.h"
+
+// longest match and literal run in the compressed data
+#define LZ_MIN_MATCH 4
+#define LZ_MAX_MATCH (LZ_MIN_MATCH + 127)
+#define LZ_MAX_LITERALS 128
+
+// no position in the hash table
+#define LZ_NO_POS 0xFFFF
+
+static inline uint32_t get_u32(const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+static inline uint16_t get_u16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+AP_Logger_Compressor::~AP_Logger_Compressor()
+{
+    free(raw);
+    free(filtered);
+    free(out);
+    free(hash_table);
+}
+
+bool AP_Logger_Compressor::init(uint16_t _block_size)
+{
+    if (_block_size < LOG_PACKET_MAX_LEN || _block_size > 16384) {
+        return false;
+    }
+    block_size = _block_size;
+    raw = (uint8_t *)malloc(block_size);
+    filtered = (uint8_t *)malloc(block_size);
+    out = (uint8_t *)malloc(max_frame_size(block_size));
+    hash_table = (uint16_t *)malloc(HASH_SIZE * sizeof(uint16_t));
+    if (raw == nullptr || filtered == nullptr || out == nullptr || hash_table == nullptr) {
+        return false;
+    }
+    reset();
+    return true;
+}
+
+void AP_Logger_Compressor::reset()
+{
+    raw_len = 0;
+    filtered_len = 0;
+    out_len = 0;
+    memset(last_record, 0, sizeof(last_record));
+}
+
+/*
+  add a record to the block, storing its payload as the difference
+  from the last record of the same type and length if there is one
+ */
+bool AP_Logger_Compressor::add(const uint8_t *record, uint16_t len)
+{
+    if (out_len != 0 || raw_len + len > block_size) {
+        return false;
+    }
+    const uint8_t type = record[2];
+    const uint16_t payload_len = len - LOG_PACKET_HEADER_LEN;
+
+    uint8_t *f = &filtered[filtered_len];
+    f[0] = len;
+    f[1] = type;
+    const uint16_t prev = last_record[type];
+    if (prev != 0 && last_len[type] == len) {
+        const uint8_t *p = &raw[prev - 1 + LOG_PACKET_HEADER_LEN];
+        const uint8_t *r = &record[LOG_PACKET_HEADER_LEN];
+        for (uint16_t i = 0; i < payload_len; i++) {
+            f[2 + i] = r[i] - p[i];
+        }
+    } else {
+        memcpy(&f[2], &record[LOG_PACKET_HEADER_LEN], payload_len);
+    }
+    filtered_len += 2 + payload_len;
+
+    memcpy(&raw[raw_len], record, len);
+    last_record[type] = raw_len + 1;
+    last_len[type] = len;
+    raw_len += len;
+    return true;
+}
+
+const uint8_t *AP_Logger_Compressor::frame(uint16_t &len)
+{
+    if (out_len == 0 && raw_len != 0) {
+        out_len = compress();
+    }
+    len = out_len;
+    return out;
+}
+
+void AP_Logger_Compressor::release_frame()
+{
+    reset();
+}
+
+// append a literal run to dst, returning the new length
+static uint16_t emit_literals(uint8_t *dst, uint16_t o, const uint8_t *src, uint16_t n)
+{
+    while (n > 0) {
+        const uint16_t run = MIN(n, LZ_MAX_LITERALS);
+        dst[o++] = run - 1;
+        memcpy(&dst[o], src, run);
+        o += run;
+        src += run;
+        n -= run;
+    }
+    return o;
+}
+
+/*
+  greedy LZ compression of the filtered block into a frame, using
+  the most recent earlier position with the same 4 bytes
+ */
+uint16_t AP_Logger_Compressor::compress()
+{
+    for (uint16_t i = 0; i < HASH_SIZE; i++) {
+        hash_table[i] = LZ_NO_POS;
+    }
+
+    const uint8_t *src = filtered;
+    const uint16_t n = filtered_len;
+    uint8_t *dst = &out[LOG_COMPRESSED_HEADER_LEN];
+    uint16_t o = 0;
+    uint16_t lit_start = 0;
+    uint16_t i = 0;
+    while (i + LZ_MIN_MATCH <= n) {
+        const uint32_t v = get_u32(&src[i]);
+        const uint16_t h = (v * 2654435761U) >> 21;
+        const uint16_t cand = hash_table[h];
+        hash_table[h] = i;
+        if (cand == LZ_NO_POS || get_u32(&src[cand]) != v) {
+            i++;
+            continue;
+        }
+        const uint16_t max_len = MIN(n - i, LZ_MAX_MATCH);
+        uint16_t len = LZ_MIN_MATCH;
+        while (len < max_len && src[cand + len] == src[i + len]) {
+            len++;
+        }
+        o = emit_literals(dst, o, &src[lit_start], i - lit_start);
+        dst[o++] = 0x80 | (len - LZ_MIN_MATCH);
+        put_u16(&dst[o], i - cand);
+        o += 2;
+        i += len;
+        lit_start = i;
+    }
+    o = emit_literals(dst, o, &src[lit_start], n - lit_start);
+
+    out[0] = HEAD_BYTE1;
+    out[1] = LOG_COMPRESSED_HEAD_BYTE2;
+    put_u16(&out[2], o);
+    put_u16(&out[4], filtered_len);
+    put_u16(&out[6], raw_len);
+    put_u16(&out[8], crc16_ccitt(dst, o, 0));
+    return LOG_COMPRESSED_HEADER_LEN + o;
+}
+
+uint32_t AP_Logger_Decompressor::frame_length(const uint8_t *hdr)
+{
+    if (hdr[0] != HEAD_BYTE1 || hdr[1] != LOG_COMPRESSED_HEAD_BYTE2) {
+        return 0;
+    }
+    return LOG_COMPRESSED_HEADER_LEN + get_u16(&hdr[2]);
+}
+
+int32_t AP_Logger_Decompressor::decode(const uint8_t *frame, uint32_t len,
+                                       uint8_t *scratch, uint8_t *out, uint16_t &out_len)
+{
+    if (len < LOG_COMPRESSED_HEADER_LEN) {
+        return 0;
+    }
+    const uint32_t frame_len = frame_length(frame);
+    if (frame_len == 0) {
+        return -1;
+    }
+    if (len < frame_len) {
+        return 0;
+    }
+    const uint16_t comp_len = get_u16(&frame[2]);
+    const uint16_t filtered_len = get_u16(&frame[4]);
+    const uint16_t decoded_len = get_u16(&frame[6]);
+    const uint8_t *data = &frame[LOG_COMPRESSED_HEADER_LEN];
+    if (crc16_ccitt(data, comp_len, 0) != get_u16(&frame[8])) {
+        return -1;
+    }
+    if (!lz_decode(data, comp_len, scratch, filtered_len) ||
+        !unfilter(scratch, filtered_len, out, decoded_len)) {
+        return -1;
+    }
+    out_len = decoded_len;
+    return frame_len;
+}
+
+bool AP_Logger_Decompressor::lz_decode(const uint8_t *in, uint16_t in_len, uint8_t *out, uint16_t out_len)
+{
+    uint32_t i = 0;
+    uint32_t o = 0;
+    while (i < in_len) {
+        const uint8_t c = in[i++];
+        if (c < 0x80) {
+            const uint16_t run = c + 1;
+            if (i + run > in_len || o + run > out_len) {
+                return false;
+            }
+            memcpy(&out[o], &in[i], run);
+            i += run;
+            o += run;
+            continue;
+        }
+        if (i + 2 > in_len) {
+            return false;
+        }
+        const uint16_t len = (c & 0x7F) + LZ_MIN_MATCH;
+        const uint16_t ofs = get_u16(&in[i]);
+        i += 2;
+        if (ofs == 0 || ofs > o || o + len > out_len) {
+            return false;
+        }
+        // byte by byte as the match may overlap the output
+        for (uint16_t k = 0; k < len; k++, o++) {
+            out[o] = out[o - ofs];
+        }
+    }
+    return o == out_len;
+}
+
+/*
+  rebuild log records from the filtered block, reversing the
+  differences from earlier records of the same type and length
+ */
+bool AP_Logger_Decompressor::unfilter(const uint8_t *in, uint16_t in_len, uint8_t *out, uint16_t out_len)
+{
+    uint16_t last_record[256] {};
+    uint8_t last_len[256];
+    uint32_t i = 0;
+    uint32_t o = 0;
+    while (i < in_len) {
+        if (i + 2 > in_len) {
+            return false;
+        }
+        const uint8_t len = in[i];
+        const uint8_t type = in[i + 1];
+        if (len < LOG_PACKET_HEADER_LEN ||
+            i + len - 1 > in_len ||
+            o + len > out_len) {
+            return false;
+        }
+        const uint16_t payload_len = len - LOG_PACKET_HEADER_LEN;
+        uint8_t *r = &out[o];
+        r[0] = HEAD_BYTE1;
+        r[1] = HEAD_BYTE2;
+        r[2] = type;
+        const uint16_t prev = last_record[type];
+        if (prev != 0 && last_len[type] == len) {
+            const uint8_t *p = &out[prev - 1 + LOG_PACKET_HEADER_LEN];
+            for (uint16_t k = 0; k < payload_len; k++) {
+                r[LOG_PACKET_HEADER_LEN + k] = in[i + 2 + k] + p[k];
+            }
+        } else {
+            memcpy(&r[LOG_PACKET_HEADER_LEN], &in[i + 2], payload_len);
+        }
+        last_record[type] = o + 1;
+        last_len[type] = len;
+        i += 2 + payload_len;
+        o += len;
+    }
+    return o == out_len;
+}
+
+#endif // HAL_LOGGER_COMPRESSION_ENABLED
@@ -0,0 +1,130 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  block compression of the log stream
+
+  Log records are gathered into blocks of whole records, and each
+  block is written as a frame which can be decoded on its own, so a
+  truncated or damaged log is readable from the next good frame.
+
+  Within a block each record is stored as its length and message type
+  followed by its payload. If an earlier record in the block has the
+  same type and length the payload is stored as the bytewise
+  difference from that record, which turns timestamps and slowly
+  changing fields into short repeating patterns. The result is then
+  LZ compressed with matches limited to the block.
+
+  frame layout, all little endian:
+    HEAD_BYTE1, LOG_COMPRESSED_HEAD_BYTE2
+    uint16_t compressed length
+    uint16_t filtered length
+    uint16_t decoded length
+    uint16_t crc16_ccitt of the compressed data
+    compressed data
+
+  compressed data is a sequence of:
+    0x00-0x7F: a run of 1 to 128 literal bytes follows
+    0x80-0xFF: copy 4 to 131 bytes from a uint16_t offset back
+ */
+#pragma once
+
+#include "AP_Logger_config.h"
+
+#if HAL_LOGGER_COMPRESSION_ENABLED
+
+#include <stdint.h>
+
+// second header byte of a compressed frame. The first is HEAD_BYTE1
+#define LOG_COMPRESSED_HEAD_BYTE2 0x96
+#define LOG_COMPRESSED_HEADER_LEN 10
+
+class AP_Logger_Compressor
+{
+public:
+    ~AP_Logger_Compressor();
+
+    // allocate buffers for blocks of up to block_size bytes of records
+    bool init(uint16_t block_size);
+
+    // add a record to the current block. Returns false if the
+    // block is full or a frame is waiting to be written
+    bool add(const uint8_t *record, uint16_t len);
+
+    // true if there are no records in the current block
+    bool empty() const { return raw_len == 0; }
+
+    // compress the current block into a frame, if not already
+    // done. The block may not be added to until the frame is
+    // released
+    const uint8_t *frame(uint16_t &len);
+
+    // start a new block once the frame has been written
+    void release_frame();
+
+    // discard the current block and any pending frame
+    void reset();
+
+    // largest frame for a block of block_size bytes
+    static uint16_t max_frame_size(uint16_t block_size) {
+        return LOG_COMPRESSED_HEADER_LEN + block_size + block_size / 128 + 1;
+    }
+
+private:
+    uint16_t block_size;
+
+    // records of the current block as written
+    uint8_t *raw;
+    uint16_t raw_len;
+
+    // records of the current block after delta filtering
+    uint8_t *filtered;
+    uint16_t filtered_len;
+
+    // offset+1 and length of the last record of each message type in raw
+    uint16_t last_record[256];
+    uint8_t last_len[256];
+
+    // the current block as a frame
+    uint8_t *out;
+    uint16_t out_len;
+
+    // most recent position of each hash of 4 bytes
+    static const uint16_t HASH_SIZE = 2048;
+    uint16_t *hash_table;
+
+    uint16_t compress();
+};
+
+class AP_Logger_Decompressor
+{
+public:
+    /*
+      decode a frame into log records. Returns the number of bytes of
+      the frame consumed, 0 if more bytes are needed, or -1 if this
+      is not a valid frame. scratch must hold the filtered length and
+      out the decoded length, both at most 65535 bytes
+     */
+    static int32_t decode(const uint8_t *frame, uint32_t len,
+                          uint8_t *scratch, uint8_t *out, uint16_t &out_len);
+
+    // length of the frame given its header, or 0 if not a frame header
+    static uint32_t frame_length(const uint8_t *hdr);
+
+private:
+    static bool lz_decode(const uint8_t *in, uint16_t in_len, uint8_t *out, uint16_t out_len);
+    static bool unfilter(const uint8_t *in, uint16_t in_len, uint8_t *out, uint16_t out_len);
+};
+
+#endif // HAL_LOGGER_COMPRESSION_ENABLED
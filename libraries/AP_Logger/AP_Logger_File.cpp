@@ -416,7 +416,7 @@ void AP_Logger_File::EraseAll()
 
 bool AP_Logger_File::WritesOK() const
 {
-    if (_write_fd == -1) {
+    if (_write_fd == -1 || stop_log_pending) {
         return false;
     }
     if (recent_open_error()) {
@@ -439,6 +439,14 @@ bool AP_Logger_File::StartNewLogOK() const
     return AP_Logger_Backend::StartNewLogOK();
 }
 
+#if HAL_LOGGER_COMPRESSION_ENABLED
+uint16_t AP_Logger_File::compress_block_size() const
+{
+    // bit 0 of LOG_COMPRESS
+    return (_front._params.compress & (1U<<0)) ? 4096 : 0;
+}
+#endif
+
 /* Write a block of data at current offset */
 bool AP_Logger_File::_WritePrioritisedBlock(const void *pBuffer, uint16_t size, bool is_critical)
 {
@@ -718,11 +726,43 @@ void AP_Logger_File::stop_logging(void)
         _write_fd = -1;
         AP::FS().close(fd);
     }
+    stop_log_pending = false;
     if (have_sem) {
         write_fd_semaphore.give();
     }
 }
 
+/*
+  stop logging once the IO thread has written out the buffer
+ */
+void AP_Logger_File::stop_logging_async(void)
+{
+    if (_write_fd == -1) {
+        return;
+    }
+    // the partly filled compressed block goes out with the rest
+    flush_compressed();
+    stop_log_pending = true;
+}
+
+/*
+  finish any log the IO thread is still writing out before arming
+ */
+void AP_Logger_File::PrepForArming()
+{
+    if (stop_log_pending) {
+        // we wait for the new log to open below, so allow the same
+        // time for the last one to close
+        const uint32_t start_ms = AP_HAL::millis();
+        EXPECT_DELAY_MS(1000);
+        while (stop_log_pending && AP_HAL::millis() - start_ms < 1000) {
+            hal.scheduler->delay(1);
+        }
+        stop_logging();
+    }
+    AP_Logger_Backend::PrepForArming();
+}
+
 /*
   does start_new_log in the logger thread
  */
@@ -936,9 +976,14 @@ void AP_Logger_File::io_timer(void)
 
     uint32_t nbytes = _writebuf.available();
     if (nbytes == 0) {
+        if (stop_log_pending) {
+            // everything is written, we can close the file
+            stop_logging();
+        }
         return;
     }
-    if (nbytes < _writebuf_chunk && 
+    if (!stop_log_pending &&
+        nbytes < _writebuf_chunk && 
         tnow - _last_write_time < 2000UL) {
         // write in _writebuf_chunk-sized chunks, but always write at
         // least once per 2 seconds if data is available
@@ -960,14 +1005,17 @@ void AP_Logger_File::io_timer(void)
     }
 #endif
     _last_write_time = tnow;
-    if (nbytes > _writebuf_chunk) {
+    if (nbytes > _writebuf_batch) {
         // be kind to the filesystem layer
-        nbytes = _writebuf_chunk;
+        nbytes = _writebuf_batch;
     }
 
+#if !HAL_LOGGER_FILE_WRITEV_ENABLED
+    // only write the contiguous part at the read pointer
     uint32_t size;
     const uint8_t *head = _writebuf.readptr(size);
     nbytes = MIN(nbytes, size);
+#endif
 
 #if !AP_FILESYSTEM_LITTLEFS_ENABLED
     // try to align writes on a 512 byte boundary to avoid filesystem reads
@@ -992,7 +1040,20 @@ void AP_Logger_File::io_timer(void)
         nbytes = bytes_until_fsync; // write exactly enough to sync
     }
 
+    const uint32_t write_start_us = AP_HAL::micros();
+#if HAL_LOGGER_FILE_WRITEV_ENABLED
+    // write straight from both parts of the ring buffer
+    ByteBuffer::IoVec vec[2];
+    const uint8_t n_vec = _writebuf.peekiovec(vec, nbytes);
+    FileIOVec iov[2];
+    for (uint8_t i=0; i<n_vec; i++) {
+        iov[i].data = vec[i].data;
+        iov[i].len = vec[i].len;
+    }
+    ssize_t nwritten = AP::FS().writev(_write_fd, iov, n_vec);
+#else
     ssize_t nwritten = AP::FS().write(_write_fd, head, nbytes);
+#endif
     last_io_operation = "";
     if (nwritten <= 0) {
         if (errno == ENOSPC) {
@@ -1016,6 +1077,7 @@ void AP_Logger_File::io_timer(void)
         _last_write_ms = tnow;
         _write_offset += nwritten;
         _writebuf.advance(nwritten);
+        df_stats_io_gather(nwritten, AP_HAL::micros() - write_start_us);
 
         // we know nwritten > 0 so we won't sync if bytes_until_fsync == 0
         if ((uint32_t)nwritten == bytes_until_fsync) {
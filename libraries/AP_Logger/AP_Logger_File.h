@@ -23,6 +23,17 @@
 #endif
 #endif
 
+// largest single write from the IO thread. Writes are still only
+// started once HAL_LOGGER_WRITE_CHUNK_SIZE bytes are buffered, but a
+// backlog is written in one go
+#ifndef HAL_LOGGER_WRITE_BATCH_SIZE
+#if HAL_LOGGER_FILE_WRITEV_ENABLED
+#define HAL_LOGGER_WRITE_BATCH_SIZE (16 * HAL_LOGGER_WRITE_CHUNK_SIZE)
+#else
+#define HAL_LOGGER_WRITE_BATCH_SIZE HAL_LOGGER_WRITE_CHUNK_SIZE
+#endif
+#endif
+
 class AP_Logger_File : public AP_Logger_Backend
 {
 public:
@@ -66,12 +77,17 @@ public:
     bool logging_failed() const override;
 
     bool logging_started(void) const override { return _write_fd != -1; }
+    void stop_logging_async(void) override;
     void io_timer(void) override;
+    void PrepForArming() override;
 
 protected:
 
     bool WritesOK() const override;
     bool StartNewLogOK() const override;
+#if HAL_LOGGER_COMPRESSION_ENABLED
+    uint16_t compress_block_size() const override;
+#endif
     void PrepForArming_start_logging() override;
 
 private:
@@ -114,6 +130,7 @@ private:
     // write buffer
     ByteBuffer _writebuf{0};
     const uint16_t _writebuf_chunk = HAL_LOGGER_WRITE_CHUNK_SIZE;
+    const uint32_t _writebuf_batch = HAL_LOGGER_WRITE_BATCH_SIZE;
     uint32_t _last_write_time;
 
     /* construct a file name given a log number. Caller must free. */
@@ -158,6 +175,8 @@ private:
     const char *last_io_operation = "";
 
     bool start_new_log_pending;
+    // the IO thread closes the file once the buffer is written out
+    bool stop_log_pending;
 };
 
 #endif // HAL_LOGGING_FILESYSTEM_ENABLED
@@ -129,6 +129,15 @@ bool AP_Logger_MAVLink::WritesOK() const
 /* Write a block of data at current offset */
 
 // DM_write: 70734 events, 0 overruns, 167806us elapsed, 2us avg, min 1us max 34us 0.620us rms
+#if HAL_LOGGER_COMPRESSION_ENABLED
+uint16_t AP_Logger_MAVLink::compress_block_size() const
+{
+    // bit 1 of LOG_COMPRESS. Small blocks so that a whole frame fits
+    // in the free blocks
+    return (_front._params.compress & (1U<<1)) ? 1024 : 0;
+}
+#endif
+
 bool AP_Logger_MAVLink::_WritePrioritisedBlock(const void *pBuffer, uint16_t size, bool is_critical)
 {
     if (!semaphore.take_nonblocking()) {
@@ -220,6 +229,8 @@ void AP_Logger_MAVLink::free_all_blocks()
 void AP_Logger_MAVLink::stop_logging()
 {
     if (_sending_to_client) {
+        // send the partly filled compressed block before the client goes
+        flush_compressed();
         _sending_to_client = false;
         _last_response_time = AP_HAL::millis();
     }
@@ -543,6 +554,8 @@ void AP_Logger_MAVLink::periodic_1Hz()
         rate_limiter = NEW_NOTHROW AP_Logger_RateLimiter(_front, _front._params.mav_ratemax, _front._params.disarm_ratemax);
     }
 
+    flush_compressed();
+
     if (_sending_to_client &&
         _last_response_time + 10000 < _last_send_time) {
         // other end appears to have timed out!
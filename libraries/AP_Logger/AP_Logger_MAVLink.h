@@ -60,6 +60,9 @@ protected:
 
     void push_log_blocks() override;
     bool WritesOK() const override;
+#if HAL_LOGGER_COMPRESSION_ENABLED
+    uint16_t compress_block_size() const override;
+#endif
 
 private:
 
@@ -47,6 +47,17 @@
 
 #endif
 
+// write the file backend's buffer in large batches with writev(),
+// including across the end of the ring buffer
+#ifndef HAL_LOGGER_FILE_WRITEV_ENABLED
+#define HAL_LOGGER_FILE_WRITEV_ENABLED (HAL_LOGGING_FILESYSTEM_ENABLED && (CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX))
+#endif
+
+// optional block compression of the file and mavlink log streams
+#ifndef HAL_LOGGER_COMPRESSION_ENABLED
+#define HAL_LOGGER_COMPRESSION_ENABLED ((HAL_LOGGING_FILESYSTEM_ENABLED || HAL_LOGGING_MAVLINK_ENABLED) && HAL_PROGRAM_SIZE_LIMIT_KB > 1024)
+#endif
+
 #ifndef HAL_LOGGER_FILE_CONTENTS_ENABLED
 #define HAL_LOGGER_FILE_CONTENTS_ENABLED HAL_LOGGING_FILESYSTEM_ENABLED && !AP_FILESYSTEM_LITTLEFS_ENABLED
 #endif
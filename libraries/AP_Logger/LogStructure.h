@@ -233,6 +233,9 @@ struct PACKED log_DSF {
     uint32_t buf_space_min;
     uint32_t buf_space_max;
     uint32_t buf_space_avg;
+    uint32_t io_bytes;
+    uint16_t io_writes;
+    uint32_t io_us;
 };
 
 struct PACKED log_Event {
@@ -326,6 +329,25 @@ struct PACKED log_MAV {
     uint32_t GCS_SYSID_last_seen_ms;
 };
 
+struct PACKED log_MAVSched {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t chan;
+    uint16_t sent;
+    uint32_t sched_us;
+    uint16_t sched_max_us;
+};
+
+struct PACKED log_MAVRoute {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t chan;
+    uint16_t forwarded;
+    uint16_t no_space;
+    uint8_t num_routes;
+    uint16_t evictions;
+};
+
 struct PACKED log_RSSI {
     LOG_PACKET_HEADER;
     uint64_t time_us;
@@ -557,6 +579,29 @@ struct PACKED log_Performance {
     uint64_t rtc;
 };
 
+struct PACKED log_TaskHist {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t task_index;
+    uint32_t count;
+    uint16_t p50_us;
+    uint16_t p99_us;
+    uint16_t p999_us;
+    uint16_t max_us;
+    char name[16];
+};
+
+struct PACKED log_SchedDeadline {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint32_t predicted_us;
+    uint32_t actual_us;
+    uint16_t max_error_us;
+    uint16_t run;
+    uint16_t skipped;
+    uint16_t forced;
+};
+
 struct PACKED log_SRTL {
     LOG_PACKET_HEADER;
     uint64_t time_us;
@@ -731,6 +776,9 @@ struct PACKED log_VER {
 // @Field: FMn: Minimum free space in write buffer in last time period
 // @Field: FMx: Maximum free space in write buffer in last time period
 // @Field: FAv: Average free space in write buffer in last time period
+// @Field: WrB: Bytes written to storage in last time period
+// @Field: WrN: Number of writes to storage in last time period
+// @Field: WrT: Time spent writing to storage in last time period
 
 // @LoggerMessage: ERR
 // @Description: Specifically coded error messages
@@ -782,6 +830,23 @@ struct PACKED log_VER {
 // @Field: tf: times buffer was full when a message was going to be sent
 // @Field: mgs: time MAV_GCS_SYSID heartbeat (or manual control) last seen
 
+// @LoggerMessage: MAVS
+// @Description: GCS MAVLink deferred message scheduler statistics since the last MAVS message
+// @Field: TimeUS: Time since system startup
+// @Field: chan: mavlink channel number
+// @Field: sent: number of scheduled messages sent
+// @Field: sch: time spent scheduling messages, excluding the time spent sending them
+// @Field: schM: longest time spent scheduling messages in a single update
+
+// @LoggerMessage: MAVR
+// @Description: GCS MAVLink routing statistics since the last MAVR message
+// @Field: TimeUS: Time since system startup
+// @Field: chan: mavlink channel number
+// @Field: fwd: number of messages forwarded onto this channel
+// @Field: fnsp: number of messages not forwarded onto this channel because there was no space
+// @Field: nr: number of learned routes
+// @Field: ev: total number of routes replaced because the routing table was full
+
 // @LoggerMessage: MAVC
 // @Description: MAVLink command we have just executed
 // @Field: TimeUS: Time since system startup
@@ -887,6 +952,27 @@ struct PACKED log_VER {
 // @Field: Ex: number of microseconds being added to each loop to address scheduler overruns
 // @Field: R: RTC time, time since Unix epoch
 
+// @LoggerMessage: TSKH
+// @Description: Scheduler task latency histogram summary, enabled with SCHED_OPTIONS
+// @Field: TimeUS: Time since system startup
+// @Field: TI: task index within the scheduler task list
+// @Field: N: number of task runs in the histogram
+// @Field: P50: upper bound of the histogram bucket holding the median task run time
+// @Field: P99: upper bound of the histogram bucket holding the 99th percentile task run time
+// @Field: P999: upper bound of the histogram bucket holding the 99.9th percentile task run time
+// @Field: Max: upper bound of the highest non-empty histogram bucket
+// @Field: Name: task name
+
+// @LoggerMessage: SCHD
+// @Description: Scheduler deadline mode budget use, enabled with SCHED_OPTIONS
+// @Field: TimeUS: Time since system startup
+// @Field: Pred: total predicted run time of tasks run by the deadline scheduler
+// @Field: Act: total actual run time of tasks run by the deadline scheduler
+// @Field: MaxE: largest amount by which a task exceeded its predicted run time
+// @Field: NRun: number of tasks run by the deadline scheduler
+// @Field: NSkip: number of due tasks skipped as their predicted run time did not fit
+// @Field: NForce: number of tasks run over budget as they reached the maximum slowdown
+
 // @LoggerMessage: POWR
 // @Description: System power information
 // @Field: TimeUS: Time since system startup
@@ -1206,6 +1292,10 @@ LOG_RTC_MESSAGE \
     LOG_STRUCTURE_FROM_PROXIMITY                                    \
     { LOG_PERFORMANCE_MSG, sizeof(log_Performance),                     \
       "PM",  "QHHHIIHHIIIIIIQ", "TimeUS,LR,NLon,NL,MaxT,Mem,Load,ErrL,InE,ErC,SPIC,I2CC,I2CI,Ex,R", "sz---b%------ss", "F----0A------FF" }, \
+    { LOG_TASK_HIST_MSG, sizeof(log_TaskHist),                          \
+      "TSKH", "QBIHHHHN", "TimeUS,TI,N,P50,P99,P999,Max,Name", "s#-ssss-", "F--FFFF-" }, \
+    { LOG_SCHED_DEADLINE_MSG, sizeof(log_SchedDeadline),                \
+      "SCHD", "QIIHHHH", "TimeUS,Pred,Act,MaxE,NRun,NSkip,NForce", "ssss---", "FFFF---" }, \
     { LOG_SRTL_MSG, sizeof(log_SRTL), \
       "SRTL", "QBHHBfff", "TimeUS,Active,NumPts,MaxPts,Action,N,E,D", "s----mmm", "F----000" }, \
 LOG_STRUCTURE_FROM_AVOIDANCE \
@@ -1243,11 +1333,15 @@ LOG_STRUCTURE_FROM_HAL \
 LOG_STRUCTURE_FROM_RPM \
 LOG_STRUCTURE_FROM_FENCE \
     { LOG_DF_FILE_STATS, sizeof(log_DSF), \
-      "DSF", "QIHIIII", "TimeUS,Dp,Blk,Bytes,FMn,FMx,FAv", "s--b---", "F--0---" }, \
+      "DSF", "QIHIIIIIHI", "TimeUS,Dp,Blk,Bytes,FMn,FMx,FAv,WrB,WrN,WrT", "s--b---b-s", "F--0---0-F" }, \
     { LOG_RALLY_MSG, sizeof(log_Rally), \
       "RALY", "QBBLLhB", "TimeUS,Tot,Seq,Lat,Lng,Alt,Flags", "s--DUm-", "F--GG0-" },  \
     { LOG_MAV_MSG, sizeof(log_MAV),   \
       "MAV", "QBHHHBHHI",   "TimeUS,chan,txp,rxp,rxdp,flags,ss,tf,mgs", "s#----s-s", "F-000-C-C" },   \
+    { LOG_MAV_SCHED_MSG, sizeof(log_MAVSched),   \
+      "MAVS", "QBHIH",   "TimeUS,chan,sent,sch,schM", "s#-ss", "F--FF" },   \
+    { LOG_MAV_ROUTE_MSG, sizeof(log_MAVRoute),   \
+      "MAVR", "QBHHBH",   "TimeUS,chan,fwd,fnsp,nr,ev", "s#----", "F-----" },   \
 LOG_STRUCTURE_FROM_VISUALODOM \
     { LOG_OPTFLOW_MSG, sizeof(log_Optflow), \
       "OF",   "QBffff",   "TimeUS,Qual,flowX,flowY,bodyX,bodyY", "s-EEEE", "F-0000" , true }, \
@@ -1369,6 +1463,10 @@ enum LogMessages : uint8_t {
     LOG_RCOUT3_MSG,
     LOG_IDS_FROM_FENCE,
     LOG_IDS_FROM_HAL,
+    LOG_TASK_HIST_MSG,
+    LOG_SCHED_DEADLINE_MSG,
+    LOG_MAV_SCHED_MSG,
+    LOG_MAV_ROUTE_MSG,
 
     _LOG_LAST_MSG_
 };
@@ -30,6 +30,7 @@ static const struct LogStructure log_structure[] = {
 };
 
 #define NUM_PACKETS 500
+#define THROUGHPUT_BYTES (16*1024*1024U)
 
 static uint16_t log_num;
 
@@ -97,6 +98,44 @@ void AP_LoggerTest::setup(void)
     hal.console->printf("Average write time %.1f usec/byte\n", 
                        (double)total_micros/((double)i*sizeof(struct log_Test)));
 
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+    // write as fast as the backend will accept, giving the IO thread
+    // a chance to run every 4k
+    hal.console->printf("Testing throughput\n");
+    const uint32_t dropped_start = logger.num_dropped();
+    const uint32_t start_ms = AP_HAL::millis();
+    uint32_t offered = 0;
+    total_micros = 0;
+    while (offered < THROUGHPUT_BYTES) {
+        uint32_t start = AP_HAL::micros();
+        struct log_Test pkt = {
+            LOG_PACKET_HEADER_INIT(LOG_TEST_MSG),
+            v1    : (uint16_t)offered,
+            v2    : 0,
+            v3    : 0,
+            v4    : 0,
+            l1    : (int32_t)offered,
+            l2    : 0
+        };
+        logger.WriteBlock(&pkt, sizeof(pkt));
+        total_micros += AP_HAL::micros() - start;
+        offered += sizeof(pkt);
+        if (offered % 4096 < sizeof(pkt)) {
+            hal.scheduler->delay_microseconds(100);
+        }
+    }
+    logger.flush();
+    const uint32_t elapsed_ms = MAX(AP_HAL::millis() - start_ms, 1U);
+    const uint32_t dropped = logger.num_dropped() - dropped_start;
+    const uint32_t accepted = offered - dropped * sizeof(struct log_Test);
+    hal.console->printf("Wrote %u bytes in %u ms: %.0f bytes/s, %.1f ms writer CPU per MB, %u dropped\n",
+                        (unsigned)accepted,
+                        (unsigned)elapsed_ms,
+                        accepted * 1000.0 / elapsed_ms,
+                        total_micros * 1.0e-3 / (accepted * 1.0e-6),
+                        (unsigned)dropped);
+#endif
+
     uint64_t now = AP_HAL::micros64();
     hal.console->printf("Testing Write\n");
     logger.Write("MARY",
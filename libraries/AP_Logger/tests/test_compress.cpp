@@ -0,0 +1,111 @@
+#include <AP_gtest.h>
+
+#include <AP_Logger/AP_Logger_Compress.h>
+#include <AP_Logger/LogStructure.h>
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+#if HAL_LOGGER_COMPRESSION_ENABLED
+
+static const uint16_t block_size = 4096;
+
+// an IMU-like record with a timestamp and slowly changing values
+static uint16_t make_record(uint8_t *rec, uint32_t n)
+{
+    rec[0] = HEAD_BYTE1;
+    rec[1] = HEAD_BYTE2;
+    const uint64_t time_us = 1000000 + n * 400;
+    if (n % 5 == 4) {
+        // a second type with a different length
+        rec[2] = 20;
+        memcpy(&rec[3], &time_us, sizeof(time_us));
+        for (uint8_t i = 11; i < 40; i++) {
+            rec[i] = n % 7 + i;
+        }
+        return 40;
+    }
+    rec[2] = 10;
+    memcpy(&rec[3], &time_us, sizeof(time_us));
+    for (uint8_t i = 0; i < 6; i++) {
+        const float v = sinf(time_us * 1.0e-6 * (i + 1));
+        memcpy(&rec[11 + i * 4], &v, sizeof(v));
+    }
+    return 35;
+}
+
+/*
+  records compressed into frames decode back to the same records
+ */
+TEST(LoggerCompress, RoundTrip)
+{
+    AP_Logger_Compressor *compressor = NEW_NOTHROW AP_Logger_Compressor();
+    ASSERT_TRUE(compressor->init(block_size));
+
+    const uint32_t num_records = 5000;
+    uint8_t *input = (uint8_t *)malloc(num_records * 40);
+    uint8_t *frames = (uint8_t *)malloc(num_records * 40);
+    uint32_t input_len = 0;
+    uint32_t frames_len = 0;
+    uint32_t num_frames = 0;
+
+    for (uint32_t n = 0; n < num_records; n++) {
+        uint8_t *rec = &input[input_len];
+        const uint16_t len = make_record(rec, n);
+        input_len += len;
+        if (compressor->add(rec, len)) {
+            continue;
+        }
+        uint16_t frame_len;
+        const uint8_t *frame = compressor->frame(frame_len);
+        EXPECT_LE(frame_len, AP_Logger_Compressor::max_frame_size(block_size));
+        memcpy(&frames[frames_len], frame, frame_len);
+        frames_len += frame_len;
+        num_frames++;
+        compressor->release_frame();
+        ASSERT_TRUE(compressor->add(rec, len));
+    }
+    uint16_t frame_len;
+    const uint8_t *frame = compressor->frame(frame_len);
+    memcpy(&frames[frames_len], frame, frame_len);
+    frames_len += frame_len;
+    num_frames++;
+
+    // the timestamps and repeated fields shrink well, the floats less so
+    EXPECT_LT(frames_len, input_len * 3 / 4);
+
+    uint8_t *scratch = (uint8_t *)malloc(UINT16_MAX);
+    uint8_t *decoded = (uint8_t *)malloc(UINT16_MAX);
+    uint32_t ofs = 0;
+    uint32_t decoded_total = 0;
+    for (uint32_t i = 0; i < num_frames; i++) {
+        uint16_t decoded_len;
+        const int32_t ret = AP_Logger_Decompressor::decode(&frames[ofs], frames_len - ofs, scratch, decoded, decoded_len);
+        ASSERT_GT(ret, 0);
+        EXPECT_EQ(memcmp(decoded, &input[decoded_total], decoded_len), 0);
+        ofs += ret;
+        decoded_total += decoded_len;
+    }
+    EXPECT_EQ(ofs, frames_len);
+    EXPECT_EQ(decoded_total, input_len);
+
+    // a damaged frame is rejected without affecting the next
+    const uint32_t first_len = AP_Logger_Decompressor::frame_length(frames);
+    frames[first_len / 2] ^= 0x55;
+    uint16_t decoded_len;
+    EXPECT_EQ(AP_Logger_Decompressor::decode(frames, frames_len, scratch, decoded, decoded_len), -1);
+    EXPECT_GT(AP_Logger_Decompressor::decode(&frames[first_len], frames_len - first_len, scratch, decoded, decoded_len), 0);
+
+    // a partial frame needs more data
+    EXPECT_EQ(AP_Logger_Decompressor::decode(&frames[first_len], 20, scratch, decoded, decoded_len), 0);
+
+    free(scratch);
+    free(decoded);
+    free(input);
+    free(frames);
+    delete compressor;
+}
+
+#endif // HAL_LOGGER_COMPRESSION_ENABLED
+
+AP_GTEST_MAIN()
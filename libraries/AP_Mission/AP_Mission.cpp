@@ -46,6 +46,15 @@ const AP_Param::GroupInfo AP_Mission::var_info[] = {
     // @User: Advanced
     AP_GROUPINFO("OPTIONS",  2, AP_Mission, _options, AP_MISSION_OPTIONS_DEFAULT),
 
+    // @Param: CACHE_SZ
+    // @DisplayName: Mission command cache size
+    // @Description: Number of decoded mission commands kept in memory to speed up reading the mission. If the mission has no more commands than this the whole mission is cached, otherwise the most recently used commands are kept. 0 disables the cache
+    // @Range: 0 5000
+    // @Increment: 1
+    // @User: Advanced
+    // @RebootRequired: True
+    AP_GROUPINFO("CACHE_SZ",  3, AP_Mission, _cache_size, AP_MISSION_CACHE_SIZE_DEFAULT),
+
     AP_GROUPEND
 };
 
@@ -87,6 +96,7 @@ void AP_Mission::init()
         _cmd_total.set(0);
     }
 
+    init_cache();
 
     // check_eeprom_version - checks version of missions stored in eeprom matches this library
     // command list will be cleared if they do not match
@@ -545,12 +555,17 @@ bool AP_Mission::replace_cmd(uint16_t index, const Mission_Command& cmd)
 
 /// is_nav_cmd - returns true if the command's id is a "navigation" command, false if "do" or "conditional" command
 bool AP_Mission::is_nav_cmd(const Mission_Command& cmd)
+{
+    return is_nav_cmd_id(cmd.id);
+}
+
+bool AP_Mission::is_nav_cmd_id(uint16_t id)
 {
     // NAV commands all have ids below MAV_CMD_NAV_LAST, plus some exceptions
-    return (cmd.id <= MAV_CMD_NAV_LAST ||
-            cmd.id == MAV_CMD_NAV_SET_YAW_SPEED ||
-            cmd.id == MAV_CMD_NAV_SCRIPT_TIME ||
-            cmd.id == MAV_CMD_NAV_ATTITUDE_TIME);
+    return (id <= MAV_CMD_NAV_LAST ||
+            id == MAV_CMD_NAV_SET_YAW_SPEED ||
+            id == MAV_CMD_NAV_SCRIPT_TIME ||
+            id == MAV_CMD_NAV_ATTITUDE_TIME);
 }
 
 /// get_next_nav_cmd - gets next "navigation" command found at or after start_index
@@ -558,8 +573,9 @@ bool AP_Mission::is_nav_cmd(const Mission_Command& cmd)
 ///     accounts for do_jump commands but never increments the jump's num_times_run (advance_current_nav_cmd is responsible for this)
 bool AP_Mission::get_next_nav_cmd(uint16_t start_index, Mission_Command& cmd)
 {
-    // search until the end of the mission command list
-    for (uint16_t cmd_index = start_index; cmd_index < (unsigned)_cmd_total; cmd_index++) {
+    // search until the end of the mission command list, skipping
+    // plain "do" commands which can't lead to a nav command
+    for (uint16_t cmd_index = next_stop(start_index); cmd_index < (unsigned)_cmd_total; cmd_index = next_stop(cmd_index+1)) {
         // get next command
         if (!get_next_cmd(cmd_index, cmd, false)) {
             // no more commands so return failure
@@ -839,6 +855,10 @@ bool AP_Mission::read_cmd_from_storage(uint16_t index, Mission_Command& cmd) con
         return false;
     }
 
+    if (cache_read(index, cmd)) {
+        return true;
+    }
+
     // ensure all bytes of cmd are zeroed
     cmd = {};
 
@@ -897,6 +917,8 @@ bool AP_Mission::read_cmd_from_storage(uint16_t index, Mission_Command& cmd) con
     // set command's index to it's position in eeprom
     cmd.index = index;
 
+    cache_store(cmd);
+
     // return success
     return true;
 }
@@ -968,6 +990,8 @@ bool AP_Mission::write_cmd_to_storage(uint16_t index, const Mission_Command& cmd
         memcpy(packed.bytes, &cmd.content, 12);
     }
 
+    cache_invalidate(index);
+
     // calculate where in storage the command should be placed
     uint16_t pos_in_storage = 4 + (index * AP_MISSION_EEPROM_COMMAND_SIZE);
 
@@ -2349,7 +2373,7 @@ bool AP_Mission::jump_to_tag(const uint16_t tag)
 uint16_t AP_Mission::get_index_of_jump_tag(const uint16_t tag) const
 {
     const auto count = num_commands();
-    for (uint16_t i = 1; i < count; i++) {
+    for (uint16_t i = next_marker(1); i < count; i = next_marker(i+1)) {
         if (get_command_id(i) != uint16_t(MAV_CMD_JUMP_TAG)) {
             continue;
         }
@@ -2469,7 +2493,7 @@ uint16_t AP_Mission::get_landing_sequence_start(const Location &current_loc)
 
     // Go through mission looking for nearest landing start command
     const auto count = num_commands();
-    for (uint16_t i = 1; i < count; i++) {
+    for (uint16_t i = next_marker(1); i < count; i = next_marker(i+1)) {
         if (get_command_id(i) != uint16_t(MAV_CMD_DO_LAND_START)) {
             continue;
         }
@@ -2541,7 +2565,7 @@ bool AP_Mission::jump_to_closest_mission_leg(const Location &current_loc)
     uint16_t search_remaining = 1000;
 
     // Go through mission and check each DO_RETURN_PATH_START
-    for (uint16_t i = 1; i < num_commands(); i++) {
+    for (uint16_t i = next_marker(1); i < num_commands(); i = next_marker(i+1)) {
         if (get_command_id(i) == uint16_t(MAV_CMD_DO_RETURN_PATH_START)) {
             uint16_t tmp_index;
             float tmp_distance;
@@ -2579,7 +2603,7 @@ bool AP_Mission::jump_to_abort_landing_sequence(const Location &current_loc)
     float min_distance = FLT_MAX;
 
     const auto count = num_commands();
-    for (uint16_t i = 1; i < count; i++) {
+    for (uint16_t i = next_marker(1); i < count; i = next_marker(i+1)) {
         if (get_command_id(i) != uint16_t(MAV_CMD_DO_GO_AROUND)) {
             continue;
         }
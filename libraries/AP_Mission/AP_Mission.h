@@ -34,6 +34,18 @@
 #endif
 #endif
 
+#ifndef AP_MISSION_CACHE_SIZE_DEFAULT
+#if HAL_MEM_CLASS >= HAL_MEM_CLASS_500
+#define AP_MISSION_CACHE_SIZE_DEFAULT       64      // cache the most recently used commands, or whole short missions
+#else
+#define AP_MISSION_CACHE_SIZE_DEFAULT       16
+#endif
+#endif
+
+#ifndef AP_MISSION_CACHE_WAYS
+#define AP_MISSION_CACHE_WAYS               4       // entries checked per lookup when the whole mission isn't cached
+#endif
+
 #define AP_MISSION_JUMP_REPEAT_FOREVER      -1      // when do-jump command's repeat count is -1 this means endless repeat
 
 #define AP_MISSION_CMD_ID_NONE              0       // mavlink cmd id of zero means invalid or missing command
@@ -61,6 +73,7 @@ union PackedContent;
 /// @brief    Object managing Mission
 class AP_Mission
 {
+    friend class AP_Mission_Test;
 
 public:
     // jump command structure
@@ -586,6 +599,7 @@ public:
 
     /// is_nav_cmd - returns true if the command's id is a "navigation" command, false if "do" or "conditional" command
     static bool is_nav_cmd(const Mission_Command& cmd);
+    static bool is_nav_cmd_id(uint16_t id);
 
     // check if command is a takeoff type command.
     bool is_takeoff_type_cmd(uint16_t id) const;
@@ -931,6 +945,7 @@ private:
     AP_Int16                _cmd_total;  // total number of commands in the mission
     AP_Int16                _options;    // bitmask options for missions, currently for mission clearing on reboot but can be expanded as required
     AP_Int8                 _restart;   // controls mission starting point when entering Auto mode (either restart from beginning of mission or resume from last command run)
+    AP_Int16                _cache_size; // number of decoded commands to keep in memory
 
     // internal variables
     bool                    _force_resume;  // when set true it forces mission to resume irrespective of MIS_RESTART param.
@@ -969,6 +984,37 @@ private:
     // const functions
     static HAL_Semaphore _rsem;
 
+    // decoded command cache, see AP_Mission_Cache.cpp
+    struct CacheEntry {
+        Mission_Command cmd;        // cmd.index is AP_MISSION_CMD_INDEX_NONE if the entry is empty
+        uint32_t last_used;
+    };
+    CacheEntry *_cache;
+    uint16_t _cache_entries;
+    mutable uint32_t _cache_counter;
+    mutable bool _cache_direct;     // true if the cache is indexed by command index
+    void init_cache();
+    CacheEntry *cache_set(uint16_t index, uint16_t &ways) const;
+    CacheEntry *cache_find(uint16_t index) const;
+    bool cache_read(uint16_t index, Mission_Command &cmd) const;
+    void cache_store(const Mission_Command &cmd) const;
+    void cache_invalidate(uint16_t index);
+
+    // positions of the commands that searches of the mission stop at
+    mutable struct {
+        uint16_t *buffer;           // stops followed by markers
+        uint16_t capacity;
+        uint16_t num_stops;         // nav and jump commands
+        uint16_t num_markers;       // landing, go around, return path and jump tag commands
+        uint16_t count;             // number of commands when the index was built
+        bool valid;
+    } _index;
+    static bool is_index_stop(uint16_t id);
+    static bool is_index_marker(uint16_t id);
+    bool update_index() const;
+    uint16_t next_stop(uint16_t index) const;
+    uint16_t next_marker(uint16_t index) const;
+
     // mission items common to all vehicles:
     bool start_command_do_aux_function(const AP_Mission::Mission_Command& cmd);
     bool start_command_do_gripper(const AP_Mission::Mission_Command& cmd);
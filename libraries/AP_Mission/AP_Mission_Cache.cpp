@@ -0,0 +1,278 @@
+/// @file    AP_Mission_Cache.cpp
+/// @brief   Decoded command cache and command index for AP_Mission
+
+/*
+  Commands are decoded from storage on every read, and look-ahead,
+  DO_JUMP resolution and landing sequence searches read the same
+  commands many times over. Decoded commands are kept in a cache of
+  MIS_CACHE_SZ entries, indexed directly by command index when the
+  whole mission fits. Otherwise the entries are grouped into small
+  sets, a command can only be held in the set chosen by its index,
+  and the least recently used entry of that set is replaced, so a
+  lookup only checks one set.
+
+  The positions of the commands the mission searches for are kept in
+  an index rebuilt from the command IDs after any change, so those
+  searches only visit the commands they are looking for.
+ */
+
+#include "AP_Mission_config.h"
+
+#if AP_MISSION_ENABLED
+
+#include "AP_Mission.h"
+
+/*
+  allocate the command cache. Called from init() once _commands_max
+  is known
+ */
+void AP_Mission::init_cache()
+{
+    const uint16_t entries = MIN(uint16_t(MAX(_cache_size.get(), 0)), _commands_max);
+    if (entries == 0) {
+        return;
+    }
+    _cache = NEW_NOTHROW CacheEntry[entries];
+    if (_cache == nullptr) {
+        return;
+    }
+    for (uint16_t i=0; i<entries; i++) {
+        _cache[i].cmd.index = AP_MISSION_CMD_INDEX_NONE;
+    }
+    _cache_entries = entries;
+}
+
+/*
+  return the first entry of the set which may hold index when the
+  cache isn't direct, and the number of entries in the set
+ */
+AP_Mission::CacheEntry *AP_Mission::cache_set(uint16_t index, uint16_t &ways) const
+{
+    ways = MIN(_cache_entries, uint16_t(AP_MISSION_CACHE_WAYS));
+    const uint16_t num_sets = _cache_entries / ways;
+    return &_cache[(index % num_sets) * ways];
+}
+
+/*
+  return the cache entry holding index, or nullptr
+ */
+AP_Mission::CacheEntry *AP_Mission::cache_find(uint16_t index) const
+{
+    if (_cache_direct) {
+        CacheEntry &e = _cache[index];
+        return e.cmd.index == index ? &e : nullptr;
+    }
+    uint16_t ways;
+    CacheEntry *set = cache_set(index, ways);
+    for (uint16_t i=0; i<ways; i++) {
+        if (set[i].cmd.index == index) {
+            return &set[i];
+        }
+    }
+    return nullptr;
+}
+
+/*
+  fill cmd from the cache, returns false on a miss. Caller holds _rsem
+  and has checked index is in the mission
+ */
+bool AP_Mission::cache_read(uint16_t index, Mission_Command &cmd) const
+{
+    if (_cache_entries == 0) {
+        return false;
+    }
+    const bool direct = _cmd_total <= _cache_entries;
+    if (direct != _cache_direct) {
+        // entries are placed differently in the two modes
+        for (uint16_t i=0; i<_cache_entries; i++) {
+            _cache[i].cmd.index = AP_MISSION_CMD_INDEX_NONE;
+        }
+        _cache_direct = direct;
+        return false;
+    }
+    CacheEntry *e = cache_find(index);
+    if (e == nullptr) {
+        return false;
+    }
+    e->last_used = ++_cache_counter;
+    // copy all bytes, as Mission_Command comparisons use memcmp
+    memcpy((void *)&cmd, (const void *)&e->cmd, sizeof(cmd));
+    return true;
+}
+
+/*
+  add a freshly decoded command to the cache. Caller holds _rsem
+ */
+void AP_Mission::cache_store(const Mission_Command &cmd) const
+{
+    if (_cache_entries == 0) {
+        return;
+    }
+    CacheEntry *e;
+    if (_cache_direct) {
+        e = &_cache[cmd.index];
+    } else {
+        // replace the least recently used entry of the command's set
+        uint16_t ways;
+        CacheEntry *set = cache_set(cmd.index, ways);
+        e = &set[0];
+        for (uint16_t i=1; i<ways && e->cmd.index != AP_MISSION_CMD_INDEX_NONE; i++) {
+            if (set[i].cmd.index == AP_MISSION_CMD_INDEX_NONE ||
+                _cache_counter - set[i].last_used > _cache_counter - e->last_used) {
+                e = &set[i];
+            }
+        }
+    }
+    memcpy((void *)&e->cmd, (const void *)&cmd, sizeof(cmd));
+    e->last_used = ++_cache_counter;
+}
+
+/*
+  forget a command which is about to be overwritten in storage
+ */
+void AP_Mission::cache_invalidate(uint16_t index)
+{
+    if (index == 0) {
+        // home is neither cached nor indexed
+        return;
+    }
+
+    WITH_SEMAPHORE(_rsem);
+
+    _index.valid = false;
+    if (_cache_entries == 0) {
+        return;
+    }
+    if (_cache_direct) {
+        if (index < _cache_entries) {
+            _cache[index].cmd.index = AP_MISSION_CMD_INDEX_NONE;
+        }
+        return;
+    }
+    CacheEntry *e = cache_find(index);
+    if (e != nullptr) {
+        e->cmd.index = AP_MISSION_CMD_INDEX_NONE;
+    }
+}
+
+/*
+  commands the mission search functions stop at
+ */
+bool AP_Mission::is_index_stop(uint16_t id)
+{
+    return is_nav_cmd_id(id) ||
+        id == MAV_CMD_DO_JUMP ||
+        id == MAV_CMD_DO_JUMP_TAG;
+}
+
+bool AP_Mission::is_index_marker(uint16_t id)
+{
+    switch (id) {
+    case MAV_CMD_DO_LAND_START:
+    case MAV_CMD_DO_GO_AROUND:
+    case MAV_CMD_DO_RETURN_PATH_START:
+    case MAV_CMD_JUMP_TAG:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*
+  rebuild the command index if the mission has changed since it was
+  built. Returns false if there is no memory for the index
+ */
+bool AP_Mission::update_index() const
+{
+    const uint16_t count = num_commands();
+    if (_index.valid && _index.count == count) {
+        return true;
+    }
+
+    // count first so the index is allocated at its final size
+    uint16_t num_stops = 0;
+    uint16_t num_markers = 0;
+    for (uint16_t i=1; i<count; i++) {
+        const uint16_t id = get_command_id(i);
+        num_stops += is_index_stop(id);
+        num_markers += is_index_marker(id);
+    }
+    const uint16_t needed = num_stops + num_markers;
+    if (needed > _index.capacity) {
+        delete[] _index.buffer;
+        _index.buffer = NEW_NOTHROW uint16_t[needed];
+        if (_index.buffer == nullptr) {
+            _index.capacity = 0;
+            _index.valid = false;
+            return false;
+        }
+        _index.capacity = needed;
+    }
+
+    // stops, then markers, each in ascending order
+    uint16_t *stop = _index.buffer;
+    uint16_t *marker = &_index.buffer[num_stops];
+    for (uint16_t i=1; i<count; i++) {
+        const uint16_t id = get_command_id(i);
+        if (is_index_stop(id)) {
+            *stop++ = i;
+        }
+        if (is_index_marker(id)) {
+            *marker++ = i;
+        }
+    }
+    _index.num_stops = num_stops;
+    _index.num_markers = num_markers;
+    _index.count = count;
+    _index.valid = true;
+    return true;
+}
+
+// return the first entry of the ascending list which is at or after index
+static uint16_t index_search(const uint16_t *list, uint16_t len, uint16_t index, uint16_t end)
+{
+    uint16_t lo = 0;
+    uint16_t hi = len;
+    while (lo < hi) {
+        const uint16_t mid = (lo + hi) / 2;
+        if (list[mid] < index) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < len ? list[lo] : end;
+}
+
+/*
+  return the index of the first nav or jump command at or after
+  index, or num_commands() if there is none. Commands in between are
+  plain "do" commands which a nav command search can skip
+ */
+uint16_t AP_Mission::next_stop(uint16_t index) const
+{
+    WITH_SEMAPHORE(_rsem);
+
+    if (index == 0 || !update_index()) {
+        // home is a nav command, and without an index we visit every command
+        return index;
+    }
+    return index_search(_index.buffer, _index.num_stops, index, num_commands());
+}
+
+/*
+  return the index of the first DO_LAND_START, DO_GO_AROUND,
+  DO_RETURN_PATH_START or JUMP_TAG command at or after index, or
+  num_commands() if there is none
+ */
+uint16_t AP_Mission::next_marker(uint16_t index) const
+{
+    WITH_SEMAPHORE(_rsem);
+
+    if (!update_index()) {
+        return index;
+    }
+    return index_search(&_index.buffer[_index.num_stops], _index.num_markers, index, num_commands());
+}
+
+#endif  // AP_MISSION_ENABLED
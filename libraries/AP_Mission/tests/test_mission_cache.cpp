@@ -0,0 +1,275 @@
+/*
+  check the decoded command cache and the command index against
+  reading the mission straight from storage
+ */
+#include <AP_gtest.h>
+
+#include <AP_Mission/AP_Mission.h>
+
+#include <string.h>
+#include <vector>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+#if AP_MISSION_ENABLED
+
+class AP_Mission_Test {
+public:
+    static constexpr uint16_t commands_max = 100;
+    static constexpr uint16_t num_cmds = 40;
+
+    bool start_command(const AP_Mission::Mission_Command& cmd) { return false; }
+    bool verify_command(const AP_Mission::Mission_Command& cmd) { return false; }
+    void exit_mission() {}
+
+    AP_Mission mission{
+        FUNCTOR_BIND_MEMBER(&AP_Mission_Test::start_command, bool, const AP_Mission::Mission_Command &),
+        FUNCTOR_BIND_MEMBER(&AP_Mission_Test::verify_command, bool, const AP_Mission::Mission_Command &),
+        FUNCTOR_BIND_MEMBER(&AP_Mission_Test::exit_mission, void)};
+
+    // commands as read back with the cache disabled
+    std::vector<AP_Mission::Mission_Command> expected;
+
+    // AP_Mission is a singleton, so all the tests share one
+    static AP_Mission_Test &get()
+    {
+        static AP_Mission_Test *t;
+        if (t == nullptr) {
+            t = NEW_NOTHROW AP_Mission_Test();
+            t->mission._commands_max = commands_max;
+        }
+        return *t;
+    }
+
+    // a mix of nav, do, jump and landing sequence commands
+    static AP_Mission::Mission_Command make_cmd(uint16_t index, uint16_t id)
+    {
+        AP_Mission::Mission_Command cmd {};
+        cmd.index = index;
+        cmd.id = id;
+        switch (id) {
+        case MAV_CMD_DO_JUMP:
+            cmd.content.jump.target = index / 2 + 1;
+            cmd.content.jump.num_times = 2;
+            break;
+        case MAV_CMD_JUMP_TAG:
+        case MAV_CMD_DO_JUMP_TAG:
+            cmd.content.jump.target = index;
+            break;
+        case MAV_CMD_DO_CHANGE_SPEED:
+            cmd.content.speed.speed_type = 1;
+            cmd.content.speed.target_ms = index;
+            break;
+        default:
+            cmd.content.location.lat = -353000000 + index * 1000;
+            cmd.content.location.lng = 1491000000 - index * 1000;
+            cmd.content.location.alt = index * 100;
+            break;
+        }
+        return cmd;
+    }
+
+    static uint16_t pick_id(uint16_t index)
+    {
+        if (index % 7 == 3) {
+            return MAV_CMD_DO_JUMP;
+        }
+        if (index % 11 == 5) {
+            return MAV_CMD_DO_LAND_START;
+        }
+        if (index % 13 == 4) {
+            return MAV_CMD_JUMP_TAG;
+        }
+        if (index % 17 == 8) {
+            return MAV_CMD_DO_JUMP_TAG;
+        }
+        if (index % 3 == 0) {
+            return MAV_CMD_DO_CHANGE_SPEED;
+        }
+        return MAV_CMD_NAV_WAYPOINT;
+    }
+
+    bool read_uncached(uint16_t index, AP_Mission::Mission_Command &cmd)
+    {
+        const uint16_t entries = mission._cache_entries;
+        mission._cache_entries = 0;
+        const bool ret = mission.read_cmd_from_storage(index, cmd);
+        mission._cache_entries = entries;
+        return ret;
+    }
+
+    // write the command to storage and remember how it reads back
+    void write(uint16_t index, uint16_t id)
+    {
+        ASSERT_TRUE(mission.write_cmd_to_storage(index, make_cmd(index, id)));
+        ASSERT_TRUE(read_uncached(index, expected[index]));
+        EXPECT_EQ(expected[index].id, id);
+    }
+
+    void write_mission()
+    {
+        expected.resize(num_cmds);
+        mission._cmd_total.set(num_cmds);
+        for (uint16_t i=1; i<num_cmds; i++) {
+            write(i, pick_id(i));
+        }
+    }
+
+    void set_cache_size(uint16_t size)
+    {
+        delete[] mission._cache;
+        mission._cache = nullptr;
+        mission._cache_entries = 0;
+        mission._cache_direct = false;
+        mission._cache_size.set(size);
+        mission.init_cache();
+        ASSERT_EQ(mission._cache_entries, size);
+    }
+
+    // read through the cache and check we get what storage holds
+    void check_read(uint16_t index)
+    {
+        AP_Mission::Mission_Command cmd;
+        ASSERT_TRUE(mission.read_cmd_from_storage(index, cmd));
+        EXPECT_TRUE(cmd == expected[index]) << "index " << index;
+        EXPECT_NE(mission.cache_find(index), nullptr) << "index " << index;
+    }
+
+    bool cached(uint16_t index) const
+    {
+        return mission.cache_find(index) != nullptr;
+    }
+
+    bool direct() const
+    {
+        return mission._cache_direct;
+    }
+
+    uint16_t next_stop(uint16_t index) const
+    {
+        return mission.next_stop(index);
+    }
+
+    uint16_t next_marker(uint16_t index) const
+    {
+        return mission.next_marker(index);
+    }
+
+    // the ids of the whole mission, as it was written
+    uint16_t id_at(uint16_t index) const
+    {
+        return expected[index].id;
+    }
+};
+
+// when the whole mission fits, every command stays cached
+TEST(AP_Mission, cache_direct)
+{
+    AP_Mission_Test &t = AP_Mission_Test::get();
+    t.write_mission();
+    t.set_cache_size(64);
+
+    for (uint8_t pass=0; pass<2; pass++) {
+        for (uint16_t i=AP_Mission_Test::num_cmds-1; i>0; i--) {
+            t.check_read(i);
+        }
+    }
+    EXPECT_TRUE(t.direct());
+    for (uint16_t i=1; i<AP_Mission_Test::num_cmds; i++) {
+        EXPECT_TRUE(t.cached(i)) << "index " << i;
+    }
+}
+
+// otherwise each set keeps its most recently used commands
+TEST(AP_Mission, cache_set_associative)
+{
+    AP_Mission_Test &t = AP_Mission_Test::get();
+    t.write_mission();
+    // two sets of AP_MISSION_CACHE_WAYS entries
+    const uint16_t num_sets = 2;
+    t.set_cache_size(num_sets * AP_MISSION_CACHE_WAYS);
+
+    for (uint16_t i=1; i<AP_Mission_Test::num_cmds; i++) {
+        t.check_read(i);
+    }
+    EXPECT_FALSE(t.direct());
+    for (uint16_t i=1; i<AP_Mission_Test::num_cmds; i++) {
+        // the last AP_MISSION_CACHE_WAYS commands read in each set
+        const bool recent = i + num_sets * AP_MISSION_CACHE_WAYS >= AP_Mission_Test::num_cmds;
+        EXPECT_EQ(t.cached(i), recent) << "index " << i;
+    }
+
+    // refreshing the oldest entry of a set makes the next oldest the
+    // one to go
+    const uint16_t last = AP_Mission_Test::num_cmds - 1;
+    const uint16_t oldest = last - (AP_MISSION_CACHE_WAYS - 1) * num_sets;
+    t.check_read(oldest);
+    t.check_read(last % num_sets + num_sets);
+    EXPECT_TRUE(t.cached(oldest));
+    EXPECT_FALSE(t.cached(oldest + num_sets));
+    for (uint16_t i=oldest + 2*num_sets; i<=last; i+=num_sets) {
+        EXPECT_TRUE(t.cached(i)) << "index " << i;
+    }
+}
+
+// a command written to storage is never read back stale from the cache
+TEST(AP_Mission, cache_invalidate)
+{
+    AP_Mission_Test &t = AP_Mission_Test::get();
+    for (const uint16_t size : { 64, 2 * AP_MISSION_CACHE_WAYS }) {
+        t.write_mission();
+        t.set_cache_size(size);
+        for (uint16_t i=1; i<AP_Mission_Test::num_cmds; i++) {
+            t.check_read(i);
+        }
+        for (uint16_t i=AP_Mission_Test::num_cmds-1; i>AP_Mission_Test::num_cmds-6; i--) {
+            const uint16_t id = t.id_at(i) == MAV_CMD_NAV_WAYPOINT ? MAV_CMD_DO_LAND_START : MAV_CMD_NAV_WAYPOINT;
+            t.write(i, id);
+            EXPECT_FALSE(t.cached(i)) << "index " << i;
+            t.check_read(i);
+        }
+    }
+}
+
+// the indexed searches stop at the same commands as a linear scan
+TEST(AP_Mission, index)
+{
+    AP_Mission_Test &t = AP_Mission_Test::get();
+    t.write_mission();
+    t.set_cache_size(0);
+
+    for (uint8_t pass=0; pass<2; pass++) {
+        const uint16_t count = AP_Mission_Test::num_cmds;
+        for (uint16_t i=1; i<=count; i++) {
+            uint16_t stop = i;
+            while (stop < count &&
+                   !AP_Mission::is_nav_cmd_id(t.id_at(stop)) &&
+                   t.id_at(stop) != MAV_CMD_DO_JUMP &&
+                   t.id_at(stop) != MAV_CMD_DO_JUMP_TAG) {
+                stop++;
+            }
+            EXPECT_EQ(t.next_stop(i), stop) << "index " << i;
+
+            uint16_t marker = i;
+            while (marker < count &&
+                   t.id_at(marker) != MAV_CMD_DO_LAND_START &&
+                   t.id_at(marker) != MAV_CMD_DO_GO_AROUND &&
+                   t.id_at(marker) != MAV_CMD_DO_RETURN_PATH_START &&
+                   t.id_at(marker) != MAV_CMD_JUMP_TAG) {
+                marker++;
+            }
+            EXPECT_EQ(t.next_marker(i), marker) << "index " << i;
+        }
+        EXPECT_EQ(t.next_stop(0), 0);
+
+        // the index is rebuilt when commands change
+        t.write(2, MAV_CMD_DO_GO_AROUND);
+        t.write(10, MAV_CMD_DO_RETURN_PATH_START);
+        t.write(12, MAV_CMD_DO_CHANGE_SPEED);
+        t.write(37, MAV_CMD_DO_CHANGE_SPEED);
+    }
+}
+
+#endif // AP_MISSION_ENABLED
+
+AP_GTEST_MAIN()
@@ -765,8 +765,8 @@ const AP_Param::GroupInfo NavEKF3::var_info2[] = {
 
     // @Param: OPTIONS
     // @DisplayName: Optional EKF behaviour
-    // @Description: EKF optional behaviour. Bit 0 (JammingExpected): Setting JammingExpected will change the EKF behaviour such that if dead reckoning navigation is possible it will require the preflight alignment GPS quality checks controlled by EK3_GPS_CHECK and EK3_CHECK_SCALE to pass before resuming GPS use if GPS lock is lost for more than 2 seconds to prevent bad position estimate. Bit 1 (Manual lane switching): DANGEROUS – If enabled, this disables automatic lane switching. If the active lane becomes unhealthy, no automatic switching will occur. Users must manually set EK3_PRIMARY to change lanes. No health checks will be performed on the selected lane. Use with extreme caution.  Bit 2 (Optflow may use terrain alt): Terrain SRTM data will be used if the vehicle climbs above the rangefinder's range allowing optical flow to be used at higher altitudes. Bit 3 (AGL KF for optflow scaling): Use a 2-state IMU-aided AGL Kalman filter (height + vertical velocity, fused with rangefinder) to compute the height-above-ground used for optical flow velocity scaling, instead of terrainState-pd. This decouples optical flow scaling from errors in the main filter's vertical position state.
-    // @Bitmask: 0:JammingExpected, 1:ManualLaneSwitching, 2:Optflow may use terrain alt, 3:AGL KF for optflow scaling
+    // @Description: EKF optional behaviour. Bit 0 (JammingExpected): Setting JammingExpected will change the EKF behaviour such that if dead reckoning navigation is possible it will require the preflight alignment GPS quality checks controlled by EK3_GPS_CHECK and EK3_CHECK_SCALE to pass before resuming GPS use if GPS lock is lost for more than 2 seconds to prevent bad position estimate. Bit 1 (Manual lane switching): DANGEROUS – If enabled, this disables automatic lane switching. If the active lane becomes unhealthy, no automatic switching will occur. Users must manually set EK3_PRIMARY to change lanes. No health checks will be performed on the selected lane. Use with extreme caution.  Bit 2 (Optflow may use terrain alt): Terrain SRTM data will be used if the vehicle climbs above the rangefinder's range allowing optical flow to be used at higher altitudes. Bit 3 (AGL KF for optflow scaling): Use a 2-state IMU-aided AGL Kalman filter (height + vertical velocity, fused with rangefinder) to compute the height-above-ground used for optical flow velocity scaling, instead of terrainState-pd. This decouples optical flow scaling from errors in the main filter's vertical position state. Bit 4 (Parallel lanes): On multi-core Linux boards the lanes are updated concurrently on worker threads. The common EKF origin is then published after all lanes have updated, in lane order, which gives the same result whether or not the lanes actually ran concurrently so that Replay matches.
+    // @Bitmask: 0:JammingExpected, 1:ManualLaneSwitching, 2:Optflow may use terrain alt, 3:AGL KF for optflow scaling, 4:Parallel lanes
     // @User: Advanced
     AP_GROUPINFO("OPTIONS",  11, NavEKF3, _options, 0),
 
@@ -929,6 +929,18 @@ bool NavEKF3::coreBetterScore(uint8_t new_core, uint8_t current_core) const
     return coreRelativeErrors[new_core] < coreRelativeErrors[current_core];
 }
 
+/*
+  if we have not overrun by more than 3 IMU frames, and we have
+  already used more than 1/3 of the CPU budget for this loop then
+  suppress the prediction step. This allows multiple EKF instances to
+  cooperate on scheduling
+ */
+bool NavEKF3::allow_state_prediction(uint8_t i)
+{
+    return core[i].getFramesSincePredict() >= (_framesPerPrediction+3) ||
+        !dal.ekf_low_time_remaining(AP_DAL::EKFType::EKF3, i);
+}
+
 /* 
   Update Filter States - this should be called whenever new IMU data is available
   Execution speed governed by SCHED_LOOP_RATE
@@ -943,17 +955,41 @@ void NavEKF3::UpdateFilter(void)
 
     imuSampleTime_us = dal.micros64();
 
-    for (uint8_t i=0; i<num_cores; i++) {
-        // if we have not overrun by more than 3 IMU frames, and we
-        // have already used more than 1/3 of the CPU budget for this
-        // loop then suppress the prediction step. This allows
-        // multiple EKF instances to cooperate on scheduling
-        bool allow_state_prediction = true;
-        if (core[i].getFramesSincePredict() < (_framesPerPrediction+3) &&
-            dal.ekf_low_time_remaining(AP_DAL::EKFType::EKF3, i)) {
-            allow_state_prediction = false;
+#if EK3_FEATURE_PARALLEL_LANES
+    const bool parallel_lanes = option_is_enabled(Option::ParallelLanes);
+    if (parallel_lanes && num_cores > 1 && lane_workers == nullptr && !lane_workers_failed) {
+        start_lane_workers();
+    }
+    if (parallel_lanes && num_lane_workers > 0) {
+        // the lanes run at the same time, so each decides against the
+        // time left before any of them run. The workers take lanes 1
+        // to num_lane_workers, and every (num_lane_workers+1)th lane
+        // after that. The main thread takes the rest
+        for (uint8_t i=0; i<num_cores; i++) {
+            allowStatePrediction[i] = allow_state_prediction(i);
+        }
+        for (uint8_t w=0; w<num_lane_workers; w++) {
+            lane_workers[w].start.signal();
+        }
+        for (uint8_t i=0; i<num_cores; i += num_lane_workers+1) {
+            core[i].UpdateFilter(allowStatePrediction[i]);
+        }
+        for (uint8_t w=0; w<num_lane_workers; w++) {
+            lane_workers[w].done.wait_blocking();
+        }
+    } else
+#endif
+    {
+        for (uint8_t i=0; i<num_cores; i++) {
+            core[i].UpdateFilter(allow_state_prediction(i));
         }
-        core[i].UpdateFilter(allow_state_prediction);
+    }
+
+    // with ParallelLanes set the lanes only share their origin once
+    // all have updated, so the result doesn't depend on the order
+    // they ran in
+    for (uint8_t i=0; i<num_cores; i++) {
+        core[i].publishPendingOrigin();
     }
 
     // If the current core selected has a bad error score or is unhealthy, switch to a healthy core with the lowest fault score
@@ -1890,6 +1926,59 @@ void NavEKF3::convert_parameters()
     }
 }
 
+#if EK3_FEATURE_PARALLEL_LANES
+/*
+  create the worker threads used to run lanes concurrently. There is
+  one worker per lane beyond the first, with the first lane run by
+  the main thread
+ */
+void NavEKF3::start_lane_workers(void)
+{
+    const uint8_t nworkers = num_cores - 1;
+    lane_workers = NEW_NOTHROW LaneWorker[nworkers];
+    if (lane_workers == nullptr) {
+        lane_workers_failed = true;
+        return;
+    }
+    for (uint8_t w=0; w<nworkers; w++) {
+        if (!hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&NavEKF3::lane_worker_thread, void),
+                                          "EKF3lane", 16384, AP_HAL::Scheduler::PRIORITY_MAIN, 0)) {
+            break;
+        }
+        num_lane_workers++;
+    }
+    if (num_lane_workers == 0) {
+        lane_workers_failed = true;
+    }
+    GCS_SEND_TEXT(MAV_SEVERITY_INFO, "EKF3 running %u lanes on %u threads",
+                  unsigned(num_cores), unsigned(num_lane_workers+1));
+}
+
+/*
+  worker thread for running lanes concurrently
+ */
+void NavEKF3::lane_worker_thread(void)
+{
+    uint8_t w;
+    {
+        WITH_SEMAPHORE(lane_worker_sem);
+        w = lane_workers_claimed++;
+    }
+
+    // keep the main thread on the first CPU to itself
+    hal.scheduler->set_thread_affinity(w+1);
+
+    LaneWorker &worker = lane_workers[w];
+    while (true) {
+        worker.start.wait_blocking();
+        for (uint8_t i=w+1; i<num_cores; i += num_lane_workers+1) {
+            core[i].UpdateFilter(allowStatePrediction[i]);
+        }
+        worker.done.signal();
+    }
+}
+#endif // EK3_FEATURE_PARALLEL_LANES
+
 // Set to true if the terrain underneath is stable enough to be used as a height reference
 // in combination with a range finder. Set to false if the terrain underneath the vehicle
 // cannot be used as a height reference. Use to prevent range finder operation otherwise
@@ -20,11 +20,14 @@
 #pragma once
 
 #include <AP_Common/Location.h>
+#include <AP_HAL/Semaphores.h>
 #include <AP_Math/AP_Math.h>
 #include <AP_Param/AP_Param.h>
 #include <AP_NavEKF/AP_Nav_Common.h>
 #include <AP_NavEKF/AP_NavEKF_Source.h>
 
+#include "AP_NavEKF3_feature.h"
+
 class NavEKF3_core;
 class EKFGSF_yaw;
 
@@ -476,6 +479,7 @@ private:
         ManualLaneSwitch        = (1<<1),
         OptflowMayUseTerrainAlt = (1<<2),
         AglKfForOptflow         = (1<<3),  // Use IMU-aided 2-state AGL KF for optflow scaling
+        ParallelLanes           = (1<<4),  // run lanes concurrently where supported
     };
     bool option_is_enabled(Option option) const {
         return (_options & (uint32_t)option) != 0;
@@ -558,6 +562,26 @@ private:
     // origin set by one of the cores
     Location common_EKF_origin;
     bool common_origin_valid;
+
+#if EK3_FEATURE_PARALLEL_LANES
+    // worker threads which run lanes concurrently with the main thread
+    struct LaneWorker {
+        HAL_BinarySemaphore start;
+        HAL_BinarySemaphore done;
+    } *lane_workers;
+    uint8_t num_lane_workers;       // number of worker threads created
+    uint8_t lane_workers_claimed;   // number of worker threads which have claimed an index
+    bool lane_workers_failed;       // true if the workers could not be allocated
+    HAL_Semaphore lane_worker_sem;
+
+    bool allowStatePrediction[MAX_EKF_CORES];       // per-lane prediction permission for this frame
+
+    void start_lane_workers(void);
+    void lane_worker_thread(void);
+#endif
+
+    // true if a lane may run its prediction step this frame
+    bool allow_state_prediction(uint8_t i);
     
     // update the yaw reset data to capture changes due to a lane switch
     // new_primary - index of the ekf instance that we are about to switch to as the primary
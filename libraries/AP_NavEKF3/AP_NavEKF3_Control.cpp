@@ -716,15 +716,32 @@ bool NavEKF3_core::setOriginLLH(const Location &loc)
     GCS_SEND_TEXT(MAV_SEVERITY_INFO, "EKF3 IMU%u origin set",(unsigned)imu_index);
 
     if (!frontend->common_origin_valid) {
-        frontend->common_origin_valid = true;
-        // put origin in frontend as well to ensure it stays in sync between lanes
-        public_origin = EKF_origin;
+        if (frontend->option_is_enabled(NavEKF3::Option::ParallelLanes)) {
+            // other lanes may be running concurrently, so the
+            // frontend publishes the origin once they have finished
+            pendingCommonOrigin = true;
+        } else {
+            frontend->common_origin_valid = true;
+            // put origin in frontend as well to ensure it stays in sync between lanes
+            public_origin = EKF_origin;
+        }
     }
 
 
     return true;
 }
 
+// publish an origin set while lanes may have been running concurrently
+void NavEKF3_core::publishPendingOrigin(void)
+{
+    if (pendingCommonOrigin && !frontend->common_origin_valid) {
+        frontend->common_origin_valid = true;
+        // put origin in frontend as well to ensure it stays in sync between lanes
+        public_origin = EKF_origin;
+    }
+    pendingCommonOrigin = false;
+}
+
 // record all requested yaw resets completed
 void NavEKF3_core::recordYawResetsCompleted()
 {
@@ -227,6 +227,10 @@ public:
     // returns false if the origin has already been set
     bool setOriginLLH(const Location &loc);
 
+    // publish an origin set while lanes may have been running
+    // concurrently. Called by the frontend for each lane in order
+    void publishPendingOrigin(void);
+
     // Set the EKF's NE horizontal position states and their corresponding variances from a supplied WGS-84 location and uncertainty
     // The altitude element of the location is not used.
     // Returns true if the set was successful
@@ -488,6 +492,9 @@ public:
     bool isStatesInitialised(void) const { return statesInitialised; }
 
 private:
+    // allow the covariance prediction benchmark to set up filter state
+    friend class NavEKF3_core_benchmark;
+
     EKFGSF_yaw *yawEstimator;
     AP_DAL &dal;
 
@@ -500,6 +507,13 @@ private:
     uint8_t imu_buffer_length;
     uint8_t obs_buffer_length;
 
+#if EK3_FEATURE_PARALLEL_LANES
+    // per-core scratch space, hiding the static copies shared by all
+    // cores in NavEKF_core_common, as lanes may be updated concurrently
+    Matrix24 KHP;
+    Vector28 Kfusion;
+#endif
+
 #if MATH_CHECK_INDEXES
     class Vector9 : public VectorN<ftype, 9> {
     public:
@@ -1190,6 +1204,7 @@ private:
     Location EKF_origin;     // LLH origin of the NED axis system, internal only
     Location &public_origin; // LLH origin of the NED axis system, public functions
     bool validOrigin;               // true when the EKF origin is valid
+    bool pendingCommonOrigin;       // true when our origin is waiting to be published as the common origin
     ftype gpsSpdAccuracy;           // estimated speed accuracy in m/s returned by the GPS receiver
     ftype gpsPosAccuracy;           // estimated position accuracy in m returned by the GPS receiver
     ftype gpsHgtAccuracy;           // estimated height accuracy in m returned by the GPS receiver
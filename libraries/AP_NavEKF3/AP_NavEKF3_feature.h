@@ -68,3 +68,8 @@
 #if EK3_FEATURE_MOVING_BASELINE && !(AP_GPS_MB_YAW_OFFSET_ENABLED)
 #error "EK3_FEATURE_MOVING_BASELINE requires AP_GPS_MB_YAW_OFFSET_ENABLED"
 #endif
+
+// allow the per-lane core updates to run concurrently on worker threads
+#ifndef EK3_FEATURE_PARALLEL_LANES
+#define EK3_FEATURE_PARALLEL_LANES (CONFIG_HAL_BOARD == HAL_BOARD_LINUX)
+#endif
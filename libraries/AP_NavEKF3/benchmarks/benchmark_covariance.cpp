@@ -0,0 +1,97 @@
+/*
+  benchmark of the EKF3 covariance prediction, run for each core on
+  every IMU update. The argument selects which states are being
+  learned, matching common vehicle configurations
+ */
+#include <AP_gbenchmark.h>
+
+#include <AP_NavEKF3/AP_NavEKF3.h>
+#include <AP_NavEKF3/AP_NavEKF3_core.h>
+#include <AP_DAL/AP_DAL.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+static NavEKF3 ekf3;
+
+class NavEKF3_core_benchmark {
+public:
+    enum StateSet {
+        ALL_STATES = 0,      // 3D mag and wind learning
+        NO_MAG_STATES = 1,   // wind learning, e.g. plane without 3D mag
+        NO_WIND_STATES = 2,  // 3D mag learning, no wind, e.g. copter
+        IMU_BIAS_ONLY = 3,   // only IMU bias states
+    };
+
+    static void setup(NavEKF3_core &core, StateSet states)
+    {
+        core.dtEkfAvg = EKF_TARGET_DT;
+        core.stateStruct.quat.from_euler(0.1, -0.05, 1.0);
+        core.imuDataDelayed.delAng = Vector3F(0.001, 0.002, -0.001);
+        core.imuDataDelayed.delVel = Vector3F(0.01, -0.02, -GRAVITY_MSS * EKF_TARGET_DT);
+        core.imuDataDelayed.delAngDT = EKF_TARGET_DT;
+        core.imuDataDelayed.delVelDT = EKF_TARGET_DT;
+
+        core.onGround = false;
+        core.windStateIsObservable = true;
+        core.treatWindStatesAsTruth = false;
+        core.inhibitDelAngBiasStates = false;
+        core.inhibitDelVelBiasStates = false;
+        core.inhibitMagStates = (states == NO_MAG_STATES || states == IMU_BIAS_ONLY);
+        core.inhibitWindStates = (states == NO_WIND_STATES || states == IMU_BIAS_ONLY);
+        core.lastInhibitMagStates = core.inhibitMagStates;
+        core.updateStateIndexLim();
+
+        // diagonal starting covariance, then a few predictions to
+        // fill in the correlations
+        memset(&core.P[0][0], 0, sizeof(core.P));
+        for (uint8_t i=0; i<=3; i++) {
+            core.P[i][i] = sq(0.1);
+        }
+        for (uint8_t i=4; i<=6; i++) {
+            core.P[i][i] = sq(0.5);
+        }
+        for (uint8_t i=7; i<=9; i++) {
+            core.P[i][i] = sq(2.0);
+        }
+        for (uint8_t i=10; i<=12; i++) {
+            core.P[i][i] = sq(radians(0.1 * EKF_TARGET_DT));
+        }
+        for (uint8_t i=13; i<=15; i++) {
+            core.P[i][i] = sq(0.1 * EKF_TARGET_DT);
+        }
+        if (!core.inhibitMagStates) {
+            for (uint8_t i=16; i<=21; i++) {
+                core.P[i][i] = sq(0.05);
+            }
+        }
+        if (!core.inhibitWindStates) {
+            core.P[22][22] = core.P[23][23] = sq(2.0);
+        }
+        for (uint8_t i=0; i<10; i++) {
+            predict(core);
+        }
+    }
+
+    static void predict(NavEKF3_core &core)
+    {
+        core.CovariancePrediction(nullptr);
+    }
+};
+
+static void BM_CovariancePrediction(benchmark::State& state)
+{
+    NavEKF3_core *core = NEW_NOTHROW NavEKF3_core(&ekf3, AP::dal());
+    NavEKF3_core_benchmark::setup(*core, NavEKF3_core_benchmark::StateSet(state.range(0)));
+
+    while (state.KeepRunning()) {
+        NavEKF3_core_benchmark::predict(*core);
+        gbenchmark_escape(core);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    delete core;
+}
+
+BENCHMARK(BM_CovariancePrediction)->DenseRange(0, 3);
+
+BENCHMARK_MAIN();
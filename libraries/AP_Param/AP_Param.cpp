@@ -25,6 +25,7 @@
 
 #include <cmath>
 #include <string.h>
+#include <ctype.h>
 
 #include <AP_Common/AP_Common.h>
 #include <AP_HAL/AP_HAL.h>
@@ -103,6 +104,10 @@ uint16_t AP_Param::_parameter_count;
 uint16_t AP_Param::_count_marker;
 uint16_t AP_Param::_count_marker_done;
 HAL_Semaphore AP_Param::_count_sem;
+#if AP_PARAM_NAME_INDEX_ENABLED
+AP_Param::NameIndex AP_Param::_name_index;
+HAL_Semaphore AP_Param::_name_index_sem;
+#endif
 
 // storage and naming information about all types that can be saved
 const AP_Param::Info *AP_Param::_var_info;
@@ -936,6 +941,31 @@ AP_Param::find_group(const char *name, uint16_t vindex, ptrdiff_t group_offset,
 AP_Param *
 AP_Param::find(const char *name, enum ap_var_type *ptype, uint16_t *flags)
 {
+#if AP_PARAM_NAME_INDEX_ENABLED
+    {
+        ParamToken token;
+        AP_Param *ap;
+        if (name_index_find(name, ptype, &token, ap) == IndexResult::FOUND) {
+            if (flags != nullptr) {
+                *flags = 0;
+                if (var_info(token.key).type == AP_PARAM_GROUP) {
+                    uint32_t group_element = 0;
+                    const struct GroupInfo *ginfo;
+                    struct GroupNesting group_nesting {};
+                    uint8_t idx;
+                    ap->find_var_info(&group_element, ginfo, group_nesting, &idx);
+                    if (ginfo != nullptr) {
+                        *flags = ginfo->flags;
+                    }
+                }
+            }
+            return ap;
+        }
+        // not every name find() accepts is a visible scalar, so a
+        // miss falls through to the full search
+    }
+#endif
+
     for (uint16_t i=0; i<_num_vars; i++) {
         const auto &info = var_info(i);
         uint8_t type = info.type;
@@ -1001,6 +1031,17 @@ AP_Param::find_by_index(uint16_t idx, enum ap_var_type *ptype, ParamToken *token
 AP_Param* AP_Param::find_by_name(const char* name, enum ap_var_type *ptype, ParamToken *token)
 {
     AP_Param *ap;
+#if AP_PARAM_NAME_INDEX_ENABLED
+    switch (name_index_find(name, ptype, token, ap)) {
+    case IndexResult::FOUND:
+        return ap;
+    case IndexResult::NOT_FOUND:
+        // the index holds exactly the scalars we would walk below
+        return nullptr;
+    case IndexResult::UNAVAILABLE:
+        break;
+    }
+#endif
     for (ap = AP_Param::first(token, ptype);
          ap && *ptype != AP_PARAM_GROUP && *ptype != AP_PARAM_NONE;
          ap = AP_Param::next_scalar(token, ptype)) {
@@ -1067,6 +1108,13 @@ bool AP_Param::find_key_by_pointer_group(const void *ptr, uint16_t vindex,
 */
 bool AP_Param::find_key_by_pointer(const void *ptr, uint16_t &key)
 {
+#if AP_PARAM_NAME_INDEX_ENABLED
+    // objects reached through pointers aren't indexed, so a miss
+    // falls through to the full search
+    if (pointer_index_find(ptr, key) == IndexResult::FOUND) {
+        return true;
+    }
+#endif
     for (uint16_t i=0; i<_num_vars; i++) {
         const auto &info = var_info(i);
         if (info.type != AP_PARAM_GROUP) {
@@ -1089,6 +1137,244 @@ bool AP_Param::find_key_by_pointer(const void *ptr, uint16_t &key)
     return false;
 }
 
+#if AP_PARAM_NAME_INDEX_ENABLED
+/*
+  case insensitive FNV-1a hash of a parameter name, folded to the 28
+  bits stored in the index
+ */
+uint32_t AP_Param::name_index_hash(const char *name)
+{
+    uint32_t h = 2166136261U;
+    for (uint8_t i=0; i<AP_MAX_NAME_SIZE && name[i] != 0; i++) {
+        h ^= uint8_t(toupper(name[i]));
+        h *= 16777619U;
+    }
+    return (h ^ (h >> 28)) & 0x0FFFFFFFU;
+}
+
+/*
+  add the group objects below a top level parameter to the pointer
+  index, in the same order find_key_by_pointer_group() visits
+  them. Objects reached through a pointer are left out as they may be
+  allocated before invalidate_count() is called, so lookups for them
+  always use the full search. If entries is nullptr the objects are
+  only counted. Returns the new number of entries
+ */
+uint16_t AP_Param::name_index_add_groups(PointerIndexEntry *entries, uint16_t n, uint16_t max,
+                                         uint16_t vindex, const struct GroupInfo *group_info, ptrdiff_t offset)
+{
+    for (uint8_t i=0; group_info[i].type != AP_PARAM_NONE; i++) {
+        if (group_info[i].type != AP_PARAM_GROUP) {
+            continue;
+        }
+        if (group_info[i].flags & AP_PARAM_FLAG_POINTER) {
+            continue;
+        }
+        ptrdiff_t base;
+        if (!get_base(var_info(vindex), base)) {
+            continue;
+        }
+        if (entries != nullptr && n < max) {
+            entries[n] = PointerIndexEntry { (const void *)(base+group_info[i].offset+offset), var_info(vindex).key, n };
+        }
+        n++;
+        ptrdiff_t new_offset = offset;
+        if (!adjust_group_offset(vindex, group_info[i], new_offset)) {
+            continue;
+        }
+        const struct GroupInfo *ginfo = get_group_info(group_info[i]);
+        if (ginfo == nullptr) {
+            continue;
+        }
+        n = name_index_add_groups(entries, n, max, vindex, ginfo, new_offset);
+    }
+    return n;
+}
+
+/*
+  make sure the index reflects the current parameter tree, rebuilding
+  it if needed. Must be called with _name_index_sem held. Returns
+  false if the index can't be used
+ */
+bool AP_Param::name_index_update(void)
+{
+    const uint16_t marker = _count_marker;
+    if (_name_index.built && _name_index.marker == marker) {
+        // up to date, or we've already found we can't build it for
+        // this tree
+        return _name_index.valid;
+    }
+    if (_name_index.built) {
+        // the tree has changed since we last built. It may be
+        // changing again (for example while enable parameters are
+        // being loaded), so wait for it to settle before paying for
+        // a rebuild
+        if (_name_index.stale_marker != marker) {
+            _name_index.stale_marker = marker;
+            _name_index.stale_lookups = 0;
+        }
+        if (_name_index.stale_lookups < AP_PARAM_NAME_INDEX_REBUILD_LOOKUPS) {
+            _name_index.stale_lookups++;
+            return false;
+        }
+    }
+
+    delete[] _name_index.names;
+    delete[] _name_index.pointers;
+    _name_index.names = nullptr;
+    _name_index.pointers = nullptr;
+    _name_index.num_names = 0;
+    _name_index.num_pointers = 0;
+    _name_index.valid = false;
+    _name_index.built = true;
+    _name_index.marker = marker;
+
+    // count what we need so we can check the memory budget
+    uint16_t num_names = 0;
+    enum ap_var_type type;
+    ParamToken token {};
+    for (AP_Param *ap = first(&token, &type); ap != nullptr; ap = next_scalar(&token, &type)) {
+        if (type <= AP_PARAM_FLOAT) {
+            num_names++;
+        }
+    }
+    uint16_t num_pointers = 0;
+    for (uint16_t i=0; i<_num_vars; i++) {
+        const auto &info = var_info(i);
+        if (info.type != AP_PARAM_GROUP || (info.flags & AP_PARAM_FLAG_POINTER)) {
+            continue;
+        }
+        const struct GroupInfo *ginfo = get_group_info(info);
+        if (ginfo != nullptr) {
+            num_pointers = name_index_add_groups(nullptr, num_pointers, 0, i, ginfo, 0);
+        }
+    }
+    const uint32_t bytes = num_names * sizeof(NameIndexEntry) + num_pointers * sizeof(PointerIndexEntry);
+    if (num_names == 0 || bytes > AP_PARAM_NAME_INDEX_MAX_BYTES) {
+        return false;
+    }
+
+    _name_index.names = NEW_NOTHROW NameIndexEntry[num_names];
+    _name_index.pointers = NEW_NOTHROW PointerIndexEntry[MAX(num_pointers, 1U)];
+    if (_name_index.names == nullptr || _name_index.pointers == nullptr) {
+        delete[] _name_index.names;
+        delete[] _name_index.pointers;
+        _name_index.names = nullptr;
+        _name_index.pointers = nullptr;
+        return false;
+    }
+
+    uint16_t n = 0;
+    token = ParamToken {};
+    for (AP_Param *ap = first(&token, &type); ap != nullptr && n < num_names; ap = next_scalar(&token, &type)) {
+        if (type > AP_PARAM_FLOAT) {
+            continue;
+        }
+        char name[AP_MAX_NAME_SIZE+1] {};
+        ap->copy_name_token(token, name, AP_MAX_NAME_SIZE);
+        NameIndexEntry &e = _name_index.names[n++];
+        e.hash = name_index_hash(name);
+        e.type = type;
+        e.token = token;
+        e.ap = ap;
+    }
+    _name_index.num_names = n;
+    qsort(_name_index.names, n, sizeof(NameIndexEntry), [](const void *v1, const void *v2) {
+        const uint32_t h1 = ((const NameIndexEntry *)v1)->hash;
+        const uint32_t h2 = ((const NameIndexEntry *)v2)->hash;
+        return h1 == h2 ? 0 : (h1 < h2 ? -1 : 1);
+    });
+
+    n = 0;
+    for (uint16_t i=0; i<_num_vars; i++) {
+        const auto &info = var_info(i);
+        if (info.type != AP_PARAM_GROUP || (info.flags & AP_PARAM_FLAG_POINTER)) {
+            continue;
+        }
+        const struct GroupInfo *ginfo = get_group_info(info);
+        if (ginfo != nullptr) {
+            n = name_index_add_groups(_name_index.pointers, n, num_pointers, i, ginfo, 0);
+        }
+    }
+    _name_index.num_pointers = MIN(n, num_pointers);
+    qsort(_name_index.pointers, _name_index.num_pointers, sizeof(PointerIndexEntry), [](const void *v1, const void *v2) {
+        const auto *e1 = (const PointerIndexEntry *)v1;
+        const auto *e2 = (const PointerIndexEntry *)v2;
+        if (e1->ptr != e2->ptr) {
+            return uintptr_t(e1->ptr) < uintptr_t(e2->ptr) ? -1 : 1;
+        }
+        return int(e1->seq) - int(e2->seq);
+    });
+
+    _name_index.valid = true;
+    return true;
+}
+
+/*
+  find a scalar parameter by name using the index
+ */
+AP_Param::IndexResult AP_Param::name_index_find(const char *name, enum ap_var_type *ptype, ParamToken *token, AP_Param *&ap)
+{
+    WITH_SEMAPHORE(_name_index_sem);
+    if (!name_index_update()) {
+        return IndexResult::UNAVAILABLE;
+    }
+    const uint32_t hash = name_index_hash(name);
+
+    // bisect for the first entry with this hash
+    uint16_t lo = 0, hi = _name_index.num_names;
+    while (lo < hi) {
+        const uint16_t mid = (lo + hi) / 2;
+        if (_name_index.names[mid].hash < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    // check each entry with a matching hash
+    for (uint16_t i=lo; i<_name_index.num_names && _name_index.names[i].hash == hash; i++) {
+        const NameIndexEntry &e = _name_index.names[i];
+        char buf[AP_MAX_NAME_SIZE+1] {};
+        e.ap->copy_name_token(e.token, buf, AP_MAX_NAME_SIZE);
+        if (strncasecmp(name, buf, AP_MAX_NAME_SIZE) == 0) {
+            ap = e.ap;
+            *ptype = (enum ap_var_type)e.type;
+            *token = e.token;
+            return IndexResult::FOUND;
+        }
+    }
+    return IndexResult::NOT_FOUND;
+}
+
+/*
+  find the key of a group object with a fixed address using the index
+ */
+AP_Param::IndexResult AP_Param::pointer_index_find(const void *ptr, uint16_t &key)
+{
+    WITH_SEMAPHORE(_name_index_sem);
+    if (!name_index_update()) {
+        return IndexResult::UNAVAILABLE;
+    }
+    // bisect for the first entry at this address, which is the one
+    // a linear search would find first
+    uint16_t lo = 0, hi = _name_index.num_pointers;
+    while (lo < hi) {
+        const uint16_t mid = (lo + hi) / 2;
+        if (uintptr_t(_name_index.pointers[mid].ptr) < uintptr_t(ptr)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < _name_index.num_pointers && _name_index.pointers[lo].ptr == ptr) {
+        key = _name_index.pointers[lo].key;
+        return IndexResult::FOUND;
+    }
+    return IndexResult::NOT_FOUND;
+}
+#endif  // AP_PARAM_NAME_INDEX_ENABLED
+
 /*
   Find key to top level group parameters by pointer
 */
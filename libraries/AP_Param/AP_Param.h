@@ -578,6 +578,10 @@ public:
     // invalidate parameter count
     static void invalidate_count(void);
 
+    // marker which changes whenever the parameter tree changes, for
+    // callers which cache information derived from the tree
+    static uint16_t get_count_marker(void) { return _count_marker; }
+
     static void set_hide_disabled_groups(bool value) { _hide_disabled_groups = value; }
 
     // set frame type flags. Used to unhide frame specific parameters
@@ -818,6 +822,56 @@ private:
     static HAL_Semaphore        _count_sem;
     static const struct Info *  _var_info;
 
+#if AP_PARAM_NAME_INDEX_ENABLED
+    /*
+      lazily built index used to speed up lookups by name and by
+      pointer. It is rebuilt when the parameter tree changes, as
+      signalled by invalidate_count()
+     */
+    // a scalar parameter, sorted by hash of its full name
+    struct NameIndexEntry {
+        uint32_t hash : 28;
+        uint32_t type : 4;
+        ParamToken token;
+        AP_Param *ap;
+    };
+    // a group object, sorted by address
+    struct PointerIndexEntry {
+        const void *ptr;
+        uint16_t key;
+        // position in var_info traversal order, to break ties
+        uint16_t seq;
+    };
+    static struct NameIndex {
+        NameIndexEntry *names;
+        PointerIndexEntry *pointers;
+        uint16_t num_names;
+        uint16_t num_pointers;
+        // _count_marker this index was built for
+        uint16_t marker;
+        // lookups made since the tree last changed
+        uint16_t stale_marker;
+        uint8_t stale_lookups;
+        // true once we have tried to build the index
+        bool built;
+        // true if names and pointers reflect the current tree
+        bool valid;
+    } _name_index;
+    static HAL_Semaphore _name_index_sem;
+
+    enum class IndexResult : uint8_t {
+        FOUND,
+        NOT_FOUND,
+        UNAVAILABLE,
+    };
+    static uint32_t name_index_hash(const char *name);
+    static bool name_index_update(void);
+    static uint16_t name_index_add_groups(PointerIndexEntry *entries, uint16_t n, uint16_t max,
+                                          uint16_t vindex, const struct GroupInfo *group_info, ptrdiff_t offset);
+    static IndexResult name_index_find(const char *name, enum ap_var_type *ptype, ParamToken *token, AP_Param *&ap);
+    static IndexResult pointer_index_find(const void *ptr, uint16_t &key);
+#endif  // AP_PARAM_NAME_INDEX_ENABLED
+
 #if AP_PARAM_DYNAMIC_ENABLED
     // allow for a dynamically allocated var table
     static uint16_t             _num_vars_base;
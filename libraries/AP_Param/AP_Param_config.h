@@ -11,3 +11,27 @@
 #ifndef FORCE_APJ_DEFAULT_PARAMETERS
 #define FORCE_APJ_DEFAULT_PARAMETERS 0
 #endif
+
+// memory budget for the lazily built name and pointer lookup index
+// used by find(), find_by_name() and find_key_by_pointer(). If the
+// index would need more than this the linear search is used instead
+#ifndef AP_PARAM_NAME_INDEX_MAX_BYTES
+#if HAL_MEM_CLASS >= HAL_MEM_CLASS_1000
+#define AP_PARAM_NAME_INDEX_MAX_BYTES 65536
+#elif HAL_MEM_CLASS >= HAL_MEM_CLASS_300
+#define AP_PARAM_NAME_INDEX_MAX_BYTES 16384
+#else
+#define AP_PARAM_NAME_INDEX_MAX_BYTES 0
+#endif
+#endif
+
+#ifndef AP_PARAM_NAME_INDEX_ENABLED
+#define AP_PARAM_NAME_INDEX_ENABLED (AP_PARAM_NAME_INDEX_MAX_BYTES > 0)
+#endif
+
+// number of lookups which must happen with the parameter tree
+// unchanged before a stale index is rebuilt. This stops us rebuilding
+// on every lookup while parameters which enable groups are being set
+#ifndef AP_PARAM_NAME_INDEX_REBUILD_LOOKUPS
+#define AP_PARAM_NAME_INDEX_REBUILD_LOOKUPS 8
+#endif
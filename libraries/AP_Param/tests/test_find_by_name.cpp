@@ -90,4 +90,35 @@ TEST(FindByName, Bob)
     }
 }
 
+TEST(FindByName, MatchesFind)
+{
+    // repeat so that later lookups come from the name index
+    for (uint8_t pass=0; pass<3; pass++) {
+        for (const auto &x : TestVehicle::var_info) {
+            if (x.type == AP_PARAM_NONE) {
+                break;
+            }
+            enum ap_var_type ptype1 = (ap_var_type)-1;
+            enum ap_var_type ptype2 = (ap_var_type)-1;
+            AP_Param::ParamToken token {};
+            AP_Param *p1 = AP_Param::find_by_name(x.name, &ptype1, &token);
+            AP_Param *p2 = AP_Param::find(x.name, &ptype2);
+            EXPECT_EQ(p1, x.ptr);
+            EXPECT_EQ(p2, x.ptr);
+            EXPECT_EQ(ptype1, AP_PARAM_INT8);
+            EXPECT_EQ(ptype2, AP_PARAM_INT8);
+        }
+    }
+}
+
+TEST(FindByName, Missing)
+{
+    for (const char *name : { "D", "AAA", "A_", "" }) {
+        enum ap_var_type ptype;
+        AP_Param::ParamToken token {};
+        EXPECT_EQ(AP_Param::find_by_name(name, &ptype, &token), nullptr);
+        EXPECT_EQ(AP_Param::find(name, &ptype), nullptr);
+    }
+}
+
 AP_GTEST_MAIN()
@@ -70,7 +70,7 @@ const AP_Param::GroupInfo AP_Scheduler::var_info[] = {
     // @Param: OPTIONS
     // @DisplayName: Scheduling options
     // @Description: This controls optional aspects of the scheduler.
-    // @Bitmask: 0:Enable per-task perf info
+    // @Bitmask: 0:Enable per-task perf info,1:Enable per-task latency histograms,2:Enable loop timeline tracing,3:Deadline-aware scheduling using measured task times
     // @User: Advanced
     AP_GROUPINFO("OPTIONS",  2, AP_Scheduler, _options, 0),
 
@@ -143,6 +143,25 @@ void AP_Scheduler::init(const AP_Scheduler::Task *tasks, uint8_t num_tasks, uint
         perf_info.allocate_task_info(_num_tasks);
     }
 
+#if AP_SCHEDULER_TASK_LATENCY_ENABLED
+    update_latency_recording();
+#endif
+
+#if AP_SCHEDULER_DEADLINE_ENABLED
+    if (_options & uint8_t(Options::DEADLINE_SCHEDULING)) {
+        _task_estimates = NEW_NOTHROW TaskEstimate[_num_tasks];
+        _deadline_queue = NEW_NOTHROW DeadlineTask[_num_tasks];
+        if (_task_estimates == nullptr || _deadline_queue == nullptr) {
+            // fall back to the priority scheduler
+            DEV_PRINTF("Unable to allocate scheduler deadline queue\n");
+            delete[] _task_estimates;
+            delete[] _deadline_queue;
+            _task_estimates = nullptr;
+            _deadline_queue = nullptr;
+        }
+    }
+#endif
+
     _log_performance_bit = log_performance_bit;
 
     // sanity check the task lists to ensure the priorities are
@@ -196,6 +215,10 @@ void AP_Scheduler::run(uint32_t time_available)
     uint8_t vehicle_tasks_offset = 0;
     uint8_t common_tasks_offset = 0;
 
+#if AP_SCHEDULER_TASK_LATENCY_ENABLED
+    perf_info.loop_trace_start(run_started_usec);
+#endif
+
     for (uint8_t i=0; i<_num_tasks; i++) {
         // determine which of the common task / vehicle task to run
         bool run_vehicle_task = false;
@@ -252,6 +275,15 @@ void AP_Scheduler::run(uint32_t time_available)
                 task_not_achieved++;
             }
 
+#if AP_SCHEDULER_DEADLINE_ENABLED
+            if (_deadline_queue != nullptr) {
+                // leave it to the deadline pass once all fast tasks
+                // have run
+                queue_deadline_task(i, task, dt, interval_ticks);
+                continue;
+            }
+#endif
+
             if (_task_time_allowed > time_available) {
                 // not enough time to run this task.  Continue loop -
                 // maybe another task will fit into time remaining
@@ -262,33 +294,9 @@ void AP_Scheduler::run(uint32_t time_available)
         }
 
         // run it
-        _task_time_started = now;
-        hal.util->persistent_data.scheduler_task = i;
-#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
-        fill_nanf_stack();
-#endif
-        task.function();
-        hal.util->persistent_data.scheduler_task = -1;
-
-        // record the tick counter when we ran. This drives
-        // when we next run the event
-        _last_run[i] = _tick_counter;
-
-        // work out how long the event actually took
-        now = AP_HAL::micros();
-        uint32_t time_taken = now - _task_time_started;
-        bool overrun = false;
-        if (time_taken > _task_time_allowed) {
-            overrun = true;
-            // the event overran!
-            debug(3, "Scheduler overrun task[%u-%s] (%u/%u)\n",
-                  (unsigned)i,
-                  task.name,
-                  (unsigned)time_taken,
-                  (unsigned)_task_time_allowed);
-        }
-
-        perf_info.update_task_info(i, time_taken, overrun);
+        const uint32_t task_start_usec = now;
+        now = run_task(i, task, task_start_usec);
+        const uint32_t time_taken = now - task_start_usec;
 
         if (time_taken >= time_available) {
             /*
@@ -306,6 +314,16 @@ void AP_Scheduler::run(uint32_t time_available)
         }
     }
 
+#if AP_SCHEDULER_DEADLINE_ENABLED
+    if (_deadline_queue != nullptr) {
+        time_available = run_deadline_tasks(time_available, now);
+    }
+#endif
+
+#if AP_SCHEDULER_TASK_LATENCY_ENABLED
+    perf_info.loop_trace_end(AP_HAL::micros());
+#endif
+
     // update number of spare microseconds
     _spare_micros += time_available;
 
@@ -316,6 +334,140 @@ void AP_Scheduler::run(uint32_t time_available)
     }
 }
 
+/*
+  run a single task and record how long it took. start_usec is the
+  time the task is being started, and the time it finished is returned
+ */
+uint32_t AP_Scheduler::run_task(uint8_t i, const Task &task, uint32_t start_usec)
+{
+    _task_time_started = start_usec;
+    hal.util->persistent_data.scheduler_task = i;
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
+    fill_nanf_stack();
+#endif
+    task.function();
+    hal.util->persistent_data.scheduler_task = -1;
+
+    // record the tick counter when we ran. This drives
+    // when we next run the event
+    _last_run[i] = _tick_counter;
+
+    // work out how long the event actually took
+    const uint32_t now = AP_HAL::micros();
+    const uint32_t time_taken = now - _task_time_started;
+    bool overrun = false;
+    if (time_taken > _task_time_allowed) {
+        overrun = true;
+        // the event overran!
+        debug(3, "Scheduler overrun task[%u-%s] (%u/%u)\n",
+              (unsigned)i,
+              task.name,
+              (unsigned)time_taken,
+              (unsigned)_task_time_allowed);
+    }
+
+    perf_info.update_task_info(i, time_taken, overrun);
+#if AP_SCHEDULER_TASK_LATENCY_ENABLED
+    perf_info.record_task_run(i, _task_time_started, MIN(time_taken, uint32_t(UINT16_MAX)));
+#endif
+#if AP_SCHEDULER_DEADLINE_ENABLED
+    if (_task_estimates != nullptr) {
+        _task_estimates[i].update(MIN(time_taken, uint32_t(UINT16_MAX)));
+    }
+#endif
+
+    return now;
+}
+
+#if AP_SCHEDULER_DEADLINE_ENABLED
+/*
+  update the running estimate of a task's run time. This uses the
+  same smoothed mean and mean deviation approach as TCP round trip
+  time estimation
+ */
+void AP_Scheduler::TaskEstimate::update(uint16_t time_taken_us)
+{
+    if (avg_us == 0) {
+        avg_us = MAX(time_taken_us, 1U);
+        dev_us = time_taken_us / 2;
+        return;
+    }
+    const int32_t err = int32_t(time_taken_us) - int32_t(avg_us);
+    avg_us = constrain_int32(int32_t(avg_us) + err / 8, 1, UINT16_MAX);
+    dev_us = constrain_int32(int32_t(dev_us) + (abs(err) - int32_t(dev_us)) / 4, 0, UINT16_MAX);
+}
+
+/*
+  return the predicted time a task will take. Until a task has been
+  measured we fall back to the max_time_micros from the task table
+ */
+uint16_t AP_Scheduler::TaskEstimate::predicted_us(const Task &task) const
+{
+    if (avg_us == 0) {
+        return task.max_time_micros;
+    }
+    return MIN(uint32_t(avg_us) + 2U * dev_us, uint32_t(UINT16_MAX));
+}
+
+/*
+  add a due task to the deadline queue, keeping the queue sorted by
+  the number of ticks remaining before the task is considered to have
+  slipped. Ties keep task table order
+ */
+void AP_Scheduler::queue_deadline_task(uint8_t i, const Task &task, uint16_t dt, uint32_t interval_ticks)
+{
+    DeadlineTask entry {
+        .task = &task,
+        .index = i,
+        .slack_ticks = int16_t(constrain_int32(int32_t(interval_ticks*2) - int32_t(dt), INT16_MIN, INT16_MAX)),
+        .forced = dt >= interval_ticks*max_task_slowdown,
+    };
+    uint8_t n = _deadline_queue_len++;
+    while (n > 0 && _deadline_queue[n-1].slack_ticks > entry.slack_ticks) {
+        _deadline_queue[n] = _deadline_queue[n-1];
+        n--;
+    }
+    _deadline_queue[n] = entry;
+}
+
+/*
+  run queued tasks earliest deadline first, packing them into the
+  remaining loop budget using their measured run times. A task which
+  has reached max_task_slowdown is run regardless of the budget so
+  that low priority tasks are never starved. Returns the remaining
+  time available
+ */
+uint32_t AP_Scheduler::run_deadline_tasks(uint32_t time_available, uint32_t now)
+{
+    for (uint8_t q = 0; q < _deadline_queue_len; q++) {
+        const DeadlineTask &entry = _deadline_queue[q];
+        const uint16_t predicted = _task_estimates[entry.index].predicted_us(*entry.task);
+        if (predicted > time_available && !entry.forced) {
+            // doesn't fit. Keep going, a shorter task may still fit
+            _deadline_stats.skipped++;
+            continue;
+        }
+
+        _task_time_allowed = MAX(entry.task->max_time_micros, predicted);
+        const uint32_t task_start_usec = now;
+        now = run_task(entry.index, *entry.task, task_start_usec);
+        const uint32_t time_taken = now - task_start_usec;
+
+        _deadline_stats.predicted_us += predicted;
+        _deadline_stats.actual_us += time_taken;
+        _deadline_stats.max_error_us = MAX(_deadline_stats.max_error_us, uint16_t(MIN(time_taken > predicted ? time_taken - predicted : 0U, uint32_t(UINT16_MAX))));
+        _deadline_stats.run++;
+        if (entry.forced) {
+            _deadline_stats.forced++;
+        }
+
+        time_available = time_taken >= time_available ? 0 : time_available - time_taken;
+    }
+    _deadline_queue_len = 0;
+    return time_available;
+}
+#endif  // AP_SCHEDULER_DEADLINE_ENABLED
+
 /*
   return number of micros until the current task reaches its deadline
  */
@@ -448,6 +600,22 @@ void AP_Scheduler::update_logging()
     } else if ((_options & uint8_t(Options::RECORD_TASK_INFO)) && !perf_info.has_task_info()) {
         perf_info.allocate_task_info(_num_tasks);
     }
+#if AP_SCHEDULER_TASK_LATENCY_ENABLED
+    if (perf_info.has_task_histograms() &&
+        _log_performance_bit != (uint32_t)-1 &&
+        AP::logger().should_log(_log_performance_bit)) {
+        Log_Write_Task_Histograms();
+    }
+    update_latency_recording();
+#endif
+#if AP_SCHEDULER_DEADLINE_ENABLED
+    if (_deadline_queue != nullptr &&
+        _log_performance_bit != (uint32_t)-1 &&
+        AP::logger().should_log(_log_performance_bit)) {
+        Log_Write_Deadline();
+    }
+    _deadline_stats = {};
+#endif
 }
 
 // Write a performance monitoring packet
@@ -479,8 +647,100 @@ void AP_Scheduler::Log_Write_Performance()
     };
     AP::logger().WriteCriticalBlock(&pkt, sizeof(pkt));
 }
+
+#if AP_SCHEDULER_TASK_LATENCY_ENABLED
+// Write a latency summary for each task which has run since startup
+void AP_Scheduler::Log_Write_Task_Histograms()
+{
+    const uint64_t now_us = AP_HAL::micros64();
+    for (uint8_t i = 0; i < _num_tasks; i++) {
+        const AP::PerfInfo::TaskHistogram *th = perf_info.get_task_histogram(i);
+        if (th == nullptr || th->count == 0) {
+            continue;
+        }
+        struct log_TaskHist pkt = {
+            LOG_PACKET_HEADER_INIT(LOG_TASK_HIST_MSG),
+            time_us : now_us,
+            task_index : i,
+            count : th->count,
+            p50_us : th->percentile_us(0.5f),
+            p99_us : th->percentile_us(0.99f),
+            p999_us : th->percentile_us(0.999f),
+            max_us : th->max_bucket_us(),
+            name : {},
+        };
+        strncpy_noterm(pkt.name, task_name(i), sizeof(pkt.name));
+        AP::logger().WriteBlock(&pkt, sizeof(pkt));
+    }
+}
+#endif  // AP_SCHEDULER_TASK_LATENCY_ENABLED
+
+#if AP_SCHEDULER_DEADLINE_ENABLED
+// Write predicted vs actual budget use of the deadline scheduler
+void AP_Scheduler::Log_Write_Deadline()
+{
+    const struct log_SchedDeadline pkt = {
+        LOG_PACKET_HEADER_INIT(LOG_SCHED_DEADLINE_MSG),
+        time_us      : AP_HAL::micros64(),
+        predicted_us : _deadline_stats.predicted_us,
+        actual_us    : _deadline_stats.actual_us,
+        max_error_us : _deadline_stats.max_error_us,
+        run          : _deadline_stats.run,
+        skipped      : _deadline_stats.skipped,
+        forced       : _deadline_stats.forced,
+    };
+    AP::logger().WriteBlock(&pkt, sizeof(pkt));
+}
+#endif  // AP_SCHEDULER_DEADLINE_ENABLED
 #endif  // HAL_LOGGING_ENABLED
 
+#if AP_SCHEDULER_TASK_LATENCY_ENABLED
+// allocate or free the latency histograms and loop trace to match the
+// current SCHED_OPTIONS
+void AP_Scheduler::update_latency_recording()
+{
+    const bool want_hist = (_options & uint8_t(Options::RECORD_TASK_HISTOGRAMS)) != 0;
+    if (!want_hist && perf_info.has_task_histograms()) {
+        perf_info.free_task_histograms();
+    } else if (want_hist && !perf_info.has_task_histograms()) {
+        perf_info.allocate_task_histograms(_num_tasks);
+    }
+
+    const bool want_trace = (_options & uint8_t(Options::RECORD_LOOP_TRACE)) != 0;
+    if (!want_trace && perf_info.has_loop_trace()) {
+        perf_info.free_loop_trace();
+    } else if (want_trace && !perf_info.has_loop_trace()) {
+        perf_info.allocate_loop_trace();
+    }
+}
+#endif  // AP_SCHEDULER_TASK_LATENCY_ENABLED
+
+// return the name of a task given its index in the merged vehicle and
+// common task list, as used by run()
+const char *AP_Scheduler::task_name(uint8_t task_index) const
+{
+    uint8_t vehicle_tasks_offset = 0;
+    uint8_t common_tasks_offset = 0;
+
+    for (uint8_t i = 0; i < _num_tasks; i++) {
+        bool run_vehicle_task = false;
+        if (vehicle_tasks_offset < _num_vehicle_tasks &&
+            common_tasks_offset < _num_common_tasks) {
+            // in case of a tie the vehicle-specific entry wins
+            run_vehicle_task = _vehicle_tasks[vehicle_tasks_offset].priority <= _common_tasks[common_tasks_offset].priority;
+        } else if (vehicle_tasks_offset < _num_vehicle_tasks) {
+            run_vehicle_task = true;
+        } else if (common_tasks_offset >= _num_common_tasks) {
+            break;
+        }
+        const Task &task = run_vehicle_task ? _vehicle_tasks[vehicle_tasks_offset++] : _common_tasks[common_tasks_offset++];
+        if (i == task_index) {
+            return task.name;
+        }
+    }
+    return "?";
+}
+
 // display task statistics as text buffer for @SYS/tasks.txt
 void AP_Scheduler::task_info(ExpandingString &str)
 {
@@ -545,6 +805,42 @@ void AP_Scheduler::task_info(ExpandingString &str)
 
         ti->print(task_name, total_time, str);
     }
+
+#if AP_SCHEDULER_TASK_LATENCY_ENABLED
+    // latency histogram summaries, all times in microseconds
+    if (perf_info.has_task_histograms()) {
+        str.printf("TaskHist\n");
+        for (uint8_t i = 0; i < _num_tasks; i++) {
+            const AP::PerfInfo::TaskHistogram *th = perf_info.get_task_histogram(i);
+            if (th != nullptr) {
+                th->print(this->task_name(i), str);
+            }
+        }
+    }
+
+    // most recent loop timelines, oldest first. Each task run is
+    // shown as its start offset and duration within the run() call
+    if (perf_info.has_loop_trace()) {
+        str.printf("LoopTrace\n");
+        for (int8_t age = AP_SCHEDULER_LOOP_TRACE_LENGTH - 1; age >= 0; age--) {
+            const AP::PerfInfo::LoopTrace *lt = perf_info.get_loop_trace(age);
+            if (lt == nullptr) {
+                continue;
+            }
+            str.printf("LOOP T=%lu RUN=%u DROP=%u\n",
+                       (unsigned long)lt->start_us,
+                       unsigned(lt->run_time_us),
+                       unsigned(lt->dropped_events));
+            for (uint8_t e = 0; e < lt->num_events; e++) {
+                const AP::PerfInfo::LoopTraceEvent &ev = lt->events[e];
+                str.printf("  %-32.32s @%5u +%5u\n",
+                           this->task_name(ev.task_index),
+                           unsigned(ev.start_us),
+                           unsigned(ev.time_us));
+            }
+        }
+    }
+#endif  // AP_SCHEDULER_TASK_LATENCY_ENABLED
 }
 
 namespace AP {
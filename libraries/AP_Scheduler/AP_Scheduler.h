@@ -94,7 +94,10 @@ public:
     };
 
     enum class Options : uint8_t {
-        RECORD_TASK_INFO = 1 << 0
+        RECORD_TASK_INFO = 1 << 0,
+        RECORD_TASK_HISTOGRAMS = 1 << 1,
+        RECORD_LOOP_TRACE = 1 << 2,
+        DEADLINE_SCHEDULING = 1 << 3,
     };
 
     enum FastTaskPriorities {
@@ -117,6 +120,16 @@ public:
     // write out PERF message to logger
     void Log_Write_Performance();
 
+#if AP_SCHEDULER_TASK_LATENCY_ENABLED
+    // write out per-task latency histogram summaries to logger
+    void Log_Write_Task_Histograms();
+#endif
+
+#if AP_SCHEDULER_DEADLINE_ENABLED
+    // write out predicted vs actual budget use of deadline scheduling
+    void Log_Write_Deadline();
+#endif
+
     // call when one tick has passed
     void tick(void);
 
@@ -192,6 +205,10 @@ public:
 
     HAL_Semaphore &get_semaphore(void) { return _rsem; }
 
+    // return the name of a task given its index in the merged
+    // vehicle and common task list
+    const char *task_name(uint8_t task_index) const;
+
     void task_info(ExpandingString &str);
 
     static const struct AP_Param::GroupInfo var_info[];
@@ -277,6 +294,51 @@ private:
 
     // semaphore that is held while not waiting for ins samples
     HAL_Semaphore _rsem;
+
+#if AP_SCHEDULER_TASK_LATENCY_ENABLED
+    // allocate or free latency histograms and loop trace to match options
+    void update_latency_recording();
+#endif
+
+    // run a single task, returning the time it finished
+    uint32_t run_task(uint8_t i, const Task &task, uint32_t start_usec);
+
+#if AP_SCHEDULER_DEADLINE_ENABLED
+    // measured run time of a task, used to pack tasks into the loop
+    struct TaskEstimate {
+        uint16_t avg_us;
+        uint16_t dev_us;
+
+        void update(uint16_t time_taken_us);
+        uint16_t predicted_us(const Task &task) const;
+    };
+    TaskEstimate *_task_estimates;
+
+    // a task which is due to run this loop
+    struct DeadlineTask {
+        const Task *task;
+        uint8_t index;
+        // ticks remaining before the task has slipped
+        int16_t slack_ticks;
+        // task has reached max_task_slowdown and must run
+        bool forced;
+    };
+    DeadlineTask *_deadline_queue;
+    uint8_t _deadline_queue_len;
+
+    // accumulated between Log_Write_Deadline() calls
+    struct {
+        uint32_t predicted_us;
+        uint32_t actual_us;
+        uint16_t max_error_us;
+        uint16_t run;
+        uint16_t skipped;
+        uint16_t forced;
+    } _deadline_stats;
+
+    void queue_deadline_task(uint8_t i, const Task &task, uint16_t dt, uint32_t interval_ticks);
+    uint32_t run_deadline_tasks(uint32_t time_available, uint32_t now);
+#endif  // AP_SCHEDULER_DEADLINE_ENABLED
 };
 
 namespace AP {
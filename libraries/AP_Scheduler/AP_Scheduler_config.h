@@ -9,3 +9,25 @@
 #ifndef AP_SCHEDULER_EXTENDED_TASKINFO_ENABLED
 #define AP_SCHEDULER_EXTENDED_TASKINFO_ENABLED 1
 #endif
+
+// per-task latency histograms and loop timeline tracing, enabled at
+// runtime via SCHED_OPTIONS
+#ifndef AP_SCHEDULER_TASK_LATENCY_ENABLED
+#define AP_SCHEDULER_TASK_LATENCY_ENABLED AP_SCHEDULER_EXTENDED_TASKINFO_ENABLED
+#endif
+
+// number of loop timelines kept in the loop trace ring buffer
+#ifndef AP_SCHEDULER_LOOP_TRACE_LENGTH
+#define AP_SCHEDULER_LOOP_TRACE_LENGTH 8
+#endif
+
+// maximum number of task runs recorded for a single loop timeline
+#ifndef AP_SCHEDULER_LOOP_TRACE_MAX_EVENTS
+#define AP_SCHEDULER_LOOP_TRACE_MAX_EVENTS 32
+#endif
+
+// deadline-aware scheduling of non-fast tasks, enabled at runtime via
+// SCHED_OPTIONS
+#ifndef AP_SCHEDULER_DEADLINE_ENABLED
+#define AP_SCHEDULER_DEADLINE_ENABLED (HAL_PROGRAM_SIZE_LIMIT_KB > 1024)
+#endif
@@ -109,6 +109,159 @@ void AP::PerfInfo::TaskInfo::print(const char* task_name, uint32_t total_time, E
                 unsigned(MIN(overrun_count, 999)), unsigned(MIN(slip_count, 999)), pct);
 }
 
+#if AP_SCHEDULER_TASK_LATENCY_ENABLED
+// allocate the per-task latency histograms
+void AP::PerfInfo::allocate_task_histograms(uint8_t num_tasks)
+{
+    _task_hist = NEW_NOTHROW TaskHistogram[num_tasks];
+    if (_task_hist == nullptr) {
+        DEV_PRINTF("Unable to allocate scheduler TaskHistogram\n");
+        _num_hist_tasks = 0;
+        return;
+    }
+    _num_hist_tasks = num_tasks;
+}
+
+void AP::PerfInfo::free_task_histograms()
+{
+    delete[] _task_hist;
+    _task_hist = nullptr;
+    _num_hist_tasks = 0;
+}
+
+// allocate the ring buffer of loop timelines
+void AP::PerfInfo::allocate_loop_trace()
+{
+    _loop_trace = NEW_NOTHROW LoopTrace[AP_SCHEDULER_LOOP_TRACE_LENGTH];
+    if (_loop_trace == nullptr) {
+        DEV_PRINTF("Unable to allocate scheduler LoopTrace\n");
+        return;
+    }
+    _loop_trace_idx = 0;
+    _loop_trace_count = 0;
+}
+
+void AP::PerfInfo::free_loop_trace()
+{
+    delete[] _loop_trace;
+    _loop_trace = nullptr;
+    _loop_trace_idx = 0;
+    _loop_trace_count = 0;
+}
+
+// return a loop timeline, 0 being the most recently completed loop
+const AP::PerfInfo::LoopTrace* AP::PerfInfo::get_loop_trace(uint8_t age) const
+{
+    if (_loop_trace == nullptr || age >= _loop_trace_count) {
+        return nullptr;
+    }
+    const uint8_t idx = (_loop_trace_idx + AP_SCHEDULER_LOOP_TRACE_LENGTH - 1 - age) % AP_SCHEDULER_LOOP_TRACE_LENGTH;
+    return &_loop_trace[idx];
+}
+
+// start recording a new loop timeline
+void AP::PerfInfo::loop_trace_start(uint32_t now_us)
+{
+    if (_loop_trace == nullptr) {
+        return;
+    }
+    LoopTrace &lt = _loop_trace[_loop_trace_idx];
+    lt.start_us = now_us;
+    lt.run_time_us = 0;
+    lt.num_events = 0;
+    lt.dropped_events = 0;
+}
+
+// finish the current loop timeline, making it visible to readers
+void AP::PerfInfo::loop_trace_end(uint32_t now_us)
+{
+    if (_loop_trace == nullptr) {
+        return;
+    }
+    LoopTrace &lt = _loop_trace[_loop_trace_idx];
+    lt.run_time_us = MIN(now_us - lt.start_us, uint32_t(UINT16_MAX));
+    _loop_trace_idx = (_loop_trace_idx + 1) % AP_SCHEDULER_LOOP_TRACE_LENGTH;
+    _loop_trace_count = MIN(_loop_trace_count + 1, AP_SCHEDULER_LOOP_TRACE_LENGTH);
+}
+
+// called after each run of a task to record its latency and position
+// in the loop timeline
+void AP::PerfInfo::record_task_run(uint8_t task_index, uint32_t task_start_us, uint16_t task_time_us)
+{
+    if (_task_hist != nullptr && task_index < _num_hist_tasks) {
+        _task_hist[task_index].update(task_time_us);
+    }
+    if (_loop_trace == nullptr) {
+        return;
+    }
+    LoopTrace &lt = _loop_trace[_loop_trace_idx];
+    if (lt.num_events >= ARRAY_SIZE(lt.events)) {
+        lt.dropped_events = MIN(lt.dropped_events + 1, UINT8_MAX);
+        return;
+    }
+    LoopTraceEvent &ev = lt.events[lt.num_events++];
+    ev.task_index = task_index;
+    ev.start_us = MIN(task_start_us - lt.start_us, uint32_t(UINT16_MAX));
+    ev.time_us = task_time_us;
+}
+
+void AP::PerfInfo::TaskHistogram::update(uint16_t task_time_us)
+{
+    const uint8_t b = task_time_us == 0 ? 0 : 31 - __builtin_clz(task_time_us);
+    if (buckets[b] == UINT16_MAX) {
+        // age the whole histogram rather than saturate one bucket
+        count = 0;
+        for (uint16_t &c : buckets) {
+            c /= 2;
+            count += c;
+        }
+    }
+    buckets[b]++;
+    count++;
+}
+
+// return upper bound in microseconds of the bucket containing the
+// given percentile
+uint16_t AP::PerfInfo::TaskHistogram::percentile_us(float p) const
+{
+    if (count == 0) {
+        return 0;
+    }
+    const uint32_t target = MAX(uint32_t(ceilf(count * p)), 1U);
+    uint32_t sum = 0;
+    for (uint8_t b = 0; b < TASK_HIST_BUCKETS; b++) {
+        sum += buckets[b];
+        if (sum >= target) {
+            return uint16_t((1UL << (b + 1)) - 1);
+        }
+    }
+    return UINT16_MAX;
+}
+
+// return upper bound of the highest non-empty bucket
+uint16_t AP::PerfInfo::TaskHistogram::max_bucket_us() const
+{
+    for (int8_t b = TASK_HIST_BUCKETS - 1; b >= 0; b--) {
+        if (buckets[b] != 0) {
+            return uint16_t((1UL << (b + 1)) - 1);
+        }
+    }
+    return 0;
+}
+
+void AP::PerfInfo::TaskHistogram::print(const char* task_name, ExpandingString& str) const
+{
+#if AP_SCHEDULER_EXTENDED_TASKINFO_ENABLED
+    const char* fmt = "%-32.32s N=%6u P50=%5u P99=%5u P999=%5u MAX=%5u\n";
+#else
+    const char* fmt = "%-16.16s N=%6u P50=%5u P99=%5u P999=%5u MAX=%5u\n";
+#endif
+    str.printf(fmt, task_name, unsigned(count),
+               unsigned(percentile_us(0.5f)), unsigned(percentile_us(0.99f)),
+               unsigned(percentile_us(0.999f)), unsigned(max_bucket_us()));
+}
+#endif  // AP_SCHEDULER_TASK_LATENCY_ENABLED
+
 // check_loop_time - check latest loop time vs min, max and overtime threshold
 void AP::PerfInfo::check_loop_time(uint32_t time_in_micros)
 {
@@ -26,6 +26,46 @@ public:
         void print(const char* task_name, uint32_t total_time, ExpandingString& str) const;
     };
 
+#if AP_SCHEDULER_TASK_LATENCY_ENABLED
+    // number of log2 buckets in a task latency histogram. Bucket n
+    // counts runs taking [2^n, 2^(n+1)) microseconds, with bucket 0
+    // also counting zero-length runs, so 16 buckets cover the full
+    // range of a uint16_t task time
+    static constexpr uint8_t TASK_HIST_BUCKETS = 16;
+
+    // per-task latency histogram. Counts are halved whenever a bucket
+    // would saturate, so the histogram ages gracefully over long runs
+    struct TaskHistogram {
+        uint16_t buckets[TASK_HIST_BUCKETS];
+        uint32_t count;
+
+        void update(uint16_t task_time_us);
+        // return upper bound in microseconds of the bucket containing
+        // the given percentile (0 to 1)
+        uint16_t percentile_us(float p) const;
+        // return upper bound of the highest non-empty bucket
+        uint16_t max_bucket_us() const;
+        void print(const char* task_name, ExpandingString& str) const;
+    };
+
+    // a single task run within a loop timeline, with times relative
+    // to the start of the AP_Scheduler::run() call
+    struct PACKED LoopTraceEvent {
+        uint8_t task_index;
+        uint16_t start_us;
+        uint16_t time_us;
+    };
+
+    // the timeline of a single AP_Scheduler::run() call
+    struct LoopTrace {
+        uint32_t start_us;
+        uint16_t run_time_us;
+        uint8_t num_events;
+        uint8_t dropped_events;
+        LoopTraceEvent events[AP_SCHEDULER_LOOP_TRACE_MAX_EVENTS];
+    };
+#endif  // AP_SCHEDULER_TASK_LATENCY_ENABLED
+
     /* Do not allow copies */
     CLASS_NO_COPY(PerfInfo);
 
@@ -62,6 +102,31 @@ public:
         }
     }
 
+#if AP_SCHEDULER_TASK_LATENCY_ENABLED
+    // allocate the per-task latency histograms
+    void allocate_task_histograms(uint8_t num_tasks);
+    void free_task_histograms();
+    bool has_task_histograms() const { return _task_hist != nullptr; }
+    const TaskHistogram* get_task_histogram(uint8_t task_index) const {
+        return (_task_hist && task_index < _num_hist_tasks) ? &_task_hist[task_index] : nullptr;
+    }
+
+    // allocate the ring buffer of loop timelines
+    void allocate_loop_trace();
+    void free_loop_trace();
+    bool has_loop_trace() const { return _loop_trace != nullptr; }
+    // return a loop timeline, 0 being the most recently completed loop
+    const LoopTrace* get_loop_trace(uint8_t age) const;
+
+    // called by the scheduler at the start and end of each run() call
+    void loop_trace_start(uint32_t now_us);
+    void loop_trace_end(uint32_t now_us);
+
+    // called after each run of a task to record its latency and
+    // position in the loop timeline
+    void record_task_run(uint8_t task_index, uint32_t task_start_us, uint16_t task_time_us);
+#endif  // AP_SCHEDULER_TASK_LATENCY_ENABLED
+
 private:
     uint16_t loop_rate_hz;
     uint16_t overtime_threshold_micros;
@@ -77,6 +142,15 @@ private:
     // performance monitoring
     uint8_t _num_tasks;
     TaskInfo* _task_info;
+#if AP_SCHEDULER_TASK_LATENCY_ENABLED
+    uint8_t _num_hist_tasks;
+    TaskHistogram* _task_hist;
+    LoopTrace* _loop_trace;
+    // index of the loop timeline currently being recorded
+    uint8_t _loop_trace_idx;
+    // number of completed loop timelines in the ring buffer
+    uint8_t _loop_trace_count;
+#endif
 };
 
 };
@@ -85,6 +85,26 @@ const AP_Param::GroupInfo AP_Terrain::var_info[] = {
     // @User: Advanced
     AP_GROUPINFO("CACHE_SZ",  5, AP_Terrain, config_cache_size, TERRAIN_GRID_BLOCK_CACHE_SIZE),
 
+#if AP_TERRAIN_WARM_CACHE_ENABLED
+    // @Param: WARM_SZ
+    // @DisplayName: Terrain warm cache size
+    // @Description: The number of 32x28 blocks to keep in memory in compressed form once they drop out of the main terrain cache. Blocks found here are restored without waiting for a disk read. Each block uses about 1100 bytes of memory
+    // @Range: 0 256
+    // @RebootRequired: True
+    // @User: Advanced
+    AP_GROUPINFO("WARM_SZ",  6, AP_Terrain, config_warm_cache_size, TERRAIN_GRID_BLOCK_WARM_CACHE_SIZE),
+#endif
+
+#if AP_TERRAIN_PREFETCH_ENABLED
+    // @Param: PF_TIME
+    // @DisplayName: Terrain prefetch time
+    // @Description: How far ahead of the vehicle, in seconds of flight at the current ground speed, terrain blocks are loaded in advance. Blocks are loaded along the current velocity vector and, when a mission is running, along the current and next mission legs. A value of zero disables prefetching
+    // @Units: s
+    // @Range: 0 600
+    // @User: Advanced
+    AP_GROUPINFO("PF_TIME",  7, AP_Terrain, prefetch_time, 60),
+#endif
+
     AP_GROUPEND
 };
 
@@ -354,7 +374,7 @@ float AP_Terrain::lookahead(float bearing, float distance, float climb_ratio)
 
 
 /*
-  1hz update function. This is here to ensure progress is made on disk
+  update function, called at 10Hz. This is here to ensure progress is made on disk
   IO even if no MAVLink send_request() operations are called for a
   while.
  */
@@ -385,6 +405,13 @@ void AP_Terrain::update(void)
     // check for pending mission data
     update_mission_data();
 
+#if AP_TERRAIN_PREFETCH_ENABLED
+    // load blocks we are about to fly into
+    if (pos_valid) {
+        update_prefetch(loc);
+    }
+#endif
+
 #if HAL_RALLY_ENABLED
     // check for pending rally data
     update_rally_data();
@@ -517,6 +544,15 @@ bool AP_Terrain::allocate(void)
         return false;
     }
     cache_size = config_cache_size;
+#if AP_TERRAIN_WARM_CACHE_ENABLED
+    // the warm cache is optional, so failing to allocate it isn't fatal
+    if (config_warm_cache_size > 0) {
+        warm_cache = (struct warm_block *)calloc(config_warm_cache_size, sizeof(warm_cache[0]));
+        if (warm_cache != nullptr) {
+            warm_cache_size = config_warm_cache_size;
+        }
+    }
+#endif
     return true;
 }
 
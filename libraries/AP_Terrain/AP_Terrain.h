@@ -50,6 +50,17 @@
 #define TERRAIN_GRID_BLOCK_CACHE_SIZE 12
 #endif
 
+// number of compressed grid_blocks kept behind the LRU memory cache.
+// Each one costs about 1100 bytes, so it is off unless TERRAIN_WARM_SZ
+// is set
+#ifndef TERRAIN_GRID_BLOCK_WARM_CACHE_SIZE
+#define TERRAIN_GRID_BLOCK_WARM_CACHE_SIZE 0
+#endif
+
+// space for a compressed grid_block's heights in the warm cache. Blocks
+// which do not compress into this are left to the disk
+#define TERRAIN_WARM_BLOCK_BYTES 1024
+
 // format of grid on disk
 #define TERRAIN_GRID_FORMAT_VERSION 1
 
@@ -80,6 +91,7 @@
  */
 
 class AP_Terrain {
+    friend class AP_Terrain_Test;
 public:
     AP_Terrain();
 
@@ -190,6 +202,21 @@ public:
      */
     void get_statistics(uint16_t &pending, uint16_t &loaded) const;
 
+    /*
+      cache statistics, counted since boot
+     */
+    struct CacheStatistics {
+        uint32_t hot_hits;      // lookups found in the main cache
+        uint32_t warm_hits;     // lookups found in the warm cache
+        uint32_t misses;        // lookups which needed a disk read
+        uint32_t disk_hits;     // disk reads which returned data
+        uint32_t disk_misses;   // disk reads which found no data
+        uint32_t prefetches;    // blocks read or requested ahead of the vehicle
+        uint32_t warm_rejects;  // blocks too rough to compress
+        uint16_t warm_blocks;   // blocks currently in the warm cache
+    };
+    void get_statistics(CacheStatistics &stats) const;
+
     /*
       get grid spacing in meters
      */
@@ -280,6 +307,27 @@ private:
         uint32_t last_access_ms;
     };
 
+#if AP_TERRAIN_WARM_CACHE_ENABLED
+    /*
+      a grid_block held in the warm cache. Heights are delta encoded
+      in file order, one signed byte per height, with an escape for
+      steps which don't fit in a byte
+     */
+    struct warm_block {
+        int32_t lat;
+        int32_t lon;
+        uint64_t bitmap;
+        uint32_t last_access_ms;
+        uint16_t spacing;
+        uint16_t version;
+        uint8_t version_minor;
+        enum GridCacheState state;
+        // compressed length, zero for an empty slot
+        uint16_t length;
+        uint8_t data[TERRAIN_WARM_BLOCK_BYTES];
+    };
+#endif
+
     /*
       grid_info is a broken down representation of a Location, giving
       the index terms for finding the right grid
@@ -374,6 +422,24 @@ private:
      */
     void update_rally_data(void);
 
+#if AP_TERRAIN_PREFETCH_ENABLED
+    /*
+      load blocks ahead of the vehicle
+     */
+    void update_prefetch(const Location &loc);
+    bool prefetch_block(const Location &loc, int32_t &last_lat, int32_t &last_lon, uint8_t &count);
+#endif
+
+#if AP_TERRAIN_WARM_CACHE_ENABLED
+    /*
+      warm cache functions
+     */
+    static bool warm_compress(const struct grid_block &grid, uint8_t *data, uint16_t &length);
+    static void warm_decompress(const uint8_t *data, struct grid_block &grid);
+    void warm_cache_store(const struct grid_cache &gcache);
+    bool warm_cache_load(struct grid_cache &gcache);
+#endif
+
     /*
       calculate reference offset if needed
      */
@@ -387,6 +453,12 @@ private:
     AP_Int16 options; // option bits
     AP_Float offset_max;
     AP_Int16 config_cache_size;
+#if AP_TERRAIN_WARM_CACHE_ENABLED
+    AP_Int16 config_warm_cache_size;
+#endif
+#if AP_TERRAIN_PREFETCH_ENABLED
+    AP_Int16 prefetch_time;
+#endif
 
     enum class Options {
         DisableDownload = (1U<<0),
@@ -406,6 +478,14 @@ private:
     uint8_t cache_size = 0;
     struct grid_cache *cache = nullptr;
 
+#if AP_TERRAIN_WARM_CACHE_ENABLED
+    // compressed blocks evicted from cache, LRU
+    uint16_t warm_cache_size;
+    struct warm_block *warm_cache;
+#endif
+
+    struct CacheStatistics cache_stats;
+
     // a grid_cache block waiting for disk IO
     enum DiskIoState {
         DiskIoIdle      = 0,
@@ -486,6 +566,11 @@ private:
     // grid spacing during rally check
     uint16_t last_rally_spacing;
 
+#if AP_TERRAIN_PREFETCH_ENABLED
+    // last time we looked ahead for blocks to load
+    uint32_t last_prefetch_ms;
+#endif
+
     char *file_path = nullptr;
 
     // status
@@ -6,3 +6,13 @@
 #ifndef AP_TERRAIN_AVAILABLE
 #define AP_TERRAIN_AVAILABLE AP_FILESYSTEM_FILE_READING_ENABLED
 #endif
+
+// keep blocks evicted from the main cache in a compressed form in RAM
+#ifndef AP_TERRAIN_WARM_CACHE_ENABLED
+#define AP_TERRAIN_WARM_CACHE_ENABLED (AP_TERRAIN_AVAILABLE && HAL_PROGRAM_SIZE_LIMIT_KB > 1024)
+#endif
+
+// load blocks ahead of the vehicle along its velocity and mission legs
+#ifndef AP_TERRAIN_PREFETCH_ENABLED
+#define AP_TERRAIN_PREFETCH_ENABLED (AP_TERRAIN_AVAILABLE && HAL_PROGRAM_SIZE_LIMIT_KB > 1024)
+#endif
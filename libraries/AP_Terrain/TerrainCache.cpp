@@ -0,0 +1,159 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  warm cache of compressed grid blocks for terrain code
+
+  Blocks evicted from the main LRU cache are compressed into the warm
+  cache, and restored from it on a later miss instead of waiting on a
+  disk read (or a GCS download when running diskless)
+ */
+
+#include "AP_Terrain.h"
+
+#if AP_TERRAIN_WARM_CACHE_ENABLED
+
+#include <AP_Common/AP_Common.h>
+
+// marks a height stored in full rather than as a one byte delta
+#define WARM_ESCAPE 0x80
+
+/*
+  compress a block's heights into a warm slot, in file order,
+  returning false if they would not fit
+ */
+bool AP_Terrain::warm_compress(const struct grid_block &grid, uint8_t *data, uint16_t &length)
+{
+    uint16_t ofs = 0;
+    int16_t prev = 0;
+    for (uint16_t i=0; i<TERRAIN_GRID_BLOCK_SIZE_X*TERRAIN_GRID_BLOCK_SIZE_Y; i++) {
+        const int16_t h = grid.height[i/TERRAIN_GRID_BLOCK_SIZE_Y][i%TERRAIN_GRID_BLOCK_SIZE_Y];
+        const int32_t delta = int32_t(h) - prev;
+        if (delta > -128 && delta < 128) {
+            if (ofs + 1 > TERRAIN_WARM_BLOCK_BYTES) {
+                return false;
+            }
+            data[ofs++] = uint8_t(int8_t(delta));
+        } else {
+            if (ofs + 3 > TERRAIN_WARM_BLOCK_BYTES) {
+                return false;
+            }
+            data[ofs++] = WARM_ESCAPE;
+            data[ofs++] = uint16_t(h) & 0xFF;
+            data[ofs++] = uint16_t(h) >> 8;
+        }
+        prev = h;
+    }
+    length = ofs;
+    return true;
+}
+
+void AP_Terrain::warm_decompress(const uint8_t *data, struct grid_block &grid)
+{
+    uint16_t ofs = 0;
+    int16_t prev = 0;
+    for (uint16_t i=0; i<TERRAIN_GRID_BLOCK_SIZE_X*TERRAIN_GRID_BLOCK_SIZE_Y; i++) {
+        if (data[ofs] == WARM_ESCAPE) {
+            prev = int16_t(data[ofs+1] | (data[ofs+2] << 8));
+            ofs += 3;
+        } else {
+            prev += int8_t(data[ofs]);
+            ofs++;
+        }
+        grid.height[i/TERRAIN_GRID_BLOCK_SIZE_Y][i%TERRAIN_GRID_BLOCK_SIZE_Y] = prev;
+    }
+}
+
+/*
+  put a block being evicted from the main cache into the warm cache,
+  replacing any older copy of it or else the least recently used slot
+ */
+void AP_Terrain::warm_cache_store(const struct grid_cache &gcache)
+{
+    const struct grid_block &grid = gcache.grid;
+    if (warm_cache_size == 0 ||
+        gcache.state == GRID_CACHE_INVALID ||
+        grid.bitmap == 0) {
+        // nothing worth keeping
+        return;
+    }
+
+    uint16_t slot = 0;
+    for (uint16_t i=0; i<warm_cache_size; i++) {
+        const struct warm_block &w = warm_cache[i];
+        if (w.length != 0 &&
+            w.lat == grid.lat && w.lon == grid.lon && w.spacing == grid.spacing) {
+            slot = i;
+            break;
+        }
+        if (w.length == 0) {
+            // prefer an empty slot, unless we find a matching block
+            if (warm_cache[slot].length != 0) {
+                slot = i;
+            }
+        } else if (warm_cache[slot].length != 0 &&
+                   w.last_access_ms < warm_cache[slot].last_access_ms) {
+            slot = i;
+        }
+    }
+
+    struct warm_block &w = warm_cache[slot];
+    uint16_t length;
+    if (!warm_compress(grid, w.data, length)) {
+        // too rough to compress. Drop any stale copy in this slot
+        w.length = 0;
+        cache_stats.warm_rejects++;
+        return;
+    }
+    w.length = length;
+    w.lat = grid.lat;
+    w.lon = grid.lon;
+    w.bitmap = grid.bitmap;
+    w.spacing = grid.spacing;
+    w.version = grid.version;
+    w.version_minor = grid.version_minor;
+    w.state = gcache.state;
+    w.last_access_ms = gcache.last_access_ms;
+}
+
+/*
+  fill in a newly set up cache entry from the warm cache if we have
+  it there. The grid indices were already filled in by the caller.
+  The warm copy is released as the block is back in the main cache
+ */
+bool AP_Terrain::warm_cache_load(struct grid_cache &gcache)
+{
+    struct grid_block &grid = gcache.grid;
+    for (uint16_t i=0; i<warm_cache_size; i++) {
+        struct warm_block &w = warm_cache[i];
+        if (w.length == 0 ||
+            !TERRAIN_LATLON_EQUAL(w.lat, grid.lat) ||
+            !TERRAIN_LATLON_EQUAL(w.lon, grid.lon) ||
+            w.spacing != grid.spacing) {
+            continue;
+        }
+        warm_decompress(w.data, grid);
+        grid.lat = w.lat;
+        grid.lon = w.lon;
+        grid.bitmap = w.bitmap;
+        grid.version = w.version;
+        grid.version_minor = w.version_minor;
+        gcache.state = w.state;
+        w.length = 0;
+        return true;
+    }
+    return false;
+}
+
+#endif // AP_TERRAIN_WARM_CACHE_ENABLED
@@ -194,6 +194,22 @@ void AP_Terrain::get_statistics(uint16_t &pending, uint16_t &loaded) const
     }
 }
 
+/*
+  get cache hit/miss statistics
+*/
+void AP_Terrain::get_statistics(CacheStatistics &stats) const
+{
+    stats = cache_stats;
+    stats.warm_blocks = 0;
+#if AP_TERRAIN_WARM_CACHE_ENABLED
+    for (uint16_t i=0; i<warm_cache_size; i++) {
+        if (warm_cache[i].length != 0) {
+            stats.warm_blocks++;
+        }
+    }
+#endif
+}
+
 #if HAL_GCS_ENABLED
 /*
    handle terrain messages from GCS
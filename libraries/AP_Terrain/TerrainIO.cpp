@@ -84,6 +84,11 @@ void AP_Terrain::schedule_disk_io(void)
     case DiskIoDoneRead: {
         // a read has completed
         int16_t cache_idx = find_io_idx(GRID_CACHE_DISKWAIT);
+        if (disk_block.block.bitmap != 0) {
+            cache_stats.disk_hits++;
+        } else {
+            cache_stats.disk_misses++;
+        }
         if (cache_idx != -1) {
             if (disk_block.block.bitmap != 0) {
                 // when bitmap is zero we read an empty block
@@ -26,6 +26,7 @@
 #include <AP_Mission/AP_Mission.h>
 #include <AP_Rally/AP_Rally.h>
 #include <AP_GPS/AP_GPS.h>
+#include <AP_AHRS/AP_AHRS.h>
 
 extern const AP_HAL::HAL& hal;
 
@@ -111,6 +112,119 @@ void AP_Terrain::update_mission_data(void)
 #endif  // AP_MISSION_ENABLED
 }
 
+#if AP_TERRAIN_PREFETCH_ENABLED
+/*
+  bring the block containing loc into the cache, skipping it if it
+  is the same block as the last one we looked at. count is reduced
+  for each block which was not already in the cache, and only blocks
+  which need a disk read or download are counted as prefetches
+ */
+bool AP_Terrain::prefetch_block(const Location &loc, int32_t &last_lat, int32_t &last_lon, uint8_t &count)
+{
+    struct grid_info info;
+    calculate_grid_info(loc, info);
+    if (info.grid_lat == last_lat && info.grid_lon == last_lon) {
+        return false;
+    }
+    last_lat = info.grid_lat;
+    last_lon = info.grid_lon;
+
+    const uint32_t hot_hits = cache_stats.hot_hits;
+    const uint32_t misses = cache_stats.misses;
+    find_grid_cache(info);
+    if (cache_stats.hot_hits != hot_hits) {
+        // already loaded, this just refreshed its LRU time
+        return false;
+    }
+    if (cache_stats.misses != misses) {
+        // not restored from the warm cache
+        cache_stats.prefetches++;
+    }
+    count--;
+    return true;
+}
+
+/*
+  load the blocks the vehicle is about to fly over, so their disk
+  reads (or GCS requests) are queued before we need them. We look
+  TERRAIN_PF_TIME seconds ahead along the velocity vector and, when a
+  mission is running, along the current and next mission legs
+ */
+void AP_Terrain::update_prefetch(const Location &loc)
+{
+    if (prefetch_time <= 0 || grid_spacing <= 0) {
+        return;
+    }
+
+    // update() runs at 10Hz, but we look a long way ahead so once a
+    // second is plenty
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - last_prefetch_ms < 1000) {
+        return;
+    }
+    last_prefetch_ms = now_ms;
+
+    const Vector2f &vel = AP::ahrs().groundspeed_vector();
+    const float distance = vel.length() * prefetch_time;
+    if (distance < grid_spacing) {
+        // not moving
+        return;
+    }
+
+    // leave most of the cache for the blocks around the vehicle
+    uint8_t count = MAX(cache_size / 4, 1);
+
+    // sample at half a block so no block along the path is missed
+    const float step = 0.5f * grid_spacing * TERRAIN_GRID_BLOCK_SPACING_X;
+    int32_t last_lat = 0;
+    int32_t last_lon = 0;
+
+    const float bearing = degrees(atan2f(vel.y, vel.x));
+    for (float d=step; d<distance && count>0; d+=step) {
+        Location loc2 = loc;
+        loc2.offset_bearing(bearing, d);
+        prefetch_block(loc2, last_lat, last_lon, count);
+    }
+
+#if AP_MISSION_ENABLED
+    const AP_Mission &mission = AP::mission();
+    if (mission.state() != AP_Mission::MISSION_RUNNING) {
+        return;
+    }
+
+    // follow the current leg then the next one
+    Location from = loc;
+    float remaining = distance;
+    uint16_t index = mission.get_current_nav_index();
+    for (uint8_t leg=0; leg<2 && remaining > 0 && count > 0; leg++) {
+        AP_Mission::Mission_Command cmd;
+        while (true) {
+            if (!mission.read_cmd_from_storage(index, cmd)) {
+                return;
+            }
+            if (mission.is_nav_cmd(cmd) &&
+                (cmd.content.location.lat != 0 || cmd.content.location.lng != 0)) {
+                break;
+            }
+            index++;
+        }
+        index++;
+
+        const Location &to = cmd.content.location;
+        const float leg_bearing = degrees(from.get_bearing(to));
+        const float leg_length = MIN(from.get_distance(to), remaining);
+        for (float d=0; d<leg_length && count>0; d+=step) {
+            Location loc2 = from;
+            loc2.offset_bearing(leg_bearing, d);
+            prefetch_block(loc2, last_lat, last_lon, count);
+        }
+        remaining -= leg_length;
+        from = to;
+    }
+#endif  // AP_MISSION_ENABLED
+}
+#endif  // AP_TERRAIN_PREFETCH_ENABLED
+
 #if HAL_RALLY_ENABLED
 /*
   check that we have fetched all rally terrain data
@@ -115,6 +115,7 @@ AP_Terrain::grid_cache &AP_Terrain::find_grid_cache(const struct grid_info &info
             TERRAIN_LATLON_EQUAL(cache[i].grid.lon,info.grid_lon) &&
             cache[i].grid.spacing == grid_spacing) {
             cache[i].last_access_ms = now_ms;
+            cache_stats.hot_hits++;
             return cache[i];
         }
         if (cache[i].last_access_ms < cache[oldest_i].last_access_ms) {
@@ -125,6 +126,10 @@ AP_Terrain::grid_cache &AP_Terrain::find_grid_cache(const struct grid_info &info
     // Not found. Use the oldest grid and make it this grid,
     // initially unpopulated
     struct grid_cache &grid = cache[oldest_i];
+#if AP_TERRAIN_WARM_CACHE_ENABLED
+    // keep what we are evicting in the warm cache
+    warm_cache_store(grid);
+#endif
     memset(&grid, 0, sizeof(grid));
 
     grid.grid.lat = info.grid_lat;
@@ -138,7 +143,15 @@ AP_Terrain::grid_cache &AP_Terrain::find_grid_cache(const struct grid_info &info
     grid.grid.version_minor = TERRAIN_VERSION_MINOR_MIN;
     grid.last_access_ms = now_ms;
 
+#if AP_TERRAIN_WARM_CACHE_ENABLED
+    if (warm_cache_load(grid)) {
+        cache_stats.warm_hits++;
+        return grid;
+    }
+#endif
+
     // mark as waiting for disk read
+    cache_stats.misses++;
     grid.state = GRID_CACHE_DISKWAIT;
 
     return grid;
@@ -0,0 +1,146 @@
+/*
+  check that grid blocks come back out of the compressed warm cache
+  unchanged, and that the cache statistics count what happened
+ */
+#include <AP_gtest.h>
+
+#include <AP_Terrain/AP_Terrain.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+#if AP_TERRAIN_WARM_CACHE_ENABLED
+
+class AP_Terrain_Test {
+public:
+    static constexpr uint16_t warm_size = 2;
+
+    // AP_Terrain is a singleton, so all the tests share one
+    static AP_Terrain &terrain()
+    {
+        static AP_Terrain *t;
+        if (t == nullptr) {
+            t = NEW_NOTHROW AP_Terrain();
+            t->warm_cache = (AP_Terrain::warm_block *)calloc(warm_size, sizeof(t->warm_cache[0]));
+            t->warm_cache_size = warm_size;
+        }
+        return *t;
+    }
+
+    // rolling ground with a cliff every few rows, which needs the
+    // escape to store
+    static void fill_smooth(AP_Terrain::grid_block &grid, int16_t base)
+    {
+        for (uint8_t x=0; x<TERRAIN_GRID_BLOCK_SIZE_X; x++) {
+            for (uint8_t y=0; y<TERRAIN_GRID_BLOCK_SIZE_Y; y++) {
+                grid.height[x][y] = base + (x*7 + y*3) % 50 + ((x % 5 == 0 && y == 0) ? -2000 : 0);
+            }
+        }
+    }
+
+    // a step on every height, too rough for the warm slot
+    static void fill_rough(AP_Terrain::grid_block &grid)
+    {
+        for (uint8_t x=0; x<TERRAIN_GRID_BLOCK_SIZE_X; x++) {
+            for (uint8_t y=0; y<TERRAIN_GRID_BLOCK_SIZE_Y; y++) {
+                grid.height[x][y] = ((x + y) & 1) ? 3000 : -400;
+            }
+        }
+    }
+
+    static void round_trip(const AP_Terrain::grid_block &grid)
+    {
+        uint8_t data[TERRAIN_WARM_BLOCK_BYTES];
+        uint16_t length = 0;
+        ASSERT_TRUE(AP_Terrain::warm_compress(grid, data, length));
+        EXPECT_GT(length, 0);
+        EXPECT_LE(length, TERRAIN_WARM_BLOCK_BYTES);
+        AP_Terrain::grid_block out {};
+        AP_Terrain::warm_decompress(data, out);
+        EXPECT_EQ(memcmp(grid.height, out.height, sizeof(grid.height)), 0);
+    }
+
+    static void round_trips()
+    {
+        AP_Terrain::grid_block grid {};
+        // flat ground is all one byte deltas
+        round_trip(grid);
+        for (int16_t base : { -400, 0, 600, 8800 }) {
+            fill_smooth(grid, base);
+            round_trip(grid);
+        }
+
+        fill_rough(grid);
+        uint8_t data[TERRAIN_WARM_BLOCK_BYTES];
+        uint16_t length = 0;
+        EXPECT_FALSE(AP_Terrain::warm_compress(grid, data, length));
+    }
+
+    static void make_cache(AP_Terrain::grid_cache &gcache, int32_t lat, int32_t lon)
+    {
+        memset(&gcache, 0, sizeof(gcache));
+        gcache.grid.lat = lat;
+        gcache.grid.lon = lon;
+        gcache.grid.spacing = 100;
+        gcache.grid.bitmap = 0x00FFFFFFFFFFFFFFULL;
+        gcache.grid.version = TERRAIN_GRID_FORMAT_VERSION;
+        gcache.state = AP_Terrain::GRID_CACHE_VALID;
+    }
+
+    static void store_and_load()
+    {
+        AP_Terrain &t = terrain();
+        AP_Terrain::CacheStatistics stats;
+        t.get_statistics(stats);
+        EXPECT_EQ(stats.warm_blocks, 0);
+        const uint32_t rejects = stats.warm_rejects;
+
+        AP_Terrain::grid_cache smooth;
+        make_cache(smooth, -353000000, 1491000000);
+        fill_smooth(smooth.grid, 600);
+        t.warm_cache_store(smooth);
+
+        AP_Terrain::grid_cache rough;
+        make_cache(rough, -353100000, 1491000000);
+        fill_rough(rough.grid);
+        t.warm_cache_store(rough);
+
+        t.get_statistics(stats);
+        EXPECT_EQ(stats.warm_blocks, 1);
+        EXPECT_EQ(stats.warm_rejects, rejects + 1);
+
+        // the rough block has to come from disk
+        AP_Terrain::grid_cache load;
+        make_cache(load, rough.grid.lat, rough.grid.lon);
+        load.state = AP_Terrain::GRID_CACHE_INVALID;
+        EXPECT_FALSE(t.warm_cache_load(load));
+
+        // the smooth one comes back whole, and leaves the warm cache
+        make_cache(load, smooth.grid.lat, smooth.grid.lon);
+        load.grid.bitmap = 0;
+        load.state = AP_Terrain::GRID_CACHE_INVALID;
+        ASSERT_TRUE(t.warm_cache_load(load));
+        EXPECT_EQ(load.state, AP_Terrain::GRID_CACHE_VALID);
+        EXPECT_EQ(load.grid.bitmap, smooth.grid.bitmap);
+        EXPECT_EQ(memcmp(load.grid.height, smooth.grid.height, sizeof(load.grid.height)), 0);
+        t.get_statistics(stats);
+        EXPECT_EQ(stats.warm_blocks, 0);
+        EXPECT_FALSE(t.warm_cache_load(load));
+    }
+};
+
+TEST(AP_Terrain, warm_round_trip)
+{
+    AP_Terrain_Test::round_trips();
+}
+
+TEST(AP_Terrain, warm_cache)
+{
+    AP_Terrain_Test::store_and_load();
+}
+
+#endif // AP_TERRAIN_WARM_CACHE_ENABLED
+
+AP_GTEST_MAIN()
@@ -152,6 +152,9 @@ const AP_Param::GroupInfo HarmonicNotchFilterParams::var_info[] = {
 template <class T>
 HarmonicNotchFilter<T>::~HarmonicNotchFilter() {
     delete[] _filters;
+    delete[] _coeffs;
+    delete[] _signal1;
+    delete[] _signal2;
     _num_filters = 0;
     _num_enabled_filters = 0;
 }
@@ -222,6 +225,32 @@ uint16_t HarmonicNotchFilter<T>::notch_count(uint8_t num_sources, uint8_t num_ha
     return notches * composite_notches;
 }
 
+/*
+  allocate the notch filters, packed coefficients and delayed samples
+  for a bank of num_filters notches. Either all are allocated or none
+ */
+template <class T>
+bool HarmonicNotchFilter<T>::allocate_bank(uint16_t num_filters, NotchFilter<float>* &filters, NotchCoeffs* &coeffs, T* &signal1, T* &signal2)
+{
+    filters = NEW_NOTHROW NotchFilter<float>[num_filters];
+    coeffs = NEW_NOTHROW NotchCoeffs[num_filters];
+    // one more delayed sample than filters for the output of the last filter
+    signal1 = NEW_NOTHROW T[num_filters+1];
+    signal2 = NEW_NOTHROW T[num_filters+1];
+    if (filters == nullptr || coeffs == nullptr || signal1 == nullptr || signal2 == nullptr) {
+        delete[] filters;
+        delete[] coeffs;
+        delete[] signal1;
+        delete[] signal2;
+        filters = nullptr;
+        coeffs = nullptr;
+        signal1 = nullptr;
+        signal2 = nullptr;
+        return false;
+    }
+    return true;
+}
+
 /*
   allocate a collection of, at most HAL_HNF_MAX_FILTERS, notch filters to be managed by this harmonic notch filter
  */
@@ -234,9 +263,9 @@ void HarmonicNotchFilter<T>::allocate_filters(uint8_t num_notches, uint32_t harm
     _harmonics = harmonics;
 
     if (_num_filters > 0) {
-        _filters = NEW_NOTHROW NotchFilter<T>[_num_filters];
-        if (_filters == nullptr) {
-            GCS_SEND_TEXT(MAV_SEVERITY_ERROR, "Failed to allocate %u bytes for notch filter", (unsigned int)(_num_filters * sizeof(NotchFilter<T>)));
+        if (!allocate_bank(_num_filters, _filters, _coeffs, _signal1, _signal2)) {
+            GCS_SEND_TEXT(MAV_SEVERITY_ERROR, "Failed to allocate %u bytes for notch filter",
+                          (unsigned int)(_num_filters * (sizeof(NotchFilter<float>) + sizeof(NotchCoeffs) + 2*sizeof(T))));
             _num_filters = 0;
         }
     }
@@ -260,16 +289,33 @@ void HarmonicNotchFilter<T>::expand_filter_count(uint16_t total_notches)
       note that we rely on the semaphore in
       AP_InertialSensor_Backend.cpp to make this thread safe
      */
-    auto filters = NEW_NOTHROW NotchFilter<T>[total_notches];
-    if (filters == nullptr) {
+    NotchFilter<float>* filters;
+    NotchCoeffs* coeffs;
+    T* signal1;
+    T* signal2;
+    if (!allocate_bank(total_notches, filters, coeffs, signal1, signal2)) {
         _alloc_has_failed = true;
         return;
     }
-    memcpy(filters, _filters, sizeof(filters[0])*_num_filters);
+    if (_num_filters > 0) {
+        memcpy(filters, _filters, sizeof(filters[0])*_num_filters);
+        memcpy(coeffs, _coeffs, sizeof(coeffs[0])*_num_filters);
+        memcpy(signal1, _signal1, sizeof(signal1[0])*(_num_filters+1));
+        memcpy(signal2, _signal2, sizeof(signal2[0])*(_num_filters+1));
+    }
     auto _old_filters = _filters;
+    auto _old_coeffs = _coeffs;
+    auto _old_signal1 = _signal1;
+    auto _old_signal2 = _signal2;
     _filters = filters;
+    _coeffs = coeffs;
+    _signal1 = signal1;
+    _signal2 = signal2;
     _num_filters = total_notches;
     delete[] _old_filters;
+    delete[] _old_coeffs;
+    delete[] _old_signal1;
+    delete[] _old_signal2;
 }
 
 /*
@@ -407,10 +453,31 @@ void HarmonicNotchFilter<T>::update(uint8_t num_centers, const float center_freq
             set_center_frequency(_num_enabled_filters++, notch_center, 1.0 + 2 * _notch_spread, harmonic_mul);
         }
     }
+
+    update_coefficients();
 }
 
 /*
-  apply a sample to each of the underlying filters in turn and return the output
+  pack the coefficients of the enabled filters so that apply() can run
+  the cascade without looking at each filter's state. A disabled
+  filter passes its input through unchanged
+ */
+template <class T>
+void HarmonicNotchFilter<T>::update_coefficients()
+{
+    for (uint16_t i = 0; i < _num_enabled_filters; i++) {
+        const auto &notch = _filters[i];
+        if (notch.initialised) {
+            _coeffs[i] = { notch.b0, notch.b1, notch.b2, notch.a1, notch.a2 };
+        } else {
+            _coeffs[i] = { 1, 0, 0, 0, 0 };
+        }
+    }
+    _num_stages = _num_enabled_filters;
+}
+
+/*
+  apply a sample to each filter of the cascade in turn and return the output
  */
 template <class T>
 T HarmonicNotchFilter<T>::apply(const T &sample)
@@ -424,25 +491,57 @@ T HarmonicNotchFilter<T>::apply(const T &sample)
     if (dfd == -1) {
         dfd = ::open("notch.txt", O_WRONLY|O_CREAT|O_TRUNC, 0644);
     }
-#endif
-
-    T output = sample;
     for (uint16_t i = 0; i < _num_enabled_filters; i++) {
-#if NOTCH_DEBUG_LOGGING
         if (!_filters[i].initialised) {
             ::dprintf(dfd, "------- ");
         } else {
             ::dprintf(dfd, "%.4f ", _filters[i]._center_freq_hz);
         }
-#endif
-        output = _filters[i].apply(output);
     }
-#if NOTCH_DEBUG_LOGGING
     if (_num_enabled_filters > 0) {
         ::dprintf(dfd, "\n");
     }
 #endif
-    return output;
+
+    if (_num_stages == 0) {
+        return sample;
+    }
+
+    if (_need_reset) {
+        // as with a single notch filter, pass the sample through and
+        // start all of the delayed samples from it
+        for (uint16_t i = 0; i <= _num_filters; i++) {
+            _signal1[i] = sample;
+            _signal2[i] = sample;
+        }
+        for (uint16_t i = 0; i < _num_stages; i++) {
+            _filters[i].need_reset = false;
+        }
+        _need_reset = false;
+        return sample;
+    }
+
+    /*
+      the delayed outputs of one filter are the delayed inputs of the
+      next, so each stage only loads the history of its output
+     */
+    T input = sample;
+    T input1 = _signal1[0];
+    T input2 = _signal2[0];
+    for (uint16_t i = 0; i < _num_stages; i++) {
+        const NotchCoeffs &c = _coeffs[i];
+        const T output1 = _signal1[i+1];
+        const T output2 = _signal2[i+1];
+        const T output = input*c.b0 + input1*c.b1 + input2*c.b2 - output1*c.a1 - output2*c.a2;
+        _signal2[i] = input1;
+        _signal1[i] = input;
+        input = output;
+        input1 = output1;
+        input2 = output2;
+    }
+    _signal2[_num_stages] = input1;
+    _signal1[_num_stages] = input;
+    return input;
 }
 
 /*
@@ -458,6 +557,7 @@ void HarmonicNotchFilter<T>::reset()
     for (uint16_t i = 0; i < _num_filters; i++) {
         _filters[i].reset();
     }
+    _need_reset = true;
 }
 
 #if HAL_LOGGING_ENABLED
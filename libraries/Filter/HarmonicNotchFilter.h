@@ -26,6 +26,12 @@ class HarmonicNotchFilterParams;
 /*
   a filter that manages a set of notch filters targetted at a fundamental center frequency
   and multiples of that fundamental frequency
+
+  The notches are a cascade of biquads. Coefficients are calculated by
+  the notch filters in update() and packed into a contiguous bank, and
+  apply() runs the whole bank in one tight loop. Each stage's input
+  history is the previous stage's output history, so the delayed
+  samples are shared between neighbouring stages
  */
 template <class T>
 class HarmonicNotchFilter {
@@ -60,8 +66,22 @@ public:
     void log_notch_centers(uint8_t instance, uint64_t now_us) const;
 
 private:
-    // underlying bank of notch filters
-    NotchFilter<T>*  _filters;
+    // underlying notch filters, used to calculate the coefficients of each stage
+    NotchFilter<float>*  _filters;
+    // coefficients of one stage of the cascade
+    struct NotchCoeffs {
+        float b0, b1, b2, a1, a2;
+    };
+    // packed coefficients of the enabled filters, disabled filters pass the sample through
+    NotchCoeffs* _coeffs;
+    // delayed samples at each point in the cascade, element i is the
+    // input of filter i and the output of filter i-1
+    T* _signal1;
+    T* _signal2;
+    // number of filters in the cascade run by apply()
+    uint16_t _num_stages;
+    // history needs to be reset to the next sample
+    bool _need_reset;
     // sample frequency for each filter
     float _sample_freq_hz;
     // base double notch bandwidth for each filter
@@ -85,6 +105,12 @@ private:
     // have we failed to expand filters?
     bool _alloc_has_failed;
 
+    // copy the coefficients of the enabled filters into the packed bank
+    void update_coefficients();
+
+    // allocate the filters and bank for num_filters notches, returns false on failure
+    static bool allocate_bank(uint16_t num_filters, NotchFilter<float>* &filters, NotchCoeffs* &coeffs, T* &signal1, T* &signal2);
+
     // calculate the number of notch filters needed for the given config,
     uint16_t notch_count(uint8_t num_sources, uint8_t num_harmonics, uint8_t composite_notches) const;
 
@@ -0,0 +1,112 @@
+/*
+  benchmark of the per-sample cost of a harmonic notch on 3 axis gyro
+  data, compared with a chain of individual notch filters. The
+  argument is the number of active notches:
+    4:  4 motors, fundamental only, single notch
+    16: 4 motors, two harmonics, double notch
+    48: 8 motors, two harmonics, triple notch
+ */
+#include <AP_gbenchmark.h>
+
+#include <Filter/HarmonicNotchFilter.h>
+#include <Filter/NotchFilter.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+static const float rate_hz = 8000;
+static const float base_freq = 80;
+static const float bandwidth = 40;
+static const float attenuation_dB = 40;
+
+struct NotchConfig {
+    uint8_t num_motors;
+    uint32_t harmonics;
+    uint8_t num_harmonics;
+    uint8_t composite_notches;
+    uint16_t options;
+};
+
+static NotchConfig notch_config(uint16_t num_notches)
+{
+    switch (num_notches) {
+    case 4:
+        return { 4, 1, 1, 1, 0 };
+    case 16:
+        return { 4, 3, 2, 2, uint16_t(HarmonicNotchFilterParams::Options::DoubleNotch) };
+    case 48:
+    default:
+        return { 8, 3, 2, 3, uint16_t(HarmonicNotchFilterParams::Options::TripleNotch) };
+    }
+}
+
+static void motor_frequencies(uint8_t num_motors, float centers[])
+{
+    for (uint8_t m=0; m<num_motors; m++) {
+        centers[m] = 150 + 5 * m;
+    }
+}
+
+static void BM_HarmonicNotchApply(benchmark::State& state)
+{
+    const NotchConfig cfg = notch_config(state.range(0));
+
+    HarmonicNotchFilterParams params {};
+    params.set_options(cfg.options);
+    params.set_attenuation(attenuation_dB);
+    params.set_bandwidth_hz(bandwidth);
+    params.set_center_freq_hz(base_freq);
+    params.set_freq_min_ratio(1.0);
+
+    HarmonicNotchFilter<Vector3f> *filter = NEW_NOTHROW HarmonicNotchFilter<Vector3f>();
+    filter->allocate_filters(cfg.num_motors, cfg.harmonics, cfg.composite_notches);
+    filter->init(rate_hz, params);
+
+    float centers[8];
+    motor_frequencies(cfg.num_motors, centers);
+    filter->update(cfg.num_motors, centers);
+
+    const Vector3f sample { 0.1, -0.2, 0.05 };
+    while (state.KeepRunning()) {
+        Vector3f output = filter->apply(sample);
+        gbenchmark_escape(&output);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    delete filter;
+}
+
+static void BM_NotchChainApply(benchmark::State& state)
+{
+    const NotchConfig cfg = notch_config(state.range(0));
+    const uint16_t num_notches = cfg.num_motors * cfg.num_harmonics * cfg.composite_notches;
+
+    float A, Q;
+    NotchFilter<Vector3f>::calculate_A_and_Q(base_freq, bandwidth / cfg.composite_notches, attenuation_dB, A, Q);
+
+    float centers[8];
+    motor_frequencies(cfg.num_motors, centers);
+
+    NotchFilter<Vector3f> *chain = NEW_NOTHROW NotchFilter<Vector3f>[num_notches];
+    for (uint16_t i = 0; i < num_notches; i++) {
+        const uint8_t m = (i / cfg.composite_notches) % cfg.num_motors;
+        const uint8_t h = i / (cfg.composite_notches * cfg.num_motors) + 1;
+        chain[i].init_with_A_and_Q(rate_hz, centers[m] * h * (1.0 + 0.01 * (i % cfg.composite_notches)), A, Q);
+    }
+
+    const Vector3f sample { 0.1, -0.2, 0.05 };
+    while (state.KeepRunning()) {
+        Vector3f output = sample;
+        for (uint16_t i = 0; i < num_notches; i++) {
+            output = chain[i].apply(output);
+        }
+        gbenchmark_escape(&output);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    delete[] chain;
+}
+
+BENCHMARK(BM_HarmonicNotchApply)->Arg(4)->Arg(16)->Arg(48);
+BENCHMARK(BM_NotchChainApply)->Arg(4)->Arg(16)->Arg(48);
+
+BENCHMARK_MAIN();
@@ -404,4 +404,85 @@ TEST(NotchFilterTest, HarmonicNotchMaxFilters)
     filter.apply(1.0);
 }
 
+/*
+  test that the packed filter bank of a harmonic notch gives the same
+  output as running a chain of individual notch filters, while the
+  source frequencies move and across a reset
+ */
+TEST(NotchFilterTest, HarmonicNotchBank)
+{
+    const uint16_t rate_hz = 2000;
+    const float base_freq = 50;
+    const float bandwidth = 25;
+    const float attenuation_dB = 30;
+    // the fundamental and second harmonic of a triple notch per motor
+    const uint16_t harmonics = 3;
+    const uint8_t num_harmonics = 2;
+    const uint8_t composite_notches = 3;
+    const uint8_t num_motors = 4;
+    const uint16_t num_filters = num_motors * num_harmonics * composite_notches;
+    const uint32_t samples = 20000;
+    const double dt = 1.0 / rate_hz;
+
+    HarmonicNotchFilterParams notch_params {};
+    notch_params.set_options(uint16_t(HarmonicNotchFilterParams::Options::TripleNotch));
+    notch_params.set_attenuation(attenuation_dB);
+    notch_params.set_bandwidth_hz(bandwidth);
+    notch_params.set_center_freq_hz(base_freq);
+    notch_params.set_freq_min_ratio(1.0);
+
+    HarmonicNotchFilter<Vector3f> bank {};
+    bank.allocate_filters(num_motors, harmonics, composite_notches);
+    bank.init(rate_hz, notch_params);
+
+    // the same notches as a chain of individual filters
+    NotchFilter<Vector3f> chain[num_filters] {};
+    float A, Q;
+    NotchFilter<Vector3f>::calculate_A_and_Q(base_freq, bandwidth / composite_notches, attenuation_dB, A, Q);
+    const float spread = bandwidth / (32 * base_freq);
+    const float spread_mul[composite_notches] { 1.0, 1.0 - spread, 1.0 + spread };
+
+    float centers[num_motors];
+    for (uint32_t s=0; s<samples; s++) {
+        // motors speed up and slow down at different rates
+        const double t = s * dt;
+        for (uint8_t m=0; m<num_motors; m++) {
+            centers[m] = 85 + 20 * m + 30 * sin(t * (m + 1));
+        }
+        bank.update(num_motors, centers);
+        uint16_t n = 0;
+        for (uint8_t h=1; h<=num_harmonics; h++) {
+            for (uint8_t m=0; m<num_motors; m++) {
+                for (uint8_t c=0; c<composite_notches; c++) {
+                    chain[n++].init_with_A_and_Q(rate_hz, centers[m] * h * spread_mul[c], A, Q);
+                }
+            }
+        }
+
+        if (s == samples/2) {
+            bank.reset();
+            for (auto &f : chain) {
+                f.reset();
+            }
+        }
+
+        // noise at the motor frequencies on top of a slow rotation
+        Vector3f sample;
+        for (uint8_t m=0; m<num_motors; m++) {
+            const float noise = 0.2 * sin(2 * M_PI * centers[m] * t);
+            sample += Vector3f(noise, -noise, 0.5 * noise);
+        }
+        sample += Vector3f(0.3, -0.1, 0.05) * sin(t);
+
+        Vector3f expected = sample;
+        for (auto &f : chain) {
+            expected = f.apply(expected);
+        }
+        const Vector3f v = bank.apply(sample);
+        EXPECT_NEAR(v.x, expected.x, 1.0e-5);
+        EXPECT_NEAR(v.y, expected.y, 1.0e-5);
+        EXPECT_NEAR(v.z, expected.z, 1.0e-5);
+    }
+}
+
 AP_GTEST_MAIN()
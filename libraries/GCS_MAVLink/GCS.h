@@ -1080,6 +1080,18 @@ private:
     uint16_t send_packet_count;
     uint16_t out_of_space_to_send_count; // number of times HAVE_PAYLOAD_SPACE and friends have returned false
 
+    // deferred message scheduler statistics, logged and reset with
+    // the link statistics
+    struct {
+        uint16_t sent;          // messages sent by update_send
+        uint32_t sched_us;      // time spent in update_send other than sending messages
+        uint16_t sched_max_us;  // longest time spent in a single update_send other than sending messages
+    } send_sched_stats;
+    // true if the scheduling times are being measured, which is only while they are logged
+    bool send_sched_stats_enabled;
+    // time spent sending messages in the current update_send
+    uint32_t update_send_message_us;
+
 #if GCS_DEBUG_SEND_MESSAGE_TIMINGS
     struct {
         uint32_t longest_time_us;
@@ -1328,8 +1328,13 @@ ap_message GCS_MAVLINK::next_deferred_bucket_message_to_send(uint16_t now16_ms)
         return no_message_to_send;
     }
 
-    const uint16_t ms_since_last_sent = now16_ms - deferred_message_bucket[sending_bucket_id].last_sent_ms;
-    if (ms_since_last_sent < get_reschedule_interval_ms(deferred_message_bucket[sending_bucket_id])) {
+    // the slowdown and penalties only lengthen a bucket's interval, so
+    // the full interval need only be calculated once the bucket's own
+    // interval has passed
+    const deferred_message_bucket_t &bucket = deferred_message_bucket[sending_bucket_id];
+    const uint16_t ms_since_last_sent = now16_ms - bucket.last_sent_ms;
+    if (ms_since_last_sent < MIN(bucket.interval_ms, 60000U) ||
+        ms_since_last_sent < get_reschedule_interval_ms(bucket)) {
         // not time to send this bucket
         return no_message_to_send;
     }
@@ -1363,7 +1368,13 @@ bool GCS_MAVLINK::do_try_send_message(const ap_message id)
     void *data = hal.scheduler->disable_interrupts_save();
     uint32_t start_send_message_us = AP_HAL::micros();
 #endif
-    if (!try_send_message(id)) {
+    // the time spent sending is only measured for the MAVS statistics
+    const uint32_t start_sched_stats_us = send_sched_stats_enabled ? AP_HAL::micros() : 0;
+    const bool sent = try_send_message(id);
+    if (send_sched_stats_enabled) {
+        update_send_message_us += AP_HAL::micros() - start_sched_stats_us;
+    }
+    if (!sent) {
         // didn't fit in buffer...
 #if GCS_DEBUG_SEND_MESSAGE_TIMINGS
         try_send_message_stats.no_space_for_message++;
@@ -1371,6 +1382,7 @@ bool GCS_MAVLINK::do_try_send_message(const ap_message id)
 #endif
         return false;
     }
+    send_sched_stats.sent++;
 #if GCS_DEBUG_SEND_MESSAGE_TIMINGS
     const uint32_t delta_us = AP_HAL::micros() - start_send_message_us;
     hal.scheduler->restore_interrupts(data);
@@ -1583,6 +1595,9 @@ void GCS_MAVLINK::update_send()
     // check for any in-progress tasks; check_tasks does its own rate-limiting
     GCS_MAVLINK_InProgress::check_tasks();
 
+    const uint32_t update_send_start_us = send_sched_stats_enabled ? AP_HAL::micros() : 0;
+    update_send_message_us = 0;
+
     const uint32_t start = AP_HAL::millis();
     const uint16_t start16 = start & 0xFFFF;
     while (AP_HAL::millis() - start < 5) { // spend a max of 5ms sending messages.  This should never trigger - out_of_time() should become true
@@ -1689,6 +1704,14 @@ void GCS_MAVLINK::update_send()
     // between the last pass through here
     send_packet_count += uint8_t(_channel_status.current_tx_seq - last_tx_seq);
     last_tx_seq = _channel_status.current_tx_seq;
+
+    // record the scheduling overhead, excluding the messages themselves
+    if (send_sched_stats_enabled) {
+        const uint32_t update_send_us = AP_HAL::micros() - update_send_start_us;
+        const uint32_t sched_us = update_send_us > update_send_message_us ? update_send_us - update_send_message_us : 0;
+        send_sched_stats.sched_us += sched_us;
+        send_sched_stats.sched_max_us = MAX(send_sched_stats.sched_max_us, MIN(sched_us, UINT16_MAX));
+    }
 }
 
 void GCS_MAVLINK::remove_message_from_bucket(int8_t bucket, ap_message id)
@@ -2136,6 +2159,32 @@ void GCS_MAVLINK::log_mavlink_stats()
     };
 
     AP::logger().WriteBlock(&pkt, sizeof(pkt));
+
+    const struct log_MAVSched sched_pkt{
+        LOG_PACKET_HEADER_INIT(LOG_MAV_SCHED_MSG),
+        time_us      : pkt.time_us,
+        chan         : (uint8_t)chan,
+        sent         : send_sched_stats.sent,
+        sched_us     : send_sched_stats.sched_us,
+        sched_max_us : send_sched_stats.sched_max_us,
+    };
+    AP::logger().WriteBlock(&sched_pkt, sizeof(sched_pkt));
+    send_sched_stats = {};
+    // only time the scheduler while its statistics are being logged
+    send_sched_stats_enabled = AP::logger().logging_started();
+
+    auto &fwd_stats = routing.fwd_stats[chan];
+    const struct log_MAVRoute route_pkt{
+        LOG_PACKET_HEADER_INIT(LOG_MAV_ROUTE_MSG),
+        time_us    : pkt.time_us,
+        chan       : (uint8_t)chan,
+        forwarded  : fwd_stats.forwarded,
+        no_space   : fwd_stats.no_space,
+        num_routes : routing.num_routes,
+        evictions  : routing.evictions,
+    };
+    AP::logger().WriteBlock(&route_pkt, sizeof(route_pkt));
+    fwd_stats = {};
 }
 #endif
 
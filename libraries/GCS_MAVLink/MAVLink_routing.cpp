@@ -32,8 +32,16 @@ extern const AP_HAL::HAL& hal;
 
 #define ROUTING_DEBUG 0
 
+// a full routing table only replaces routes that have been quiet for
+// this long, so a burst of new sysids can't push out active routes
+#define ROUTE_REPLACE_TIMEOUT_MS 5000
+
 // constructor
-MAVLink_routing::MAVLink_routing(void) : num_routes(0) {}
+MAVLink_routing::MAVLink_routing(void) : num_routes(0)
+{
+    memset(pair_head, ROUTE_NONE, sizeof(pair_head));
+    memset(sys_head, ROUTE_NONE, sizeof(sys_head));
+}
 
 /*
   forward a MAVLink message to the right port. This also
@@ -206,41 +214,24 @@ bool MAVLink_routing::forward(GCS_MAVLINK &in_link,
 
     // forward on any channels matching the targets
     bool forwarded = false;
-    bool sent_to_chan[MAVLINK_COMM_NUM_BUFFERS];
-    memset(sent_to_chan, 0, sizeof(sent_to_chan));
-    for (uint8_t i=0; i<num_routes; i++) {
-
-        // Skip if channel is private and the target system or component IDs do not match
-        GCS_MAVLINK *out_link = gcs().chan(routes[i].channel);
-        if (out_link == nullptr) {
-            // this is bad
-            continue;
+    bool sent_to_chan[MAVLINK_COMM_NUM_BUFFERS] {};
+    if (broadcast_system) {
+        // broadcasts go to every route
+        for (uint8_t i=0; i<num_routes; i++) {
+            forwarded |= forward_on_route(in_link, msg, routes[i], target_system, target_component, sent_to_chan);
         }
-        if (out_link->is_private() &&
-            (target_system != routes[i].sysid ||
-             target_component != routes[i].compid)) {
-            continue;
+    } else if (broadcast_component || !match_system) {
+        // any component of the target system
+        for (uint8_t i=sys_head[sys_hash(target_system)]; i != ROUTE_NONE; i=routes[i].next_sys) {
+            if (routes[i].sysid == target_system) {
+                forwarded |= forward_on_route(in_link, msg, routes[i], target_system, target_component, sent_to_chan);
+            }
         }
-
-        if (broadcast_system || (target_system == routes[i].sysid &&
-                                 (broadcast_component || 
-                                  target_component == routes[i].compid ||
-                                  !match_system))) {
-
-            if (&in_link != out_link && !sent_to_chan[routes[i].channel]) {
-                if (out_link->check_payload_size(msg.len)) {
-#if ROUTING_DEBUG
-                    ::printf("fwd msg %u from chan %u on chan %u sysid=%d compid=%d\n",
-                             msg.msgid,
-                             (unsigned)in_link.get_chan(),
-                             (unsigned)routes[i].channel,
-                             (int)target_system,
-                             (int)target_component);
-#endif
-                    _mavlink_resend_uart(routes[i].channel, &msg);
-                }
-                sent_to_chan[routes[i].channel] = true;
-                forwarded = true;
+    } else {
+        // only the target component of our system
+        for (uint8_t i=pair_head[pair_hash(target_system, target_component)]; i != ROUTE_NONE; i=routes[i].next_pair) {
+            if (routes[i].sysid == target_system && routes[i].compid == target_component) {
+                forwarded |= forward_on_route(in_link, msg, routes[i], target_system, target_component, sent_to_chan);
             }
         }
     }
@@ -253,6 +244,47 @@ bool MAVLink_routing::forward(GCS_MAVLINK &in_link,
     return process_locally;
 }
 
+/*
+  forward a message on the channel of a route which matches the
+  message's targets. Returns true if the message went, or would have
+  gone if there was space, to a channel other than the one it came in on
+*/
+bool MAVLink_routing::forward_on_route(GCS_MAVLINK &in_link, const mavlink_message_t &msg,
+                                       const route &r, int16_t target_system, int16_t target_component,
+                                       bool sent_to_chan[])
+{
+    GCS_MAVLINK *out_link = gcs().chan(r.channel);
+    if (out_link == nullptr) {
+        // this is bad
+        return false;
+    }
+    // Skip if channel is private and the target system or component IDs do not match
+    if (out_link->is_private() &&
+        (target_system != r.sysid ||
+         target_component != r.compid)) {
+        return false;
+    }
+    if (&in_link == out_link || sent_to_chan[r.channel]) {
+        return false;
+    }
+    if (out_link->check_payload_size(msg.len)) {
+#if ROUTING_DEBUG
+        ::printf("fwd msg %u from chan %u on chan %u sysid=%d compid=%d\n",
+                 msg.msgid,
+                 (unsigned)in_link.get_chan(),
+                 (unsigned)r.channel,
+                 (int)target_system,
+                 (int)target_component);
+#endif
+        _mavlink_resend_uart(r.channel, &msg);
+        fwd_stats[r.channel].forwarded++;
+    } else {
+        fwd_stats[r.channel].no_space++;
+    }
+    sent_to_chan[r.channel] = true;
+    return true;
+}
+
 /*
   send a MAVLink message to all components with this vehicle's system id
 
@@ -271,10 +303,10 @@ void MAVLink_routing::send_to_components(const char *pkt, const mavlink_msg_entr
 {
     bool sent_to_chan[MAVLINK_COMM_NUM_BUFFERS] {};
 
-    // check learned routes
-    for (uint8_t i=0; i<num_routes; i++) {
+    // check learned routes with our system ID
+    for (uint8_t i=sys_head[sys_hash(mavlink_system.sysid)]; i != ROUTE_NONE; i=routes[i].next_sys) {
         if (routes[i].sysid != mavlink_system.sysid) {
-            // our system ID hasn't been seen on this link
+            // another system on the same hash chain
             continue;
         }
         if (sent_to_chan[routes[i].channel]) {
@@ -350,7 +382,6 @@ bool MAVLink_routing::find_by_mavtype_and_compid(uint8_t mavtype, uint8_t compid
 */
 void MAVLink_routing::learn_route(GCS_MAVLINK &in_link, const mavlink_message_t &msg)
 {
-    uint8_t i;
     if (msg.sysid == 0) {
         // don't learn routes to the broadcast system
         return;
@@ -368,30 +399,93 @@ void MAVLink_routing::learn_route(GCS_MAVLINK &in_link, const mavlink_message_t
         return;
     }
     const mavlink_channel_t in_channel = in_link.get_chan();
-    for (i=0; i<num_routes; i++) {
-        if (routes[i].sysid == msg.sysid &&
-            routes[i].compid == msg.compid &&
-            routes[i].channel == in_channel) {
-            if (routes[i].mavtype == 0 && msg.msgid == MAVLINK_MSG_ID_HEARTBEAT) {
-                routes[i].mavtype = mavlink_msg_heartbeat_get_type(&msg);
+    const uint32_t now_ms = AP_HAL::millis();
+    for (uint8_t i=pair_head[pair_hash(msg.sysid, msg.compid)]; i != ROUTE_NONE; i=routes[i].next_pair) {
+        route &r = routes[i];
+        if (r.sysid == msg.sysid &&
+            r.compid == msg.compid &&
+            r.channel == in_channel) {
+            if (r.mavtype == 0 && msg.msgid == MAVLINK_MSG_ID_HEARTBEAT) {
+                r.mavtype = mavlink_msg_heartbeat_get_type(&msg);
             }
-            break;
+            r.last_seen_ms = now_ms;
+            return;
         }
     }
-    if (i == num_routes && i<MAVLINK_MAX_ROUTES) {
-        routes[i].sysid = msg.sysid;
-        routes[i].compid = msg.compid;
-        routes[i].channel = in_channel;
-        if (msg.msgid == MAVLINK_MSG_ID_HEARTBEAT) {
-            routes[i].mavtype = mavlink_msg_heartbeat_get_type(&msg);
+
+    uint8_t idx;
+    if (num_routes < MAVLINK_MAX_ROUTES) {
+        idx = num_routes++;
+    } else {
+        // replace the least recently seen route, if it has gone quiet
+        idx = 0;
+        for (uint8_t i=1; i<num_routes; i++) {
+            if (now_ms - routes[i].last_seen_ms > now_ms - routes[idx].last_seen_ms) {
+                idx = i;
+            }
+        }
+        if (now_ms - routes[idx].last_seen_ms < ROUTE_REPLACE_TIMEOUT_MS) {
+            return;
         }
-        num_routes++;
 #if ROUTING_DEBUG
-        ::printf("learned route %u %u via %u\n",
-                 (unsigned)msg.sysid,
-                 (unsigned)msg.compid,
-                 (unsigned)in_channel);
+        ::printf("dropped route %u %u via %u\n",
+                 (unsigned)routes[idx].sysid,
+                 (unsigned)routes[idx].compid,
+                 (unsigned)routes[idx].channel);
 #endif
+        unlink_route(idx);
+        evictions++;
+    }
+
+    route &r = routes[idx];
+    r.sysid = msg.sysid;
+    r.compid = msg.compid;
+    r.channel = in_channel;
+    r.mavtype = 0;
+    if (msg.msgid == MAVLINK_MSG_ID_HEARTBEAT) {
+        r.mavtype = mavlink_msg_heartbeat_get_type(&msg);
+    }
+    r.last_seen_ms = now_ms;
+    link_route(idx);
+#if ROUTING_DEBUG
+    ::printf("learned route %u %u via %u\n",
+             (unsigned)msg.sysid,
+             (unsigned)msg.compid,
+             (unsigned)in_channel);
+#endif
+}
+
+/*
+  add a route to the front of its hash chains
+*/
+void MAVLink_routing::link_route(uint8_t idx)
+{
+    route &r = routes[idx];
+    uint8_t &pair = pair_head[pair_hash(r.sysid, r.compid)];
+    r.next_pair = pair;
+    pair = idx;
+    uint8_t &sys = sys_head[sys_hash(r.sysid)];
+    r.next_sys = sys;
+    sys = idx;
+}
+
+/*
+  remove a route from its hash chains
+*/
+void MAVLink_routing::unlink_route(uint8_t idx)
+{
+    const route &r = routes[idx];
+    for (uint8_t *p = &pair_head[pair_hash(r.sysid, r.compid)]; *p != ROUTE_NONE; p = &routes[*p].next_pair) {
+        if (*p == idx) {
+            *p = r.next_pair;
+            break;
+        }
+    }
+    for (uint8_t *p = &sys_head[sys_hash(r.sysid)]; *p != ROUTE_NONE; p = &routes[*p].next_sys) {
+        if (*p == idx) {
+            *p = r.next_sys;
+            break;
+        }
     }
 }
 
@@ -415,7 +509,7 @@ void MAVLink_routing::handle_heartbeat(GCS_MAVLINK &link, const mavlink_message_
     mask &= ~no_route_mask;
     
     // mask out channels that are known sources for this sysid/compid
-    for (uint8_t i=0; i<num_routes; i++) {
+    for (uint8_t i=pair_head[pair_hash(msg.sysid, msg.compid)]; i != ROUTE_NONE; i=routes[i].next_pair) {
         if (routes[i].sysid == msg.sysid && routes[i].compid == msg.compid) {
             mask &= ~(1U<<((unsigned)(routes[i].channel-MAVLINK_COMM_0)));
         }
@@ -440,6 +534,9 @@ void MAVLink_routing::handle_heartbeat(GCS_MAVLINK &link, const mavlink_message_
                          (unsigned)msg.compid);
 #endif
                 _mavlink_resend_uart(channel, &msg);
+                fwd_stats[i].forwarded++;
+            } else {
+                fwd_stats[i].no_space++;
             }
         }
     }
@@ -3,11 +3,20 @@
 #pragma once
 
 #include <AP_Common/AP_Common.h>
+#include <AP_HAL/AP_HAL_Boards.h>
 #include "GCS_MAVLink.h"
 
-// 20 routes should be enough for now. This may need to increase as
-// we make more extensive use of MAVLink forwarding
+// number of routes to learn. When the table is full the least
+// recently seen route is replaced
+#ifndef MAVLINK_MAX_ROUTES
+#if HAL_MEM_CLASS >= HAL_MEM_CLASS_500
+#define MAVLINK_MAX_ROUTES 64
+#else
 #define MAVLINK_MAX_ROUTES 20
+#endif
+#endif
+
+static_assert(MAVLINK_MAX_ROUTES > 0 && MAVLINK_MAX_ROUTES < 255, "MAVLINK_MAX_ROUTES must fit in a uint8_t route index");
 
 /*
   object to handle MAVLink packet routing
@@ -52,16 +61,61 @@ public:
     bool find_by_mavtype_and_compid(uint8_t mavtype, uint8_t compid, uint8_t &sysid, mavlink_channel_t &channel) const;
 
 private:
-    // a simple linear routing table. We don't expect to have a lot of
-    // routes, so a scalable structure isn't worthwhile yet.
+    // the routing table. Routes are only ever appended or replaced,
+    // so routes[0..num_routes) are always in use. Each route is on
+    // two hash chains, one keyed by sysid and compid and one keyed by
+    // sysid alone, so targeted messages only look at the routes that
+    // can match
     uint8_t num_routes;
     struct route {
         uint8_t sysid;
         uint8_t compid;
         mavlink_channel_t channel;
         uint8_t mavtype;
+        uint8_t next_pair;      // next route on the same sysid/compid chain
+        uint8_t next_sys;       // next route on the same sysid chain
+        uint32_t last_seen_ms;  // last time a message came in on this route
     } routes[MAVLINK_MAX_ROUTES];
-    
+
+    // end of a hash chain
+    static const uint8_t ROUTE_NONE = 0xFF;
+
+    // smallest power of two holding n routes
+    static constexpr uint16_t hash_size(uint16_t n, uint16_t size=1) {
+        return size >= n ? size : hash_size(n, size*2);
+    }
+    static const uint16_t ROUTE_HASH_SIZE = hash_size(MAVLINK_MAX_ROUTES);
+
+    // first route on each chain
+    uint8_t pair_head[ROUTE_HASH_SIZE];
+    uint8_t sys_head[ROUTE_HASH_SIZE];
+
+    static uint8_t pair_hash(uint8_t sysid, uint8_t compid) {
+        return (sysid * 251U + compid) & (ROUTE_HASH_SIZE-1);
+    }
+    static uint8_t sys_hash(uint8_t sysid) {
+        return sysid & (ROUTE_HASH_SIZE-1);
+    }
+
+    // add and remove a route from the hash chains
+    void link_route(uint8_t idx);
+    void unlink_route(uint8_t idx);
+
+    // number of routes replaced because the table was full
+    uint16_t evictions;
+
+    // per channel forwarding statistics since they were last logged
+    struct {
+        uint16_t forwarded;
+        uint16_t no_space;
+    } fwd_stats[MAVLINK_COMM_NUM_BUFFERS];
+
+    // forward a message on the channel of a route, if it has not
+    // already been sent there. Returns true if the route was used
+    bool forward_on_route(GCS_MAVLINK &in_link, const mavlink_message_t &msg,
+                          const route &r, int16_t target_system, int16_t target_component,
+                          bool sent_to_chan[]);
+
     // a channel mask to block routing as required
     uint8_t no_route_mask;
     
@@ -300,7 +300,8 @@ void Aircraft::sync_frame_time(void)
     uint64_t now = get_wall_time_us();
     uint64_t dt_us = now - last_wall_time_us;
 
-    const float target_dt_us = 1.0e6/(rate_hz*target_speedup);
+    // a negative speedup runs as fast as possible
+    const float target_dt_us = target_speedup > 0 ? 1.0e6/(rate_hz*target_speedup) : 0;
 
     // accumulate sleep debt if we're running too fast
     sleep_debt_us += target_dt_us - dt_us;
@@ -318,7 +319,9 @@ void Aircraft::sync_frame_time(void)
 #else
         // ??
 #endif
-        sleep_debt_us -= (get_wall_time_us() - now);
+        const uint64_t slept_us = get_wall_time_us() - now;
+        sleep_debt_us -= slept_us;
+        sleep_time_us += slept_us;
     }
     last_wall_time_us = get_wall_time_us();
 
@@ -480,13 +483,15 @@ void Aircraft::fill_fdm(struct sitl_fdm &fdm)
     }
 
     // in the first call here, if a speedup option is specified, overwrite it
-    if (is_equal(last_speedup, -1.0f) && !is_equal(get_speedup(), 1.0f)) {
+    if (!speedup_initialised && !is_equal(get_speedup(), 1.0f)) {
         sitl->speedup.set(get_speedup());
     }
     
-    if (!is_equal(last_speedup, float(sitl->speedup)) && sitl->speedup > 0) {
+    if ((!speedup_initialised || !is_equal(last_speedup, float(sitl->speedup))) &&
+        !is_zero(sitl->speedup)) {
         set_speedup(sitl->speedup);
         last_speedup = sitl->speedup;
+        speedup_initialised = true;
     }
 
 #if HAL_LOGGING_ENABLED
@@ -62,6 +62,9 @@ public:
     void set_speedup(float speedup);
     float get_speedup() const { return target_speedup; }
 
+    // total wall clock time spent sleeping to hold the speedup
+    uint64_t get_sleep_time_us() const { return sleep_time_us; }
+
     /*
       set instance number
      */
@@ -284,11 +287,13 @@ protected:
     uint32_t last_fps_report_ms;
     float achieved_rate_hz;  // achieved speedup rate
     int64_t sleep_debt_us;
+    uint64_t sleep_time_us;
     uint32_t last_frame_count;
     uint8_t instance;
     const char *autotest_dir;
     bool use_time_sync = true;
-    float last_speedup = -1.0f;
+    float last_speedup;
+    bool speedup_initialised = false;  // last_speedup has been set
     const char *config_ = "";
     float eas2tas = 1.0;
     float air_density = SSL_AIR_DENSITY;
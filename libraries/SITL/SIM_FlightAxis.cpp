@@ -159,7 +159,7 @@ FlightAxis::FlightAxis(const char *frame_str) :
 
     use_time_sync = false;
     flightaxis_sync_imus_to_frames = true;  // tell the IMUs to advance on each frame that is processed
-    rate_hz = 250 / target_speedup;
+    rate_hz = 250 / realflight_speedup();
     if(strstr(frame_str, "helidemix") != nullptr) {
         _options.set(_options | uint32_t(Option::HeliDemix));
     }
@@ -594,7 +594,7 @@ void FlightAxis::update(const struct sitl_input &input)
 
     gyro = Vector3f(radians(constrain_float(state.m_rollRate_DEGpSEC, -2000, 2000)),
                     radians(constrain_float(state.m_pitchRate_DEGpSEC, -2000, 2000)),
-                    -radians(constrain_float(state.m_yawRate_DEGpSEC, -2000, 2000))) * target_speedup;
+                    -radians(constrain_float(state.m_yawRate_DEGpSEC, -2000, 2000))) * realflight_speedup();
 
     velocity_ef = Vector3f(state.m_velocityWorldU_MPS,
                              state.m_velocityWorldV_MPS,
@@ -194,6 +194,12 @@ private:
         return (uint32_t(option) & uint32_t(_options)) != 0;
     }
 
+    // RealFlight runs in real time, so a negative (as fast as
+    // possible) speedup is treated as 1
+    float realflight_speedup() const {
+        return target_speedup > 0 ? target_speedup : 1.0f;
+    }
+
     double average_frame_time_s;
     double initial_time_s;
     double last_time_s;